@@ -0,0 +1,107 @@
+#include "FrameArena.h"
+#include <algorithm>
+#include <cassert>
+
+namespace utils
+{
+
+CLinearArena::CLinearArena(size_t _BlockSize) :
+    m_BlockSize(_BlockSize),
+    m_Offset(0),
+    m_UsedSize(0)
+{
+  assert(_BlockSize > 0);
+  AddBlock(_BlockSize);
+}
+
+void CLinearArena::Reset()
+{
+  if (m_Blocks.size() > 1)
+  {
+    const size_t TotalSize = GetCapacity();
+    m_Blocks.clear();
+    AddBlock(TotalSize);
+  }
+
+  m_Offset   = 0;
+  m_UsedSize = 0;
+}
+
+size_t CLinearArena::GetUsedSize() const
+{
+  return m_UsedSize;
+}
+
+size_t CLinearArena::GetCapacity() const
+{
+  size_t Capacity = 0;
+  for (const TBlock &Block : m_Blocks)
+    Capacity += Block.Size;
+
+  return Capacity;
+}
+
+void *CLinearArena::do_allocate(size_t _Bytes, size_t _Alignment)
+{
+  const auto AlignUp = [_Alignment](size_t _Value) {
+    return (_Value + _Alignment - 1) & ~(_Alignment - 1);
+  };
+
+  size_t Start = AlignUp(m_Offset);
+  if (Start + _Bytes > m_Blocks.back().Size)
+  {
+    // The rest of the current block is wasted, it's back after the reset
+    m_UsedSize += m_Blocks.back().Size - m_Offset;
+    AddBlock(_Bytes + _Alignment);
+    Start = AlignUp(m_Offset);
+  }
+
+  m_UsedSize += Start + _Bytes - m_Offset;
+  m_Offset    = Start + _Bytes;
+
+  return m_Blocks.back().Data.get() + Start;
+}
+
+void CLinearArena::do_deallocate(void *, size_t, size_t)
+{
+}
+
+bool CLinearArena::do_is_equal(const std::pmr::memory_resource &_Other) const noexcept
+{
+  return this == &_Other;
+}
+
+void CLinearArena::AddBlock(size_t _MinSize)
+{
+  const size_t Size = std::max(_MinSize, m_BlockSize);
+  m_Blocks.push_back({std::make_unique_for_overwrite<std::byte[]>(Size), Size});
+  m_Offset = 0;
+}
+
+CFrameArena::CFrameArena(size_t _FramesInFlight, size_t _BlockSize) :
+    m_Current(0)
+{
+  assert(_FramesInFlight > 0);
+
+  m_Arenas.reserve(_FramesInFlight);
+  for (size_t i = 0; i < _FramesInFlight; ++i)
+    m_Arenas.push_back(std::make_unique<CLinearArena>(_BlockSize));
+}
+
+void CFrameArena::BeginFrame()
+{
+  m_Current = (m_Current + 1) % m_Arenas.size();
+  m_Arenas[m_Current]->Reset();
+}
+
+std::pmr::memory_resource *CFrameArena::GetResource()
+{
+  return m_Arenas[m_Current].get();
+}
+
+size_t CFrameArena::GetUsedSize() const
+{
+  return m_Arenas[m_Current]->GetUsedSize();
+}
+
+} // namespace utils
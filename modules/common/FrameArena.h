@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Core.h"
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace utils
+{
+
+// Bump allocator handing out memory from big blocks, usable by any std::pmr container.
+// Deallocation does nothing, everything is released at once by Reset. A request that doesn't
+// fit takes another block from the heap; Reset merges the blocks into one big enough for the
+// whole peak, so a load that doesn't grow stops touching the heap. Not thread safe.
+class CLinearArena final : public std::pmr::memory_resource
+{
+  DISABLE_CLASS_COPY(CLinearArena);
+
+public:
+  explicit CLinearArena(size_t _BlockSize);
+
+  void Reset();
+
+  size_t GetUsedSize() const; // Bytes handed out since the last reset, padding included
+  size_t GetCapacity() const;
+
+protected:
+  void *do_allocate(size_t _Bytes, size_t _Alignment) override;
+  void do_deallocate(void *_Pointer, size_t _Bytes, size_t _Alignment) override;
+  bool do_is_equal(const std::pmr::memory_resource &_Other) const noexcept override;
+
+private:
+  struct TBlock
+  {
+    std::unique_ptr<std::byte[]> Data;
+    size_t                       Size;
+  };
+
+  void AddBlock(size_t _MinSize);
+
+private:
+  std::vector<TBlock> m_Blocks; // Allocations come from the last one
+  size_t              m_BlockSize;
+  size_t              m_Offset; // Into the last block
+  size_t              m_UsedSize;
+};
+
+// A linear arena for every frame in flight. Transient data of a frame lives in its arena, which
+// is reset only when the frame index comes around to it again, so a frame still consumed while
+// the next one is built keeps its data.
+class CFrameArena final
+{
+  DISABLE_CLASS_COPY(CFrameArena);
+
+public:
+  CFrameArena(size_t _FramesInFlight, size_t _BlockSize);
+
+  void BeginFrame(); // Switches to the arena of the next frame and resets it
+
+  std::pmr::memory_resource *GetResource();
+  size_t GetUsedSize() const; // Of the current frame so far
+
+private:
+  std::vector<std::unique_ptr<CLinearArena>> m_Arenas;
+  size_t                                     m_Current;
+};
+
+} // namespace utils
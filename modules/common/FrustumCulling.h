@@ -0,0 +1,184 @@
+#pragma once
+
+#include <glm/geometric.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define FRUSTUM_CULLING_SSE 1
+#else
+#define FRUSTUM_CULLING_SSE 0
+#endif
+
+namespace utils
+{
+
+enum EFrustumPlane : uint8_t
+{
+  EFrustumPlane_Left,
+  EFrustumPlane_Right,
+  EFrustumPlane_Bottom,
+  EFrustumPlane_Top,
+  EFrustumPlane_Near,
+  EFrustumPlane_Far,
+
+  EFrustumPlane_Count
+};
+
+// Planes face inwards, a point P is on the inner side of (N, D) when dot(N, P) + D >= 0
+struct TFrustum
+{
+  std::array<glm::vec4, EFrustumPlane_Count> Planes; // Indexed by EFrustumPlane
+};
+
+// Gribb-Hartmann extraction from a matrix that maps into glm's clip space, the planes are normalized
+inline TFrustum ExtractFrustum(const glm::mat4 &_ViewProjection)
+{
+  const auto Row = [&_ViewProjection](int _Index) {
+    return glm::vec4(_ViewProjection[0][_Index], _ViewProjection[1][_Index], _ViewProjection[2][_Index], _ViewProjection[3][_Index]);
+  };
+
+  const glm::vec4 W = Row(3);
+
+  TFrustum Frustum{.Planes = {W + Row(0), W - Row(0), W + Row(1), W - Row(1), W + Row(2), W - Row(2)}};
+  for (glm::vec4 &Plane : Frustum.Planes)
+    Plane /= glm::length(glm::vec3(Plane));
+
+  return Frustum;
+}
+
+// Scalar version of the test below, for single boxes
+inline bool IsBoxVisible(const TFrustum &_Frustum, const glm::vec3 &_Center, const glm::vec3 &_Extent)
+{
+  for (const glm::vec4 &Plane : _Frustum.Planes)
+  {
+    const float Distance = Plane.x * _Center.x + Plane.y * _Center.y + Plane.z * _Center.z + Plane.w;
+    const float Radius   = std::abs(Plane.x) * _Extent.x + std::abs(Plane.y) * _Extent.y + std::abs(Plane.z) * _Extent.z;
+    if (Distance + Radius < 0.0f)
+      return false;
+  }
+
+  return true;
+}
+
+// The whole box on the inner side of every plane
+inline bool IsBoxInside(const TFrustum &_Frustum, const glm::vec3 &_Center, const glm::vec3 &_Extent)
+{
+  for (const glm::vec4 &Plane : _Frustum.Planes)
+  {
+    const float Distance = Plane.x * _Center.x + Plane.y * _Center.y + Plane.z * _Center.z + Plane.w;
+    const float Radius   = std::abs(Plane.x) * _Extent.x + std::abs(Plane.y) * _Extent.y + std::abs(Plane.z) * _Extent.z;
+    if (Distance - Radius < 0.0f)
+      return false;
+  }
+
+  return true;
+}
+
+// Boxes as centers and half extents in separate arrays, the layout the culling kernel reads
+struct TBoundsList
+{
+  std::vector<float> CenterX;
+  std::vector<float> CenterY;
+  std::vector<float> CenterZ;
+  std::vector<float> ExtentX;
+  std::vector<float> ExtentY;
+  std::vector<float> ExtentZ;
+
+  void Clear()
+  {
+    for (std::vector<float> *Values : {&CenterX, &CenterY, &CenterZ, &ExtentX, &ExtentY, &ExtentZ})
+      Values->clear();
+  }
+
+  void Push(const glm::vec3 &_Center, const glm::vec3 &_Extent)
+  {
+    CenterX.push_back(_Center.x);
+    CenterY.push_back(_Center.y);
+    CenterZ.push_back(_Center.z);
+    ExtentX.push_back(_Extent.x);
+    ExtentY.push_back(_Extent.y);
+    ExtentZ.push_back(_Extent.z);
+  }
+
+  size_t Size() const
+  {
+    return CenterX.size();
+  }
+};
+
+// Writes 1 into _Visible for every box that isn't entirely behind one of the planes, 0 otherwise.
+// Conservative: boxes near the edges of the frustum may pass without touching it. Four boxes are
+// tested at once with SSE, the remainder and other targets go through the scalar loop.
+inline void CullBounds(const TFrustum &_Frustum, const TBoundsList &_Bounds, std::vector<uint8_t> &_Visible)
+{
+  const size_t Count = _Bounds.Size();
+  _Visible.resize(Count);
+
+  size_t i = 0;
+
+#if FRUSTUM_CULLING_SSE
+  struct TPlane
+  {
+    __m128 NX, NY, NZ, D;
+    __m128 AbsNX, AbsNY, AbsNZ;
+  };
+
+  std::array<TPlane, EFrustumPlane_Count> Planes;
+  for (size_t p = 0; p < Planes.size(); ++p)
+  {
+    const glm::vec4 &Plane = _Frustum.Planes[p];
+    Planes[p]              = TPlane{
+        .NX    = _mm_set1_ps(Plane.x),
+        .NY    = _mm_set1_ps(Plane.y),
+        .NZ    = _mm_set1_ps(Plane.z),
+        .D     = _mm_set1_ps(Plane.w),
+        .AbsNX = _mm_set1_ps(std::abs(Plane.x)),
+        .AbsNY = _mm_set1_ps(std::abs(Plane.y)),
+        .AbsNZ = _mm_set1_ps(std::abs(Plane.z)),
+    };
+  }
+
+  const __m128 Zero = _mm_setzero_ps();
+
+  for (; i + 4 <= Count; i += 4)
+  {
+    const __m128 CX = _mm_loadu_ps(&_Bounds.CenterX[i]);
+    const __m128 CY = _mm_loadu_ps(&_Bounds.CenterY[i]);
+    const __m128 CZ = _mm_loadu_ps(&_Bounds.CenterZ[i]);
+    const __m128 EX = _mm_loadu_ps(&_Bounds.ExtentX[i]);
+    const __m128 EY = _mm_loadu_ps(&_Bounds.ExtentY[i]);
+    const __m128 EZ = _mm_loadu_ps(&_Bounds.ExtentZ[i]);
+
+    __m128 Outside = Zero;
+    for (const TPlane &Plane : Planes)
+    {
+      // Signed distance of the center plus the extent projected onto the normal, summed in the
+      // order of IsBoxVisible so both round the same way on the planes
+      const __m128 Distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(Plane.NX, CX), _mm_mul_ps(Plane.NY, CY)), _mm_mul_ps(Plane.NZ, CZ)), Plane.D);
+      const __m128 Radius   = _mm_add_ps(_mm_add_ps(_mm_mul_ps(Plane.AbsNX, EX), _mm_mul_ps(Plane.AbsNY, EY)), _mm_mul_ps(Plane.AbsNZ, EZ));
+      Outside               = _mm_or_ps(Outside, _mm_cmplt_ps(_mm_add_ps(Distance, Radius), Zero));
+    }
+
+    const int Mask = _mm_movemask_ps(Outside);
+    for (size_t Lane = 0; Lane < 4; ++Lane)
+      _Visible[i + Lane] = ((Mask >> Lane) & 1) == 0;
+  }
+#endif
+
+  for (; i < Count; ++i)
+  {
+    const glm::vec3 Center(_Bounds.CenterX[i], _Bounds.CenterY[i], _Bounds.CenterZ[i]);
+    const glm::vec3 Extent(_Bounds.ExtentX[i], _Bounds.ExtentY[i], _Bounds.ExtentZ[i]);
+    _Visible[i] = IsBoxVisible(_Frustum, Center, Extent);
+  }
+}
+
+} // namespace utils
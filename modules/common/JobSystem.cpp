@@ -0,0 +1,122 @@
+#include "JobSystem.h"
+#include <algorithm>
+#include <cassert>
+
+namespace utils
+{
+
+namespace
+{
+
+thread_local bool IsInsideLoop = false;
+
+} // namespace
+
+CJobSystem &CJobSystem::Instance()
+{
+  static CJobSystem Instance(std::max(std::thread::hardware_concurrency(), 2u) - 1);
+  return Instance;
+}
+
+CJobSystem::CJobSystem(size_t _WorkersCount)
+{
+  m_Workers.reserve(_WorkersCount);
+  for (size_t i = 0; i < _WorkersCount; ++i)
+    m_Workers.emplace_back(&CJobSystem::WorkerLoop, this);
+}
+
+CJobSystem::~CJobSystem()
+{
+  {
+    std::lock_guard Lock(m_Mutex);
+    m_IsStopping = true;
+  }
+
+  m_WorkAvailable.notify_all();
+
+  for (std::thread &Worker : m_Workers)
+    Worker.join();
+}
+
+size_t CJobSystem::GetThreadsCount() const
+{
+  return m_Workers.size() + 1;
+}
+
+void CJobSystem::ParallelFor(size_t _Count, const std::function<void(size_t)> &_Job)
+{
+  if (_Count == 0)
+    return;
+
+  if (_Count == 1 || m_Workers.empty() || IsInsideLoop)
+  {
+    for (size_t i = 0; i < _Count; ++i)
+      _Job(i);
+    return;
+  }
+
+  std::lock_guard LoopLock(m_LoopMutex);
+
+  {
+    std::lock_guard Lock(m_Mutex);
+    m_Job         = &_Job;
+    m_Count       = _Count;
+    m_ActiveCount = m_Workers.size();
+    m_NextIndex.store(0, std::memory_order_relaxed);
+    m_Generation++;
+  }
+
+  m_WorkAvailable.notify_all();
+
+  RunIterations();
+
+  // The job and the counters must outlive every worker that may still touch them
+  std::unique_lock Lock(m_Mutex);
+  m_WorkDone.wait(Lock, [this] { return m_ActiveCount == 0; });
+  m_Job = nullptr;
+}
+
+void CJobSystem::WorkerLoop()
+{
+  uint64_t SeenGeneration = 0;
+
+  while (true)
+  {
+    {
+      std::unique_lock Lock(m_Mutex);
+      m_WorkAvailable.wait(Lock, [&] { return m_IsStopping || m_Generation != SeenGeneration; });
+
+      if (m_IsStopping)
+        return;
+
+      SeenGeneration = m_Generation;
+    }
+
+    RunIterations();
+
+    bool IsLast = false;
+    {
+      std::lock_guard Lock(m_Mutex);
+      IsLast = --m_ActiveCount == 0;
+    }
+
+    if (IsLast)
+      m_WorkDone.notify_one();
+  }
+}
+
+void CJobSystem::RunIterations()
+{
+  IsInsideLoop = true;
+
+  size_t Index = m_NextIndex.fetch_add(1, std::memory_order_relaxed);
+  while (Index < m_Count)
+  {
+    (*m_Job)(Index);
+    Index = m_NextIndex.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  IsInsideLoop = false;
+}
+
+} // namespace utils
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils
+{
+
+// Fixed pool of worker threads for data parallel loops. The calling thread works on the loop as
+// well and returns once every iteration is done, so the loop bodies may reference its locals.
+// One loop runs at a time, loops started from inside a loop body run on the calling thread only.
+class CJobSystem final
+{
+public:
+  static CJobSystem &Instance();
+
+  explicit CJobSystem(size_t _WorkersCount);
+  ~CJobSystem();
+
+  CJobSystem(const CJobSystem &)            = delete;
+  CJobSystem &operator=(const CJobSystem &) = delete;
+
+  size_t GetThreadsCount() const; // Workers and the calling thread
+
+  // _Job(i) for every i in [0, _Count), in no particular order
+  void ParallelFor(size_t _Count, const std::function<void(size_t)> &_Job);
+
+private:
+  void WorkerLoop();
+  void RunIterations();
+
+private:
+  std::vector<std::thread> m_Workers;
+  std::mutex               m_LoopMutex; // Held by the thread that runs the current loop
+  std::mutex               m_Mutex;
+  std::condition_variable  m_WorkAvailable;
+  std::condition_variable  m_WorkDone;
+
+  // Current loop, guarded by m_Mutex apart from the counters
+  const std::function<void(size_t)> *m_Job = nullptr;
+  size_t                             m_Count       = 0;
+  uint64_t                           m_Generation  = 0;
+  size_t                             m_ActiveCount = 0; // Workers still inside the loop
+  std::atomic<size_t>                m_NextIndex   = 0;
+  bool                               m_IsStopping  = false;
+};
+
+} // namespace utils
@@ -6,6 +6,7 @@
 
 CStaticArray<CLogger::LogCallback, CLogger::CallbacksAmount> CLogger::LogCallbacks;
 ELogType                                                     CLogger::Verbosity = ELogType::Debug;
+std::mutex                                                   CLogger::Mutex;
 
 const std::string_view                     CLogger::Filename    = "engine_log";
 const std::map<ELogType, std::string_view> CLogger::MessageType = {{ELogType::Debug, "[DEBUG] {}\n"},
@@ -14,6 +15,19 @@ const std::map<ELogType, std::string_view> CLogger::MessageType = {{ELogType::De
                                                                    {ELogType::Error, "[ERROR] {}\n"},
                                                                    {ELogType::Fatal, "[!] {}\n"}};
 
+void CLogger::SetSinks(uint32_t _Sinks)
+{
+  std::lock_guard Lock(Mutex);
+
+  LogCallbacks.Clear();
+
+  if (_Sinks & File)
+    LogCallbacks.PushBack(CLogger::LogToFile);
+
+  if (_Sinks & Console)
+    LogCallbacks.PushBack(CLogger::LogToConsole);
+}
+
 void CLogger::DoLog(ELogType _Type, const std::string &_Log)
 {
   if (!IsLoggable(_Type))
@@ -21,6 +35,7 @@ void CLogger::DoLog(ELogType _Type, const std::string &_Log)
 
   const std::string MessageToLog = std::vformat(MessageType.at(_Type), std::make_format_args(_Log));
 
+  std::lock_guard Lock(Mutex);
   for (auto Callback : LogCallbacks)
     Callback(MessageToLog);
 }
@@ -37,12 +52,8 @@ void CLogger::LogToConsole(const std::string &_Log)
 
 void CLogger::LogToFile(const std::string &_Log)
 {
-  static auto Flags = std::ios::out;
-
-  std::fstream LogFile(Filename.data(), Flags);
+  // Truncated by the first message of the run and kept open since
+  static std::ofstream LogFile(Filename.data(), std::ios::out);
   if (LogFile.is_open())
-  {
-    Flags = std::ios::app;
-    LogFile << _Log;
-  }
+    LogFile << _Log << std::flush;
 }
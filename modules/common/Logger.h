@@ -3,6 +3,7 @@
 #include "containers/StaticArray.h"
 #include <format>
 #include <map>
+#include <mutex>
 #include <string>
 
 enum class ELogType
@@ -14,6 +15,7 @@ enum class ELogType
   Fatal
 };
 
+// Thread safe, messages from different threads are written one at a time
 class CLogger final
 {
 public:
@@ -24,16 +26,7 @@ public:
     Console = 0x02
   };
 
-  static constexpr void SetSinks(uint32_t _Sinks)
-  {
-    LogCallbacks.Clear();
-
-    if (_Sinks & File)
-      LogCallbacks.PushBack(CLogger::LogToFile);
-
-    if (_Sinks & Console)
-      LogCallbacks.PushBack(CLogger::LogToConsole);
-  }
+  static void SetSinks(uint32_t _Sinks);
 
   static constexpr void SetVerbosity(ELogType _Verbosity)
   {
@@ -62,7 +55,8 @@ private:
   static const std::string_view                     Filename;
   static const std::map<ELogType, std::string_view> MessageType;
 
-  static ELogType Verbosity;
+  static ELogType   Verbosity;
+  static std::mutex Mutex; // Guards the sinks and what they write to
 };
 
 #define LOG_DEBUG(...)   CLogger::Log(ELogType::Debug, __VA_ARGS__)
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace utils
+{
+
+struct TSortEntry
+{
+  uint64_t Key;
+  uint32_t Index; // Into the array the key was built from
+};
+
+// Stable LSD radix sort on 64-bit keys, one byte per pass. Digits that are the same for every
+// entry are skipped, so keys with unused bits cost fewer passes. _Scratch is kept by the caller
+// to avoid allocating every frame.
+inline void RadixSort(std::vector<TSortEntry> &_Entries, std::vector<TSortEntry> &_Scratch)
+{
+  constexpr size_t   DIGIT_BITS = 8;
+  constexpr size_t   DIGITS     = 64 / DIGIT_BITS;
+  constexpr size_t   RADIX      = size_t(1) << DIGIT_BITS;
+  constexpr uint64_t DIGIT_MASK = RADIX - 1;
+
+  const size_t Count = _Entries.size();
+  if (Count < 2)
+    return;
+
+  // All histograms in a single read of the keys
+  std::array<std::array<uint32_t, RADIX>, DIGITS> Histograms{};
+  for (const TSortEntry &Entry : _Entries)
+  {
+    for (size_t Digit = 0; Digit < DIGITS; ++Digit)
+      Histograms[Digit][(Entry.Key >> (Digit * DIGIT_BITS)) & DIGIT_MASK]++;
+  }
+
+  _Scratch.resize(Count);
+
+  std::vector<TSortEntry> *Source      = &_Entries;
+  std::vector<TSortEntry> *Destination = &_Scratch;
+
+  for (size_t Digit = 0; Digit < DIGITS; ++Digit)
+  {
+    std::array<uint32_t, RADIX> &Histogram = Histograms[Digit];
+
+    const size_t Shift = Digit * DIGIT_BITS;
+    if (Histogram[((*Source)[0].Key >> Shift) & DIGIT_MASK] == Count)
+      continue;
+
+    uint32_t Offset = 0;
+    for (uint32_t &Bucket : Histogram)
+    {
+      const uint32_t BucketCount = Bucket;
+      Bucket                     = Offset;
+      Offset += BucketCount;
+    }
+
+    for (const TSortEntry &Entry : *Source)
+      (*Destination)[Histogram[(Entry.Key >> Shift) & DIGIT_MASK]++] = Entry;
+
+    std::swap(Source, Destination);
+  }
+
+  if (Source != &_Entries)
+    _Entries.swap(_Scratch);
+}
+
+} // namespace utils
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Log-linear histogram in the spirit of HdrHistogram: every power-of-two range is split into
+// the same number of linear sub-buckets, so the relative error is bounded (< 1%) for any magnitude.
+// Recording, removing and querying a percentile do not allocate.
+class CHdrHistogram
+{
+public:
+  explicit CHdrHistogram(uint64_t _MaxValue) :
+      m_Counts(GetIndex(_MaxValue) + 1, 0),
+      m_MaxValue(_MaxValue),
+      m_TotalCount(0)
+  {
+  }
+
+  void Record(uint64_t _Value)
+  {
+    m_Counts[GetIndex(std::min(_Value, m_MaxValue))]++;
+    m_TotalCount++;
+  }
+
+  void Remove(uint64_t _Value)
+  {
+    uint64_t &Count = m_Counts[GetIndex(std::min(_Value, m_MaxValue))];
+    assert(Count > 0 && "Removing a value that was never recorded");
+
+    Count--;
+    m_TotalCount--;
+  }
+
+  void Reset()
+  {
+    std::fill(m_Counts.begin(), m_Counts.end(), 0);
+    m_TotalCount = 0;
+  }
+
+  uint64_t GetCount() const
+  {
+    return m_TotalCount;
+  }
+
+  // Returns the highest value equivalent to the one at the given rank, _Percent is in [0, 100]
+  uint64_t GetPercentile(double _Percent) const
+  {
+    if (m_TotalCount == 0)
+      return 0;
+
+    const uint64_t Rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(_Percent / 100.0 * m_TotalCount)));
+
+    uint64_t Accumulated = 0;
+    for (size_t i = 0; i < m_Counts.size(); ++i)
+    {
+      Accumulated += m_Counts[i];
+      if (Accumulated >= Rank)
+        return std::min(GetHighestValue(i), m_MaxValue);
+    }
+
+    return m_MaxValue;
+  }
+
+private:
+  static size_t GetIndex(uint64_t _Value)
+  {
+    if (_Value < SUB_BUCKETS_COUNT)
+      return static_cast<size_t>(_Value);
+
+    const unsigned Shift = std::bit_width(_Value) - SUB_BUCKET_BITS;
+    return SUB_BUCKETS_COUNT + (Shift - 1) * SUB_BUCKETS_HALF + ((_Value >> Shift) - SUB_BUCKETS_HALF);
+  }
+
+  static uint64_t GetHighestValue(size_t _Index)
+  {
+    if (_Index < SUB_BUCKETS_COUNT)
+      return _Index;
+
+    const size_t   Shift    = (_Index - SUB_BUCKETS_COUNT) / SUB_BUCKETS_HALF + 1;
+    const uint64_t SubIndex = (_Index - SUB_BUCKETS_COUNT) % SUB_BUCKETS_HALF + SUB_BUCKETS_HALF;
+    return ((SubIndex + 1) << Shift) - 1;
+  }
+
+private:
+  static constexpr unsigned SUB_BUCKET_BITS   = 8;
+  static constexpr size_t   SUB_BUCKETS_COUNT = size_t(1) << SUB_BUCKET_BITS;
+  static constexpr size_t   SUB_BUCKETS_HALF  = SUB_BUCKETS_COUNT / 2;
+
+  std::vector<uint64_t> m_Counts;
+  uint64_t              m_MaxValue;
+  uint64_t              m_TotalCount;
+};
@@ -24,6 +24,9 @@ public:
   CUnorderedVector<TEntity> GetEntities() const;
   CUnorderedVector<TComponentView> GetEntityComponents(TEntity _Entity) const;
 
+  // Components are modified in place, the systems observing them learn about it from here
+  void NotifyComponentChanged(TEntity _Entity, TTypeID _TypeID);
+
   template <typename T>
   void RegisterComponent();
 
@@ -36,6 +39,9 @@ public:
   template <typename T>
   T &GetComponent(TEntity _Entity);
 
+  template <typename T>
+  void NotifyComponentChanged(TEntity _Entity);
+
   template <typename T>
   TComponentType GetComponentType() const;
 
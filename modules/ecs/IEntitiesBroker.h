@@ -18,6 +18,7 @@ public:
   virtual CEntitySpawner CreateEntitySpawner()                                        = 0;
   virtual CUnorderedVector<TEntity> GetEntities() const                               = 0;
   virtual CUnorderedVector<TComponentView> GetEntityComponents(TEntity _Entity) const = 0;
+  virtual void NotifyComponentChanged(TEntity _Entity, TTypeID _TypeID)              = 0;
 };
 
 } // namespace ecs
\ No newline at end of file
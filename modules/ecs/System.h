@@ -30,6 +30,11 @@ public:
       OnEntityDeleted(_Entity);
   }
 
+  void ComponentChanged(ecs::TEntity _Entity, ecs::TComponentType _ComponentType)
+  {
+    OnComponentChanged(_Entity, _ComponentType);
+  }
+
 protected:
   virtual void OnEntityAdded(ecs::TEntity _Entity)
   {
@@ -41,6 +46,12 @@ protected:
     // Empty
   }
 
+  // A component of the signature was modified in place, only for entities of the system
+  virtual void OnComponentChanged(ecs::TEntity _Entity, ecs::TComponentType _ComponentType)
+  {
+    // Empty
+  }
+
 protected:
   CCoordinator                  *m_Coordinator;
   CUnorderedVector<ecs::TEntity> m_Entities;
@@ -35,6 +35,13 @@ public:
     return m_ComponentTypes[TypeID];
   }
 
+  TComponentType GetComponentType(TTypeID _TypeID) const
+  {
+    assert(m_ComponentTypes.contains(_TypeID) && "Component not registered before use.");
+
+    return m_ComponentTypes.at(_TypeID);
+  }
+
   template <typename T>
   void AddComponent(TEntity _Entity, T &&_Component)
   {
@@ -44,4 +44,9 @@ CUnorderedVector<TComponentView> CCoordinator::GetEntityComponents(TEntity _Enti
   return m_ComponentManager->GetEntityComponents(_Entity);
 }
 
+void CCoordinator::NotifyComponentChanged(TEntity _Entity, TTypeID _TypeID)
+{
+  m_SystemManager->ComponentChanged(_Entity, m_EntityManager->GetSignature(_Entity), m_ComponentManager->GetComponentType(_TypeID));
+}
+
 } // namespace ecs
\ No newline at end of file
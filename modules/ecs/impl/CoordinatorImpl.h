@@ -43,6 +43,12 @@ T &CCoordinator::GetComponent(TEntity _Entity)
   return m_ComponentManager->GetComponent<T>(_Entity);
 }
 
+template <typename T>
+void CCoordinator::NotifyComponentChanged(TEntity _Entity)
+{
+  m_SystemManager->ComponentChanged(_Entity, m_EntityManager->GetSignature(_Entity), m_ComponentManager->GetComponentType<T>());
+}
+
 template <typename T>
 TComponentType CCoordinator::GetComponentType() const
 {
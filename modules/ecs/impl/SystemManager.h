@@ -66,6 +66,17 @@ public:
     }
   }
 
+  void ComponentChanged(ecs::TEntity _Entity, const ecs::TSignature &_EntitySignature, ecs::TComponentType _ComponentType)
+  {
+    for (const auto &[Name, System] : m_Systems)
+    {
+      const ecs::TSignature &SystemSignature = m_Signatures[Name];
+
+      if (SystemSignature.test(_ComponentType) && (_EntitySignature & SystemSignature) == SystemSignature)
+        System->ComponentChanged(_Entity, _ComponentType);
+    }
+  }
+
 private:
   std::unordered_map<ctti::type_id_t, ecs::TSignature>          m_Signatures;
   std::unordered_map<ctti::type_id_t, std::shared_ptr<CSystem>> m_Systems;
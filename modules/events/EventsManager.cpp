@@ -91,3 +91,8 @@ void CEventsManager::Unnotify(const TEvent &_Event)
   if (Iter != m_PendingEvents.end())
     m_PendingEvents.erase(Iter);
 }
+
+bool CEventsManager::HasPendingEvents() const
+{
+  return !m_PendingEvents.empty();
+}
@@ -28,6 +28,8 @@ public:
   void Notify(TEvent _Event);
   void Unnotify(const TEvent &_Event);
 
+  bool HasPendingEvents() const;
+
 private:
   using ListenersList = std::vector<std::weak_ptr<IEventsListener>>;
 
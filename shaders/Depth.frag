@@ -2,22 +2,39 @@
 
 struct TMaterial
 {
-  sampler2D BaseColorTexture;
-
+  vec4  BaseColorFactor;
+  vec3  EmissiveFactor;
+  float MetallicFactor;
+  float RoughnessFactor;
+  float OcclusionStrength;
   float AlphaCutoff;
   int   AlphaMode;
+  bool  IsDoubleSided;
+  int   BaseColorTextureTexCoordIndex;
+  int   MetallicRoughnessTextureTexCoordIndex;
+  int   NormalTextureTexCoordIndex;
+  int   OcclusionTextureTexCoordIndex;
+  int   EmissiveTextureTexCoordIndex;
 };
 
-uniform TMaterial u_Material;
+layout(std430, binding = 2) readonly buffer u_Materials
+{
+  TMaterial Materials[];
+};
+
+uniform sampler2D u_BaseColorTexture;
 
 in vec2 io_TexCoords;
 
+flat in uint io_MaterialIndex;
+
 void main()
 {
-  bool isEnableCutoff = u_Material.AlphaMode == 1 || u_Material.AlphaMode == 2; // Treat BLEND as MASK in the depth pass
+  TMaterial material       = Materials[io_MaterialIndex];
+  bool      isEnableCutoff = material.AlphaMode == 1 || material.AlphaMode == 2; // Treat BLEND as MASK in the depth pass
 
-  vec4 baseColorSample = texture(u_Material.BaseColorTexture, io_TexCoords);
-  if (isEnableCutoff && baseColorSample.a < u_Material.AlphaCutoff)
+  vec4 baseColorSample = texture(u_BaseColorTexture, io_TexCoords);
+  if (isEnableCutoff && baseColorSample.a < material.AlphaCutoff)
     discard;
 
   // gl_FragDepth = gl_FragCoord.z;
@@ -6,11 +6,34 @@ layout(location = 3) in vec2 aTexCoords_0;
 
 out vec2 io_TexCoords;
 
-uniform mat4 u_Model;
-uniform mat4 u_LightSpaceMatrix;
+flat out uint io_MaterialIndex;
+
+struct TDrawData
+{
+  mat4 Model;
+  uint MaterialIndex;
+  vec4 BoundsMin; // World space, read by OcclusionCull.comp
+  vec4 BoundsMax;
+};
+
+layout(std430, binding = 3) readonly buffer u_DrawData
+{
+  TDrawData Draws[];
+};
+
+layout(std140, binding = 4) uniform u_Frame
+{
+  mat4 LightSpaceMatrix;
+  vec2 Jitter;
+  vec2 PrevJitter;
+  vec2 InverseScreenSize;
+};
 
 void main()
 {
-  io_TexCoords = aTexCoords_0;
-  gl_Position  = u_LightSpaceMatrix * u_Model * vec4(aPos, 1.0);
+  TDrawData draw = Draws[gl_BaseInstance + gl_InstanceID];
+
+  io_TexCoords     = aTexCoords_0;
+  io_MaterialIndex = draw.MaterialIndex;
+  gl_Position      = LightSpaceMatrix * draw.Model * vec4(aPos, 1.0);
 }
\ No newline at end of file
@@ -4,11 +4,22 @@ layout(location = 0) in vec3 aPos;
 
 out vec3 io_WorldPos;
 
-uniform mat4 u_MVP;
+layout(std140, binding = 5) uniform u_View
+{
+  mat4 ViewMatrix;
+  mat4 ProjectionMatrix;
+  mat4 ViewProjectionMatrix;
+  mat4 JitteredViewProjectionMatrix;
+  mat4 PrevJitteredViewProjectionMatrix;
+  vec3 CameraPosition;
+};
+
 uniform mat4 u_Model;
 
 void main()
 {
-  io_WorldPos = (u_Model * vec4(aPos, 1.0)).xyz;
-  gl_Position = u_MVP * vec4(aPos, 1.0);
+  vec4 worldPos = u_Model * vec4(aPos, 1.0);
+
+  io_WorldPos = worldPos.xyz;
+  gl_Position = ViewProjectionMatrix * worldPos;
 }
@@ -14,21 +14,6 @@ layout(std140, binding = 1) uniform u_Lighting
 
 struct TMaterial
 {
-  sampler2D BaseColorTexture;
-  int       BaseColorTextureTexCoordIndex;
-
-  sampler2D MetallicRoughnessTexture;
-  int       MetallicRoughnessTextureTexCoordIndex;
-
-  sampler2D NormalTexture;
-  int       NormalTextureTexCoordIndex;
-
-  sampler2D OcclusionTexture;
-  int       OcclusionTextureTexCoordIndex;
-
-  sampler2D EmissiveTexture;
-  int       EmissiveTextureTexCoordIndex;
-
   vec4  BaseColorFactor;
   vec3  EmissiveFactor;
   float MetallicFactor;
@@ -37,14 +22,36 @@ struct TMaterial
   float AlphaCutoff;
   int   AlphaMode;
   bool  IsDoubleSided;
+  int   BaseColorTextureTexCoordIndex;
+  int   MetallicRoughnessTextureTexCoordIndex;
+  int   NormalTextureTexCoordIndex;
+  int   OcclusionTextureTexCoordIndex;
+  int   EmissiveTextureTexCoordIndex;
 };
 
-uniform TMaterial   u_Material;
+layout(std430, binding = 2) readonly buffer u_Materials
+{
+  TMaterial Materials[];
+};
+
+layout(std140, binding = 5) uniform u_View
+{
+  mat4 ViewMatrix;
+  mat4 ProjectionMatrix;
+  mat4 ViewProjectionMatrix;
+  mat4 JitteredViewProjectionMatrix;
+  mat4 PrevJitteredViewProjectionMatrix;
+  vec3 CameraPosition;
+};
+
+uniform sampler2D   u_BaseColorTexture;
+uniform sampler2D   u_MetallicRoughnessTexture;
+uniform sampler2D   u_NormalTexture;
+uniform sampler2D   u_OcclusionTexture;
+uniform sampler2D   u_EmissiveTexture;
 uniform sampler2D   u_ShadowMap;
 uniform bool        u_IsShadowMapEnabled;
 uniform samplerCube u_IrradianceMap;
-uniform mat4        u_LightSpaceMatrix;
-uniform vec3        u_ViewPos;
 
 in vec3 io_Normal;
 in vec3 io_FragPos;
@@ -54,6 +61,8 @@ in vec2 io_TexCoords[4];
 in vec4 io_CurrPosition;
 in vec4 io_PrevPosition;
 
+flat in uint io_MaterialIndex;
+
 layout(location = 0) out vec4 o_FragColor;
 layout(location = 1) out vec2 o_Velocity;
 
@@ -133,35 +142,37 @@ float CalculateShadow(vec4 fragLightPos, vec3 lightDir, vec3 normal)
 
 void main()
 {
-  vec2 baseColorTexCoords         = io_TexCoords[u_Material.BaseColorTextureTexCoordIndex];
-  vec2 normalTexCoords            = io_TexCoords[u_Material.NormalTextureTexCoordIndex];
-  vec2 emissiveTexCoords          = io_TexCoords[u_Material.EmissiveTextureTexCoordIndex];
-  vec2 metallicRoughnessTexCoords = io_TexCoords[u_Material.MetallicRoughnessTextureTexCoordIndex];
-  vec2 occlusionTexCoords         = io_TexCoords[u_Material.OcclusionTextureTexCoordIndex];
+  TMaterial material = Materials[io_MaterialIndex];
+
+  vec2 baseColorTexCoords         = io_TexCoords[material.BaseColorTextureTexCoordIndex];
+  vec2 normalTexCoords            = io_TexCoords[material.NormalTextureTexCoordIndex];
+  vec2 emissiveTexCoords          = io_TexCoords[material.EmissiveTextureTexCoordIndex];
+  vec2 metallicRoughnessTexCoords = io_TexCoords[material.MetallicRoughnessTextureTexCoordIndex];
+  vec2 occlusionTexCoords         = io_TexCoords[material.OcclusionTextureTexCoordIndex];
 
   // Base Color
-  vec4 baseColorSample = texture(u_Material.BaseColorTexture, baseColorTexCoords) * u_Material.BaseColorFactor;
+  vec4 baseColorSample = texture(u_BaseColorTexture, baseColorTexCoords) * material.BaseColorFactor;
 
-  if (u_Material.AlphaMode == 1 && baseColorSample.a < u_Material.AlphaCutoff)
+  if (material.AlphaMode == 1 && baseColorSample.a < material.AlphaCutoff)
     discard;
 
   vec3 albedo = baseColorSample.rgb;
 
   // Metallic & Roughness
-  vec4 mrSample = texture(u_Material.MetallicRoughnessTexture, metallicRoughnessTexCoords);
+  vec4 mrSample = texture(u_MetallicRoughnessTexture, metallicRoughnessTexCoords);
 
-  float metallic  = mrSample.b * u_Material.MetallicFactor;
-  float roughness = mrSample.g * u_Material.RoughnessFactor;
+  float metallic  = mrSample.b * material.MetallicFactor;
+  float roughness = mrSample.g * material.RoughnessFactor;
   roughness       = clamp(roughness, 0.04, 1.0);
 
   // Normal Mapping
-  vec3 N = texture(u_Material.NormalTexture, normalTexCoords).rgb;
+  vec3 N = texture(u_NormalTexture, normalTexCoords).rgb;
   N      = normalize(io_TBN * (N * 2.0 - 1.0));
 
-  if (u_Material.IsDoubleSided && !gl_FrontFacing)
+  if (material.IsDoubleSided && !gl_FrontFacing)
     N = -N;
 
-  vec3 V = normalize(u_ViewPos - io_FragPos);
+  vec3 V = normalize(CameraPosition - io_FragPos);
   vec3 L = normalize(-LightDirectional.Direction);
   vec3 H = normalize(V + L);
   vec3 R = reflect(-V, N);
@@ -172,8 +183,8 @@ void main()
   F0      = mix(F0, albedo, metallic);
 
   float shadow    = CalculateShadow(io_FragLightPos, L, N);
-  float occlusion = texture(u_Material.OcclusionTexture, occlusionTexCoords).r * u_Material.OcclusionStrength;
-  vec3  emissive  = texture(u_Material.EmissiveTexture, emissiveTexCoords).rgb * u_Material.EmissiveFactor;
+  float occlusion = texture(u_OcclusionTexture, occlusionTexCoords).r * material.OcclusionStrength;
+  vec3  emissive  = texture(u_EmissiveTexture, emissiveTexCoords).rgb * material.EmissiveFactor;
   vec3  radiance  = LightDirectional.Color * LightDirectional.Intensity;
 
   float NDF = DistributionGGX(N, H, roughness);
@@ -198,7 +209,7 @@ void main()
   vec3 diffuse    = irradiance * albedo;
   vec3 ambient    = kD * diffuse * occlusion;
 
-  float alpha = (u_Material.AlphaMode == 0) ? 1.0 : baseColorSample.a;
+  float alpha = (material.AlphaMode == 0) ? 1.0 : baseColorSample.a;
 
   vec3 color  = ambient + Lo + emissive;
   o_FragColor = vec4(color, alpha);
@@ -16,30 +16,61 @@ out vec2 io_TexCoords[4];
 out vec4 io_CurrPosition;
 out vec4 io_PrevPosition;
 
-uniform mat4 u_Model;
-uniform mat4 u_CurrViewProjection;
-uniform mat4 u_PrevViewProjection;
-uniform mat4 u_MVP;
-uniform mat4 u_LightSpaceMatrix;
+flat out uint io_MaterialIndex;
+
+struct TDrawData
+{
+  mat4 Model;
+  uint MaterialIndex;
+  vec4 BoundsMin; // World space, read by OcclusionCull.comp
+  vec4 BoundsMax;
+};
+
+layout(std430, binding = 3) readonly buffer u_DrawData
+{
+  TDrawData Draws[];
+};
+
+layout(std140, binding = 4) uniform u_Frame
+{
+  mat4 LightSpaceMatrix;
+  vec2 Jitter;
+  vec2 PrevJitter;
+  vec2 InverseScreenSize;
+};
+
+layout(std140, binding = 5) uniform u_View
+{
+  mat4 ViewMatrix;
+  mat4 ProjectionMatrix;
+  mat4 ViewProjectionMatrix;
+  mat4 JitteredViewProjectionMatrix;
+  mat4 PrevJitteredViewProjectionMatrix;
+  vec3 CameraPosition;
+};
 
 void main()
 {
-  vec4 worldPos   = u_Model * vec4(aPos, 1.0);
-  io_CurrPosition = u_CurrViewProjection * worldPos;
-  io_PrevPosition = u_PrevViewProjection * worldPos;
+  TDrawData draw  = Draws[gl_BaseInstance + gl_InstanceID];
+  mat4      model = draw.Model;
+
+  vec4 worldPos   = model * vec4(aPos, 1.0);
+  io_CurrPosition = JitteredViewProjectionMatrix * worldPos;
+  io_PrevPosition = PrevJitteredViewProjectionMatrix * worldPos;
 
-  vec3 T = normalize(vec3(u_Model * vec4(aTangent, 0.0)));
-  vec3 N = normalize(vec3(u_Model * vec4(aNormal, 0.0)));
+  vec3 T = normalize(vec3(model * vec4(aTangent, 0.0)));
+  vec3 N = normalize(vec3(model * vec4(aNormal, 0.0)));
   T      = normalize(T - dot(T, N) * N);
   vec3 B = cross(N, T);
 
-  io_TBN          = mat3(T, B, N);
-  io_FragPos      = vec3(worldPos);
-  io_Normal       = mat3(u_Model) * aNormal;
-  io_FragLightPos = u_LightSpaceMatrix * vec4(io_FragPos, 1.0);
-  io_TexCoords[0] = aTexCoords_0;
-  io_TexCoords[1] = aTexCoords_1;
-  io_TexCoords[2] = aTexCoords_2;
-  io_TexCoords[3] = aTexCoords_3;
-  gl_Position     = io_CurrPosition;
+  io_TBN           = mat3(T, B, N);
+  io_FragPos       = vec3(worldPos);
+  io_Normal        = mat3(model) * aNormal;
+  io_FragLightPos  = LightSpaceMatrix * vec4(io_FragPos, 1.0);
+  io_TexCoords[0]  = aTexCoords_0;
+  io_TexCoords[1]  = aTexCoords_1;
+  io_TexCoords[2]  = aTexCoords_2;
+  io_TexCoords[3]  = aTexCoords_3;
+  io_MaterialIndex = draw.MaterialIndex;
+  gl_Position      = io_CurrPosition;
 }
\ No newline at end of file
@@ -3,11 +3,18 @@
 in vec2  io_TexCoords;
 out vec4 o_FragColor;
 
+layout(std140, binding = 4) uniform u_Frame
+{
+  mat4 LightSpaceMatrix;
+  vec2 Jitter;
+  vec2 PrevJitter;
+  vec2 InverseScreenSize;
+};
+
 uniform sampler2D ColorTexture;
 uniform sampler2D DepthTexture;
 uniform sampler2D BloomTexture;
 uniform sampler2D TAATexture;
-uniform vec2      InverseScreenSize;
 uniform bool      IsFXAAEnabled;
 uniform bool      IsTAAEnabled;
 uniform bool      IsHDR;
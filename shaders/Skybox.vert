@@ -4,12 +4,19 @@ layout(location = 0) in vec3 aPos;
 
 out vec3 io_TexCoords;
 
-uniform mat4 u_Projection;
-uniform mat4 u_View;
+layout(std140, binding = 5) uniform u_View
+{
+  mat4 ViewMatrix;
+  mat4 ProjectionMatrix;
+  mat4 ViewProjectionMatrix;
+  mat4 JitteredViewProjectionMatrix;
+  mat4 PrevJitteredViewProjectionMatrix;
+  vec3 CameraPosition;
+};
 
 void main()
 {
   io_TexCoords = aPos;
-  vec4 pos     = u_Projection * u_View * vec4(aPos, 1.0);
+  vec4 pos     = ProjectionMatrix * mat4(mat3(ViewMatrix)) * vec4(aPos, 1.0);
   gl_Position  = pos.xyww;
 }
\ No newline at end of file
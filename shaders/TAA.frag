@@ -8,9 +8,13 @@ uniform sampler2D HistoryFrame;
 uniform sampler2D VelocityTexture;
 uniform sampler2D DepthTexture;
 
-uniform vec2 Jitter;
-uniform vec2 PrevJitter;
-uniform vec2 InverseScreenSize;
+layout(std140, binding = 4) uniform u_Frame
+{
+  mat4 LightSpaceMatrix;
+  vec2 Jitter;
+  vec2 PrevJitter;
+  vec2 InverseScreenSize;
+};
 
 vec3 CatmullRom(vec3 p0, vec3 p1, vec3 p2, vec3 p3, float t)
 {
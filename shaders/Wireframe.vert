@@ -1,10 +1,20 @@
-#version 330 core
+#version 460 core
 
 layout(location = 0) in vec3 a_Pos;
 
-uniform mat4 u_MVP;
+layout(std140, binding = 5) uniform u_View
+{
+  mat4 ViewMatrix;
+  mat4 ProjectionMatrix;
+  mat4 ViewProjectionMatrix;
+  mat4 JitteredViewProjectionMatrix;
+  mat4 PrevJitteredViewProjectionMatrix;
+  vec3 CameraPosition;
+};
+
+uniform mat4 u_Model;
 
 void main()
 {
-  gl_Position = u_MVP * vec4(a_Pos, 1.0);
+  gl_Position = ViewProjectionMatrix * u_Model * vec4(a_Pos, 1.0);
 }
@@ -1,14 +1,29 @@
 #include "engine/Engine.h"
+#include "engine/Config.h"
 #include <common/Logger.h>
+#include <string_view>
 
 int main(int argc, char *argv[])
 {
   CLogger::SetSinks(CLogger::Console | CLogger::File);
   CLogger::SetVerbosity(ELogType::Debug);
 
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::string_view(argv[i]) == "--render-thread")
+      CConfig::Instance().SetRenderThreadEnabled(true);
+  }
+
+  std::optional<TBenchmarkOptions> BenchmarkOptions = CBenchmark::ParseArguments(argc, argv);
+  if (!BenchmarkOptions && CBenchmark::IsRequested(argc, argv))
+  {
+    LOG_FATAL("Invalid benchmark arguments");
+    return EXIT_FAILURE;
+  }
+
   CEngine &Engine = CEngine::Instance();
 
-  if (const int InitCode = Engine.Init(); InitCode != EXIT_SUCCESS)
+  if (const int InitCode = Engine.Init(std::move(BenchmarkOptions)); InitCode != EXIT_SUCCESS)
   {
     LOG_FATAL("Engine initialisation failed. Error: {}", InitCode);
     Engine.Shutdown();
@@ -0,0 +1,331 @@
+#include "MeshSimplifier.h"
+#include <glm/geometric.hpp>
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <unordered_map>
+
+namespace
+{
+
+constexpr float MIN_NORMAL_COSINE = 0.2f; // Collapses turning a triangle further than that are rejected
+
+// Sum of squared distances to planes, weighted by the area of their triangles. Divided by the
+// total weight it's the mean squared distance, comparable with the error limit.
+struct TQuadric
+{
+  double A00 = 0.0, A01 = 0.0, A02 = 0.0, A03 = 0.0;
+  double A11 = 0.0, A12 = 0.0, A13 = 0.0;
+  double A22 = 0.0, A23 = 0.0;
+  double A33    = 0.0;
+  double Weight = 0.0;
+
+  static TQuadric FromPlane(const glm::vec3 &_Normal, float _Distance, double _Weight)
+  {
+    const double A = _Normal.x, B = _Normal.y, C = _Normal.z, D = _Distance;
+
+    return TQuadric{
+        .A00    = A * A * _Weight,
+        .A01    = A * B * _Weight,
+        .A02    = A * C * _Weight,
+        .A03    = A * D * _Weight,
+        .A11    = B * B * _Weight,
+        .A12    = B * C * _Weight,
+        .A13    = B * D * _Weight,
+        .A22    = C * C * _Weight,
+        .A23    = C * D * _Weight,
+        .A33    = D * D * _Weight,
+        .Weight = _Weight,
+    };
+  }
+
+  TQuadric &operator+=(const TQuadric &_Other)
+  {
+    A00    += _Other.A00;
+    A01    += _Other.A01;
+    A02    += _Other.A02;
+    A03    += _Other.A03;
+    A11    += _Other.A11;
+    A12    += _Other.A12;
+    A13    += _Other.A13;
+    A22    += _Other.A22;
+    A23    += _Other.A23;
+    A33    += _Other.A33;
+    Weight += _Other.Weight;
+    return *this;
+  }
+
+  TQuadric operator+(const TQuadric &_Other) const
+  {
+    TQuadric Result = *this;
+    return Result += _Other;
+  }
+
+  double GetError(const glm::vec3 &_Point) const
+  {
+    const double X = _Point.x, Y = _Point.y, Z = _Point.z;
+
+    const double Error = A00 * X * X + 2.0 * A01 * X * Y + 2.0 * A02 * X * Z + 2.0 * A03 * X + //
+                         A11 * Y * Y + 2.0 * A12 * Y * Z + 2.0 * A13 * Y +                     //
+                         A22 * Z * Z + 2.0 * A23 * Z + A33;
+
+    return Weight > 0.0 ? std::max(Error, 0.0) / Weight : 0.0;
+  }
+};
+
+// The versions of both vertices tell whether the collapse is still current once it's popped
+struct TCollapse
+{
+  double   Error;
+  uint32_t From;
+  uint32_t To;
+  uint32_t FromVersion;
+  uint32_t ToVersion;
+
+  bool operator>(const TCollapse &_Other) const
+  {
+    return Error > _Other.Error;
+  }
+};
+
+uint64_t GetEdgeKey(uint32_t _A, uint32_t _B)
+{
+  return _A < _B ? (static_cast<uint64_t>(_A) << 32) | _B : (static_cast<uint64_t>(_B) << 32) | _A;
+}
+
+class CSimplifier final
+{
+public:
+  CSimplifier(std::span<const glm::vec3> _Positions, std::span<const uint32_t> _Indices) :
+      m_Positions(_Positions),
+      m_Indices(_Indices.begin(), _Indices.end()),
+      m_IsTriangleRemoved(_Indices.size() / 3, false),
+      m_VertexTriangles(_Positions.size()),
+      m_Quadrics(_Positions.size()),
+      m_Versions(_Positions.size(), 0),
+      m_IsLocked(_Positions.size(), false),
+      m_IndicesCount(0)
+  {
+    InitQuadrics();
+    LockBorders();
+  }
+
+  std::vector<uint32_t> Simplify(size_t _TargetIndicesCount, float _MaxError)
+  {
+    const double MaxError = static_cast<double>(_MaxError) * _MaxError;
+
+    for (size_t Triangle = 0; Triangle < m_IsTriangleRemoved.size(); ++Triangle)
+      if (!m_IsTriangleRemoved[Triangle])
+        for (int Corner = 0; Corner < 3; ++Corner)
+          PushCollapses(m_Indices[Triangle * 3 + Corner], m_Indices[Triangle * 3 + (Corner + 1) % 3]);
+
+    while (m_IndicesCount > _TargetIndicesCount && !m_Queue.empty())
+    {
+      const TCollapse Collapse = m_Queue.top();
+      m_Queue.pop();
+
+      if (Collapse.FromVersion != m_Versions[Collapse.From] || Collapse.ToVersion != m_Versions[Collapse.To])
+        continue;
+
+      // The queue is ordered, everything left is worse
+      if (Collapse.Error > MaxError)
+        break;
+
+      if (CanCollapse(Collapse.From, Collapse.To))
+        ApplyCollapse(Collapse.From, Collapse.To);
+    }
+
+    std::vector<uint32_t> Result;
+    Result.reserve(m_IndicesCount);
+
+    for (size_t Triangle = 0; Triangle < m_IsTriangleRemoved.size(); ++Triangle)
+      if (!m_IsTriangleRemoved[Triangle])
+        Result.insert(Result.end(), m_Indices.begin() + Triangle * 3, m_Indices.begin() + Triangle * 3 + 3);
+
+    return Result;
+  }
+
+private:
+  void InitQuadrics()
+  {
+    for (size_t Triangle = 0; Triangle < m_IsTriangleRemoved.size(); ++Triangle)
+    {
+      const uint32_t *Corners = &m_Indices[Triangle * 3];
+
+      const bool IsOutOfRange = Corners[0] >= m_Positions.size() || Corners[1] >= m_Positions.size() || Corners[2] >= m_Positions.size();
+      if (IsOutOfRange || Corners[0] == Corners[1] || Corners[1] == Corners[2] || Corners[0] == Corners[2])
+      {
+        m_IsTriangleRemoved[Triangle] = true;
+        continue;
+      }
+
+      const glm::vec3 &P0     = m_Positions[Corners[0]];
+      const glm::vec3  Cross  = glm::cross(m_Positions[Corners[1]] - P0, m_Positions[Corners[2]] - P0);
+      const float      Length = glm::length(Cross);
+
+      // Zero area triangles add no plane but still hold their vertices together
+      if (Length > 0.0f)
+      {
+        const glm::vec3 Normal  = Cross / Length;
+        const TQuadric  Quadric = TQuadric::FromPlane(Normal, -glm::dot(Normal, P0), 0.5 * Length);
+
+        for (int Corner = 0; Corner < 3; ++Corner)
+          m_Quadrics[Corners[Corner]] += Quadric;
+      }
+
+      for (int Corner = 0; Corner < 3; ++Corner)
+        m_VertexTriangles[Corners[Corner]].push_back(static_cast<uint32_t>(Triangle));
+
+      m_IndicesCount += 3;
+    }
+  }
+
+  // Edges of a single triangle are on a border, moving their vertices would open holes
+  void LockBorders()
+  {
+    std::unordered_map<uint64_t, uint32_t> EdgeTriangles;
+    EdgeTriangles.reserve(m_Indices.size());
+
+    for (size_t Triangle = 0; Triangle < m_IsTriangleRemoved.size(); ++Triangle)
+      if (!m_IsTriangleRemoved[Triangle])
+        for (int Corner = 0; Corner < 3; ++Corner)
+          EdgeTriangles[GetEdgeKey(m_Indices[Triangle * 3 + Corner], m_Indices[Triangle * 3 + (Corner + 1) % 3])]++;
+
+    for (const auto &[Key, Count] : EdgeTriangles)
+    {
+      if (Count != 1)
+        continue;
+
+      m_IsLocked[static_cast<uint32_t>(Key >> 32)]        = true;
+      m_IsLocked[static_cast<uint32_t>(Key & 0xffffffff)] = true;
+    }
+  }
+
+  void PushCollapses(uint32_t _A, uint32_t _B)
+  {
+    const TQuadric Quadric = m_Quadrics[_A] + m_Quadrics[_B];
+
+    if (!m_IsLocked[_A])
+      m_Queue.push(TCollapse{.Error = Quadric.GetError(m_Positions[_B]), .From = _A, .To = _B, .FromVersion = m_Versions[_A], .ToVersion = m_Versions[_B]});
+
+    if (!m_IsLocked[_B])
+      m_Queue.push(TCollapse{.Error = Quadric.GetError(m_Positions[_A]), .From = _B, .To = _A, .FromVersion = m_Versions[_B], .ToVersion = m_Versions[_A]});
+  }
+
+  void GatherNeighbours(uint32_t _Vertex, std::vector<uint32_t> &_Neighbours) const
+  {
+    _Neighbours.clear();
+
+    for (uint32_t Triangle : m_VertexTriangles[_Vertex])
+      if (!m_IsTriangleRemoved[Triangle])
+        for (int Corner = 0; Corner < 3; ++Corner)
+          if (m_Indices[Triangle * 3 + Corner] != _Vertex)
+            _Neighbours.push_back(m_Indices[Triangle * 3 + Corner]);
+
+    std::sort(_Neighbours.begin(), _Neighbours.end());
+    _Neighbours.erase(std::unique(_Neighbours.begin(), _Neighbours.end()), _Neighbours.end());
+  }
+
+  bool CanCollapse(uint32_t _From, uint32_t _To)
+  {
+    // Link condition: an edge of a manifold shares exactly its two opposite vertices, more would pinch the surface
+    GatherNeighbours(_From, m_FromNeighbours);
+    GatherNeighbours(_To, m_ToNeighbours);
+
+    m_SharedNeighbours.clear();
+    std::set_intersection(m_FromNeighbours.begin(), m_FromNeighbours.end(), m_ToNeighbours.begin(), m_ToNeighbours.end(),
+                          std::back_inserter(m_SharedNeighbours));
+
+    if (m_SharedNeighbours.size() > 2)
+      return false;
+
+    // Triangles that stay must not flip or fold over
+    for (uint32_t Triangle : m_VertexTriangles[_From])
+    {
+      if (m_IsTriangleRemoved[Triangle])
+        continue;
+
+      const uint32_t *Corners = &m_Indices[Triangle * 3];
+      if (Corners[0] == _To || Corners[1] == _To || Corners[2] == _To)
+        continue;
+
+      glm::vec3 Before[3], After[3];
+      for (int Corner = 0; Corner < 3; ++Corner)
+      {
+        Before[Corner] = m_Positions[Corners[Corner]];
+        After[Corner]  = m_Positions[Corners[Corner] == _From ? _To : Corners[Corner]];
+      }
+
+      const glm::vec3 NormalBefore = glm::cross(Before[1] - Before[0], Before[2] - Before[0]);
+      const glm::vec3 NormalAfter  = glm::cross(After[1] - After[0], After[2] - After[0]);
+      const float     LengthBefore = glm::length(NormalBefore);
+      const float     LengthAfter  = glm::length(NormalAfter);
+
+      if (LengthAfter <= 0.0f)
+        return false;
+
+      if (LengthBefore > 0.0f && glm::dot(NormalBefore, NormalAfter) < MIN_NORMAL_COSINE * LengthBefore * LengthAfter)
+        return false;
+    }
+
+    return true;
+  }
+
+  void ApplyCollapse(uint32_t _From, uint32_t _To)
+  {
+    for (uint32_t Triangle : m_VertexTriangles[_From])
+    {
+      if (m_IsTriangleRemoved[Triangle])
+        continue;
+
+      uint32_t *Corners = &m_Indices[Triangle * 3];
+      if (Corners[0] == _To || Corners[1] == _To || Corners[2] == _To)
+      {
+        m_IsTriangleRemoved[Triangle]  = true;
+        m_IndicesCount                -= 3;
+        continue;
+      }
+
+      for (int Corner = 0; Corner < 3; ++Corner)
+        if (Corners[Corner] == _From)
+          Corners[Corner] = _To;
+
+      m_VertexTriangles[_To].push_back(Triangle);
+    }
+
+    m_VertexTriangles[_From].clear();
+    std::erase_if(m_VertexTriangles[_To], [this](uint32_t _Triangle) { return m_IsTriangleRemoved[_Triangle]; });
+
+    m_Quadrics[_To] += m_Quadrics[_From];
+    m_Versions[_From]++;
+    m_Versions[_To]++;
+
+    // The quadric of _To changed, so did the cost of every edge around it
+    GatherNeighbours(_To, m_ToNeighbours);
+    for (uint32_t Neighbour : m_ToNeighbours)
+      PushCollapses(_To, Neighbour);
+  }
+
+private:
+  std::span<const glm::vec3>           m_Positions;
+  std::vector<uint32_t>                m_Indices;
+  std::vector<bool>                    m_IsTriangleRemoved;
+  std::vector<std::vector<uint32_t>>   m_VertexTriangles;
+  std::vector<TQuadric>                m_Quadrics;
+  std::vector<uint32_t>                m_Versions;
+  std::vector<bool>                    m_IsLocked;
+  size_t                               m_IndicesCount; // Of the triangles left
+  std::vector<uint32_t>                m_FromNeighbours;
+  std::vector<uint32_t>                m_ToNeighbours;
+  std::vector<uint32_t>                m_SharedNeighbours;
+  std::priority_queue<TCollapse, std::vector<TCollapse>, std::greater<>> m_Queue;
+};
+
+} // namespace
+
+std::vector<uint32_t> SimplifyMesh(std::span<const glm::vec3> _Positions, std::span<const uint32_t> _Indices, size_t _TargetIndicesCount,
+                                   float _MaxError)
+{
+  CSimplifier Simplifier(_Positions, _Indices);
+  return Simplifier.Simplify(_TargetIndicesCount, _MaxError);
+}
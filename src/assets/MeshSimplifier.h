@@ -0,0 +1,15 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+// Quadric error simplification (Garland-Heckbert) of a triangle list. Edges collapse onto one of
+// their vertices, so the result indexes the same vertices as the source and can share its vertex
+// buffer. Vertices on borders never move, seams count as borders since their vertices are split.
+// Stops at _TargetIndicesCount or once every collapse would move the surface by more than
+// _MaxError, in the units of the positions. Returns the simplified triangle list.
+std::vector<uint32_t> SimplifyMesh(std::span<const glm::vec3> _Positions, std::span<const uint32_t> _Indices, size_t _TargetIndicesCount,
+                                   float _MaxError);
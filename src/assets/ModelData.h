@@ -71,6 +71,7 @@ struct TPrimitive
   uint32_t                             VerticesCount = 0;
   std::optional<glm::vec3>             MinValues;
   std::optional<glm::vec3>             MaxValues;
+  std::vector<std::vector<uint32_t>>   LODs; // Simplified triangle lists over the same vertices, coarser each
 };
 
 struct TMesh
@@ -2,6 +2,8 @@
 
 #include "pch.h"
 #include "Shader.h"
+#include "render/GLState.h"
+#include "render/RenderStats.h"
 #include "utils/Path.h"
 #include <common/Logger.h>
 #include <glm/glm.hpp>
@@ -27,13 +29,63 @@ static bool WaitForFileAvailable(const std::filesystem::path &_Path)
   return false;
 }
 
-static inline bool operator<(const std::string &_L, const std::string_view &_R)
+template <class>
+static constexpr bool AlwaysFalse = false;
+
+static bool IsSamplerType(GLenum _Type)
 {
-  return _L < _R;
+  switch (_Type)
+  {
+  case GL_SAMPLER_2D:
+  case GL_SAMPLER_3D:
+  case GL_SAMPLER_CUBE:
+  case GL_SAMPLER_2D_SHADOW:
+  case GL_SAMPLER_2D_ARRAY:
+  case GL_SAMPLER_2D_ARRAY_SHADOW:
+  case GL_SAMPLER_2D_MULTISAMPLE:
+  case GL_SAMPLER_CUBE_SHADOW:
+  case GL_INT_SAMPLER_2D:
+  case GL_UNSIGNED_INT_SAMPLER_2D:
+    return true;
+  default:
+    return false;
+  }
 }
 
-template <class>
-static constexpr bool AlwaysFalse = false;
+// Samplers and booleans are set through the integer overloads
+static bool IsCompatibleType(GLenum _Type, size_t _TypeIndex)
+{
+  switch (_TypeIndex)
+  {
+  case UNIFORM_TYPE_INDEX<int>:
+    return _Type == GL_INT || _Type == GL_BOOL || IsSamplerType(_Type);
+  case UNIFORM_TYPE_INDEX<unsigned>:
+    return _Type == GL_UNSIGNED_INT || _Type == GL_BOOL;
+  case UNIFORM_TYPE_INDEX<float>:
+    return _Type == GL_FLOAT;
+  case UNIFORM_TYPE_INDEX<glm::mat3>:
+    return _Type == GL_FLOAT_MAT3;
+  case UNIFORM_TYPE_INDEX<glm::mat4>:
+    return _Type == GL_FLOAT_MAT4;
+  case UNIFORM_TYPE_INDEX<glm::vec2>:
+    return _Type == GL_FLOAT_VEC2;
+  case UNIFORM_TYPE_INDEX<glm::vec3>:
+    return _Type == GL_FLOAT_VEC3;
+  case UNIFORM_TYPE_INDEX<glm::vec4>:
+    return _Type == GL_FLOAT_VEC4;
+  default:
+    return false;
+  }
+}
+
+static std::string GetResourceName(GLuint _Program, GLenum _Interface, GLuint _Index, GLint _Length)
+{
+  std::string Name(static_cast<size_t>(std::max(_Length, 1)), '\0');
+  GLsizei     Written = 0;
+  glGetProgramResourceName(_Program, _Interface, _Index, _Length, &Written, Name.data());
+  Name.resize(static_cast<size_t>(Written));
+  return Name;
+}
 
 CShader::CShader() :
     m_ID(INVALID_VALUE)
@@ -56,49 +108,29 @@ void CShader::Shutdown()
 
 bool CShader::Load(const std::filesystem::path &_Path, CPasskey<CResourceManager>)
 {
-  const std::filesystem::path VertexShaderPath = std::filesystem::path(_Path).replace_extension(VERTEX_SHADER_EXTENSION);
-  const GLuint                VertexShader     = LoadShader(VertexShaderPath, GL_VERTEX_SHADER);
-  if (VertexShader == INVALID_VALUE)
-    return false;
+  const std::vector<TStage> Stages = GetStages(_Path);
 
-  const std::filesystem::path FragmentShaderPath = std::filesystem::path(_Path).replace_extension(FRAGMENT_SHADER_EXTENSION);
-  const GLuint                FragmentShader     = LoadShader(FragmentShaderPath, GL_FRAGMENT_SHADER);
-  if (FragmentShader == INVALID_VALUE)
+  std::string LinkErrorLog;
+  m_ID = CreateProgram(Stages, LinkErrorLog);
+  if (m_ID == INVALID_VALUE)
   {
-    glDeleteShader(VertexShader);
+    if (!LinkErrorLog.empty())
+      CLogger::Log(ELogType::Error, std::format("[CShader] Shader '{}' linkage error:\n{}", _Path.string(), LinkErrorLog));
     return false;
   }
 
-  m_ID = glCreateProgram();
-  glAttachShader(m_ID, VertexShader);
-  glAttachShader(m_ID, FragmentShader);
-  glLinkProgram(m_ID);
-
-  glDeleteShader(VertexShader);
-  glDeleteShader(FragmentShader);
-
-  GLint Success;
-  glGetProgramiv(m_ID, GL_LINK_STATUS, &Success);
-  if (Success == GL_FALSE)
-  {
-    char ErrorLog[512] = {'\0'};
-    glGetShaderInfoLog(m_ID, 512, NULL, ErrorLog);
-    CLogger::Log(ELogType::Error, std::format("[CShader] Shader '{}' linkage error:\n{}", _Path.string(), ErrorLog));
-    Shutdown();
-    return false;
-  }
+  Reflect();
 
 #if SHADERS_HOT_RELOAD
   m_BasePath = _Path;
 
-  std::error_code Error;
-  m_VertexTimestamp = std::filesystem::last_write_time(VertexShaderPath, Error);
-  if (Error)
-    m_VertexTimestamp = std::filesystem::file_time_type{};
-
-  m_FragmentTimestamp = std::filesystem::last_write_time(FragmentShaderPath, Error);
-  if (Error)
-    m_FragmentTimestamp = std::filesystem::file_time_type{};
+  m_StageTimestamps.clear();
+  for (const TStage &Stage : Stages)
+  {
+    std::error_code Error;
+    const auto      Timestamp = std::filesystem::last_write_time(Stage.Path, Error);
+    m_StageTimestamps.push_back(Error ? std::filesystem::file_time_type{} : Timestamp);
+  }
 #endif
 
 #if DEV_STAGE
@@ -116,7 +148,7 @@ GLuint CShader::GetID() const
 void CShader::Use() const
 {
   assert(IsValid());
-  glUseProgram(m_ID);
+  CGLState::UseProgram(m_ID);
 }
 
 bool CShader::IsValid() const
@@ -124,41 +156,17 @@ bool CShader::IsValid() const
   return m_ID != INVALID_VALUE;
 }
 
+// Slow path for one-off uniforms, passes resolve handles instead
 void CShader::SetUniform(std::string_view _Name, const UniformType &_Value)
 {
   assert(IsValid());
   assert(IsUsed());
 
-  auto UniformLocIter = m_UniformsCache.find(_Name);
-  if (UniformLocIter == m_UniformsCache.end())
-  {
-    GLint UniformLoc = glGetUniformLocation(GetID(), _Name.data());
-    UniformLocIter   = m_UniformsCache.emplace(_Name.data(), UniformLoc).first;
-  }
+  const TUniformInfo *Uniform = FindUniform(_Name);
+  if (!Uniform)
+    return;
 
-  std::visit(
-      [UniformLoc = UniformLocIter->second](auto &&_Arg) {
-        using Type = std::decay_t<decltype(_Arg)>;
-        if constexpr (std::is_same_v<Type, GLint>)
-          glUniform1i(UniformLoc, _Arg);
-        else if constexpr (std::is_same_v<Type, GLuint>)
-          glUniform1ui(UniformLoc, _Arg);
-        else if constexpr (std::is_same_v<Type, GLfloat>)
-          glUniform1f(UniformLoc, _Arg);
-        else if constexpr (std::is_same_v<Type, glm::mat3>)
-          glUniformMatrix3fv(UniformLoc, 1, GL_FALSE, glm::value_ptr(_Arg));
-        else if constexpr (std::is_same_v<Type, glm::mat4>)
-          glUniformMatrix4fv(UniformLoc, 1, GL_FALSE, glm::value_ptr(_Arg));
-        else if constexpr (std::is_same_v<Type, glm::vec2>)
-          glUniform2fv(UniformLoc, 1, glm::value_ptr(_Arg));
-        else if constexpr (std::is_same_v<Type, glm::vec3>)
-          glUniform3fv(UniformLoc, 1, glm::value_ptr(_Arg));
-        else if constexpr (std::is_same_v<Type, glm::vec4>)
-          glUniform4fv(UniformLoc, 1, glm::value_ptr(_Arg));
-        else
-          static_assert(AlwaysFalse<Type>, "Non-exhaustive visitor");
-      },
-      _Value);
+  std::visit([Location = Uniform->Location](auto &&_Arg) { UploadUniform(Location, _Arg); }, _Value);
 }
 
 void CShader::SetUniformBlockBinding(std::string_view _BlockName, GLuint _UniformBlockBinding)
@@ -166,14 +174,11 @@ void CShader::SetUniformBlockBinding(std::string_view _BlockName, GLuint _Unifor
   assert(IsValid());
   assert(IsUsed());
 
-  auto UniformLocIter = m_UniformsCache.find(_BlockName);
-  if (UniformLocIter == m_UniformsCache.end())
-  {
-    GLint UniformBlockLoc = glGetUniformBlockIndex(GetID(), _BlockName.data());
-    UniformLocIter        = m_UniformsCache.emplace(_BlockName.data(), UniformBlockLoc).first;
-  }
+  const TBlockInfo *Block = FindBlock(_BlockName, GL_UNIFORM_BLOCK);
+  if (!Block)
+    return;
 
-  glUniformBlockBinding(GetID(), UniformLocIter->second, _UniformBlockBinding);
+  glUniformBlockBinding(GetID(), Block->Index, _UniformBlockBinding);
 }
 
 void CShader::Validate()
@@ -182,62 +187,38 @@ void CShader::Validate()
   if (m_BasePath.empty())
     return;
 
-  const std::filesystem::path VertexShaderPath   = std::filesystem::path(m_BasePath).replace_extension(VERTEX_SHADER_EXTENSION);
-  const std::filesystem::path FragmentShaderPath = std::filesystem::path(m_BasePath).replace_extension(FRAGMENT_SHADER_EXTENSION);
+  const std::vector<TStage> Stages = GetStages(m_BasePath);
 
-  auto GetWriteTime = [](const std::filesystem::path &_Path, std::filesystem::file_time_type &_Out) {
+  std::vector<std::filesystem::file_time_type> NewTimestamps;
+  for (const TStage &Stage : Stages)
+  {
     std::error_code Error;
-    _Out = std::filesystem::last_write_time(_Path, Error);
-    return !Error;
-  };
-
-  std::filesystem::file_time_type NewVertexTimestamp{};
-  std::filesystem::file_time_type NewFragmentTimestamp{};
-
-  if (!GetWriteTime(VertexShaderPath, NewVertexTimestamp) || !GetWriteTime(FragmentShaderPath, NewFragmentTimestamp))
-    return;
+    NewTimestamps.push_back(std::filesystem::last_write_time(Stage.Path, Error));
+    if (Error)
+      return;
+  }
 
-  if (NewVertexTimestamp == m_VertexTimestamp && NewFragmentTimestamp == m_FragmentTimestamp)
+  if (NewTimestamps == m_StageTimestamps)
     return;
   // Ensure the shader files are available (editors may perform atomic replace while saving).
-  if (!WaitForFileAvailable(VertexShaderPath) || !WaitForFileAvailable(FragmentShaderPath))
-    return;
+  for (const TStage &Stage : Stages)
+    if (!WaitForFileAvailable(Stage.Path))
+      return;
 
-  const GLuint NewVertex = LoadShader(VertexShaderPath, GL_VERTEX_SHADER);
-  if (NewVertex == INVALID_VALUE)
-    return;
-
-  const GLuint NewFragment = LoadShader(FragmentShaderPath, GL_FRAGMENT_SHADER);
-  if (NewFragment == INVALID_VALUE)
+  std::string  LinkErrorLog;
+  const GLuint NewProgram = CreateProgram(Stages, LinkErrorLog);
+  if (NewProgram == INVALID_VALUE)
   {
-    glDeleteShader(NewVertex);
-    return;
-  }
-
-  const GLuint NewProgram = glCreateProgram();
-  glAttachShader(NewProgram, NewVertex);
-  glAttachShader(NewProgram, NewFragment);
-  glLinkProgram(NewProgram);
-  glDeleteShader(NewVertex);
-  glDeleteShader(NewFragment);
-
-  GLint Success = GL_FALSE;
-  glGetProgramiv(NewProgram, GL_LINK_STATUS, &Success);
-  if (Success == GL_FALSE)
-  {
-    char ErrorLog[512] = {'\0'};
-    glGetProgramInfoLog(NewProgram, 512, NULL, ErrorLog);
-    CLogger::Log(ELogType::Error, "[CShader] Hot reload linkage error for '{}':\n{}", utils::GetRelativePath(m_BasePath.string()).string(), ErrorLog);
-    glDeleteProgram(NewProgram);
+    if (!LinkErrorLog.empty())
+      CLogger::Log(ELogType::Error, "[CShader] Hot reload linkage error for '{}':\n{}", utils::GetRelativePath(m_BasePath.string()).string(), LinkErrorLog);
     return;
   }
 
   const GLuint OldProgram = m_ID;
   m_ID                    = NewProgram;
-  m_VertexTimestamp       = NewVertexTimestamp;
-  m_FragmentTimestamp     = NewFragmentTimestamp;
-  m_UniformsCache.clear();
-  glUseProgram(m_ID);
+  m_StageTimestamps       = std::move(NewTimestamps);
+  Reflect();
+  CGLState::UseProgram(m_ID);
 
   if (OldProgram != INVALID_VALUE)
     UnloadShader(OldProgram);
@@ -253,6 +234,199 @@ bool CShader::IsUsed() const
   return GLuint(Program) == GetID();
 }
 
+void CShader::Reflect()
+{
+  m_Uniforms.clear();
+  m_Blocks.clear();
+
+  GLint UniformsCount = 0;
+  glGetProgramInterfaceiv(m_ID, GL_UNIFORM, GL_ACTIVE_RESOURCES, &UniformsCount);
+
+  for (GLint i = 0; i < UniformsCount; ++i)
+  {
+    constexpr GLenum Properties[] = {GL_NAME_LENGTH, GL_TYPE, GL_LOCATION, GL_ARRAY_SIZE, GL_BLOCK_INDEX};
+    GLint            Values[std::size(Properties)];
+    glGetProgramResourceiv(m_ID, GL_UNIFORM, i, std::size(Properties), Properties, std::size(Values), nullptr, Values);
+
+    // Members of uniform blocks are set through their buffers
+    if (Values[4] != -1)
+      continue;
+
+    std::string Name = GetResourceName(m_ID, GL_UNIFORM, i, Values[0]);
+    if (Name.ends_with("[0]"))
+      Name.resize(Name.size() - 3);
+
+    m_Uniforms.push_back(TUniformInfo{
+        .Name      = std::move(Name),
+        .Location  = Values[2],
+        .Type      = static_cast<GLenum>(Values[1]),
+        .ArraySize = Values[3],
+    });
+  }
+
+  for (GLenum Interface : {GL_UNIFORM_BLOCK, GL_SHADER_STORAGE_BLOCK})
+  {
+    GLint BlocksCount = 0;
+    glGetProgramInterfaceiv(m_ID, Interface, GL_ACTIVE_RESOURCES, &BlocksCount);
+
+    for (GLint i = 0; i < BlocksCount; ++i)
+    {
+      constexpr GLenum Properties[] = {GL_NAME_LENGTH, GL_BUFFER_DATA_SIZE};
+      GLint            Values[std::size(Properties)];
+      glGetProgramResourceiv(m_ID, Interface, i, std::size(Properties), Properties, std::size(Values), nullptr, Values);
+
+      m_Blocks.push_back(TBlockInfo{
+          .Name      = GetResourceName(m_ID, Interface, i, Values[0]),
+          .Interface = Interface,
+          .Index     = static_cast<GLuint>(i),
+          .DataSize  = Values[1],
+      });
+    }
+  }
+
+  std::ranges::sort(m_Uniforms, {}, &TUniformInfo::Name);
+  std::ranges::sort(m_Blocks, {}, &TBlockInfo::Name);
+
+  ResolveHandleLocations();
+}
+
+const CShader::TUniformInfo *CShader::FindUniform(std::string_view _Name) const
+{
+  auto It = std::ranges::lower_bound(m_Uniforms, _Name, {}, &TUniformInfo::Name);
+  return It != m_Uniforms.end() && It->Name == _Name ? &*It : nullptr;
+}
+
+const CShader::TBlockInfo *CShader::FindBlock(std::string_view _Name, GLenum _Interface) const
+{
+  for (auto It = std::ranges::lower_bound(m_Blocks, _Name, {}, &TBlockInfo::Name); It != m_Blocks.end() && It->Name == _Name; ++It)
+    if (It->Interface == _Interface)
+      return &*It;
+
+  return nullptr;
+}
+
+uint32_t CShader::ResolveHandle(std::string_view _Name, size_t _TypeIndex)
+{
+  assert(IsValid());
+
+  auto It = std::ranges::find(m_HandleNames, _Name);
+  if (It != m_HandleNames.end())
+  {
+    const size_t Slot = std::distance(m_HandleNames.begin(), It);
+    assert(m_HandleTypes[Slot] == _TypeIndex && "The uniform is already resolved with another type");
+    return static_cast<uint32_t>(Slot);
+  }
+
+  m_HandleNames.emplace_back(_Name);
+  m_HandleTypes.push_back(_TypeIndex);
+  ResolveHandleLocations();
+
+  return static_cast<uint32_t>(m_HandleNames.size() - 1);
+}
+
+// Uniforms that were optimized out keep the location -1, GL ignores writes to it
+void CShader::ResolveHandleLocations()
+{
+  m_HandleLocations.resize(m_HandleNames.size());
+
+  for (size_t Slot = 0; Slot < m_HandleNames.size(); ++Slot)
+  {
+    const TUniformInfo *Uniform = FindUniform(m_HandleNames[Slot]);
+    m_HandleLocations[Slot]     = Uniform ? Uniform->Location : -1;
+
+    if (Uniform && !IsCompatibleType(Uniform->Type, m_HandleTypes[Slot]))
+      CLogger::Log(ELogType::Error, "[CShader] Uniform '{}' of '{}' doesn't match the type of its handle", m_HandleNames[Slot], m_Path.string());
+  }
+}
+
+template <class T>
+void CShader::UploadUniform(GLint _Location, const T &_Value)
+{
+  if (_Location < 0)
+    return;
+
+  if constexpr (std::is_same_v<T, GLint>)
+    glUniform1i(_Location, _Value);
+  else if constexpr (std::is_same_v<T, GLuint>)
+    glUniform1ui(_Location, _Value);
+  else if constexpr (std::is_same_v<T, GLfloat>)
+    glUniform1f(_Location, _Value);
+  else if constexpr (std::is_same_v<T, glm::mat3>)
+    glUniformMatrix3fv(_Location, 1, GL_FALSE, glm::value_ptr(_Value));
+  else if constexpr (std::is_same_v<T, glm::mat4>)
+    glUniformMatrix4fv(_Location, 1, GL_FALSE, glm::value_ptr(_Value));
+  else if constexpr (std::is_same_v<T, glm::vec2>)
+    glUniform2fv(_Location, 1, glm::value_ptr(_Value));
+  else if constexpr (std::is_same_v<T, glm::vec3>)
+    glUniform3fv(_Location, 1, glm::value_ptr(_Value));
+  else if constexpr (std::is_same_v<T, glm::vec4>)
+    glUniform4fv(_Location, 1, glm::value_ptr(_Value));
+  else
+    static_assert(AlwaysFalse<T>, "Unsupported uniform type");
+
+  CRenderCounters::CountUniformUpload();
+}
+
+template void CShader::UploadUniform(GLint, const GLint &);
+template void CShader::UploadUniform(GLint, const GLuint &);
+template void CShader::UploadUniform(GLint, const GLfloat &);
+template void CShader::UploadUniform(GLint, const glm::mat3 &);
+template void CShader::UploadUniform(GLint, const glm::mat4 &);
+template void CShader::UploadUniform(GLint, const glm::vec2 &);
+template void CShader::UploadUniform(GLint, const glm::vec3 &);
+template void CShader::UploadUniform(GLint, const glm::vec4 &);
+
+// A compute shader next to the base path makes a compute program, otherwise it's a vertex and a fragment shader
+std::vector<CShader::TStage> CShader::GetStages(const std::filesystem::path &_BasePath)
+{
+  const std::filesystem::path ComputeShaderPath = std::filesystem::path(_BasePath).replace_extension(COMPUTE_SHADER_EXTENSION);
+  if (std::filesystem::exists(ComputeShaderPath))
+    return {TStage{.Path = ComputeShaderPath, .Type = GL_COMPUTE_SHADER}};
+
+  return {
+      TStage{.Path = std::filesystem::path(_BasePath).replace_extension(VERTEX_SHADER_EXTENSION), .Type = GL_VERTEX_SHADER},
+      TStage{.Path = std::filesystem::path(_BasePath).replace_extension(FRAGMENT_SHADER_EXTENSION), .Type = GL_FRAGMENT_SHADER},
+  };
+}
+
+// Compilation errors are logged by LoadShader(), _LinkErrorLog is filled only if linking fails
+GLuint CShader::CreateProgram(const std::vector<TStage> &_Stages, std::string &_LinkErrorLog)
+{
+  std::vector<GLuint> Shaders;
+  for (const TStage &Stage : _Stages)
+  {
+    const GLuint Shader = LoadShader(Stage.Path, Stage.Type);
+    if (Shader == INVALID_VALUE)
+    {
+      for (GLuint Loaded : Shaders)
+        glDeleteShader(Loaded);
+      return INVALID_VALUE;
+    }
+    Shaders.push_back(Shader);
+  }
+
+  const GLuint Program = glCreateProgram();
+  for (GLuint Shader : Shaders)
+    glAttachShader(Program, Shader);
+  glLinkProgram(Program);
+
+  for (GLuint Shader : Shaders)
+    glDeleteShader(Shader);
+
+  GLint Success = GL_FALSE;
+  glGetProgramiv(Program, GL_LINK_STATUS, &Success);
+  if (Success == GL_FALSE)
+  {
+    char ErrorLog[512] = {'\0'};
+    glGetProgramInfoLog(Program, 512, NULL, ErrorLog);
+    _LinkErrorLog = ErrorLog;
+    glDeleteProgram(Program);
+    return INVALID_VALUE;
+  }
+
+  return Program;
+}
+
 GLuint CShader::LoadShader(const std::filesystem::path &_Path, GLenum _ShaderType)
 {
   std::ifstream ShaderFile(_Path);
@@ -2,6 +2,9 @@
 
 #include "render/ShaderTypes.h"
 #include "interfaces/Asset.h"
+#include <cassert>
+#include <string>
+#include <vector>
 
 class CShader final : public IAsset
 {
@@ -19,14 +22,63 @@ public:
   void Use() const;
   bool IsValid() const;
 
+  // Resolved by name once, the handles stay valid across hot reloads
+  template <class T>
+  TUniformHandle<T> GetUniformHandle(std::string_view _Name)
+  {
+    return TUniformHandle<T>{.Slot = ResolveHandle(_Name, UNIFORM_TYPE_INDEX<T>)};
+  }
+
+  template <class T>
+  void SetUniform(TUniformHandle<T> _Handle, const std::type_identity_t<T> &_Value)
+  {
+    assert(_Handle.IsValid() && _Handle.Slot < m_HandleLocations.size());
+    assert(IsUsed());
+    UploadUniform(m_HandleLocations[_Handle.Slot], _Value);
+  }
+
   void SetUniform(std::string_view _Name, const UniformType &_Value);
   void SetUniformBlockBinding(std::string_view _BlockName, unsigned _UniformBlockBinding);
 
   void Validate();
 
+private:
+  struct TUniformInfo
+  {
+    std::string Name; // Without the [0] suffix of arrays
+    int         Location;
+    unsigned    Type;
+    int         ArraySize;
+  };
+
+  struct TBlockInfo
+  {
+    std::string Name;
+    unsigned    Interface; // GL_UNIFORM_BLOCK or GL_SHADER_STORAGE_BLOCK
+    unsigned    Index;
+    int         DataSize;
+  };
+
+  struct TStage
+  {
+    std::filesystem::path Path;
+    unsigned              Type;
+  };
+
 private:
   bool IsUsed() const;
 
+  void Reflect();
+  const TUniformInfo *FindUniform(std::string_view _Name) const;
+  const TBlockInfo *FindBlock(std::string_view _Name, unsigned _Interface) const;
+  uint32_t ResolveHandle(std::string_view _Name, size_t _TypeIndex);
+  void ResolveHandleLocations();
+
+  template <class T>
+  static void UploadUniform(int _Location, const T &_Value);
+
+  static std::vector<TStage> GetStages(const std::filesystem::path &_BasePath);
+  static unsigned CreateProgram(const std::vector<TStage> &_Stages, std::string &_LinkErrorLog);
   static unsigned LoadShader(const std::filesystem::path &_Path, unsigned _ShaderType);
   static void UnloadShader(unsigned _ShaderID);
 
@@ -34,13 +86,17 @@ private:
   static constexpr inline unsigned  INVALID_VALUE             = 0u;
   static constexpr std::string_view VERTEX_SHADER_EXTENSION   = ".vert";
   static constexpr std::string_view FRAGMENT_SHADER_EXTENSION = ".frag";
+  static constexpr std::string_view COMPUTE_SHADER_EXTENSION  = ".comp";
 
-  unsigned                                     m_ID;
-  std::map<std::string, unsigned, std::less<>> m_UniformsCache;
+  unsigned                  m_ID;
+  std::vector<TUniformInfo> m_Uniforms;    // Sorted by name
+  std::vector<TBlockInfo>   m_Blocks;      // Sorted by name
+  std::vector<std::string>  m_HandleNames; // Indexed by the handle slots
+  std::vector<size_t>       m_HandleTypes; // Indices into UniformType
+  std::vector<int>          m_HandleLocations;
 
 #if SHADERS_HOT_RELOAD
-  std::filesystem::path           m_BasePath;
-  std::filesystem::file_time_type m_VertexTimestamp{};
-  std::filesystem::file_time_type m_FragmentTimestamp{};
+  std::filesystem::path                        m_BasePath;
+  std::vector<std::filesystem::file_time_type> m_StageTimestamps; // Ordered as GetStages()
 #endif
 };
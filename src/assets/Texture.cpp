@@ -1,8 +1,12 @@
 #include <glad/glad.h>
 #include "Texture.h"
+#include "render/GLState.h"
+#include "render/Sampler.h"
 #include "utils/Path.h"
 #include "utils/Image.h"
 #include <common/Logger.h>
+#include <algorithm>
+#include <bit>
 #include <vector>
 
 namespace
@@ -85,6 +89,8 @@ constexpr GLint ToGLInternalFormat(EInternalFormat _Format)
     return GL_RGB16F;
   case EInternalFormat::RGBA16F:
     return GL_RGBA16F;
+  case EInternalFormat::R32F:
+    return GL_R32F;
   case EInternalFormat::Depth16:
     return GL_DEPTH_COMPONENT16;
   case EInternalFormat::Depth24:
@@ -97,6 +103,46 @@ constexpr GLint ToGLInternalFormat(EInternalFormat _Format)
   }
 }
 
+constexpr uint32_t GetBytesPerTexel(EInternalFormat _Format)
+{
+  switch (_Format)
+  {
+  case EInternalFormat::R8:
+    return 1;
+  case EInternalFormat::RG8:
+  case EInternalFormat::Depth16:
+    return 2;
+  case EInternalFormat::RGB8:
+    return 3;
+  case EInternalFormat::RGBA8:
+  case EInternalFormat::RG16F:
+  case EInternalFormat::R32F:
+  case EInternalFormat::Depth24:
+  case EInternalFormat::Depth32:
+    return 4;
+  case EInternalFormat::RGB16F:
+    return 6;
+  case EInternalFormat::RGBA16F:
+    return 8;
+  default:
+    assert(false && "Unsupported internal format");
+    return 4;
+  }
+}
+
+// An estimate: drivers may pad texels (e.g. RGB8 to RGBA8) and align mip levels
+constexpr uint64_t EstimateTextureSize(int _Width, int _Height, uint32_t _BytesPerTexel, int _Layers, bool _HasMipmaps)
+{
+  const uint64_t Size = static_cast<uint64_t>(_Width) * _Height * _BytesPerTexel * _Layers;
+  return _HasMipmaps ? Size * 4 / 3 : Size;
+}
+
+// Full chain down to 1x1
+GLsizei GetMipLevelsCount(int _Width, int _Height)
+{
+  return static_cast<GLsizei>(std::bit_width(static_cast<unsigned>(std::max(_Width, _Height))));
+}
+
 constexpr GLint ToGLFormat(int _Channels)
 {
   switch (_Channels)
@@ -192,6 +238,36 @@ unsigned GetSupportedAnisotropyLevel()
   return AnisotropyLevel;
 }
 
+namespace
+{
+
+TSamplerState ToSamplerState(const TTextureParams &_Params)
+{
+  TSamplerState State{
+      .WrapS     = ToGLWrap(_Params.WrapS),
+      .WrapT     = ToGLWrap(_Params.WrapT),
+      .WrapR     = ToGLWrap(_Params.WrapR),
+      .MinFilter = ToGLFilter(_Params.MinFilter),
+      .MagFilter = ToGLFilter(_Params.MagFilter),
+  };
+
+  if (_Params.BorderColors.has_value())
+    std::copy_n(_Params.BorderColors->Data(), TTextureParams::BordersCount, State.BorderColor.begin());
+
+  return State;
+}
+
+// The filters stay on the texture as well, for code that samples it without the sampler (ImGui)
+void AttachSampler(GLuint _Texture, const TSamplerState &_State)
+{
+  glTextureParameteri(_Texture, GL_TEXTURE_MIN_FILTER, _State.MinFilter);
+  glTextureParameteri(_Texture, GL_TEXTURE_MAG_FILTER, _State.MagFilter);
+
+  CGLState::SetTextureSampler(_Texture, CSamplerCache::Get(_State));
+}
+
+} // namespace
+
 // CTexture
 
 const unsigned CTexture::INVALID_TEXTURE = 0u;
@@ -199,7 +275,9 @@ const unsigned CTexture::INVALID_TEXTURE = 0u;
 CTexture::CTexture(unsigned _Target) :
     m_ID(INVALID_TEXTURE),
     m_Target(_Target),
-    m_Size()
+    m_Size(),
+    m_GPUMemoryTag(EGPUMemoryTag::Textures),
+    m_GPUMemorySize(0)
 {
 }
 
@@ -212,9 +290,12 @@ void CTexture::Shutdown()
 {
   if (IsValid())
   {
+    CGLState::OnTextureDeleted(m_ID);
     glDeleteTextures(1, &m_ID);
     m_ID = INVALID_TEXTURE;
   }
+
+  SetGPUMemorySize(m_GPUMemoryTag, 0);
 }
 
 void CTexture::Bind(unsigned _TextureUnit) const
@@ -247,22 +328,34 @@ TVector2i CTexture::GetSize() const
   return m_Size;
 }
 
+uint64_t CTexture::GetGPUMemorySize() const
+{
+  return m_GPUMemorySize;
+}
+
 void CTexture::OverrideTarget(unsigned _Target)
 {
   assert(!IsValid() && "Cannot override target of an already created texture");
   m_Target = _Target;
 }
 
+void CTexture::SetGPUMemorySize(EGPUMemoryTag _Tag, uint64_t _Size)
+{
+  utils::TrackGPUMemory(m_GPUMemoryTag, -static_cast<int64_t>(m_GPUMemorySize));
+  utils::TrackGPUMemory(_Tag, static_cast<int64_t>(_Size));
+
+  m_GPUMemoryTag  = _Tag;
+  m_GPUMemorySize = _Size;
+}
+
 void CTexture::Bind(unsigned _Target, unsigned _TextureUnit, unsigned _TextureID)
 {
-  glActiveTexture(_TextureUnit);
-  glBindTexture(_Target, _TextureID);
+  CGLState::BindTexture(_Target, _TextureUnit, _TextureID);
 }
 
 void CTexture::Unbind(unsigned _Target)
 {
-  glActiveTexture(GL_TEXTURE0);
-  glBindTexture(_Target, INVALID_TEXTURE);
+  CGLState::BindTexture(_Target, GL_TEXTURE0, INVALID_TEXTURE);
 }
 
 // C2DTexture
@@ -297,30 +390,27 @@ bool C2DTexture::Load(const std::filesystem::path &_Path, const TTextureParams &
     return false;
   }
 
-  const GLenum Format         = ToGLFormat(Image.GetChannels());
-  const GLenum InternalFormat = ToGLInternalFormat(Image.GetChannels(), _Params.sRGB, _Params.HDR);
-
-  glGenTextures(1, &m_ID);
-  glBindTexture(m_Target, m_ID);
-  glTexImage2D(m_Target, 0, InternalFormat, Image.GetWidth(), Image.GetHeight(), 0, Format, _Params.HDR ? GL_FLOAT : GL_UNSIGNED_BYTE, Image.GetPixels());
+  const GLenum  Format         = ToGLFormat(Image.GetChannels());
+  const GLenum  InternalFormat = ToGLInternalFormat(Image.GetChannels(), _Params.sRGB, _Params.HDR);
+  const GLsizei Levels         = _Params.HDR ? 1 : GetMipLevelsCount(Image.GetWidth(), Image.GetHeight());
 
-  glTexParameteri(m_Target, GL_TEXTURE_WRAP_S, ToGLWrap(_Params.WrapS));
-  glTexParameteri(m_Target, GL_TEXTURE_WRAP_T, ToGLWrap(_Params.WrapT));
-  glTexParameteri(m_Target, GL_TEXTURE_MIN_FILTER, ToGLFilter(_Params.MinFilter));
-  glTexParameteri(m_Target, GL_TEXTURE_MAG_FILTER, ToGLFilter(_Params.MagFilter));
+  glCreateTextures(m_Target, 1, &m_ID);
+  glTextureStorage2D(m_ID, Levels, InternalFormat, Image.GetWidth(), Image.GetHeight());
+  glTextureSubImage2D(m_ID, 0, 0, 0, Image.GetWidth(), Image.GetHeight(), Format, _Params.HDR ? GL_FLOAT : GL_UNSIGNED_BYTE, Image.GetPixels());
 
-  if (GLAD_GL_ARB_texture_filter_anisotropic)
-    glTexParameterf(m_Target, GL_TEXTURE_MAX_ANISOTROPY, std::min(float(GetSupportedAnisotropyLevel()), _Params.Anisotropy));
+  if (Levels > 1)
+    glGenerateTextureMipmap(m_ID);
 
-  if (!_Params.HDR)
-    glGenerateMipmap(m_Target);
-
-  if (_Params.BorderColors.has_value())
-    glTexParameterfv(m_Target, GL_TEXTURE_BORDER_COLOR, _Params.BorderColors->Data());
+  TSamplerState SamplerState = ToSamplerState(_Params);
+  SamplerState.Anisotropy    = std::max(1.0f, std::min(float(GetSupportedAnisotropyLevel()), _Params.Anisotropy));
+  AttachSampler(m_ID, SamplerState);
 
   m_Path = _Path;
   m_Size = TVector2i(Image.GetWidth(), Image.GetHeight());
 
+  const uint32_t BytesPerTexel = _Params.HDR ? GetBytesPerTexel(EInternalFormat::RGB16F) : Image.GetChannels();
+  SetGPUMemorySize(_Params.MemoryTag, EstimateTextureSize(Image.GetWidth(), Image.GetHeight(), BytesPerTexel, 1, !_Params.HDR));
+
   return true;
 }
 
@@ -339,34 +429,40 @@ bool C2DTexture::Generate(const TTextureParams &_Params, CPasskey<CResourceManag
   if (IsMultisampled)
     OverrideTarget(SAMPLED_TARGET);
 
-  glGenTextures(1, &m_ID);
-  glBindTexture(m_Target, m_ID);
+  glCreateTextures(m_Target, 1, &m_ID);
 
   if (IsMultisampled)
   {
     const GLint   InternalFormat = ToGLInternalFormat(_Params.InternalFormat);
     const GLsizei Samples        = std::min(static_cast<GLsizei>(_Params.Samples.value()), static_cast<GLsizei>(GetSupportedMaxSamples()));
-    glTexImage2DMultisample(m_Target, Samples, InternalFormat, _Params.Width, _Params.Height, GL_TRUE);
+    glTextureStorage2DMultisample(m_ID, Samples, InternalFormat, _Params.Width, _Params.Height, GL_TRUE);
   }
   else
   {
-    const GLint InternalFormat = ToGLInternalFormat(_Params.InternalFormat);
-    const GLint Format         = ToGLFormat(_Params.Format);
-    const GLint Type           = ToGLType(_Params.Type);
-    glTexImage2D(m_Target, 0, InternalFormat, _Params.Width, _Params.Height, 0, Format, Type, _Params.Data);
-
-    glTexParameteri(m_Target, GL_TEXTURE_WRAP_S, ToGLWrap(_Params.WrapS));
-    glTexParameteri(m_Target, GL_TEXTURE_WRAP_T, ToGLWrap(_Params.WrapT));
-    glTexParameteri(m_Target, GL_TEXTURE_MIN_FILTER, ToGLFilter(_Params.MinFilter));
-    glTexParameteri(m_Target, GL_TEXTURE_MAG_FILTER, ToGLFilter(_Params.MagFilter));
-
-    if (_Params.BorderColors.has_value())
-      glTexParameterfv(m_Target, GL_TEXTURE_BORDER_COLOR, _Params.BorderColors->Data());
+    const GLint   InternalFormat = ToGLInternalFormat(_Params.InternalFormat);
+    const GLint   Format         = ToGLFormat(_Params.Format);
+    const GLint   Type           = ToGLType(_Params.Type);
+    const GLsizei Levels         = _Params.GenerateMipmaps ? GetMipLevelsCount(_Params.Width, _Params.Height) : 1;
+    glTextureStorage2D(m_ID, Levels, InternalFormat, _Params.Width, _Params.Height);
+
+    // Without data the mip chain is filled by whoever renders into it
+    if (_Params.Data)
+    {
+      glTextureSubImage2D(m_ID, 0, 0, 0, _Params.Width, _Params.Height, Format, Type, _Params.Data);
+      if (Levels > 1)
+        glGenerateTextureMipmap(m_ID);
+    }
+
+    AttachSampler(m_ID, ToSamplerState(_Params));
   }
 
   m_Size = TVector2i(_Params.Width, _Params.Height);
   m_Path = "Generated Texture";
 
+  const int  Layers     = IsMultisampled ? std::min(_Params.Samples.value(), static_cast<int>(GetSupportedMaxSamples())) : 1;
+  const bool HasMipmaps = !IsMultisampled && _Params.GenerateMipmaps;
+  SetGPUMemorySize(_Params.MemoryTag, EstimateTextureSize(_Params.Width, _Params.Height, GetBytesPerTexel(_Params.InternalFormat), Layers, HasMipmaps));
+
   return true;
 }
 
@@ -416,38 +512,21 @@ bool CCubemap::Generate(const TTextureParams &_Params, CPasskey<CResourceManager
 
   assert(!IsValid() && "The texture already exists");
 
-  const GLint InternalFormat = ToGLInternalFormat(_Params.InternalFormat);
-  const GLint Format         = ToGLFormat(_Params.Format);
-  const GLint Type           = ToGLType(_Params.Type);
-
-  glGenTextures(1, &m_ID);
-  glBindTexture(m_Target, m_ID);
-
-  for (int i = 0; i < CUBEMAP_FACES_COUNT; ++i)
-  {
-    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, //
-                 0,                                  //
-                 InternalFormat,                     //
-                 _Params.Width,                      //
-                 _Params.Height,                     //
-                 0,                                  //
-                 Format,                             //
-                 Type,                               //
-                 nullptr);
-  }
+  const GLint   InternalFormat = ToGLInternalFormat(_Params.InternalFormat);
+  const GLsizei Levels         = _Params.GenerateMipmaps ? GetMipLevelsCount(_Params.Width, _Params.Height) : 1;
 
-  glTexParameteri(m_Target, GL_TEXTURE_WRAP_S, ToGLWrap(_Params.WrapS));
-  glTexParameteri(m_Target, GL_TEXTURE_WRAP_T, ToGLWrap(_Params.WrapT));
-  glTexParameteri(m_Target, GL_TEXTURE_WRAP_R, ToGLWrap(_Params.WrapR));
-  glTexParameteri(m_Target, GL_TEXTURE_MIN_FILTER, ToGLFilter(_Params.MinFilter));
-  glTexParameteri(m_Target, GL_TEXTURE_MAG_FILTER, ToGLFilter(_Params.MagFilter));
+  // All six faces in one allocation, the mip chain is filled by whoever renders into it
+  glCreateTextures(m_Target, 1, &m_ID);
+  glTextureStorage2D(m_ID, Levels, InternalFormat, _Params.Width, _Params.Height);
 
-  if (_Params.GenerateMipmaps)
-    glGenerateMipmap(m_Target);
+  AttachSampler(m_ID, ToSamplerState(_Params));
 
   m_Size = TVector2i(_Params.Width, _Params.Height);
   m_Path = "Generated Cubemap";
 
+  SetGPUMemorySize(_Params.MemoryTag, EstimateTextureSize(_Params.Width, _Params.Height, GetBytesPerTexel(_Params.InternalFormat), CUBEMAP_FACES_COUNT,
+                                                          _Params.GenerateMipmaps));
+
   return true;
 }
 
@@ -487,25 +566,26 @@ bool CCubemap::LoadLegacy(const std::filesystem::path &_Path, const TTexturePara
   bool Success = false;
   if (Success = (Images.size() == CUBEMAP_FACES_COUNT))
   {
-    glGenTextures(1, &m_ID);
-    glBindTexture(m_Target, m_ID);
+    // Faces are expected to share the size, the storage takes the format of the first one
+    const GLenum InternalFormat = ToGLInternalFormat(Images[0].GetChannels(), false, false);
+
+    glCreateTextures(m_Target, 1, &m_ID);
+    glTextureStorage2D(m_ID, 1, InternalFormat, Images[0].GetWidth(), Images[0].GetHeight());
 
     for (int i = 0; i < Images.size(); ++i)
     {
       const CImage &Image  = Images[i];
       const GLenum  Format = ToGLFormat(Image.GetChannels());
-      glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, Format, Image.GetWidth(), Image.GetHeight(), 0, Format, GL_UNSIGNED_BYTE, Image.GetPixels());
+      glTextureSubImage3D(m_ID, 0, 0, 0, i, Image.GetWidth(), Image.GetHeight(), 1, Format, GL_UNSIGNED_BYTE, Image.GetPixels());
     }
 
-    glTexParameteri(m_Target, GL_TEXTURE_MIN_FILTER, ToGLFilter(_Params.MinFilter));
-    glTexParameteri(m_Target, GL_TEXTURE_MAG_FILTER, ToGLFilter(_Params.MagFilter));
-    glTexParameteri(m_Target, GL_TEXTURE_WRAP_S, ToGLWrap(_Params.WrapS));
-    glTexParameteri(m_Target, GL_TEXTURE_WRAP_T, ToGLWrap(_Params.WrapT));
-    glTexParameteri(m_Target, GL_TEXTURE_WRAP_R, ToGLWrap(_Params.WrapR));
+    AttachSampler(m_ID, ToSamplerState(_Params));
 
     m_Size = TVector2i(Images[0].GetWidth(), Images[0].GetHeight());
     m_Path = _Path;
 
+    SetGPUMemorySize(_Params.MemoryTag, EstimateTextureSize(m_Size.X, m_Size.Y, Images[0].GetChannels(), CUBEMAP_FACES_COUNT, false));
+
     LOG_INFO("[CCubemap] Texture '{}' loaded successfully", utils::GetRelativePath(_Path).string());
   }
   else
@@ -16,6 +16,7 @@ public:
   bool IsValid() const;
 
   TVector2i GetSize() const;
+  uint64_t GetGPUMemorySize() const;
 
   void Bind(unsigned _TextureUnit) const;
   void Unbind() const;
@@ -24,6 +25,7 @@ protected:
   CTexture(unsigned _Target);
 
   void OverrideTarget(unsigned _Target);
+  void SetGPUMemorySize(EGPUMemoryTag _Tag, uint64_t _Size);
 
   static void Bind(unsigned _Target, unsigned _TextureUnit, unsigned _TextureID);
   static void Unbind(unsigned _Target);
@@ -32,9 +34,11 @@ public:
   static const unsigned INVALID_TEXTURE;
 
 protected:
-  unsigned  m_ID;
-  unsigned  m_Target;
-  TVector2i m_Size;
+  unsigned      m_ID;
+  unsigned      m_Target;
+  TVector2i     m_Size;
+  EGPUMemoryTag m_GPUMemoryTag;
+  uint64_t      m_GPUMemorySize;
 };
 
 // ----------------------------------------------
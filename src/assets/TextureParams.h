@@ -1,5 +1,6 @@
 #pragma once
 
+#include "utils/Memory.h"
 #include <common/containers/StaticArray.h>
 #include <cstdint>
 #include <optional>
@@ -40,6 +41,7 @@ enum class EInternalFormat : std::uint8_t
   RG16F,
   RGB16F,
   RGBA16F,
+  R32F,
   Depth16,
   Depth24,
   Depth32
@@ -91,4 +93,6 @@ struct TTextureParams
   ETextureWrap   WrapR     = ETextureWrap::Repeat; // For cubemaps
   ETextureFilter MinFilter = ETextureFilter::LinearMipmapLinear;
   ETextureFilter MagFilter = ETextureFilter::Linear;
+
+  EGPUMemoryTag MemoryTag = EGPUMemoryTag::Textures;
 };
@@ -1,7 +1,9 @@
 #include "pch.h"
 
 #include "TinyGLTFParseStrategy.h"
+#include "MeshSimplifier.h"
 #include "utils/Path.h"
+#include <common/JobSystem.h>
 #include <common/Stopwatch.h>
 #include <common/Logger.h>
 #include <mikktspace.h>
@@ -10,6 +12,14 @@
 namespace
 {
 
+// Every LOD aims at half the triangles of the one before and may move the surface twice as far,
+// starting from LOD_BASE_ERROR of the primitive's extent
+constexpr int    LOD_COUNT         = 3;
+constexpr float  LOD_REDUCTION     = 0.5f;
+constexpr float  LOD_BASE_ERROR    = 0.005f;
+constexpr float  LOD_MIN_REDUCTION = 0.8f; // A LOD keeping more of the triangles of the one before isn't worth a draw
+constexpr size_t LOD_MIN_TRIANGLES = 128;  // Smaller primitives are drawn whole
+
 EAlphaMode ToModelAlphaMode(const std::string &_Mode)
 {
   if (_Mode == "MASK")
@@ -149,6 +159,51 @@ void CopyData(const std::vector<uint8_t> &_Src, std::vector<uint8_t> &_Dst, size
   }
 }
 
+std::vector<glm::vec3> ReadPositions(const TAttribute &_Attribute)
+{
+  const size_t Stride = _Attribute.ByteStride > 0 ? static_cast<size_t>(_Attribute.ByteStride) : sizeof(glm::vec3);
+
+  std::vector<glm::vec3> Positions(_Attribute.Data.size() / Stride);
+  for (size_t i = 0; i < Positions.size(); ++i)
+    std::memcpy(&Positions[i], _Attribute.Data.data() + i * Stride, sizeof(glm::vec3));
+
+  return Positions;
+}
+
+template <typename T>
+void ReadIndices(const std::vector<uint8_t> &_Source, std::vector<uint32_t> &_Target)
+{
+  for (size_t i = 0; i < _Target.size(); ++i)
+  {
+    T Index;
+    std::memcpy(&Index, _Source.data() + i * sizeof(T), sizeof(T));
+    _Target[i] = Index;
+  }
+}
+
+std::vector<uint32_t> ReadIndices(const TPrimitive &_Primitive)
+{
+  std::vector<uint32_t> Indices(_Primitive.IndicesCount);
+
+  switch (_Primitive.IndicesType)
+  {
+  case EIndexType::UnsignedByte:
+    ReadIndices<uint8_t>(_Primitive.Indices, Indices);
+    break;
+  case EIndexType::UnsignedShort:
+    ReadIndices<uint16_t>(_Primitive.Indices, Indices);
+    break;
+  case EIndexType::UnsignedInt:
+    ReadIndices<uint32_t>(_Primitive.Indices, Indices);
+    break;
+  default:
+    Indices.clear();
+    break;
+  }
+
+  return Indices;
+}
+
 } // namespace
 
 bool CTinyGLTFParseStrategy::Parse(const std::filesystem::path &_Path, TModelData &_Model)
@@ -249,6 +304,15 @@ void CTinyGLTFParseStrategy::ParseMeshes(const tinygltf::Model &_Source, TModelD
       GenerateTangentsIfMissing(Primitive);
     }
   }
+
+  MEASURE_ZONE("Generate LODs");
+
+  std::vector<TPrimitive *> Primitives;
+  for (TMesh &Mesh : _Target.Meshes)
+    for (TPrimitive &Primitive : Mesh.Primitives)
+      Primitives.push_back(&Primitive);
+
+  utils::CJobSystem::Instance().ParallelFor(Primitives.size(), [&](size_t _Index) { GenerateLODs(*Primitives[_Index]); });
 }
 
 void CTinyGLTFParseStrategy::ParseAttributes(const tinygltf::Model     &_Source,
@@ -567,3 +631,44 @@ void CTinyGLTFParseStrategy::GenerateTangentsIfMissing(TPrimitive &Primitive)
 
   Primitive.Attributes.emplace(EAttributeType::Tangent, std::move(TangentAttr));
 }
+
+void CTinyGLTFParseStrategy::GenerateLODs(TPrimitive &_Primitive)
+{
+  if (_Primitive.Mode != EPrimitiveMode::Triangles || _Primitive.Indices.empty() || _Primitive.IndicesCount / 3 < LOD_MIN_TRIANGLES)
+    return;
+
+  auto PositionIt = _Primitive.Attributes.find(EAttributeType::Position);
+  if (PositionIt == _Primitive.Attributes.end() || PositionIt->second.ComponentType != EAttributeComponentType::Float)
+    return;
+
+  const std::vector<glm::vec3> Positions = ReadPositions(PositionIt->second);
+  const std::vector<uint32_t>  Indices   = ReadIndices(_Primitive);
+  if (Positions.empty() || Indices.empty())
+    return;
+
+  glm::vec3 Min = Positions.front(), Max = Positions.front();
+  for (const glm::vec3 &Position : Positions)
+  {
+    Min = glm::min(Min, Position);
+    Max = glm::max(Max, Position);
+  }
+
+  const float Extent = glm::length(Max - Min);
+  if (Extent <= 0.0f)
+    return;
+
+  // Every LOD is simplified from the full mesh, errors of coarser ones don't pile up
+  size_t PreviousCount = Indices.size();
+  for (int LOD = 1; LOD <= LOD_COUNT; ++LOD)
+  {
+    const size_t TargetCount = static_cast<size_t>(PreviousCount * LOD_REDUCTION) / 3 * 3;
+    const float  MaxError    = Extent * LOD_BASE_ERROR * static_cast<float>(1 << (LOD - 1));
+
+    std::vector<uint32_t> LODIndices = SimplifyMesh(Positions, Indices, TargetCount, MaxError);
+    if (LODIndices.empty() || LODIndices.size() > PreviousCount * LOD_MIN_REDUCTION)
+      break;
+
+    PreviousCount = LODIndices.size();
+    _Primitive.LODs.push_back(std::move(LODIndices));
+  }
+}
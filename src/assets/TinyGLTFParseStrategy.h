@@ -24,4 +24,5 @@ private:
   void ParseMaterials(const tinygltf::Model &_Source, TModelData &_Target);
   void ParseImages(const tinygltf::Model &_Source, TModelData &_Target, const std::filesystem::path &_ModelDirectory);
   void GenerateTangentsIfMissing(TPrimitive &Primitive);
+  void GenerateLODs(TPrimitive &_Primitive);
 };
\ No newline at end of file
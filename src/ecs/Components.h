@@ -1,6 +1,9 @@
 #pragma once
 
 #include "render/Buffer.h"
+#include "render/GeometryPool.h"
+#include "render/MaterialBuffer.h"
+#include "render/OcclusionBuffer.h"
 #include "render/ShaderTypes.h"
 #include "render/RenderTypes.h"
 #include "physics/Collision.h"
@@ -38,17 +41,23 @@ struct TModelComponent
     GLint                     TexCoordIndex = 0;
   };
 
+  struct TLOD
+  {
+    uint32_t FirstIndex   = 0; // From the first index of the geometry
+    uint32_t IndicesCount = 0;
+  };
+
   struct TPrimitiveData
   {
-    TSharedVAO                VAO;
-    std::vector<TSharedVBO>   VBOs;
-    std::optional<TSharedEBO> EBO;
-    EPrimitiveMode            Mode            = EPrimitiveMode::Triangles;
-    glm::mat4                 PrimitiveMatrix = glm::mat4(1.0f);
-    int                       MaterialIndex   = -1;
-    uint32_t                  VerticesCount   = 0;
-    uint32_t                  IndicesCount    = 0;
-    EIndexType                Type            = EIndexType::Absent;
+    std::shared_ptr<CGeometryPool::CAllocation> Geometry; // Vertices and indices in the geometry pool, LODs after the full mesh
+    std::shared_ptr<const TOccluderMesh>        Occluder; // Large opaque primitives only
+    std::vector<TLOD>                           LODs;     // The full mesh first, coarser ones after it
+    EPrimitiveMode                              Mode            = EPrimitiveMode::Triangles;
+    glm::mat4                                   PrimitiveMatrix = glm::mat4(1.0f);
+    TAABB                                       Bounds;         // In the entity space, PrimitiveMatrix applied
+    int                                         MaterialIndex   = -1;
+    uint32_t                                    VerticesCount   = 0;
+    uint32_t                                    IndicesCount    = 0; // Of the full mesh
   };
 
   struct TMaterialData
@@ -66,6 +75,8 @@ struct TModelComponent
     float      AlphaCutoff       = 0.5f;
     EAlphaMode AlphaMode         = EAlphaMode::Opaque;
     bool       IsDoubleSided     = false;
+
+    std::shared_ptr<CMaterialBuffer::CHandle> Handle; // Packed parameters in the material buffer
   };
 
   std::vector<TPrimitiveData> Primitives;
@@ -21,6 +21,7 @@ void CComponentsFactory::CreateEnvironmentComponent(const std::filesystem::path
     Params.Type              = EType::Float;
     Params.Width             = 512;
     Params.Height            = 512;
+    Params.MemoryTag         = EGPUMemoryTag::Environment;
     _Component.SkyboxTexture = resource::CreateCubemap("SKYBOX_CUBEMAP", Params);
   }
 
@@ -37,6 +38,7 @@ void CComponentsFactory::CreateEnvironmentComponent(const std::filesystem::path
     Params.Type              = EType::Float;
     Params.Width             = 32;
     Params.Height            = 32;
+    Params.MemoryTag         = EGPUMemoryTag::Environment;
     _Component.IrradianceMap = resource::CreateCubemap("IRRADIANCE_CUBEMAP", Params);
   }
 
@@ -47,6 +49,7 @@ void CComponentsFactory::CreateEnvironmentComponent(const std::filesystem::path
     Params.WrapT                  = ETextureWrap::ClampToEdge;
     Params.MinFilter              = ETextureFilter::Linear;
     Params.MagFilter              = ETextureFilter::Linear;
+    Params.MemoryTag              = EGPUMemoryTag::Environment;
     _Component.EquirectangularMap = resource::LoadTexture(_Path, Params);
   }
 }
@@ -6,9 +6,17 @@
 #include "assets/Texture.h"
 #include "utils/Resource.h"
 #include <common/Stopwatch.h>
+#include <cstring>
+#include <numeric>
 
 namespace ecs
 {
+
+// Primitives drawn into the occlusion buffer have to span this much along two axes at least,
+// and those with more triangles than it's worth rasterizing on the CPU are left out
+constexpr float    OCCLUDER_MIN_SIZE      = 2.0f;
+constexpr uint32_t OCCLUDER_MAX_TRIANGLES = 2048;
+
 static GLint ToAttributeLocation(EAttributeType _Type)
 {
   switch (_Type)
@@ -102,6 +110,25 @@ static TModelComponent::TTexture LoadTexture(const TModelData &_ModelData, const
   return Result;
 }
 
+static TShaderMaterial CreateShaderMaterial(const TModelComponent::TMaterialData &_Material)
+{
+  return TShaderMaterial{
+      .BaseColorFactor                       = _Material.BaseColorFactor,
+      .EmissiveFactor                        = _Material.EmissiveFactor,
+      .MetallicFactor                        = _Material.MetallicFactor,
+      .RoughnessFactor                       = _Material.RoughnessFactor,
+      .OcclusionStrength                     = _Material.OcclusionStrength,
+      .AlphaCutoff                           = _Material.AlphaCutoff,
+      .AlphaMode                             = static_cast<int32_t>(_Material.AlphaMode),
+      .IsDoubleSided                         = _Material.IsDoubleSided,
+      .BaseColorTextureTexCoordIndex         = _Material.BaseColorTexture.TexCoordIndex,
+      .MetallicRoughnessTextureTexCoordIndex = _Material.MetallicRoughnessTexture.TexCoordIndex,
+      .NormalTextureTexCoordIndex            = _Material.NormalTexture.TexCoordIndex,
+      .OcclusionTextureTexCoordIndex         = _Material.OcclusionTexture.TexCoordIndex,
+      .EmissiveTextureTexCoordIndex          = _Material.EmissiveTexture.TexCoordIndex,
+  };
+}
+
 static void ParseMaterials(const TModelData &_ModelData, TModelComponent &_Component)
 {
   _Component.Materials.reserve(_ModelData.Materials.size());
@@ -121,50 +148,165 @@ static void ParseMaterials(const TModelData &_ModelData, TModelComponent &_Compo
     Material.NormalTexture                   = LoadTexture(_ModelData, SrcMaterial.NormalTexture, ETextureType::Normal);
     Material.OcclusionTexture                = LoadTexture(_ModelData, SrcMaterial.OcclusionTexture, ETextureType::Occlusion);
     Material.EmissiveTexture                 = LoadTexture(_ModelData, SrcMaterial.EmissiveTexture, ETextureType::Emissive);
+    Material.Handle                          = resource::CreateMaterial(CreateShaderMaterial(Material));
+  }
+}
+
+template <typename T>
+static void CopyIndices(const std::vector<uint8_t> &_Source, std::vector<uint32_t> &_Target)
+{
+  for (size_t i = 0; i < _Target.size(); ++i)
+  {
+    T Index;
+    std::memcpy(&Index, _Source.data() + i * sizeof(T), sizeof(T));
+    _Target[i] = Index;
+  }
+}
+
+// The geometry pool keeps 32-bit indices only, primitives without indices are drawn in vertex order
+static std::vector<uint32_t> ToIndices(const TPrimitive &_Primitive)
+{
+  std::vector<uint32_t> Indices;
+
+  if (_Primitive.Indices.empty())
+  {
+    Indices.resize(_Primitive.VerticesCount);
+    std::iota(Indices.begin(), Indices.end(), 0u);
+    return Indices;
+  }
+
+  Indices.resize(_Primitive.IndicesCount);
+
+  switch (_Primitive.IndicesType)
+  {
+  case EIndexType::UnsignedByte:
+    CopyIndices<uint8_t>(_Primitive.Indices, Indices);
+    break;
+  case EIndexType::UnsignedShort:
+    CopyIndices<uint16_t>(_Primitive.Indices, Indices);
+    break;
+  case EIndexType::UnsignedInt:
+    CopyIndices<uint32_t>(_Primitive.Indices, Indices);
+    break;
+  default:
+    assert(false && "Unknown index type");
+    break;
   }
+
+  return Indices;
+}
+
+template <typename TFunc>
+static void ForEachPosition(const TPrimitive &_Primitive, TFunc &&_Func)
+{
+  auto It = _Primitive.Attributes.find(EAttributeType::Position);
+  if (It == _Primitive.Attributes.end())
+    return;
+
+  const TAttribute &Positions = It->second;
+  const size_t      Stride    = Positions.ByteStride > 0 ? static_cast<size_t>(Positions.ByteStride) : sizeof(glm::vec3);
+
+  for (size_t Offset = 0; Offset + sizeof(glm::vec3) <= Positions.Data.size(); Offset += Stride)
+  {
+    glm::vec3 Position;
+    std::memcpy(&Position, Positions.Data.data() + Offset, sizeof(glm::vec3));
+    _Func(Position);
+  }
+}
+
+static TAABB CalculatePrimitiveBounds(const TPrimitive &_Primitive, const glm::mat4 &_Transform)
+{
+  TAABB Bounds;
+
+  if (_Primitive.MinValues.has_value() && _Primitive.MaxValues.has_value())
+    Bounds = TAABB{.Min = _Primitive.MinValues.value(), .Max = _Primitive.MaxValues.value()};
+  else
+    ForEachPosition(_Primitive, [&Bounds](const glm::vec3 &_Position) { Bounds.Expand(_Position); });
+
+  return Bounds.Transform(_Transform);
+}
+
+// Blended and masked surfaces let the geometry behind them through, so they never occlude
+static bool IsOccluder(const TModelComponent &_Component, const TModelComponent::TPrimitiveData &_Primitive)
+{
+  if (_Primitive.Mode != EPrimitiveMode::Triangles || _Primitive.IndicesCount / 3 > OCCLUDER_MAX_TRIANGLES || !_Primitive.Bounds.IsValid())
+    return false;
+
+  if (_Component.Materials[_Primitive.MaterialIndex].AlphaMode != EAlphaMode::Opaque)
+    return false;
+
+  glm::vec3 Size = _Primitive.Bounds.Size();
+  std::sort(&Size.x, &Size.x + 3);
+
+  return Size[1] >= OCCLUDER_MIN_SIZE;
+}
+
+static std::shared_ptr<const TOccluderMesh> CreateOccluderMesh(const TPrimitive &_Primitive, std::vector<uint32_t> _Indices)
+{
+  auto Mesh     = std::make_shared<TOccluderMesh>();
+  Mesh->Indices = std::move(_Indices);
+  Mesh->Positions.reserve(_Primitive.VerticesCount);
+
+  ForEachPosition(_Primitive, [&Mesh](const glm::vec3 &_Position) { Mesh->Positions.push_back(_Position); });
+
+  return Mesh;
 }
 
 static void ParseMesh(const TModelData &_Model, const TMesh &_Mesh, TModelComponent &_Component, const glm::mat4 &_NodeTransform)
 {
   for (const TPrimitive &Primitive : _Mesh.Primitives)
   {
-    TModelComponent::TPrimitiveData &PrimitiveData = _Component.Primitives.emplace_back();
-    PrimitiveData.MaterialIndex                    = std::max(Primitive.MaterialIndex, 0);
-    PrimitiveData.Mode                             = Primitive.Mode;
-    PrimitiveData.PrimitiveMatrix                  = _NodeTransform;
-    PrimitiveData.VerticesCount                    = Primitive.VerticesCount;
-    PrimitiveData.VAO                              = std::make_shared<CVertexArray>();
-
-    for (const auto &[Type, Attribute] : Primitive.Attributes)
+    if (Primitive.VerticesCount == 0)
     {
-      const GLuint AttributeLoc = ToAttributeLocation(Type);
+      CLogger::Log(ELogType::Warning, "[CreateModelComponent] Skipping a primitive without vertices");
+      continue;
+    }
 
-      assert(AttributeLoc != GLuint(-1));
+    std::vector<uint32_t> Indices = ToIndices(Primitive);
 
-      PrimitiveData.VAO->Bind();
+    TModelComponent::TPrimitiveData &PrimitiveData = _Component.Primitives.emplace_back();
+    PrimitiveData.LODs.push_back(TModelComponent::TLOD{.FirstIndex = 0, .IndicesCount = static_cast<uint32_t>(Indices.size())});
 
-      TSharedVBO &VBO = PrimitiveData.VBOs.emplace_back(std::make_shared<CVertexBuffer>(GL_STATIC_DRAW));
-      VBO->Bind();
-      VBO->Assign(Attribute.Data);
+    // The LODs index the same vertices, they follow the full mesh in a single allocation
+    TGeometryData Geometry;
+    Geometry.VerticesCount = Primitive.VerticesCount;
+    Geometry.Indices       = Indices;
 
-      PrimitiveData.VAO->EnableAttrib(AttributeLoc, Attribute.Type, ToRawAttributeComponentType(Attribute.ComponentType), Attribute.IsNormalized,
-                                      Attribute.ByteStride);
-      PrimitiveData.VAO->Unbind();
+    for (const std::vector<uint32_t> &LODIndices : Primitive.LODs)
+    {
+      PrimitiveData.LODs.push_back(TModelComponent::TLOD{
+          .FirstIndex   = static_cast<uint32_t>(Geometry.Indices.size()),
+          .IndicesCount = static_cast<uint32_t>(LODIndices.size()),
+      });
+      Geometry.Indices.insert(Geometry.Indices.end(), LODIndices.begin(), LODIndices.end());
     }
 
-    if (!Primitive.Indices.empty())
+    for (const auto &[Type, Attribute] : Primitive.Attributes)
     {
-      PrimitiveData.IndicesCount = Primitive.IndicesCount;
-      PrimitiveData.Type         = Primitive.IndicesType;
-
-      PrimitiveData.VAO->Bind();
+      const GLuint AttributeLoc = ToAttributeLocation(Type);
 
-      TSharedEBO &EBO = PrimitiveData.EBO.emplace(std::make_shared<CElementBuffer>(GL_STATIC_DRAW));
-      EBO->Bind();
-      EBO->Assign(Primitive.Indices);
+      assert(AttributeLoc != GLuint(-1));
 
-      PrimitiveData.VAO->Unbind();
+      Geometry.Format.push_back(TVertexAttribute{
+          .Location      = AttributeLoc,
+          .Size          = Attribute.Type,
+          .ComponentType = ToRawAttributeComponentType(Attribute.ComponentType),
+          .IsNormalized  = Attribute.IsNormalized,
+          .Stride        = Attribute.ByteStride,
+      });
+      Geometry.Streams.emplace_back(Attribute.Data);
     }
+
+    PrimitiveData.MaterialIndex   = std::max(Primitive.MaterialIndex, 0);
+    PrimitiveData.Mode            = Primitive.Mode;
+    PrimitiveData.PrimitiveMatrix = _NodeTransform;
+    PrimitiveData.Bounds          = CalculatePrimitiveBounds(Primitive, _NodeTransform);
+    PrimitiveData.VerticesCount   = Primitive.VerticesCount;
+    PrimitiveData.IndicesCount    = static_cast<uint32_t>(Indices.size());
+    PrimitiveData.Geometry        = resource::AllocateGeometry(Geometry);
+
+    if (IsOccluder(_Component, PrimitiveData))
+      PrimitiveData.Occluder = CreateOccluderMesh(Primitive, std::move(Indices));
   }
 }
 
@@ -219,6 +361,7 @@ void CComponentsFactory::CreateModelComponent(const std::shared_ptr<CModel> &_Mo
     Material.NormalTexture.Texture            = resource::GetDefaultTexture(ETextureType::Normal);
     Material.OcclusionTexture.Texture         = resource::GetDefaultTexture(ETextureType::Occlusion);
     Material.EmissiveTexture.Texture          = resource::GetDefaultTexture(ETextureType::Emissive);
+    Material.Handle                           = resource::CreateMaterial(CreateShaderMaterial(Material));
   }
   else
   {
@@ -21,4 +21,18 @@ void CLightingSystem::Collect(TFrameData &_FrameData)
   }
 }
 
+std::optional<glm::vec3> CLightingSystem::GetDirectionalLightDirection() const
+{
+  std::optional<glm::vec3> Direction;
+
+  for (ecs::TEntity Entity : m_Entities)
+  {
+    const auto &Light = m_Coordinator->GetComponent<TLightComponent>(Entity);
+    if (Light.Type == ELightType::Directional)
+      Direction = Light.Direction;
+  }
+
+  return Direction;
+}
+
 } // namespace ecs
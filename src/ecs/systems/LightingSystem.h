@@ -2,6 +2,8 @@
 
 #include "interfaces/FrameDataCollector.h"
 #include <ecs/System.h>
+#include <glm/vec3.hpp>
+#include <optional>
 #include <vector>
 
 namespace ecs
@@ -12,6 +14,8 @@ class CLightingSystem : public IFrameDataCollector,
 {
 public:
   void Collect(TFrameData &_FrameData) override;
+
+  std::optional<glm::vec3> GetDirectionalLightDirection() const; // Of the last one, as the renderer picks it
 };
 
 } // namespace ecs
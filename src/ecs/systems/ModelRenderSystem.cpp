@@ -3,14 +3,155 @@
 #include "ModelRenderSystem.h"
 #include "ecs/Components.h"
 #include "ecs/Coordinator.h"
+#include "engine/Camera.h"
+#include "engine/Config.h"
+#include "engine/Engine.h"
 #include "render/RenderCommand.h"
 #include "render/RenderQueue.h"
 #include "assets/Texture.h"
+#include <span>
 
 namespace ecs
 {
 
+// A LOD gives way to the next coarser one below this part of the screen height, halved per level
+// as the LODs are simplified with twice the error each. The hysteresis keeps it from flickering
+// when the size stays around a threshold.
+constexpr float LOD_SCREEN_SIZE = 0.25f;
+constexpr float LOD_HYSTERESIS  = 0.1f;
+
+static float GetLODMinScreenSize(uint32_t _LOD)
+{
+  return LOD_SCREEN_SIZE / static_cast<float>(1u << _LOD);
+}
+
+// Part of the screen height the bounding sphere covers
+static float GetScreenSize(const TAABB &_Bounds, const glm::vec3 &_CameraPosition, float _ProjectionScale)
+{
+  const float Radius   = 0.5f * glm::length(_Bounds.Size());
+  const float Distance = glm::distance(_Bounds.Center(), _CameraPosition);
+
+  return Distance > Radius ? Radius * _ProjectionScale / Distance : std::numeric_limits<float>::max();
+}
+
+static uint32_t SelectLOD(uint32_t _CurrentLOD, uint32_t _LODsCount, float _ScreenSize)
+{
+  const uint32_t LastLOD = _LODsCount - 1;
+
+  uint32_t LOD = std::min(_CurrentLOD, LastLOD);
+  while (LOD < LastLOD && _ScreenSize < GetLODMinScreenSize(LOD) * (1.0f - LOD_HYSTERESIS))
+    ++LOD;
+  while (LOD > 0 && _ScreenSize > GetLODMinScreenSize(LOD - 1) * (1.0f + LOD_HYSTERESIS))
+    --LOD;
+
+  return LOD;
+}
+
 void CModelRenderSystem::Collect(CRenderQueue &_Queue)
+{
+  BeginCollect();
+  Collect(_Queue, 0, m_Proxies.size());
+}
+
+void CModelRenderSystem::BeginCollect(std::optional<std::span<const ecs::TEntity>> _VisibleEntities)
+{
+  if (!CConfig::Instance().GetRetainedRenderListEnabled())
+    for (ecs::TEntity Entity : m_Entities)
+      BuildProxies(Entity);
+
+  const std::shared_ptr<CCamera> Camera = CEngine::Instance().GetCamera();
+
+  m_CollectParams = TCollectParams{
+      .IsLODEnabled    = CConfig::Instance().GetLODEnabled() && Camera,
+      .ShadowLODBias   = static_cast<uint32_t>(std::max(CConfig::Instance().GetShadowLODBias(), 0)),
+      .CameraPosition  = Camera ? Camera->GetPosition() : glm::vec3(0.0f),
+      .ProjectionScale = Camera ? Camera->GetPerspectiveProjection()[1][1] : 1.0f,
+      .IsCulled        = _VisibleEntities.has_value(),
+  };
+
+  m_VisibleProxies.clear();
+  if (!_VisibleEntities)
+    return;
+
+  for (ecs::TEntity Entity : _VisibleEntities.value())
+  {
+    // The tree holds entities without a model as well
+    const auto It = m_EntityProxies.find(Entity);
+    if (It != m_EntityProxies.end())
+      m_VisibleProxies.insert(m_VisibleProxies.end(), It->second.begin(), It->second.end());
+  }
+}
+
+void CModelRenderSystem::Collect(CRenderQueue &_Queue, size_t _FirstProxy, size_t _ProxiesCount)
+{
+  assert(_FirstProxy + _ProxiesCount <= GetProxiesCount());
+
+  if (m_CollectParams.IsCulled)
+  {
+    for (uint32_t Index : std::span(m_VisibleProxies).subspan(_FirstProxy, _ProxiesCount))
+      CollectProxy(m_Proxies[Index], _Queue);
+  }
+  else
+  {
+    for (TRenderProxy &Proxy : std::span(m_Proxies).subspan(_FirstProxy, _ProxiesCount))
+      CollectProxy(Proxy, _Queue);
+  }
+}
+
+size_t CModelRenderSystem::GetProxiesCount() const
+{
+  return m_CollectParams.IsCulled ? m_VisibleProxies.size() : m_Proxies.size();
+}
+
+void CModelRenderSystem::CollectProxy(TRenderProxy &_Proxy, CRenderQueue &_Queue)
+{
+  const auto [IsLODEnabled, ShadowLODBias, CameraPosition, ProjectionScale, IsCulled] = m_CollectParams;
+
+  const uint32_t LODsCount = static_cast<uint32_t>(_Proxy.LODs.size());
+
+  _Proxy.CurrentLOD = IsLODEnabled ? SelectLOD(_Proxy.CurrentLOD, LODsCount, GetScreenSize(_Proxy.Command.Bounds, CameraPosition, ProjectionScale)) : 0;
+
+  const uint32_t ShadowLOD = IsLODEnabled ? std::min(_Proxy.CurrentLOD + ShadowLODBias, LODsCount - 1) : 0;
+
+  TRenderCommand Command = _Proxy.Command;
+  Command.IndicesCount   = _Proxy.LODs[_Proxy.CurrentLOD].IndicesCount;
+  Command.FirstIndex     = _Proxy.FirstIndex + _Proxy.LODs[_Proxy.CurrentLOD].FirstIndex;
+  Command.RenderFlags.set(ERenderFlags_CastShadow, ShadowLOD == _Proxy.CurrentLOD);
+
+  // Shadows of a coarser LOD go as a command of their own
+  if (ShadowLOD != _Proxy.CurrentLOD)
+  {
+    TRenderCommand ShadowCommand = _Proxy.Command;
+    ShadowCommand.Occluder       = nullptr;
+    ShadowCommand.IndicesCount   = _Proxy.LODs[ShadowLOD].IndicesCount;
+    ShadowCommand.FirstIndex     = _Proxy.FirstIndex + _Proxy.LODs[ShadowLOD].FirstIndex;
+    ShadowCommand.RenderFlags    = TRenderFlags().set(ERenderFlags_CastShadow);
+
+    _Queue.Push(std::move(ShadowCommand));
+  }
+
+  _Queue.Push(std::move(Command));
+}
+
+void CModelRenderSystem::OnEntityAdded(ecs::TEntity _Entity)
+{
+  BuildProxies(_Entity);
+}
+
+void CModelRenderSystem::OnEntityDeleted(ecs::TEntity _Entity)
+{
+  RemoveProxies(_Entity);
+}
+
+void CModelRenderSystem::OnComponentChanged(ecs::TEntity _Entity, ecs::TComponentType _ComponentType)
+{
+  if (_ComponentType == m_Coordinator->GetComponentType<TTransformComponent>())
+    UpdateTransform(_Entity);
+  else if (_ComponentType == m_Coordinator->GetComponentType<TModelComponent>())
+    BuildProxies(_Entity);
+}
+
+void CModelRenderSystem::BuildProxies(ecs::TEntity _Entity)
 {
   constexpr auto GetTextureID = [](const TModelComponent::TTexture &_Texture) -> uint32_t {
     return _Texture.Texture ? _Texture.Texture->ID() : CTexture::INVALID_TEXTURE;
@@ -18,51 +159,110 @@ void CModelRenderSystem::Collect(CRenderQueue &_Queue)
 
   constexpr ERenderFlags AlphaFlag[] = {ERenderFlags_Opaque, ERenderFlags_Transparent};
 
-  for (ecs::TEntity Entity : m_Entities)
+  const TModelComponent     &ModelComponent     = m_Coordinator->GetComponent<TModelComponent>(_Entity);
+  const TTransformComponent &TransformComponent = m_Coordinator->GetComponent<TTransformComponent>(_Entity);
+
+  auto It = m_EntityProxies.find(_Entity);
+  if (It != m_EntityProxies.end() && It->second.size() != ModelComponent.Primitives.size())
+  {
+    RemoveProxies(_Entity);
+    It = m_EntityProxies.end();
+  }
+
+  if (It == m_EntityProxies.end())
+  {
+    It = m_EntityProxies.emplace(_Entity, std::vector<uint32_t>(ModelComponent.Primitives.size())).first;
+
+    for (uint32_t Slot = 0; Slot < It->second.size(); ++Slot)
+    {
+      It->second[Slot] = static_cast<uint32_t>(m_Proxies.size());
+
+      TRenderProxy &Proxy = m_Proxies.emplace_back();
+      Proxy.Entity        = _Entity;
+      Proxy.Slot          = Slot;
+    }
+  }
+
+  for (size_t Index = 0; Index < ModelComponent.Primitives.size(); ++Index)
+  {
+    const TModelComponent::TPrimitiveData &Primitive = ModelComponent.Primitives[Index];
+    const TModelComponent::TMaterialData  &Material  = ModelComponent.Materials[Primitive.MaterialIndex];
+
+    TRenderFlags RenderFlags;
+    RenderFlags.set(ERenderFlags_ReceiveShadow);
+    RenderFlags.set(AlphaFlag[Material.AlphaMode == EAlphaMode::Blend]);
+
+    TRenderProxy &Proxy = m_Proxies[It->second[Index]];
+
+    Proxy.Command = TRenderCommand{
+        .Material =
+            TMaterial{
+                .Index                    = Material.Handle->GetIndex(),
+                .BaseColorTexture         = GetTextureID(Material.BaseColorTexture),
+                .NormalTexture            = GetTextureID(Material.NormalTexture),
+                .MetallicRoughnessTexture = GetTextureID(Material.MetallicRoughnessTexture),
+                .OcclusionTexture         = GetTextureID(Material.OcclusionTexture),
+                .EmissiveTexture          = GetTextureID(Material.EmissiveTexture),
+                .AlphaMode                = Material.AlphaMode,
+                .IsDoubleSided            = Material.IsDoubleSided,
+            },
+        .VAO           = Primitive.Geometry->GetVAO(),
+        .ModelMatrix   = TransformComponent.WorldMatrix * Primitive.PrimitiveMatrix,
+        .Bounds        = Primitive.Bounds.Transform(TransformComponent.WorldMatrix),
+        .Occluder      = Primitive.Occluder.get(),
+        .IndicesCount  = Primitive.IndicesCount,
+        .FirstIndex    = Primitive.Geometry->GetFirstIndex(),
+        .BaseVertex    = static_cast<int32_t>(Primitive.Geometry->GetBaseVertex()),
+        .IndexType     = EIndexType::UnsignedInt,
+        .PrimitiveMode = Primitive.Mode,
+        .RenderFlags   = std::move(RenderFlags),
+    };
+
+    Proxy.LODs            = Primitive.LODs;
+    Proxy.LocalBounds     = Primitive.Bounds;
+    Proxy.PrimitiveMatrix = Primitive.PrimitiveMatrix;
+    Proxy.FirstIndex      = Primitive.Geometry->GetFirstIndex();
+  }
+}
+
+void CModelRenderSystem::RemoveProxies(ecs::TEntity _Entity)
+{
+  auto It = m_EntityProxies.find(_Entity);
+  if (It == m_EntityProxies.end())
+    return;
+
+  // From the back, so the last proxy is never one of those still to be removed
+  std::vector<uint32_t> Indices = std::move(It->second);
+  std::ranges::sort(Indices, std::greater());
+  m_EntityProxies.erase(It);
+
+  for (uint32_t Index : Indices)
   {
-    TModelComponent &ModelComponent = m_Coordinator->GetComponent<TModelComponent>(Entity);
-    for (TModelComponent::TPrimitiveData &Primitive : ModelComponent.Primitives)
+    if (Index != m_Proxies.size() - 1)
     {
-      TTransformComponent            &TransformComponent = m_Coordinator->GetComponent<TTransformComponent>(Entity);
-      TModelComponent::TMaterialData &Material           = ModelComponent.Materials[Primitive.MaterialIndex];
-
-      TRenderFlags RenderFlags;
-      RenderFlags.set(ERenderFlags_CastShadow);
-      RenderFlags.set(ERenderFlags_ReceiveShadow);
-      RenderFlags.set(AlphaFlag[Material.AlphaMode == EAlphaMode::Blend]);
-
-      TRenderCommand Command{
-          .Material =
-              TMaterial{
-                  .BaseColorTexture                      = GetTextureID(Material.BaseColorTexture),
-                  .BaseColorTextureTexCoordIndex         = Material.BaseColorTexture.TexCoordIndex,
-                  .NormalTexture                         = GetTextureID(Material.NormalTexture),
-                  .NormalTextureTexCoordIndex            = Material.NormalTexture.TexCoordIndex,
-                  .MetallicRoughnessTexture              = GetTextureID(Material.MetallicRoughnessTexture),
-                  .MetallicRoughnessTextureTexCoordIndex = Material.MetallicRoughnessTexture.TexCoordIndex,
-                  .OcclusionTexture                      = GetTextureID(Material.OcclusionTexture),
-                  .OcclusionTextureTexCoordIndex         = Material.OcclusionTexture.TexCoordIndex,
-                  .EmissiveTexture                       = GetTextureID(Material.EmissiveTexture),
-                  .EmissiveTextureTexCoordIndex          = Material.EmissiveTexture.TexCoordIndex,
-                  .BaseColorFactor                       = Material.BaseColorFactor,
-                  .EmissiveFactor                        = Material.EmissiveFactor,
-                  .MetallicFactor                        = Material.MetallicFactor,
-                  .RoughnessFactor                       = Material.RoughnessFactor,
-                  .OcclusionStrength                     = Material.OcclusionStrength,
-                  .AlphaCutoff                           = Material.AlphaCutoff,
-                  .AlphaMode                             = Material.AlphaMode,
-                  .IsDoubleSided                         = Material.IsDoubleSided,
-              },
-          .VAO           = Primitive.VAO,
-          .ModelMatrix   = TransformComponent.WorldMatrix * Primitive.PrimitiveMatrix,
-          .IndicesCount  = Primitive.IndicesCount,
-          .IndexType     = Primitive.Type,
-          .PrimitiveMode = Primitive.Mode,
-          .RenderFlags   = std::move(RenderFlags),
-      };
-
-      _Queue.Push(std::move(Command));
+      TRenderProxy &Proxy = m_Proxies[Index];
+      Proxy               = std::move(m_Proxies.back());
+
+      m_EntityProxies[Proxy.Entity][Proxy.Slot] = Index;
     }
+
+    m_Proxies.pop_back();
+  }
+}
+
+void CModelRenderSystem::UpdateTransform(ecs::TEntity _Entity)
+{
+  auto It = m_EntityProxies.find(_Entity);
+  if (It == m_EntityProxies.end())
+    return;
+
+  const glm::mat4 &WorldMatrix = m_Coordinator->GetComponent<TTransformComponent>(_Entity).WorldMatrix;
+
+  for (uint32_t Index : It->second)
+  {
+    TRenderProxy &Proxy       = m_Proxies[Index];
+    Proxy.Command.ModelMatrix = WorldMatrix * Proxy.PrimitiveMatrix;
+    Proxy.Command.Bounds      = Proxy.LocalBounds.Transform(WorldMatrix);
   }
 }
 
@@ -1,16 +1,73 @@
 #pragma once
 
 #include "interfaces/RenderCollector.h"
+#include "ecs/Components.h"
+#include "render/RenderCommand.h"
 #include <ecs/System.h>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
 
 namespace ecs
 {
 
+// Keeps a render proxy with a ready command for every primitive of the model entities. Proxies
+// follow the ECS observers: built when an entity shows up, patched when its transform or model
+// changes and dropped with it, so a frame only picks the LODs and copies the commands out. With
+// the retained list disabled in the config every proxy is rebuilt each frame. Proxies are removed
+// by moving the last one into the hole, so a removal costs as much as the primitives it drops.
 class CModelRenderSystem : public IRenderCollector,
                            public CSystem
 {
 public:
   void Collect(CRenderQueue &_Queue) override;
+
+  // Collection split in ranges of proxies for the job system: BeginCollect once on the owning
+  // thread, then the ranges may be collected concurrently as long as they don't overlap.
+  // With _VisibleEntities only the proxies of those entities are collected, found through the
+  // entity lookup, so the cost follows what's visible rather than the scene size.
+  void BeginCollect(std::optional<std::span<const ecs::TEntity>> _VisibleEntities = std::nullopt);
+  void Collect(CRenderQueue &_Queue, size_t _FirstProxy, size_t _ProxiesCount);
+  size_t GetProxiesCount() const; // To collect this frame, set by BeginCollect
+
+protected:
+  void OnEntityAdded(ecs::TEntity _Entity) override;
+  void OnEntityDeleted(ecs::TEntity _Entity) override;
+  void OnComponentChanged(ecs::TEntity _Entity, ecs::TComponentType _ComponentType) override;
+
+private:
+  struct TRenderProxy
+  {
+    TRenderCommand                     Command; // The LOD range and the shadow flag are set every frame
+    std::vector<TModelComponent::TLOD> LODs;
+    TAABB                              LocalBounds; // In the entity space, PrimitiveMatrix applied
+    glm::mat4                          PrimitiveMatrix = glm::mat4(1.0f);
+    uint32_t                           FirstIndex      = 0; // Of the geometry
+    uint32_t                           CurrentLOD      = 0; // Picked last frame, for the hysteresis
+    ecs::TEntity                       Entity          = 0;
+    uint32_t                           Slot            = 0; // In the proxies list of the entity
+  };
+
+  struct TCollectParams
+  {
+    bool      IsLODEnabled    = false;
+    uint32_t  ShadowLODBias   = 0;
+    glm::vec3 CameraPosition  = glm::vec3(0.0f);
+    float     ProjectionScale = 1.0f;
+    bool      IsCulled        = false; // Only m_VisibleProxies are collected
+  };
+
+  void BuildProxies(ecs::TEntity _Entity); // Keeps the picked LODs if the primitives stay the same
+  void RemoveProxies(ecs::TEntity _Entity);
+  void UpdateTransform(ecs::TEntity _Entity);
+  void CollectProxy(TRenderProxy &_Proxy, CRenderQueue &_Queue);
+
+private:
+  std::vector<TRenderProxy>                               m_Proxies;
+  std::unordered_map<ecs::TEntity, std::vector<uint32_t>> m_EntityProxies; // Indices into m_Proxies, in the primitives order
+  std::vector<uint32_t>                                   m_VisibleProxies; // Indices into m_Proxies, of the current frame
+  TCollectParams                                          m_CollectParams;  // Of the current frame
 };
 
-} // namespace ecs
\ No newline at end of file
+} // namespace ecs
@@ -0,0 +1,74 @@
+#include "pch.h"
+
+#include "SpatialSystem.h"
+#include "ecs/Components.h"
+#include "ecs/Coordinator.h"
+#include "engine/Config.h"
+#include "render/RenderCommand.h"
+#include "render/RenderQueue.h"
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace ecs
+{
+
+void CSpatialSystem::Collect(CRenderQueue &_Queue)
+{
+  if (!CConfig::Instance().GetSpatialTreeOverlayEnabled())
+    return;
+
+  m_Tree.ForEachNode([&_Queue](const TAABB &_Box, bool) {
+    glm::mat4 BoxMatrix = glm::translate(glm::mat4(1.0f), _Box.Center());
+    BoxMatrix           = glm::scale(BoxMatrix, _Box.Size());
+
+    TRenderFlags RenderFlags;
+    RenderFlags.set(ERenderFlags_Wireframe);
+
+    TRenderCommand Command{
+        .ModelMatrix = BoxMatrix,
+        .RenderFlags = std::move(RenderFlags),
+    };
+
+    _Queue.Push(std::move(Command));
+  });
+}
+
+const CAABBTree &CSpatialSystem::GetTree() const
+{
+  return m_Tree;
+}
+
+void CSpatialSystem::OnEntityAdded(ecs::TEntity _Entity)
+{
+  TAABB Box = GetWorldBox(_Entity);
+  if (!Box.IsValid()) // Entities without geometry are kept as points, they may get a box later
+    Box.Expand(glm::vec3(m_Coordinator->GetComponent<TTransformComponent>(_Entity).WorldMatrix[3]));
+
+  m_Proxies.emplace(_Entity, m_Tree.Insert(Box, _Entity));
+}
+
+void CSpatialSystem::OnEntityDeleted(ecs::TEntity _Entity)
+{
+  auto It = m_Proxies.find(_Entity);
+  if (It == m_Proxies.end())
+    return;
+
+  m_Tree.Remove(It->second);
+  m_Proxies.erase(It);
+}
+
+void CSpatialSystem::OnComponentChanged(ecs::TEntity _Entity, ecs::TComponentType)
+{
+  const TAABB Box = GetWorldBox(_Entity);
+  if (Box.IsValid())
+    m_Tree.Move(m_Proxies.at(_Entity), Box);
+}
+
+TAABB CSpatialSystem::GetWorldBox(ecs::TEntity _Entity) const
+{
+  const TTransformComponent &TransformComponent = m_Coordinator->GetComponent<TTransformComponent>(_Entity);
+  const TCollisionComponent &CollisionComponent = m_Coordinator->GetComponent<TCollisionComponent>(_Entity);
+
+  return CollisionComponent.BoundingBox.Transform(TransformComponent.WorldMatrix);
+}
+
+} // namespace ecs
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "interfaces/RenderCollector.h"
+#include "physics/AABBTree.h"
+#include <ecs/System.h>
+#include <unordered_map>
+
+namespace ecs
+{
+
+// Keeps the world space collision boxes of the entities in a dynamic tree for spatial queries.
+// Boxes move when the transform or the collision component reports a change; the fattened leaves
+// make small moves cheap.
+class CSpatialSystem : public IRenderCollector,
+                       public CSystem
+{
+public:
+  void Collect(CRenderQueue &_Queue) override; // The tree nodes, if the overlay is enabled
+
+  const CAABBTree &GetTree() const; // User data of the leaves is the entity
+
+protected:
+  void OnEntityAdded(ecs::TEntity _Entity) override;
+  void OnEntityDeleted(ecs::TEntity _Entity) override;
+  void OnComponentChanged(ecs::TEntity _Entity, ecs::TComponentType _ComponentType) override;
+
+private:
+  TAABB GetWorldBox(ecs::TEntity _Entity) const;
+
+private:
+  CAABBTree                                           m_Tree;
+  std::unordered_map<ecs::TEntity, CAABBTree::TProxy> m_Proxies;
+};
+
+} // namespace ecs
@@ -104,7 +104,8 @@ void CEditorUI::RenderFrame()
   m_GlobalParamsWindow->Render();
   m_PerformanceWindow->Render();
   m_OverviewWindow->Render();
-  m_ViewportWindow->Render(m_EntitiesWindow->GetSelectedEntity());
+  if (const std::optional<ecs::TEntity> PickedEntity = m_ViewportWindow->Render(m_EntitiesWindow->GetSelectedEntity()))
+    m_EntitiesWindow->SelectEntity(PickedEntity.value());
 
   RenderEnd();
 }
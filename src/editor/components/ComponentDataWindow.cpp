@@ -33,8 +33,8 @@ void CComponentDataWindow::Render(const std::optional<ecs::TEntity> &_SelectedEn
       const CUnorderedVector<ecs::TComponentView> Components = m_WorldEditor.GetEntityComponents(_SelectedEntity.value());
       for (const ecs::TComponentView &ComponentView : Components)
       {
-        if (ImGui::CollapsingHeader(ComponentView.Name.c_str()))
-          m_ComponentRenderer.Render(ComponentView);
+        if (ImGui::CollapsingHeader(ComponentView.Name.c_str()) && m_ComponentRenderer.Render(ComponentView))
+          m_WorldEditor.NotifyComponentChanged(_SelectedEntity.value(), ComponentView.TypeID);
       }
     }
 
@@ -33,6 +33,9 @@ public:
 
   const std::optional<ecs::TEntity> &GetSelectedEntity() const;
 
+  void SelectEntity(ecs::TEntity _Entity);
+  void DeselectEntity();
+
 private:
   void SpawnEntity(ecs::TEntityType _Type);
   int GetSelectedEntityIndex(const CUnorderedVector<ecs::TEntity> &_Entities) const;
@@ -40,9 +43,6 @@ private:
   void DisplaySpawnPopup();
   void DisplayEntitiesList();
 
-  void SelectEntity(ecs::TEntity _Entity);
-  void DeselectEntity();
-
   std::string GetEntityName(ecs::TEntity _Entity) const;
 
 private:
@@ -3,6 +3,7 @@
 #include "interfaces/WorldEditor.h"
 #include "engine/Camera.h"
 #include "engine/Engine.h"
+#include <ecs/Utils.h>
 #include <imgui/imgui.h>
 #include <imgui/ImGuizmo/ImGuizmo.h>
 
@@ -41,7 +42,10 @@ void CGizmoRenderer::Render(ecs::TEntity _Entity, TRectf _ViewportRect)
   const auto               Operation = static_cast<ImGuizmo::OPERATION>(m_Operations[m_CurrentOperation]);
 
   if (ImGuizmo::Manipulate(glm::value_ptr(View), glm::value_ptr(Proj), Operation, ImGuizmo::LOCAL, glm::value_ptr(Model)))
+  {
     Transform->WorldMatrix = Model;
+    m_WorldEditor.NotifyComponentChanged(_Entity, ecs::utils::GetComponentTypeID<ecs::TTransformComponent>());
+  }
 }
 
 } // namespace editor
\ No newline at end of file
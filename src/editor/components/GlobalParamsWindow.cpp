@@ -59,6 +59,38 @@ void CGlobalParamsWindow::Render()
       int BloomBlurPasses = CConfig::Instance().GetBloomBlurPasses();
       if (ImGui::DragInt("Bloom blur passes", &BloomBlurPasses, 1, 0, 100))
         CConfig::Instance().SetBloomBlurPasses(BloomBlurPasses);
+
+      ImGui::Separator();
+
+      bool OcclusionCullingEnabled = CConfig::Instance().GetOcclusionCullingEnabled();
+      if (ImGui::Checkbox("Occlusion culling", &OcclusionCullingEnabled))
+        CConfig::Instance().SetOcclusionCullingEnabled(OcclusionCullingEnabled);
+
+      bool GPUOcclusionCullingEnabled = CConfig::Instance().GetGPUOcclusionCullingEnabled();
+      if (ImGui::Checkbox("GPU occlusion culling", &GPUOcclusionCullingEnabled))
+        CConfig::Instance().SetGPUOcclusionCullingEnabled(GPUOcclusionCullingEnabled);
+
+      ImGui::Separator();
+
+      bool RetainedRenderListEnabled = CConfig::Instance().GetRetainedRenderListEnabled();
+      if (ImGui::Checkbox("Retained render list", &RetainedRenderListEnabled))
+        CConfig::Instance().SetRetainedRenderListEnabled(RetainedRenderListEnabled);
+
+      bool ParallelCollectEnabled = CConfig::Instance().GetParallelCollectEnabled();
+      if (ImGui::Checkbox("Parallel command collection", &ParallelCollectEnabled))
+        CConfig::Instance().SetParallelCollectEnabled(ParallelCollectEnabled);
+
+      bool SpatialCullingEnabled = CConfig::Instance().GetSpatialCullingEnabled();
+      if (ImGui::Checkbox("Spatial tree culling", &SpatialCullingEnabled))
+        CConfig::Instance().SetSpatialCullingEnabled(SpatialCullingEnabled);
+
+      bool LODEnabled = CConfig::Instance().GetLODEnabled();
+      if (ImGui::Checkbox("LODs", &LODEnabled))
+        CConfig::Instance().SetLODEnabled(LODEnabled);
+
+      int ShadowLODBias = CConfig::Instance().GetShadowLODBias();
+      if (ImGui::DragInt("Shadow LOD bias", &ShadowLODBias, 1, 0, 3))
+        CConfig::Instance().SetShadowLODBias(ShadowLODBias);
     }
 
     if (ImGui::CollapsingHeader("Anti Aliasing"))
@@ -150,6 +182,11 @@ void CGlobalParamsWindow::Render()
       float  WireframeColorArr[4] = {WireframeColor.R, WireframeColor.G, WireframeColor.B, WireframeColor.A};
       if (ImGui::ColorEdit4("Wireframe color", WireframeColorArr, ImGuiColorEditFlags_Float | ImGuiColorEditFlags_NoInputs))
         CConfig::Instance().SetWireframeColor(TColor(WireframeColorArr[0], WireframeColorArr[1], WireframeColorArr[2], WireframeColorArr[3]));
+
+      // Drawn by the wireframe pass
+      bool SpatialTreeOverlayEnabled = CConfig::Instance().GetSpatialTreeOverlayEnabled();
+      if (ImGui::Checkbox("Draw spatial tree", &SpatialTreeOverlayEnabled))
+        CConfig::Instance().SetSpatialTreeOverlayEnabled(SpatialTreeOverlayEnabled);
     }
 
     if (ImGui::CollapsingHeader("Camera"))
@@ -70,6 +70,9 @@ void COverviewWindow::Render()
         ImGui::Text("Triangles: %s", FormatCount(Pipeline->GetTrianglesCount()).c_str());
         ImGui::Text("Lines: %s", FormatCount(Pipeline->GetLinesCount()).c_str());
         ImGui::Text("Points: %s", FormatCount(Pipeline->GetPointsCount()).c_str());
+        ImGui::Text("Culled objects: %s", FormatCount(Pipeline->GetCulledObjectsCount()).c_str());
+        ImGui::Text("Culled shadow casters: %s", FormatCount(Pipeline->GetCulledShadowCastersCount()).c_str());
+        ImGui::Text("Occluded objects: %s", FormatCount(Pipeline->GetOccludedObjectsCount()).c_str());
 
         if (ImGui::CollapsingHeader("Shadow map"))
         {
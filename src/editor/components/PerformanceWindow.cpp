@@ -3,8 +3,11 @@
 #include "PerformanceWindow.h"
 #include "engine/Engine.h"
 #include "interfaces/RenderPipeline.h"
+#include "render/RenderStats.h"
 #include "render/passes/RenderPassTypes.h"
+#include "utils/Memory.h"
 #include <imgui/imgui.h>
+#include <imgui/misc/cpp/imgui_stdlib.h>
 #include <imgui/implot/implot.h>
 #include <algorithm>
 #include <numeric>
@@ -53,9 +56,14 @@ void CPerformanceWindow::Render()
 
   UpdateFPSHistory();
   UpdateRenderPassHistory();
+  m_HitchDetector.OnFrame(*CEngine::Instance().GetRenderPipeline(), CEngine::Instance().GetFrameTime());
 
   RenderFPSSection();
   RenderPassesSection();
+  RenderStateChangesSection();
+  RenderHitchesSection();
+  RenderMemorySection();
+  RenderRecordingSection();
 
   ImGui::End();
 }
@@ -110,10 +118,12 @@ void CPerformanceWindow::RenderFPSSection()
 
   if (ImGui::CollapsingHeader("Details##FPSDetails"))
   {
-    ImGui::Columns(2, "PerformanceStats");
+    ImGui::Columns(3, "PerformanceStats");
     ImGui::Text("FPS");
     ImGui::NextColumn();
     ImGui::Text("Tick (ms)");
+    ImGui::NextColumn();
+    ImGui::Text("Percentiles (ms)");
     ImGui::Separator();
     ImGui::NextColumn();
     ImGui::Text("Min: %.1f", m_FPSHistory.Min);
@@ -123,6 +133,11 @@ void CPerformanceWindow::RenderFPSSection()
     ImGui::Text("Min: %.2f", m_FrameTimeHistory.Min);
     ImGui::Text("Max: %.2f", m_FrameTimeHistory.Max);
     ImGui::Text("Avg: %.2f", m_FrameTimeHistory.Avg);
+    ImGui::NextColumn();
+    ImGui::Text("P50: %.2f", m_HitchDetector.GetPercentile(50.0f));
+    ImGui::Text("P90: %.2f", m_HitchDetector.GetPercentile(90.0f));
+    ImGui::Text("P99: %.2f", m_HitchDetector.GetPercentile(99.0f));
+    ImGui::Text("P99.9: %.2f", m_HitchDetector.GetPercentile(99.9f));
     ImGui::Columns(1);
   }
 
@@ -210,6 +225,166 @@ void CPerformanceWindow::RenderPassesStatistics(const RenderPassesList &_RenderP
   ImGui::Columns(1);
 }
 
+void CPerformanceWindow::RenderStateChangesSection()
+{
+  if (!ImGui::CollapsingHeader("State Changes"))
+    return;
+
+  const auto RenderPipeline = CEngine::Instance().GetRenderPipeline();
+
+  constexpr const char *Headers[] = {"Pass", "Draws", "Shaders", "Textures", "VAOs", "Uniforms", "FBOs", "Blend", "Cull", "Depth"};
+
+  const auto RenderRow = [](std::string_view _Name, uint32_t _DrawCalls, const TRenderStateChanges &_Changes) {
+    ImGui::Text("%s", _Name.data());
+    ImGui::NextColumn();
+
+    for (uint32_t Value : {_DrawCalls, _Changes.ShaderSwitches, _Changes.TextureBinds, _Changes.VAOBinds, _Changes.UniformUploads, _Changes.FBOBinds,
+                           _Changes.BlendChanges, _Changes.CullChanges, _Changes.DepthChanges})
+    {
+      ImGui::Text("%u", Value);
+      ImGui::NextColumn();
+    }
+  };
+
+  ImGui::Columns(std::size(Headers), "StateChanges");
+
+  for (const char *Header : Headers)
+  {
+    ImGui::Text("%s", Header);
+    ImGui::NextColumn();
+  }
+  ImGui::Separator();
+
+  for (const auto &[Type, Name] : GetRenderPasses())
+  {
+    const TRenderPassStats Stats = RenderPipeline->GetRenderPassStats(Type);
+    RenderRow(Name, Stats.DrawCalls, Stats.StateChanges);
+  }
+
+  ImGui::Separator();
+  RenderRow("Frame", RenderPipeline->GetDrawCallsCount(), RenderPipeline->GetStateChanges());
+
+  ImGui::Columns(1);
+
+  if (ImGui::CollapsingHeader("Texture Units##StateChangesTextureUnits"))
+  {
+    const TTextureUnitBinds &TextureUnitBinds = RenderPipeline->GetTextureUnitBinds();
+    for (size_t i = 0; i < TextureUnitBinds.size(); ++i)
+    {
+      if (TextureUnitBinds[i] != 0)
+        ImGui::Text("Unit %2zu: %u", i, TextureUnitBinds[i]);
+    }
+  }
+}
+
+void CPerformanceWindow::RenderHitchesSection()
+{
+  if (!ImGui::CollapsingHeader("Hitches"))
+    return;
+
+  float Threshold = m_HitchDetector.GetThreshold();
+  if (ImGui::SliderFloat("Threshold (x median)##HitchThreshold", &Threshold, 1.5f, 10.0f, "%.1f"))
+    m_HitchDetector.SetThreshold(Threshold);
+
+  ImGui::Text("Hitches: %u. Median: %.2f ms", m_HitchDetector.GetHitchesCount(), m_HitchDetector.GetPercentile(50.0f));
+
+  for (const THitchTrace &Trace : m_HitchDetector.GetTraces())
+  {
+    const auto HitchFrame = std::find_if(Trace.Frames.begin(), Trace.Frames.end(), [&Trace](const TFrameStatsRecord &_Record) {
+      return _Record.FrameIndex == Trace.FrameIndex;
+    });
+
+    if (HitchFrame != Trace.Frames.end())
+      ImGui::BulletText("Frame %u: %.2f ms (median %.2f ms)", Trace.FrameIndex, HitchFrame->FrameTime, Trace.Median);
+  }
+
+  ImGui::InputText("File##HitchDumpPath", &m_HitchDumpPath);
+  if (ImGui::Button("Dump##HitchTraces") && !m_HitchDumpPath.empty())
+    m_HitchDetector.Dump(m_HitchDumpPath);
+
+  ImGui::SameLine();
+  if (ImGui::Button("Clear##HitchTraces"))
+    m_HitchDetector.Reset();
+}
+
+void CPerformanceWindow::RenderMemorySection()
+{
+  if (!ImGui::CollapsingHeader("Memory"))
+    return;
+
+  constexpr float MB = 1024.0f * 1024.0f;
+
+  const auto RenderTable = [MB]<typename TagType>(const char *_Category, TMemoryCounter (*_GetMemory)(TagType)) {
+    ImGui::Columns(3, _Category);
+    ImGui::Text("%s", _Category);
+    ImGui::NextColumn();
+    ImGui::Text("Live (MB)");
+    ImGui::NextColumn();
+    ImGui::Text("Peak (MB)");
+    ImGui::NextColumn();
+    ImGui::Separator();
+
+    uint64_t TotalLive = 0;
+    for (size_t i = 0; i < static_cast<size_t>(TagType::Count); ++i)
+    {
+      const TagType        Tag     = static_cast<TagType>(i);
+      const TMemoryCounter Counter = _GetMemory(Tag);
+      TotalLive += Counter.Live;
+
+      ImGui::Text("%s", utils::GetMemoryTagName(Tag).data());
+      ImGui::NextColumn();
+      ImGui::Text("%.2f", Counter.Live / MB);
+      ImGui::NextColumn();
+      ImGui::Text("%.2f", Counter.Peak / MB);
+      ImGui::NextColumn();
+    }
+
+    ImGui::Separator();
+    ImGui::Text("Total");
+    ImGui::NextColumn();
+    ImGui::Text("%.2f", TotalLive / MB);
+    ImGui::NextColumn();
+    ImGui::NextColumn();
+    ImGui::Columns(1);
+  };
+
+  if (utils::IsMemoryTrackingEnabled())
+    RenderTable("CPU", &utils::GetCPUMemory);
+  else
+    ImGui::TextDisabled("CPU allocations aren't tracked, build with MEMORY_TRACKING");
+
+  RenderTable("GPU (estimated)", &utils::GetGPUMemory);
+
+  ImGui::Text("Resident: %.2f MB. Peak: %.2f MB", utils::GetMemoryUsage() / MB, utils::GetPeakMemoryUsage() / MB);
+
+  const CEngine &Engine = CEngine::Instance();
+  ImGui::Text("Frame arena: %.1f KB", Engine.GetFrameArena().GetUsedSize() / 1024.0);
+  if (utils::IsMemoryTrackingEnabled())
+    ImGui::Text("Heap allocations this frame: %u", Engine.GetFrameHeapAllocations());
+}
+
+void CPerformanceWindow::RenderRecordingSection()
+{
+  if (m_StatsRecorder.IsRecording())
+    m_StatsRecorder.Record(*CEngine::Instance().GetRenderPipeline(), CEngine::Instance().GetFrameTime());
+
+  if (!ImGui::CollapsingHeader("Recording"))
+    return;
+
+  if (m_StatsRecorder.IsRecording())
+  {
+    ImGui::Text("Recording to %s: %u frames", m_StatsRecorder.GetPath().string().c_str(), m_StatsRecorder.GetRecordsCount());
+    if (ImGui::Button("Stop##StatsRecording"))
+      m_StatsRecorder.Stop();
+  }
+  else
+  {
+    ImGui::InputText("File##StatsRecordPath", &m_StatsRecordPath);
+    if (ImGui::Button("Start##StatsRecording") && !m_StatsRecordPath.empty())
+      m_StatsRecorder.Start(m_StatsRecordPath);
+  }
+}
+
 void CPerformanceWindow::UpdateFPSHistory()
 {
   constexpr auto Comparator = [](const TVector2f &a, const TVector2f &b) {
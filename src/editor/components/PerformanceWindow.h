@@ -3,6 +3,8 @@
 #if DEV_STAGE
 
 #include "EditorWindow.h"
+#include "engine/HitchDetector.h"
+#include "engine/StatsRecorder.h"
 #include <deque>
 #include <vector>
 #include <array>
@@ -38,6 +40,10 @@ private:
   void RenderPassesSection();
   void RenderPassesPlot(const RenderPassesList &_RenderPasses);
   void RenderPassesStatistics(const RenderPassesList &_RenderPasses);
+  void RenderStateChangesSection();
+  void RenderHitchesSection();
+  void RenderMemorySection();
+  void RenderRecordingSection();
 
   static const RenderPassesList &GetRenderPasses();
 
@@ -54,6 +60,12 @@ private:
 
   std::array<THistoryBuffer, RENDER_PASS_COUNT> m_RenderPassStats;
   float                                         m_MaxRenderPassTime = 0;
+
+  CStatsRecorder m_StatsRecorder;
+  std::string    m_StatsRecordPath = "stats.bin";
+
+  CHitchDetector m_HitchDetector;
+  std::string    m_HitchDumpPath = "hitches.json";
 };
 
 } // namespace editor
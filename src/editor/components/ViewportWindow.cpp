@@ -2,6 +2,7 @@
 
 #include "ViewportWindow.h"
 #include "GizmoRenderer.h"
+#include "engine/Camera.h"
 #include "engine/Engine.h"
 #include "engine/Config.h"
 #include "interfaces/RenderPipeline.h"
@@ -9,6 +10,7 @@
 #include "utils/Event.h"
 #include <common/MathTypes.h>
 #include <imgui/imgui.h>
+#include <imgui/ImGuizmo/ImGuizmo.h>
 
 namespace editor
 {
@@ -29,8 +31,10 @@ TVector2i CViewportWindow::GetSize() const
   return m_Size;
 }
 
-void CViewportWindow::Render(const std::optional<ecs::TEntity> &_SelectedEntity)
+std::optional<ecs::TEntity> CViewportWindow::Render(const std::optional<ecs::TEntity> &_SelectedEntity)
 {
+  std::optional<ecs::TEntity> PickedEntity;
+
   if (ImGui::Begin(GetName().c_str(), nullptr, ImGuiWindowFlags_NoCollapse))
   {
     const bool      IsGizmoEnabled = CConfig::Instance().GetGizmoEnabled();
@@ -45,19 +49,54 @@ void CViewportWindow::Render(const std::optional<ecs::TEntity> &_SelectedEntity)
       event::Notify(TEventType::ViewportResized, NewSize);
     }
 
+    const TRectf ViewportRect(Pos.x, Pos.y, Available.x, Available.y);
+
     if (TextureID != 0 && Available.x > 0.0f && Available.y > 0.0f)
+    {
       ImGui::Image(static_cast<ImTextureID>(static_cast<uintptr_t>(TextureID)), Available, ImVec2(0, 1), ImVec2(1, 0));
+
+      // A click on the gizmo drives the gizmo instead
+      const bool IsOverGizmo = IsGizmoEnabled && _SelectedEntity.has_value() && ImGuizmo::IsOver();
+      if (ImGui::IsItemClicked(ImGuiMouseButton_Left) && !IsOverGizmo)
+        PickedEntity = PickEntity(ViewportRect);
+    }
     else
+    {
       ImGui::TextUnformatted("Render texture unavailable");
+    }
 
     if (IsGizmoEnabled && _SelectedEntity.has_value())
     {
       ImGui::SetCursorScreenPos(Pos);
-      m_GizmoRenderer.Render(_SelectedEntity.value(), TRectf(Pos.x, Pos.y, Available.x, Available.y));
+      m_GizmoRenderer.Render(_SelectedEntity.value(), ViewportRect);
     }
   }
 
   ImGui::End();
+
+  return PickedEntity;
+}
+
+std::optional<ecs::TEntity> CViewportWindow::PickEntity(TRectf _ViewportRect) const
+{
+  const std::shared_ptr<CCamera> Camera = CEngine::Instance().GetCamera();
+  if (!Camera)
+    return std::nullopt;
+
+  const ImVec2    Mouse = ImGui::GetMousePos();
+  const glm::vec2 NDC   = glm::vec2((Mouse.x - _ViewportRect.Position.X) / _ViewportRect.Size.X * 2.0f - 1.0f,
+                                    1.0f - (Mouse.y - _ViewportRect.Position.Y) / _ViewportRect.Size.Y * 2.0f);
+
+  // The ray runs from the near plane to the far one under the mouse
+  const glm::mat4 InverseViewProjection = glm::inverse(Camera->GetPerspectiveProjection() * Camera->GetView());
+
+  glm::vec4 Near = InverseViewProjection * glm::vec4(NDC, -1.0f, 1.0f);
+  glm::vec4 Far  = InverseViewProjection * glm::vec4(NDC, 1.0f, 1.0f);
+  Near          /= Near.w;
+  Far           /= Far.w;
+
+  const glm::vec3 Ray = glm::vec3(Far - Near);
+  return m_WorldEditor.PickEntity(glm::vec3(Near), Ray, glm::length(Ray));
 }
 
 } // namespace editor
@@ -19,9 +19,12 @@ public:
   std::string GetName() const override;
   TVector2i GetSize() const override;
 
-  void Render(const std::optional<ecs::TEntity> &_SelectedEntity);
+  // Returns the entity clicked in the viewport, if any
+  std::optional<ecs::TEntity> Render(const std::optional<ecs::TEntity> &_SelectedEntity);
 
 private:
+  std::optional<ecs::TEntity> PickEntity(TRectf _ViewportRect) const; // Under the mouse
+
   IWorldEditor  &m_WorldEditor;
   CGizmoRenderer m_GizmoRenderer;
   TVector2i      m_Size;
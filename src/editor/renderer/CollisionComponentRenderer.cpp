@@ -12,13 +12,15 @@ ecs::TTypeID TCollisionComponentRenderer::GetComponentTypeID() noexcept
   return ecs::utils::GetComponentTypeID<ecs::TCollisionComponent>();
 }
 
-void TCollisionComponentRenderer::Render(void *Data) noexcept
+bool TCollisionComponentRenderer::Render(void *Data) noexcept
 {
   auto *Component = static_cast<ecs::TCollisionComponent *>(Data);
 
   ImGui::Text("Bounding box:");
   ImGui::Text("Min: (%.2f, %.2f, %.2f)", Component->BoundingBox.Min.x, Component->BoundingBox.Min.y, Component->BoundingBox.Min.z);
   ImGui::Text("Max: (%.2f, %.2f, %.2f)", Component->BoundingBox.Max.x, Component->BoundingBox.Max.y, Component->BoundingBox.Max.z);
+
+  return false;
 }
 
 } // namespace editor
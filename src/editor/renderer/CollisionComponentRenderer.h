@@ -11,7 +11,7 @@ namespace editor
 struct TCollisionComponentRenderer
 {
   static ecs::TTypeID GetComponentTypeID() noexcept;
-  static void Render(void *Data) noexcept;
+  static bool Render(void *Data) noexcept;
 };
 
 static_assert(ComponentRenderer<TCollisionComponentRenderer>, "TCollisionComponentRenderer must satisfy ComponentRenderer");
@@ -28,11 +28,13 @@ CComponentRenderer::CComponentRenderer()
   RegisterComponentRenderer<TCollisionComponentRenderer>();
 }
 
-void CComponentRenderer::Render(ecs::TComponentView _ComponentView)
+bool CComponentRenderer::Render(ecs::TComponentView _ComponentView)
 {
   auto Iter = m_RenderFunctions.find(_ComponentView.TypeID);
   if (Iter != m_RenderFunctions.end())
-    Iter->second(_ComponentView.Data);
+    return Iter->second(_ComponentView.Data);
+
+  return false;
 }
 
 } // namespace editor
@@ -19,7 +19,7 @@ class CComponentRenderer
 public:
   CComponentRenderer();
 
-  void Render(ecs::TComponentView _ComponentView);
+  bool Render(ecs::TComponentView _ComponentView); // True if the component was edited
 
 private:
   template <ComponentRenderer T>
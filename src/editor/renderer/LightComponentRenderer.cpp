@@ -12,20 +12,22 @@ ecs::TTypeID TLightComponentRenderer::GetComponentTypeID() noexcept
   return ecs::utils::GetComponentTypeID<ecs::TLightComponent>();
 }
 
-void TLightComponentRenderer::Render(void *Data) noexcept
+bool TLightComponentRenderer::Render(void *Data) noexcept
 {
   auto *Component = static_cast<ecs::TLightComponent *>(Data);
 
+  bool ValueChanged = false;
+
   switch (Component->Type)
   {
   case ELightType::Directional: {
-    ImGui::DragFloat3("Direction##LightDir", glm::value_ptr(Component->Direction), 0.1f);
+    ValueChanged |= ImGui::DragFloat3("Direction##LightDir", glm::value_ptr(Component->Direction), 0.1f);
     ImGui::Separator();
 
-    ImGui::ColorEdit3("Color##LightColor", glm::value_ptr(Component->Color),
-                      ImGuiColorEditFlags_InputRGB | ImGuiColorEditFlags_Float | ImGuiColorEditFlags_HDR);
+    ValueChanged |= ImGui::ColorEdit3("Color##LightColor", glm::value_ptr(Component->Color),
+                                      ImGuiColorEditFlags_InputRGB | ImGuiColorEditFlags_Float | ImGuiColorEditFlags_HDR);
     ImGui::Separator();
-    ImGui::DragFloat("Intensity##LightIntensity", &Component->Intensity, 0.1f, 0.0f, 100.0f);
+    ValueChanged |= ImGui::DragFloat("Intensity##LightIntensity", &Component->Intensity, 0.1f, 0.0f, 100.0f);
     break;
   }
 
@@ -33,6 +35,8 @@ void TLightComponentRenderer::Render(void *Data) noexcept
     assert(false);
     break;
   }
+
+  return ValueChanged;
 }
 
 } // namespace editor
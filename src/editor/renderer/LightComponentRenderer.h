@@ -11,7 +11,7 @@ namespace editor
 struct TLightComponentRenderer
 {
   static ecs::TTypeID GetComponentTypeID() noexcept;
-  static void Render(void *Data) noexcept;
+  static bool Render(void *Data) noexcept;
 };
 
 static_assert(ComponentRenderer<TLightComponentRenderer>, "TLightComponentRenderer must satisfy ComponentRenderer");
@@ -23,7 +23,7 @@ ecs::TTypeID TModelComponentRenderer::GetComponentTypeID() noexcept
   return ecs::utils::GetComponentTypeID<ecs::TModelComponent>();
 }
 
-void TModelComponentRenderer::Render(void *Data) noexcept
+bool TModelComponentRenderer::Render(void *Data) noexcept
 {
   auto *Component = static_cast<ecs::TModelComponent *>(Data);
 
@@ -89,6 +89,8 @@ void TModelComponentRenderer::Render(void *Data) noexcept
     }
     ImGui::PopID();
   }
+
+  return false;
 }
 
 } // namespace editor
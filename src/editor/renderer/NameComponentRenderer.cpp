@@ -12,7 +12,7 @@ ecs::TTypeID TNameComponentRenderer::GetComponentTypeID() noexcept
   return ecs::utils::GetComponentTypeID<ecs::TNameComponent>();
 }
 
-void TNameComponentRenderer::Render(void *Data) noexcept
+bool TNameComponentRenderer::Render(void *Data) noexcept
 {
   auto *Component = static_cast<ecs::TNameComponent *>(Data);
 
@@ -28,8 +28,11 @@ void TNameComponentRenderer::Render(void *Data) noexcept
   constexpr auto Flags = ImGuiInputTextFlags_NoUndoRedo;
   ImGui::InputText("Name##EntityName", &Buffer, Flags);
 
-  if (ImGui::IsItemDeactivatedAfterEdit() && !Buffer.empty())
-    Component->Name = Buffer;
+  if (!ImGui::IsItemDeactivatedAfterEdit() || Buffer.empty())
+    return false;
+
+  Component->Name = Buffer;
+  return true;
 }
 
 } // namespace editor
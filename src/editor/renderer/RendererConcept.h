@@ -12,10 +12,10 @@ template <typename T>
 concept ComponentRenderer = requires {
   { T::GetComponentTypeID() } noexcept -> std::same_as<ecs::TTypeID>;
 } && requires(void *data) {
-  { T::Render(data) } noexcept -> std::same_as<void>;
+  { T::Render(data) } noexcept -> std::same_as<bool>;
 };
 
-using RenderFunction = void (*)(void *);
+using RenderFunction = bool (*)(void *); // True if the component was edited
 
 } // namespace editor
 
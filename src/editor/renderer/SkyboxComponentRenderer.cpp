@@ -28,7 +28,7 @@ ecs::TTypeID TSkyboxComponentRenderer::GetComponentTypeID() noexcept
   return ecs::utils::GetComponentTypeID<ecs::TEnvironmentComponent>();
 }
 
-void TSkyboxComponentRenderer::Render(void *Data) noexcept
+bool TSkyboxComponentRenderer::Render(void *Data) noexcept
 {
   auto *Component = static_cast<ecs::TEnvironmentComponent *>(Data);
 
@@ -52,6 +52,8 @@ void TSkyboxComponentRenderer::Render(void *Data) noexcept
     DisplayTextureInfo(Component->IrradianceMap);
     ImGui::Unindent();
   }
+
+  return false;
 }
 
 } // namespace editor
@@ -13,7 +13,7 @@ ecs::TTypeID TTransformComponentRenderer::GetComponentTypeID() noexcept
   return ecs::utils::GetComponentTypeID<ecs::TTransformComponent>();
 }
 
-void TTransformComponentRenderer::Render(void *Data) noexcept
+bool TTransformComponentRenderer::Render(void *Data) noexcept
 {
   auto *TransformComponent = static_cast<ecs::TTransformComponent *>(Data);
 
@@ -65,6 +65,8 @@ void TTransformComponentRenderer::Render(void *Data) noexcept
     Scale                           = glm::max(Scale, glm::vec3(kMinScale));
     TransformComponent->WorldMatrix = glm::recompose(Scale, Rotation, Translation, glm::vec3(0.0f), glm::vec4(0.0f, 0.0f, 0.0f, 1.0f));
   }
+
+  return ValueChanged;
 }
 
 } // namespace editor
@@ -0,0 +1,531 @@
+#include "pch.h"
+
+#include "Benchmark.h"
+#include "Camera.h"
+#include "Engine.h"
+#include "ecs/Components.h"
+#include "ecs/ComponentsFactory.h"
+#include "interfaces/RenderPipeline.h"
+#include "render/RenderCommand.h"
+#include "render/RenderCommandSorter.h"
+#include "render/RenderQueue.h"
+#include "render/RenderStats.h"
+#include "utils/Json.h"
+#include "utils/Memory.h"
+#include "utils/Resource.h"
+#include "scenes/World.h"
+#include <ecs/EntitySpawner.h>
+#include <ecs/IEntitiesBroker.h>
+#include <common/Logger.h>
+#include <common/Clock.h>
+#include <common/JobSystem.h>
+#include <glm/gtx/norm.hpp>
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <string_view>
+
+namespace
+{
+
+template <typename T>
+bool ParseNumber(std::string_view _Text, T &_Value)
+{
+  const auto [Ptr, Error] = std::from_chars(_Text.data(), _Text.data() + _Text.size(), _Value);
+  return Error == std::errc() && Ptr == _Text.data() + _Text.size();
+}
+
+// Nearest-rank percentile, expects sorted input
+float Percentile(const std::vector<float> &_Sorted, float _Percent)
+{
+  if (_Sorted.empty())
+    return 0.0f;
+
+  const size_t Rank = static_cast<size_t>(std::ceil(_Percent / 100.0f * _Sorted.size()));
+  return _Sorted[std::clamp<size_t>(Rank, 1, _Sorted.size()) - 1];
+}
+
+nlohmann::json Summarize(std::vector<float> _Values)
+{
+  std::sort(_Values.begin(), _Values.end());
+
+  const float Sum = std::accumulate(_Values.begin(), _Values.end(), 0.0f);
+
+  return nlohmann::json{
+      {"Min", _Values.empty() ? 0.0f : _Values.front()},
+      {"Max", _Values.empty() ? 0.0f : _Values.back()},
+      {"Avg", _Values.empty() ? 0.0f : Sum / _Values.size()},
+      {"P50", Percentile(_Values, 50.0f)},
+      {"P90", Percentile(_Values, 90.0f)},
+      {"P95", Percentile(_Values, 95.0f)},
+      {"P99", Percentile(_Values, 99.0f)},
+  };
+}
+
+template <typename TagType>
+nlohmann::json SummarizeMemory(TMemoryCounter (*_GetMemory)(TagType))
+{
+  nlohmann::json Memory;
+  for (size_t i = 0; i < static_cast<size_t>(TagType::Count); ++i)
+  {
+    const TagType        Tag     = static_cast<TagType>(i);
+    const TMemoryCounter Counter = _GetMemory(Tag);
+
+    Memory[std::string(utils::GetMemoryTagName(Tag))] = {
+        {"LiveBytes", Counter.Live},
+        {"PeakBytes", Counter.Peak},
+    };
+  }
+
+  return Memory;
+}
+
+// The sorting used before sort keys: opaque first, then transparent back to front
+void LegacySortCommands(std::vector<TRenderCommand> &_Commands, const glm::vec3 &_CameraPosition)
+{
+  auto It = std::stable_partition(_Commands.begin(), _Commands.end(), [](const TRenderCommand &Command) {
+    return Command.Material.AlphaMode != EAlphaMode::Blend;
+  });
+
+  std::stable_sort(It, _Commands.end(), [&_CameraPosition](const TRenderCommand &A, const TRenderCommand &B) {
+    return glm::length2(_CameraPosition - glm::vec3(A.ModelMatrix[3])) > glm::length2(_CameraPosition - glm::vec3(B.ModelMatrix[3]));
+  });
+}
+
+std::vector<TRenderCommand> GenerateCommands(size_t _Count, const std::vector<TSharedVAO> &_VAOs)
+{
+  constexpr uint32_t MATERIALS_COUNT = 256;
+
+  std::mt19937                            Random(42);
+  std::uniform_int_distribution<uint32_t> Material(0, MATERIALS_COUNT - 1);
+  std::uniform_int_distribution<size_t>   VAO(0, _VAOs.size() - 1);
+  std::uniform_real_distribution<float>   Position(-200.0f, 200.0f);
+  std::uniform_int_distribution<int>      Percent(0, 99);
+
+  std::vector<TRenderCommand> Commands(_Count);
+  for (TRenderCommand &Command : Commands)
+  {
+    const int        Roll      = Percent(Random);
+    const EAlphaMode AlphaMode = Roll < 70 ? EAlphaMode::Opaque : (Roll < 90 ? EAlphaMode::Mask : EAlphaMode::Blend);
+
+    Command.Material.Index         = Material(Random);
+    Command.Material.AlphaMode     = AlphaMode;
+    Command.Material.IsDoubleSided = Percent(Random) < 10;
+    Command.VAO                    = _VAOs[VAO(Random)];
+    Command.ModelMatrix[3]         = glm::vec4(Position(Random), Position(Random), Position(Random), 1.0f);
+    Command.RenderFlags.set(AlphaMode == EAlphaMode::Blend ? ERenderFlags_Transparent : ERenderFlags_Opaque);
+  }
+
+  return Commands;
+}
+
+// Times the legacy comparison sort against the radix sort of the keys, median of a few repeats
+nlohmann::json RunSortBenchmark()
+{
+  constexpr size_t COMMANDS_COUNTS[] = {10'000, 50'000, 100'000, 200'000};
+  constexpr size_t REPEATS           = 7;
+  constexpr size_t VAOS_COUNT        = 512;
+
+  std::vector<TSharedVAO> VAOs;
+  for (size_t i = 0; i < VAOS_COUNT; ++i)
+    VAOs.push_back(std::make_shared<CVertexArray>());
+
+  const glm::vec3 CameraPosition(0.0f);
+
+  nlohmann::json Results = nlohmann::json::array();
+  for (size_t CommandsCount : COMMANDS_COUNTS)
+  {
+    const std::vector<TRenderCommand> Source = GenerateCommands(CommandsCount, VAOs);
+
+    std::vector<float> LegacyTimes;
+    std::vector<float> RadixTimes;
+
+    CRenderCommandSorter Sorter;
+    for (size_t Repeat = 0; Repeat < REPEATS; ++Repeat)
+    {
+      std::vector<TRenderCommand> Commands = Source;
+
+      utils::CClock Clock;
+      LegacySortCommands(Commands, CameraPosition);
+      LegacyTimes.push_back(Clock.GetElapsedTimeMs());
+
+      Commands = Source;
+
+      Clock = utils::CClock();
+      Sorter.Sort(Commands, CameraPosition);
+      RadixTimes.push_back(Clock.GetElapsedTimeMs());
+    }
+
+    std::sort(LegacyTimes.begin(), LegacyTimes.end());
+    std::sort(RadixTimes.begin(), RadixTimes.end());
+
+    const float LegacyTime = Percentile(LegacyTimes, 50.0f);
+    const float RadixTime  = Percentile(RadixTimes, 50.0f);
+
+    CLogger::Log(ELogType::Info, "[CBenchmark] Sorting {} commands: legacy {:.3f} ms, radix {:.3f} ms", CommandsCount, LegacyTime, RadixTime);
+
+    Results.push_back({
+        {"Commands", CommandsCount},
+        {"LegacyMs", LegacyTime},
+        {"RadixMs", RadixTime},
+    });
+  }
+
+  return Results;
+}
+
+// Times the render command collection of the loaded scene with 1 to N threads, median of a few repeats
+nlohmann::json RunCollectBenchmark(CWorld &_World)
+{
+  constexpr size_t REPEATS = 7;
+
+  const size_t MaxThreadsCount = utils::CJobSystem::Instance().GetThreadsCount();
+
+  nlohmann::json Results = nlohmann::json::array();
+  for (size_t ThreadsCount = 1; ThreadsCount <= MaxThreadsCount; ++ThreadsCount)
+  {
+    utils::CJobSystem JobSystem(ThreadsCount - 1);
+
+    std::vector<float> Times;
+    size_t             CommandsCount = 0;
+
+    for (size_t Repeat = 0; Repeat < REPEATS; ++Repeat)
+    {
+      CRenderQueue Queue;
+
+      // The parallel path even with it disabled in the config
+      utils::CClock Clock;
+      _World.Collect(Queue, JobSystem);
+      Times.push_back(Clock.GetElapsedTimeMs());
+
+      CommandsCount = Queue.GetSize();
+    }
+
+    std::sort(Times.begin(), Times.end());
+
+    const float Time = Percentile(Times, 50.0f);
+
+    CLogger::Log(ELogType::Info, "[CBenchmark] Collecting {} commands on {} threads: {:.3f} ms", CommandsCount, ThreadsCount, Time);
+
+    Results.push_back({
+        {"Threads", ThreadsCount},
+        {"Commands", CommandsCount},
+        {"Ms", Time},
+    });
+  }
+
+  return Results;
+}
+
+} // namespace
+
+bool CBenchmark::IsRequested(int _Argc, char *_Argv[])
+{
+  for (int i = 1; i < _Argc; ++i)
+  {
+    if (std::string_view(_Argv[i]) == "--benchmark")
+      return true;
+  }
+
+  return false;
+}
+
+std::optional<TBenchmarkOptions> CBenchmark::ParseArguments(int _Argc, char *_Argv[])
+{
+  std::optional<TBenchmarkOptions> Options;
+
+  for (int i = 1; i < _Argc; ++i)
+  {
+    const std::string_view Argument = _Argv[i];
+    if (Argument != "--benchmark")
+      continue;
+
+    if (i + 1 == _Argc)
+    {
+      CLogger::Log(ELogType::Error, "[CBenchmark] Missing value for argument '{}'", Argument);
+      return std::nullopt;
+    }
+
+    Options.emplace().ScenePath = _Argv[++i];
+    break;
+  }
+
+  if (!Options)
+    return std::nullopt;
+
+  for (int i = 1; i < _Argc; ++i)
+  {
+    if (std::string_view(_Argv[i]) == "--sort-benchmark")
+      Options->SortBenchmark = true;
+    else if (std::string_view(_Argv[i]) == "--collect-benchmark")
+      Options->CollectBenchmark = true;
+  }
+
+  constexpr std::string_view VALUE_ARGUMENTS[] = {"--frames", "--warmup", "--timestep", "--camera-path", "--report", "--record-stats"};
+
+  for (int i = 1; i < _Argc; ++i)
+  {
+    const std::string_view Argument = _Argv[i];
+    if (std::ranges::find(VALUE_ARGUMENTS, Argument) == std::ranges::end(VALUE_ARGUMENTS))
+      continue;
+
+    // Running with the default instead would measure another configuration than asked for
+    if (i + 1 == _Argc)
+    {
+      CLogger::Log(ELogType::Error, "[CBenchmark] Missing value for argument '{}'", Argument);
+      return std::nullopt;
+    }
+
+    const std::string_view Value = _Argv[++i];
+
+    bool IsValid = true;
+    if (Argument == "--frames")
+      IsValid = ParseNumber(Value, Options->FramesCount) && Options->FramesCount > 0;
+    else if (Argument == "--warmup")
+      IsValid = ParseNumber(Value, Options->WarmupFrames);
+    else if (Argument == "--timestep")
+      IsValid = ParseNumber(Value, Options->TimeStep) && Options->TimeStep > 0.0f;
+    else if (Argument == "--camera-path")
+      Options->CameraPath = Value;
+    else if (Argument == "--report")
+      Options->ReportPath = Value;
+    else if (Argument == "--record-stats")
+      Options->StatsPath = Value;
+
+    if (!IsValid)
+    {
+      CLogger::Log(ELogType::Error, "[CBenchmark] Invalid value '{}' for argument '{}'", Value, Argument);
+      return std::nullopt;
+    }
+  }
+
+  return Options;
+}
+
+CBenchmark::CBenchmark(TBenchmarkOptions _Options) :
+    m_Options(std::move(_Options)),
+    m_FrameIndex(0)
+{
+}
+
+bool CBenchmark::Init(ecs::IEntitiesBroker &_World)
+{
+  if (!LoadCameraPath() || !LoadScene(_World))
+    return false;
+
+  m_Samples.reserve(m_Options.FramesCount);
+
+  if (!m_Options.StatsPath.empty() && !m_StatsRecorder.Start(m_Options.StatsPath))
+    return false;
+
+  CLogger::Log(ELogType::Info, "[CBenchmark] Scene: {}. Frames: {} (+{} warmup). Timestep: {} ms", m_Options.ScenePath.string(),
+               m_Options.FramesCount, m_Options.WarmupFrames, m_Options.TimeStep);
+  return true;
+}
+
+void CBenchmark::BeginFrame(CCamera &_Camera)
+{
+  if (m_CameraPath.empty())
+    return;
+
+  const float           Time     = m_FrameIndex * m_Options.TimeStep / 1000.0f;
+  const TCameraKeyframe Keyframe = SampleCameraPath(Time);
+
+  _Camera.SetPosition(Keyframe.Position);
+  _Camera.LookAt(Keyframe.Target);
+}
+
+void CBenchmark::EndFrame(const IRenderPipeline &_RenderPipeline, float _FrameTime)
+{
+  if (m_FrameIndex++ < m_Options.WarmupFrames)
+    return;
+
+  TFrameSample Sample;
+  Sample.FrameTime           = _FrameTime;
+  Sample.DrawCalls           = _RenderPipeline.GetDrawCallsCount();
+  Sample.Triangles           = _RenderPipeline.GetTrianglesCount();
+  Sample.CulledObjects       = _RenderPipeline.GetCulledObjectsCount();
+  Sample.CulledShadowCasters = _RenderPipeline.GetCulledShadowCastersCount();
+  Sample.OccludedObjects     = _RenderPipeline.GetOccludedObjectsCount();
+  Sample.StateChanges        = _RenderPipeline.GetStateChanges();
+
+  for (size_t i = 0; i < RENDER_PASS_GROUPS_COUNT; ++i)
+  {
+    const TRenderPassStats Stats = _RenderPipeline.GetRenderPassStats(RENDER_PASS_GROUPS[i]);
+    Sample.PassCPUTimes[i]       = Stats.CPUTime;
+    Sample.PassGPUTimes[i]       = Stats.GPUTime;
+  }
+
+  m_Samples.push_back(Sample);
+  m_StatsRecorder.Record(_RenderPipeline, _FrameTime);
+}
+
+bool CBenchmark::IsFinished() const
+{
+  return m_FrameIndex >= m_Options.WarmupFrames + m_Options.FramesCount;
+}
+
+float CBenchmark::GetTimeStep() const
+{
+  return m_Options.TimeStep;
+}
+
+bool CBenchmark::WriteReport()
+{
+  m_StatsRecorder.Stop();
+
+  const auto Collect = [this](auto _Getter) {
+    std::vector<float> Values;
+    Values.reserve(m_Samples.size());
+    for (const TFrameSample &Sample : m_Samples)
+      Values.push_back(static_cast<float>(_Getter(Sample)));
+    return Values;
+  };
+
+  nlohmann::json Passes;
+  for (size_t i = 0; i < RENDER_PASS_GROUPS_COUNT; ++i)
+  {
+    Passes[std::string(GetRenderPassGroupName(RENDER_PASS_GROUPS[i]))] = {
+        {"CPU", Summarize(Collect([i](const TFrameSample &_Sample) { return _Sample.PassCPUTimes[i]; }))},
+        {"GPU", Summarize(Collect([i](const TFrameSample &_Sample) { return _Sample.PassGPUTimes[i]; }))},
+    };
+  }
+
+  const auto CollectStateChanges = [&Collect](uint32_t TRenderStateChanges::*_Counter) {
+    return Summarize(Collect([_Counter](const TFrameSample &_Sample) { return _Sample.StateChanges.*_Counter; }));
+  };
+
+  const nlohmann::json StateChanges = {
+      {"ShaderSwitches", CollectStateChanges(&TRenderStateChanges::ShaderSwitches)},
+      {"TextureBinds", CollectStateChanges(&TRenderStateChanges::TextureBinds)},
+      {"VAOBinds", CollectStateChanges(&TRenderStateChanges::VAOBinds)},
+      {"UniformUploads", CollectStateChanges(&TRenderStateChanges::UniformUploads)},
+      {"FBOBinds", CollectStateChanges(&TRenderStateChanges::FBOBinds)},
+      {"BlendChanges", CollectStateChanges(&TRenderStateChanges::BlendChanges)},
+      {"CullChanges", CollectStateChanges(&TRenderStateChanges::CullChanges)},
+      {"DepthChanges", CollectStateChanges(&TRenderStateChanges::DepthChanges)},
+  };
+
+  nlohmann::json Report = {
+      {"Scene", m_Options.ScenePath.string()},
+      {"CameraPath", m_Options.CameraPath.string()},
+      {"Frames", m_Samples.size()},
+      {"TimeStep", m_Options.TimeStep},
+      {"FrameTime", Summarize(Collect([](const TFrameSample &_Sample) { return _Sample.FrameTime; }))},
+      {"Passes", std::move(Passes)},
+      {"DrawCalls", Summarize(Collect([](const TFrameSample &_Sample) { return _Sample.DrawCalls; }))},
+      {"Triangles", Summarize(Collect([](const TFrameSample &_Sample) { return _Sample.Triangles; }))},
+      {"CulledObjects", Summarize(Collect([](const TFrameSample &_Sample) { return _Sample.CulledObjects; }))},
+      {"CulledShadowCasters", Summarize(Collect([](const TFrameSample &_Sample) { return _Sample.CulledShadowCasters; }))},
+      {"OccludedObjects", Summarize(Collect([](const TFrameSample &_Sample) { return _Sample.OccludedObjects; }))},
+      {"StateChanges", StateChanges},
+      {"PeakMemoryBytes", utils::GetPeakMemoryUsage()},
+      {"Memory",
+       {
+           {"CPU", utils::IsMemoryTrackingEnabled() ? SummarizeMemory(&utils::GetCPUMemory) : nlohmann::json()},
+           {"GPU", SummarizeMemory(&utils::GetGPUMemory)},
+       }},
+  };
+
+  // After the memory summary, the synthetic commands would show up in the peaks
+  if (m_Options.SortBenchmark)
+    Report["CommandSort"] = RunSortBenchmark();
+
+  if (m_Options.CollectBenchmark)
+    Report["CommandCollect"] = RunCollectBenchmark(*CEngine::Instance().GetWorld());
+
+  std::ofstream File(m_Options.ReportPath);
+  if (!File.is_open())
+  {
+    CLogger::Log(ELogType::Error, "[CBenchmark] Failed to open report file: {}", m_Options.ReportPath.string());
+    return false;
+  }
+
+  File << Report.dump(2);
+
+  CLogger::Log(ELogType::Info, "[CBenchmark] Report saved: {}", m_Options.ReportPath.string());
+  return true;
+}
+
+bool CBenchmark::LoadCameraPath()
+{
+  if (m_Options.CameraPath.empty())
+  {
+    CLogger::Log(ELogType::Warning, "[CBenchmark] No camera path provided, the camera stays static");
+    return true;
+  }
+
+  const nlohmann::json Json = utils::ParseJson(m_Options.CameraPath);
+  if (!Json.contains("Keyframes"))
+  {
+    CLogger::Log(ELogType::Error, "[CBenchmark] Invalid camera path file: {}", m_Options.CameraPath.string());
+    return false;
+  }
+
+  for (const nlohmann::json &Keyframe : Json["Keyframes"])
+  {
+    const auto Position = Keyframe["Position"].get<std::array<float, 3>>();
+    const auto Target   = Keyframe["Target"].get<std::array<float, 3>>();
+
+    m_CameraPath.push_back(TCameraKeyframe{
+        .Time     = Keyframe["Time"].get<float>(),
+        .Position = glm::vec3(Position[0], Position[1], Position[2]),
+        .Target   = glm::vec3(Target[0], Target[1], Target[2]),
+    });
+  }
+
+  std::sort(m_CameraPath.begin(), m_CameraPath.end(), [](const TCameraKeyframe &A, const TCameraKeyframe &B) {
+    return A.Time < B.Time;
+  });
+
+  return true;
+}
+
+bool CBenchmark::LoadScene(ecs::IEntitiesBroker &_World)
+{
+  std::shared_ptr<CModel> Model = resource::LoadModel(m_Options.ScenePath);
+  if (!Model)
+  {
+    CLogger::Log(ELogType::Error, "[CBenchmark] Failed to load scene: {}", m_Options.ScenePath.string());
+    return false;
+  }
+
+  _World.CreateEntitySpawner()
+      .AddComponent(ecs::CComponentsFactory::Create<ecs::TTransformComponent>(glm::mat4x4(1.0f)))
+      .AddComponent(ecs::CComponentsFactory::Create<ecs::TModelComponent>(Model))
+      .AddComponent(ecs::CComponentsFactory::Create<ecs::TCollisionComponent>(Model))
+      .AddComponent(ecs::CComponentsFactory::Create<ecs::TNameComponent>("Benchmark scene"))
+      .Spawn();
+
+  _World.CreateEntitySpawner()
+      .AddComponent(ecs::CComponentsFactory::Create<ecs::TLightComponent>(ELightType::Directional))
+      .AddComponent(ecs::CComponentsFactory::Create<ecs::TNameComponent>("Benchmark light"))
+      .Spawn();
+
+  return true;
+}
+
+CBenchmark::TCameraKeyframe CBenchmark::SampleCameraPath(float _Time) const
+{
+  assert(!m_CameraPath.empty());
+
+  if (_Time <= m_CameraPath.front().Time)
+    return m_CameraPath.front();
+  if (_Time >= m_CameraPath.back().Time)
+    return m_CameraPath.back();
+
+  auto Next = std::upper_bound(m_CameraPath.begin(), m_CameraPath.end(), _Time, [](float _Value, const TCameraKeyframe &_Keyframe) {
+    return _Value < _Keyframe.Time;
+  });
+  auto Prev = std::prev(Next);
+
+  const float Alpha = (_Time - Prev->Time) / std::max(Next->Time - Prev->Time, 1e-6f);
+
+  return TCameraKeyframe{
+      .Time     = _Time,
+      .Position = glm::mix(Prev->Position, Next->Position, Alpha),
+      .Target   = glm::mix(Prev->Target, Next->Target, Alpha),
+  };
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "StatsRecorder.h"
+#include "render/RenderStats.h"
+#include <glm/vec3.hpp>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+class CCamera;
+class IRenderPipeline;
+
+namespace ecs
+{
+class IEntitiesBroker;
+}
+
+struct TBenchmarkOptions
+{
+  std::filesystem::path ScenePath;
+  std::filesystem::path CameraPath;
+  std::filesystem::path ReportPath       = "benchmark_report.json";
+  std::filesystem::path StatsPath; // Optional per-frame binary recording
+  uint32_t              FramesCount      = 1000;
+  uint32_t              WarmupFrames     = 16;
+  float                 TimeStep         = 1000.0f / 60.0f; // ms
+  bool                  SortBenchmark    = false;           // Compares render command sorting paths after the run
+  bool                  CollectBenchmark = false;           // Times the render command collection on 1 to N threads after the run
+};
+
+// Drives a deterministic run: fixed timestep, scripted camera, fixed frame count.
+// Collects per-frame statistics and writes them as a JSON report at the end.
+class CBenchmark final
+{
+public:
+  static bool IsRequested(int _Argc, char *_Argv[]);
+  // std::nullopt without --benchmark or with a missing or invalid value, IsRequested tells them apart
+  static std::optional<TBenchmarkOptions> ParseArguments(int _Argc, char *_Argv[]);
+
+  explicit CBenchmark(TBenchmarkOptions _Options);
+
+  bool Init(ecs::IEntitiesBroker &_World);
+
+  void BeginFrame(CCamera &_Camera);
+  void EndFrame(const IRenderPipeline &_RenderPipeline, float _FrameTime);
+
+  bool IsFinished() const;
+  float GetTimeStep() const;
+
+  bool WriteReport();
+
+private:
+  struct TCameraKeyframe
+  {
+    float     Time; // s
+    glm::vec3 Position;
+    glm::vec3 Target;
+  };
+
+  struct TFrameSample
+  {
+    float                                       FrameTime;
+    std::array<float, RENDER_PASS_GROUPS_COUNT> PassCPUTimes;
+    std::array<float, RENDER_PASS_GROUPS_COUNT> PassGPUTimes;
+    uint32_t                                    DrawCalls;
+    uint32_t                                    Triangles;
+    uint32_t                                    CulledObjects;
+    uint32_t                                    CulledShadowCasters;
+    uint32_t                                    OccludedObjects;
+    TRenderStateChanges                         StateChanges;
+  };
+
+  bool LoadCameraPath();
+  bool LoadScene(ecs::IEntitiesBroker &_World);
+  TCameraKeyframe SampleCameraPath(float _Time) const;
+
+private:
+  TBenchmarkOptions            m_Options;
+  std::vector<TCameraKeyframe> m_CameraPath;
+  std::vector<TFrameSample>    m_Samples;
+  CStatsRecorder               m_StatsRecorder;
+  uint32_t                     m_FrameIndex;
+};
@@ -76,6 +76,17 @@ void CCamera::SetPosition(const glm::vec3 &_Pos)
   m_Position = _Pos;
 }
 
+void CCamera::LookAt(const glm::vec3 &_Target)
+{
+  const glm::vec3 Direction = _Target - m_Position;
+  if (glm::length(Direction) <= 0.0f)
+    return;
+
+  m_Forward = glm::normalize(Direction);
+  m_Yaw     = glm::degrees(std::atan2(m_Forward.z, m_Forward.x));
+  m_Pitch   = std::max(-89.0f, std::min(89.0f, glm::degrees(std::asin(m_Forward.y))));
+}
+
 glm::vec3 CCamera::GetPosition() const
 {
   return m_Position;
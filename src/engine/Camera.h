@@ -22,6 +22,7 @@ public:
   void Update(float _TimeDelta) override;
 
   void SetPosition(const glm::vec3 &_Pos);
+  void LookAt(const glm::vec3 &_Target);
   glm::vec3 GetPosition() const;
   glm::vec3 GetForwardVector() const;
   glm::vec3 GetUpVector() const;
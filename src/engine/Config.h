@@ -96,6 +96,62 @@ public:
       event::Notify(TEventType::Config_SSAOEnabledChanged, _Enabled);
     }
   }
+  void SetOcclusionCullingEnabled(bool _Enabled)
+  {
+    if (IsOcclusionCullingEnabled != _Enabled)
+    {
+      IsOcclusionCullingEnabled = _Enabled;
+      event::Notify(TEventType::Config_OcclusionCullingEnabledChanged, _Enabled);
+    }
+  }
+  void SetGPUOcclusionCullingEnabled(bool _Enabled)
+  {
+    if (IsGPUOcclusionCullingEnabled != _Enabled)
+    {
+      IsGPUOcclusionCullingEnabled = _Enabled;
+      event::Notify(TEventType::Config_GPUOcclusionCullingEnabledChanged, _Enabled);
+    }
+  }
+  void SetRetainedRenderListEnabled(bool _Enabled)
+  {
+    if (IsRetainedRenderListEnabled != _Enabled)
+    {
+      IsRetainedRenderListEnabled = _Enabled;
+      event::Notify(TEventType::Config_RetainedRenderListEnabledChanged, _Enabled);
+    }
+  }
+  void SetParallelCollectEnabled(bool _Enabled)
+  {
+    if (IsParallelCollectEnabled != _Enabled)
+    {
+      IsParallelCollectEnabled = _Enabled;
+      event::Notify(TEventType::Config_ParallelCollectEnabledChanged, _Enabled);
+    }
+  }
+  void SetSpatialCullingEnabled(bool _Enabled)
+  {
+    if (IsSpatialCullingEnabled != _Enabled)
+    {
+      IsSpatialCullingEnabled = _Enabled;
+      event::Notify(TEventType::Config_SpatialCullingEnabledChanged, _Enabled);
+    }
+  }
+  void SetLODEnabled(bool _Enabled)
+  {
+    if (IsLODEnabled != _Enabled)
+    {
+      IsLODEnabled = _Enabled;
+      event::Notify(TEventType::Config_LODEnabledChanged, _Enabled);
+    }
+  }
+  void SetShadowLODBias(int _Bias)
+  {
+    if (ShadowLODBias != _Bias)
+    {
+      ShadowLODBias = _Bias;
+      event::Notify(TEventType::Config_ShadowLODBiasChanged, _Bias);
+    }
+  }
   void SetGizmoEnabled(bool _Enabled)
   {
     if (IsGizmoEnabled != _Enabled)
@@ -120,6 +176,14 @@ public:
       event::Notify(TEventType::Config_WireframeEnabledChanged, _Enabled);
     }
   }
+  void SetSpatialTreeOverlayEnabled(bool _Enabled)
+  {
+    if (IsSpatialTreeOverlayEnabled != _Enabled)
+    {
+      IsSpatialTreeOverlayEnabled = _Enabled;
+      event::Notify(TEventType::Config_SpatialTreeOverlayEnabledChanged, _Enabled);
+    }
+  }
   void SetBloomEnabled(bool _Enabled)
   {
     if (IsBloomEnabled != _Enabled)
@@ -219,6 +283,22 @@ public:
     }
   }
 #endif
+  void SetBenchmarkMode(bool _Enabled)
+  {
+    IsBenchmarkModeEnabled = _Enabled;
+  }
+  bool IsBenchmarkMode() const
+  {
+    return IsBenchmarkModeEnabled;
+  }
+  void SetRenderThreadEnabled(bool _Enabled)
+  {
+    IsRenderThreadEnabled = _Enabled;
+  }
+  bool GetRenderThreadEnabled() const
+  {
+    return IsRenderThreadEnabled;
+  }
   int GetShadowMapSize() const
   {
     return ShadowMapSize;
@@ -283,6 +363,34 @@ public:
   {
     return IsSSAOEnabled;
   }
+  bool GetOcclusionCullingEnabled() const
+  {
+    return IsOcclusionCullingEnabled;
+  }
+  bool GetGPUOcclusionCullingEnabled() const
+  {
+    return IsGPUOcclusionCullingEnabled;
+  }
+  bool GetRetainedRenderListEnabled() const
+  {
+    return IsRetainedRenderListEnabled;
+  }
+  bool GetParallelCollectEnabled() const
+  {
+    return IsParallelCollectEnabled;
+  }
+  bool GetSpatialCullingEnabled() const
+  {
+    return IsSpatialCullingEnabled;
+  }
+  bool GetLODEnabled() const
+  {
+    return IsLODEnabled;
+  }
+  int GetShadowLODBias() const
+  {
+    return ShadowLODBias;
+  }
 
   bool GetGizmoEnabled() const
   {
@@ -296,6 +404,10 @@ public:
   {
     return IsWireframeEnabled;
   }
+  bool GetSpatialTreeOverlayEnabled() const
+  {
+    return IsSpatialTreeOverlayEnabled;
+  }
   TColor GetWireframeColor() const
   {
     return WireframeColor;
@@ -361,7 +473,7 @@ public:
   }
   bool IsEditorEnabled() const
   {
-    return static_cast<bool>(DEV_STAGE);
+    return static_cast<bool>(DEV_STAGE) && !IsBenchmarkModeEnabled;
   }
   unsigned GetMaxSupportedMSAASamples() const
   {
@@ -370,17 +482,24 @@ public:
 
 private:
   // Render
-  int   ShadowMapSize            = 4096;
-  bool  AreShadowsEnabled        = true;
-  bool  IsHDREnabled             = true;
-  float HDRExposure              = 1.0f;
-  bool  IsGammaCorrectionEnabled = true;
-  float Gamma                    = 2.2f;
-  bool  IsBloomEnabled           = true;
-  float BloomThreshold           = 1.0f;
-  float BloomIntensity           = 1.0f;
-  int   BloomBlurPasses          = 10;
-  bool  IsSSAOEnabled            = true;
+  int   ShadowMapSize                = 4096;
+  bool  AreShadowsEnabled            = true;
+  bool  IsHDREnabled                 = true;
+  float HDRExposure                  = 1.0f;
+  bool  IsGammaCorrectionEnabled     = true;
+  float Gamma                        = 2.2f;
+  bool  IsBloomEnabled               = true;
+  float BloomThreshold               = 1.0f;
+  float BloomIntensity               = 1.0f;
+  int   BloomBlurPasses              = 10;
+  bool  IsSSAOEnabled                = true;
+  bool  IsOcclusionCullingEnabled    = true;
+  bool  IsGPUOcclusionCullingEnabled = false;
+  bool  IsRetainedRenderListEnabled  = true; // Otherwise the render proxies are rebuilt every frame
+  bool  IsParallelCollectEnabled     = true; // Render commands are generated by the job system
+  bool  IsSpatialCullingEnabled      = true; // Entities out of the views are skipped with the spatial tree
+  bool  IsLODEnabled                 = true;
+  int   ShadowLODBias                = 1; // Shadows use a LOD this much coarser than the view
 
   // Anti Aliasing
   int  MSAASampleCount = 4;
@@ -388,10 +507,11 @@ private:
   bool IsFXAAEnabled   = false;
 
   // Debug
-  bool   IsGizmoEnabled     = true;
-  bool   IsGridEnabled      = true;
-  bool   IsWireframeEnabled = true;
-  TColor WireframeColor     = TColor(1.0f, 1.0f, 0.0f, 0.8f);
+  bool   IsGizmoEnabled              = true;
+  bool   IsGridEnabled               = true;
+  bool   IsWireframeEnabled          = true;
+  TColor WireframeColor              = TColor(1.0f, 1.0f, 0.0f, 0.8f);
+  bool   IsSpatialTreeOverlayEnabled = false;
 
   // Camera parameters
   float Camera_ZNear = 0.1f;
@@ -403,4 +523,10 @@ private:
   float LightSpaceMatrix_ZFar         = 45.0f;
   float LightSpaceMatrix_OrthLeftBot  = -30.0f;
   float LightSpaceMatrix_OrthRightTop = 30.0f;
+
+  // Benchmark
+  bool IsBenchmarkModeEnabled = false;
+
+  // Threading, set before the main loop starts
+  bool IsRenderThreadEnabled = false; // Frames are rendered on a thread of their own, see CRenderThread
 };
@@ -1,12 +1,20 @@
 #include <glad/glad.h>
 #include "Display.h"
+#include "render/GLState.h"
 #include "utils/Image.h"
 #include <common/Logger.h>
 #include <GLFW/glfw3.h>
 #include <cstdlib>
 
-static inline void ApplyInitHints()
+static inline void ApplyInitHints(bool _IsHeadless)
 {
+  if (_IsHeadless)
+  {
+    // No display server is needed, the context comes from EGL (surfaceless) or OSMesa
+    glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL);
+    return;
+  }
+
 #if defined(__linux__)
   // Force X11 only on Linux (needed for apitrace / GLX)
   glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_X11);
@@ -20,9 +28,9 @@ CDisplay::CDisplay() :
 
 CDisplay::~CDisplay() = default;
 
-int CDisplay::Init(const std::string &_Title, const std::filesystem::path &_IconPath)
+int CDisplay::Init(const std::string &_Title, const std::filesystem::path &_IconPath, bool _IsHeadless)
 {
-  ApplyInitHints();
+  ApplyInitHints(_IsHeadless);
 
   CLogger::Log(ELogType::Info, "[CDisplay] Init GLFW. Version: {}", glfwGetVersionString());
   if (glfwInit() != GLFW_TRUE)
@@ -33,12 +41,7 @@ int CDisplay::Init(const std::string &_Title, const std::filesystem::path &_Icon
     return ErrorCode;
   }
 
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
-  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
-  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-  // glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_NATIVE_CONTEXT_API);
-
-  m_Window = glfwCreateWindow(DEFAULT_WIDTH, DEFAULT_HEIGHT, _Title.c_str(), nullptr, nullptr);
+  m_Window = CreateGLFWWindow(_Title, _IsHeadless);
   if (!m_Window)
   {
     const char *ErrorDescription;
@@ -71,13 +74,13 @@ int CDisplay::Init(const std::string &_Title, const std::filesystem::path &_Icon
     CLogger::Log(ELogType::Info, "[CDisplay] Maximum supported texture image units: {}", MaxTextureUnits);
   }
 
-  glViewport(0, 0, DEFAULT_WIDTH, DEFAULT_HEIGHT);
-  glfwSwapInterval(1); // VSYNC
+  CGLState::SetViewport({.Width = DEFAULT_WIDTH, .Height = DEFAULT_HEIGHT});
+  glfwSwapInterval(_IsHeadless ? 0 : 1); // VSYNC
 
-  glEnable(GL_DEPTH_TEST);
-  glEnable(GL_STENCIL_TEST);
-  glEnable(GL_MULTISAMPLE);
-  glEnable(GL_TEXTURE_CUBE_MAP_SEAMLESS);
+  CGLState::SetEnabled(GL_DEPTH_TEST, true);
+  CGLState::SetEnabled(GL_STENCIL_TEST, true);
+  CGLState::SetEnabled(GL_MULTISAMPLE, true);
+  CGLState::SetEnabled(GL_TEXTURE_CUBE_MAP_SEAMLESS, true);
 
   // glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
   // glfwWindowHint(GLFW_OPENGL_DEBUG_CONTEXT, true);
@@ -109,6 +112,16 @@ void CDisplay::SwapBuffers()
     glfwSwapBuffers(m_Window);
 }
 
+void CDisplay::MakeContextCurrent()
+{
+  glfwMakeContextCurrent(m_Window);
+}
+
+void CDisplay::ReleaseContext()
+{
+  glfwMakeContextCurrent(nullptr);
+}
+
 bool CDisplay::ShouldClose() const
 {
   return m_Window ? glfwWindowShouldClose(m_Window) : true;
@@ -182,6 +195,31 @@ void CDisplay::SetKeyCallback(KeyCallback _Callback)
   m_KeyCallback = _Callback;
 }
 
+GLFWwindow *CDisplay::CreateGLFWWindow(const std::string &_Title, bool _IsHeadless)
+{
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
+  glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 6);
+  glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+  // glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_NATIVE_CONTEXT_API);
+
+  if (!_IsHeadless)
+    return glfwCreateWindow(DEFAULT_WIDTH, DEFAULT_HEIGHT, _Title.c_str(), nullptr, nullptr);
+
+  glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+  constexpr int ContextAPIs[] = {GLFW_EGL_CONTEXT_API, GLFW_OSMESA_CONTEXT_API};
+  for (const int ContextAPI : ContextAPIs)
+  {
+    glfwWindowHint(GLFW_CONTEXT_CREATION_API, ContextAPI);
+    if (GLFWwindow *Window = glfwCreateWindow(DEFAULT_WIDTH, DEFAULT_HEIGHT, _Title.c_str(), nullptr, nullptr))
+      return Window;
+
+    CLogger::Log(ELogType::Warning, "[CDisplay] Headless context creation failed. API: {:#x}", ContextAPI);
+  }
+
+  return nullptr;
+}
+
 void CDisplay::InitCallbacks()
 {
   glfwSetWindowUserPointer(m_Window, this);
@@ -220,7 +258,7 @@ void CDisplay::OnWindowResizedProxy(GLFWwindow *_Window, int _Width, int _Height
   auto *Display = static_cast<CDisplay *>(glfwGetWindowUserPointer(_Window));
   if (Display)
   {
-    glViewport(0, 0, _Width, _Height);
+    CGLState::SetViewport({.Width = _Width, .Height = _Height});
     if (Display->m_ResizeCallback)
       Display->m_ResizeCallback(_Width, _Height);
   }
@@ -21,11 +21,15 @@ public:
   CDisplay();
   ~CDisplay();
 
-  int Init(const std::string &_Title, const std::filesystem::path &_IconPath);
+  int Init(const std::string &_Title, const std::filesystem::path &_IconPath, bool _IsHeadless = false);
   void Shutdown();
 
   void PollEvents();
   void SwapBuffers();
+
+  // The GL context is current on one thread at a time, it has to be released before another takes it
+  void MakeContextCurrent();
+  void ReleaseContext();
   bool ShouldClose() const;
   void SetShouldClose(bool _ShouldClose);
 
@@ -45,6 +49,7 @@ public:
   void SetKeyCallback(KeyCallback _Callback);
 
 private:
+  GLFWwindow *CreateGLFWWindow(const std::string &_Title, bool _IsHeadless);
   void InitCallbacks();
   void LoadIcon(const std::filesystem::path &_IconPath);
 
@@ -4,24 +4,37 @@
 #include "Display.h"
 #include "InputManager.h"
 #include "ResourceManager.h"
+#include "RenderThread.h"
 #include "editor/EditorUI.h"
 #include "utils/Event.h"
+#include "utils/Memory.h"
 #include "render/GLRenderer.h"
 #include "render/RenderTypes.h"
-#include "render/FrameData.h"
+#include "render/FramePacket.h"
 #include "render/RenderPipeline.h"
-#include "render/RenderQueue.h"
 #include "scenes/World.h"
 #include <events/EventsManager.h>
+#include <common/Clock.h>
 #include <GLFW/glfw3.h>
 #include <glm/glm.hpp>
 #include <string>
 
+namespace
+{
+
+constexpr size_t FRAMES_IN_FLIGHT       = 3; // Built, queued and rendered, when running pipelined
+constexpr size_t FRAME_ARENA_BLOCK_SIZE = 1024 * 1024;
+
+} // namespace
+
 CEngine::TSharedPtr CEngine::Singleton = nullptr;
 
 CEngine::CEngine() :
     m_FrameTime(0.0f),
-    m_RequestShutdown(false)
+    m_RequestShutdown(false),
+    m_FrameArena(FRAMES_IN_FLIGHT, FRAME_ARENA_BLOCK_SIZE),
+    m_FrameStartAllocations(0),
+    m_LastCommandsCount(0)
 {
   assert(Singleton == nullptr && "CEngine instance already exists!");
 }
@@ -39,10 +52,15 @@ CEngine &CEngine::Instance()
 void CEngine::Shutdown()
 {
 #if DEV_STAGE
-  m_EditorUI->Shutdown();
-  m_EditorUI.reset();
+  if (m_EditorUI)
+  {
+    m_EditorUI->Shutdown();
+    m_EditorUI.reset();
+  }
 #endif
 
+  m_Benchmark.reset();
+
   m_World->Shutdown();
   m_World.reset();
 
@@ -66,8 +84,14 @@ void CEngine::Shutdown()
   Singleton.reset();
 }
 
-int CEngine::Init()
+int CEngine::Init(std::optional<TBenchmarkOptions> _BenchmarkOptions)
 {
+  if (_BenchmarkOptions)
+  {
+    CConfig::Instance().SetBenchmarkMode(true);
+    m_Benchmark = std::make_unique<CBenchmark>(std::move(*_BenchmarkOptions));
+  }
+
   m_Display         = CDisplay::Create();
   m_InputManager    = CInputManager::Create();
   m_EventsManager   = CEventsManager::Create();
@@ -75,12 +99,14 @@ int CEngine::Init()
   m_World           = CWorld::Create();
   m_ResourceManager = CResourceManager::Create();
 #if DEV_STAGE
-  m_EditorUI = editor::CEditorUI::Create(*m_World);
+  if (CConfig::Instance().IsEditorEnabled())
+    m_EditorUI = editor::CEditorUI::Create(*m_World);
 #endif
 
   const std::string GameTitle       = CConfig::Instance().GetAppTitle();
   const auto        WindowIconPath  = CConfig::Instance().GetAppIconPath();
-  const int         DisplayInitCode = m_Display->Init(GameTitle, WindowIconPath);
+  const bool        IsHeadless      = CConfig::Instance().IsBenchmarkMode();
+  const int         DisplayInitCode = m_Display->Init(GameTitle, WindowIconPath, IsHeadless);
 
   if (DisplayInitCode != EXIT_SUCCESS)
     return DisplayInitCode;
@@ -100,8 +126,12 @@ int CEngine::Init()
 
   m_Camera->SetPosition(glm::vec3(0.0f, 5.0f, 20.0f));
 
+  if (m_Benchmark && !m_Benchmark->Init(*m_World))
+    return EXIT_FAILURE;
+
 #if DEV_STAGE
-  m_EditorUI->Init(GetDisplay()->GetWindow());
+  if (m_EditorUI)
+    m_EditorUI->Init(GetDisplay()->GetWindow());
 #endif
 
   return EXIT_SUCCESS;
@@ -110,7 +140,12 @@ int CEngine::Init()
 int CEngine::Run()
 {
   std::unique_ptr<IRenderer> Renderer = std::make_unique<COpenGLRenderer>();
-  Renderer->SetCamera(m_Camera);
+
+  if (m_Benchmark)
+    return RunBenchmark(*Renderer);
+
+  if (CConfig::Instance().GetRenderThreadEnabled())
+    return RunPipelined(*Renderer);
 
   float LastFrameTime = 0.0f;
   while (!m_RequestShutdown && !m_Display->ShouldClose())
@@ -119,6 +154,7 @@ int CEngine::Run()
     const float  FrameDelta       = (CurrentFrameTime - LastFrameTime) * 1000.0f;
     LastFrameTime                 = CurrentFrameTime;
 
+    BeginFrame();
     SetFrameTime(FrameDelta);
 
     Update(FrameDelta);
@@ -131,30 +167,145 @@ int CEngine::Run()
   return EXIT_SUCCESS;
 }
 
+int CEngine::RunBenchmark(IRenderer &_Renderer)
+{
+  const float TimeStep = m_Benchmark->GetTimeStep();
+
+  while (!m_RequestShutdown && !m_Benchmark->IsFinished())
+  {
+    utils::CClock FrameClock;
+
+    m_Benchmark->BeginFrame(*m_Camera);
+
+    BeginFrame();
+    SetFrameTime(TimeStep);
+
+    Update(TimeStep);
+    Render(_Renderer);
+
+    m_Display->SwapBuffers();
+    m_Display->PollEvents();
+
+    m_Benchmark->EndFrame(*m_RenderPipeline, FrameClock.GetElapsedTimeMs());
+  }
+
+  return m_Benchmark->WriteReport() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// The main thread simulates a frame while the render thread renders the previous one. The editor
+// reads and edits the world and draws with GL, so it runs with the context lent by the render
+// thread, which has nothing left to render by then: editor frames don't overlap.
+int CEngine::RunPipelined(IRenderer &_Renderer)
+{
+  m_RenderThread = std::make_unique<CRenderThread>(*m_Display, *m_RenderPipeline, _Renderer);
+  m_RenderThread->Start();
+
+  float LastFrameTime = 0.0f;
+  while (!m_RequestShutdown && !m_Display->ShouldClose())
+  {
+    const double CurrentFrameTime = GetApplicationRunningTime();
+    const float  FrameDelta       = (CurrentFrameTime - LastFrameTime) * 1000.0f;
+    LastFrameTime                 = CurrentFrameTime;
+
+    BeginFrame();
+    SetFrameTime(FrameDelta);
+
+    Update(FrameDelta);
+
+    TFramePacket Packet = BuildFramePacket();
+#if DEV_STAGE
+    Packet.ShouldPresent = !m_EditorUI;
+#endif
+    m_RenderThread->Submit(std::move(Packet));
+
+#if DEV_STAGE
+    if (m_EditorUI)
+    {
+      m_RenderThread->RunWithContext([this] {
+        RenderEditor();
+        m_Display->SwapBuffers();
+      });
+    }
+#endif
+
+    m_Display->PollEvents();
+  }
+
+  m_RenderThread->Stop();
+  m_RenderThread.reset();
+
+  return EXIT_SUCCESS;
+}
+
+void CEngine::BeginFrame()
+{
+  m_FrameStartAllocations = utils::GetCPUAllocationsCount();
+  m_FrameArena.BeginFrame();
+}
+
 void CEngine::Update(float _TimeDelta)
 {
-  m_EventsManager->Update(_TimeDelta);
-  m_ResourceManager->Update(_TimeDelta);
+  if (!m_RenderThread)
+    UpdateEventsAndResources(_TimeDelta);
+  else if (m_EventsManager->HasPendingEvents() || m_ResourceManager->IsPruneScheduled())
+    m_RenderThread->RunWithContext([this, _TimeDelta] { UpdateEventsAndResources(_TimeDelta); });
 
   m_InputManager->Update();
   ProcessInput(_TimeDelta);
 
   m_Camera->Update(_TimeDelta);
+
+  MEMORY_TAG_SCOPE(EMemoryTag::ECS);
   m_World->Update(_TimeDelta);
 }
 
+void CEngine::UpdateEventsAndResources(float _TimeDelta)
+{
+  m_EventsManager->Update(_TimeDelta);
+  m_ResourceManager->Update(_TimeDelta);
+}
+
+TFramePacket CEngine::BuildFramePacket()
+{
+  MEMORY_TAG_SCOPE(EMemoryTag::Render);
+
+  // Dies with the frame, so it takes the memory from its arena instead of the heap
+  TFramePacket Packet(m_FrameArena.GetResource());
+  Packet.Queue.Reserve(m_LastCommandsCount);
+
+  Packet.FrameData.Camera = TFrameData::TCamera{
+      .Position   = m_Camera->GetPosition(),
+      .View       = m_Camera->GetView(),
+      .Projection = m_Camera->GetPerspectiveProjection(),
+  };
+
+  m_World->Collect(Packet.FrameData);
+  m_World->Collect(Packet.Queue);
+  m_LastCommandsCount = Packet.Queue.GetSize();
+
+  return Packet;
+}
+
 void CEngine::Render(IRenderer &_Renderer)
 {
-  CRenderQueue RenderQueue;
-  TFrameData   FrameData;
+  {
+    TFramePacket Packet = BuildFramePacket();
 
-  m_World->Collect(FrameData);
-  m_World->Collect(RenderQueue);
+    MEMORY_TAG_SCOPE(EMemoryTag::Render);
+    m_RenderPipeline->Render(Packet.FrameData, Packet.Queue, _Renderer);
+  }
 
-  m_RenderPipeline->Render(FrameData, RenderQueue, _Renderer);
+  RenderEditor();
+}
 
+void CEngine::RenderEditor()
+{
 #if DEV_STAGE
-  m_EditorUI->RenderFrame();
+  if (m_EditorUI)
+  {
+    MEMORY_TAG_SCOPE(EMemoryTag::Editor);
+    m_EditorUI->RenderFrame();
+  }
 #endif
 }
 
@@ -178,6 +329,16 @@ float CEngine::GetApplicationRunningTime() const
   return static_cast<float>(glfwGetTime());
 }
 
+uint32_t CEngine::GetFrameHeapAllocations() const
+{
+  return static_cast<uint32_t>(utils::GetCPUAllocationsCount() - m_FrameStartAllocations);
+}
+
+const utils::CFrameArena &CEngine::GetFrameArena() const
+{
+  return m_FrameArena;
+}
+
 TVector2i CEngine::GetWindowSize() const
 {
   return m_Display->GetSize();
@@ -186,9 +347,12 @@ TVector2i CEngine::GetWindowSize() const
 TVector2i CEngine::GetViewportSize() const
 {
 #if DEV_STAGE
-  TVector2i ViewportSize = m_EditorUI->GetViewportSize();
-  if (ViewportSize.X > 0 && ViewportSize.Y > 0)
-    return ViewportSize;
+  if (m_EditorUI)
+  {
+    TVector2i ViewportSize = m_EditorUI->GetViewportSize();
+    if (ViewportSize.X > 0 && ViewportSize.Y > 0)
+      return ViewportSize;
+  }
 #endif
   return GetWindowSize();
 }
@@ -5,7 +5,10 @@
 #include <common/interfaces/Shutdownable.h>
 #include <common/Sharable.h>
 #include <common/MathTypes.h>
+#include <common/FrameArena.h>
+#include "Benchmark.h"
 #include <memory>
+#include <optional>
 
 class CWorld;
 class CShader;
@@ -17,6 +20,8 @@ class CInputManager;
 class CEventsManager;
 class IRenderPipeline;
 class IRenderer;
+class CRenderThread;
+struct TFramePacket;
 
 namespace editor
 {
@@ -38,7 +43,7 @@ public:
 
   void Shutdown() override;
 
-  int Init();
+  int Init(std::optional<TBenchmarkOptions> _BenchmarkOptions = std::nullopt);
   int Run();
 
 public:
@@ -57,11 +62,20 @@ public:
   float GetFPS() const;
   float GetApplicationRunningTime() const;
 
+  uint32_t GetFrameHeapAllocations() const; // Since the frame began, counted only with MEMORY_TRACKING
+  const utils::CFrameArena &GetFrameArena() const;
+
   void OnEvent(const TEvent &_Event) override;
 
 private:
-  void Render(IRenderer &_Renderer);
+  int RunBenchmark(IRenderer &_Renderer);
+  int RunPipelined(IRenderer &_Renderer);
+  void BeginFrame();
   void Update(float _TimeDelta) override;
+  void UpdateEventsAndResources(float _TimeDelta); // May call GL
+  TFramePacket BuildFramePacket();
+  void Render(IRenderer &_Renderer);
+  void RenderEditor();
 
   void SetFrameTime(float _Time);
 
@@ -85,6 +99,10 @@ private:
   float m_FrameTime;
   bool  m_RequestShutdown;
 
+  utils::CFrameArena m_FrameArena; // Transient data of the frames, the render queue and the frame data
+  uint64_t           m_FrameStartAllocations;
+  size_t             m_LastCommandsCount;
+
   std::shared_ptr<CDisplay>         m_Display;
   std::shared_ptr<CInputManager>    m_InputManager;
   std::shared_ptr<CEventsManager>   m_EventsManager;
@@ -92,6 +110,8 @@ private:
   std::shared_ptr<CWorld>           m_World;
   std::shared_ptr<CResourceManager> m_ResourceManager;
   std::shared_ptr<IRenderPipeline>  m_RenderPipeline;
+  std::unique_ptr<CBenchmark>       m_Benchmark;
+  std::unique_ptr<CRenderThread>    m_RenderThread; // Only while running pipelined
 
 #if DEV_STAGE
   std::shared_ptr<editor::CEditorUI> m_EditorUI;
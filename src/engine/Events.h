@@ -20,10 +20,18 @@ enum class TEventType
   Config_GammaCorrectionEnabledChanged,
   Config_GammaChanged,
   Config_SSAOEnabledChanged,
+  Config_OcclusionCullingEnabledChanged,
+  Config_GPUOcclusionCullingEnabledChanged,
+  Config_RetainedRenderListEnabledChanged,
+  Config_ParallelCollectEnabledChanged,
+  Config_SpatialCullingEnabledChanged,
+  Config_LODEnabledChanged,
+  Config_ShadowLODBiasChanged,
   Config_GizmoEnabledChanged,
   Config_GridEnabledChanged,
   Config_WireframeEnabledChanged,
   Config_WireframeColorChanged,
+  Config_SpatialTreeOverlayEnabledChanged,
   Config_BloomEnabledChanged,
   Config_BloomThresholdChanged,
   Config_BloomIntensityChanged,
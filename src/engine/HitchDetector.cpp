@@ -0,0 +1,205 @@
+#include "pch.h"
+
+#include "HitchDetector.h"
+#include "Engine.h"
+#include "ResourceManager.h"
+#include "StatsRecorder.h"
+#include "utils/Json.h"
+#include <common/Logger.h>
+
+namespace
+{
+
+nlohmann::json StateChangesToJson(const TRenderStateChanges &_Changes)
+{
+  return nlohmann::json{
+      {"ShaderSwitches", _Changes.ShaderSwitches},
+      {"TextureBinds", _Changes.TextureBinds},
+      {"VAOBinds", _Changes.VAOBinds},
+      {"UniformUploads", _Changes.UniformUploads},
+      {"FBOBinds", _Changes.FBOBinds},
+      {"BlendChanges", _Changes.BlendChanges},
+      {"CullChanges", _Changes.CullChanges},
+      {"DepthChanges", _Changes.DepthChanges},
+  };
+}
+
+nlohmann::json RecordToJson(const TFrameStatsRecord &_Record)
+{
+  nlohmann::json Passes;
+  for (size_t i = 0; i < RENDER_PASS_GROUPS_COUNT; ++i)
+  {
+    Passes[std::string(GetRenderPassGroupName(RENDER_PASS_GROUPS[i]))] = {
+        {"CPU", _Record.PassCPUTimes[i]},
+        {"GPU", _Record.PassGPUTimes[i]},
+        {"DrawCalls", _Record.PassDrawCalls[i]},
+        {"Triangles", _Record.PassTriangles[i]},
+        {"StateChanges", StateChangesToJson(_Record.PassStateChanges[i])},
+    };
+  }
+
+  return nlohmann::json{
+      {"FrameIndex", _Record.FrameIndex},
+      {"FrameTime", _Record.FrameTime},
+      {"Passes", std::move(Passes)},
+      {"DrawCalls", _Record.DrawCalls},
+      {"Vertices", _Record.Vertices},
+      {"Indices", _Record.Indices},
+      {"Triangles", _Record.Triangles},
+      {"Lines", _Record.Lines},
+      {"Points", _Record.Points},
+      {"StateChanges", StateChangesToJson(_Record.StateChanges)},
+      {"TextureUnitBinds", _Record.TextureUnitBinds},
+      {"AssetLoads", _Record.AssetLoads},
+      {"AssetsCount", _Record.AssetsCount},
+      {"HeapAllocations", _Record.HeapAllocations},
+      {"FrameArenaUsage", _Record.FrameArenaUsage},
+      {"MemoryUsage", _Record.MemoryUsage},
+      {"PeakMemoryUsage", _Record.PeakMemoryUsage},
+  };
+}
+
+} // namespace
+
+CHitchDetector::CHitchDetector() :
+    m_Histogram(MAX_FRAME_TIME),
+    m_Threshold(2.0f),
+    m_FrameIndex(0),
+    m_HitchesCount(0),
+    m_LastLoadedAssetsCount(0)
+{
+}
+
+void CHitchDetector::OnFrame(const IRenderPipeline &_RenderPipeline, float _FrameTime)
+{
+  const uint32_t LoadedAssetsCount = CEngine::Instance().GetResourceManager()->GetLoadedAssetsCount();
+
+  TFrameStatsRecord Record = CStatsRecorder::Capture(_RenderPipeline, _FrameTime);
+  Record.FrameIndex        = m_FrameIndex++;
+  Record.AssetLoads        = m_FrameIndex > 1 ? LoadedAssetsCount - m_LastLoadedAssetsCount : 0;
+
+  m_LastLoadedAssetsCount = LoadedAssetsCount;
+
+  if (m_Histogram.GetCount() >= MIN_SAMPLES)
+  {
+    const float Median = GetPercentile(50.0f);
+    if (_FrameTime > Median * m_Threshold)
+    {
+      m_HitchesCount++;
+
+      // A hitch inside the following frames of another one is already part of its trace
+      if (!m_PendingTrace)
+      {
+        m_PendingTrace.emplace(THitchTrace{
+            .FrameIndex = Record.FrameIndex,
+            .Median     = Median,
+            .Frames     = std::vector<TFrameStatsRecord>(m_RecentFrames.begin(), m_RecentFrames.end()),
+        });
+      }
+    }
+  }
+
+  if (m_PendingTrace)
+  {
+    m_PendingTrace->Frames.push_back(Record);
+
+    if (Record.FrameIndex - m_PendingTrace->FrameIndex >= FOLLOWING_FRAMES)
+    {
+      if (m_Traces.size() == MAX_TRACES)
+        m_Traces.pop_front();
+
+      m_Traces.push_back(std::move(*m_PendingTrace));
+      m_PendingTrace.reset();
+    }
+  }
+
+  const uint64_t FrameTimeUs = static_cast<uint64_t>(_FrameTime * 1000.0f);
+  m_Histogram.Record(FrameTimeUs);
+  m_Window.push_back(FrameTimeUs);
+  if (m_Window.size() > WINDOW_SIZE)
+  {
+    m_Histogram.Remove(m_Window.front());
+    m_Window.pop_front();
+  }
+
+  m_RecentFrames.push_back(Record);
+  if (m_RecentFrames.size() > PRECEDING_FRAMES)
+    m_RecentFrames.pop_front();
+}
+
+void CHitchDetector::Reset()
+{
+  m_Histogram.Reset();
+  m_Window.clear();
+  m_RecentFrames.clear();
+  m_Traces.clear();
+  m_PendingTrace.reset();
+  m_HitchesCount = 0;
+}
+
+float CHitchDetector::GetPercentile(float _Percent) const
+{
+  return m_Histogram.GetPercentile(_Percent) / 1000.0f;
+}
+
+uint32_t CHitchDetector::GetHitchesCount() const
+{
+  return m_HitchesCount;
+}
+
+const std::deque<THitchTrace> &CHitchDetector::GetTraces() const
+{
+  return m_Traces;
+}
+
+void CHitchDetector::SetThreshold(float _Threshold)
+{
+  m_Threshold = _Threshold;
+}
+
+float CHitchDetector::GetThreshold() const
+{
+  return m_Threshold;
+}
+
+bool CHitchDetector::Dump(const std::filesystem::path &_Path) const
+{
+  nlohmann::json Traces = nlohmann::json::array();
+  for (const THitchTrace &Trace : m_Traces)
+  {
+    nlohmann::json Frames = nlohmann::json::array();
+    for (const TFrameStatsRecord &Record : Trace.Frames)
+      Frames.push_back(RecordToJson(Record));
+
+    Traces.push_back({
+        {"FrameIndex", Trace.FrameIndex},
+        {"Median", Trace.Median},
+        {"Frames", std::move(Frames)},
+    });
+  }
+
+  const nlohmann::json Dump = {
+      {"Threshold", m_Threshold},
+      {"HitchesCount", m_HitchesCount},
+      {"Percentiles",
+       {
+           {"P50", GetPercentile(50.0f)},
+           {"P90", GetPercentile(90.0f)},
+           {"P99", GetPercentile(99.0f)},
+           {"P99.9", GetPercentile(99.9f)},
+       }},
+      {"Traces", std::move(Traces)},
+  };
+
+  std::ofstream File(_Path);
+  if (!File.is_open())
+  {
+    CLogger::Log(ELogType::Error, "[CHitchDetector] Failed to open file: {}", _Path.string());
+    return false;
+  }
+
+  File << Dump.dump(2);
+
+  CLogger::Log(ELogType::Info, "[CHitchDetector] {} hitch traces saved: {}", m_Traces.size(), _Path.string());
+  return true;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "StatsRecord.h"
+#include <common/containers/HdrHistogram.h>
+#include <deque>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+class IRenderPipeline;
+
+struct THitchTrace
+{
+  uint32_t                       FrameIndex; // Index of the hitch frame
+  float                          Median;     // ms, at the moment of detection
+  std::vector<TFrameStatsRecord> Frames;     // Preceding frames, the hitch frame and the following ones
+};
+
+// Tracks rolling frame-time percentiles and captures full per-frame stats around frames
+// that take longer than a multiple of the median. GPU times arrive a few frames late,
+// so every trace also keeps a couple of frames after the hitch.
+class CHitchDetector final
+{
+public:
+  CHitchDetector();
+
+  void OnFrame(const IRenderPipeline &_RenderPipeline, float _FrameTime);
+  void Reset();
+
+  float GetPercentile(float _Percent) const; // ms
+  uint32_t GetHitchesCount() const;
+  const std::deque<THitchTrace> &GetTraces() const;
+
+  void SetThreshold(float _Threshold);
+  float GetThreshold() const;
+
+  bool Dump(const std::filesystem::path &_Path) const;
+
+private:
+  static constexpr size_t   WINDOW_SIZE      = 1000; // Frames in the rolling percentiles
+  static constexpr size_t   MIN_SAMPLES      = 60;   // Frames before detection starts
+  static constexpr size_t   PRECEDING_FRAMES = 8;
+  static constexpr size_t   FOLLOWING_FRAMES = 4;
+  static constexpr size_t   MAX_TRACES       = 16;
+  static constexpr uint64_t MAX_FRAME_TIME   = 60ull * 1000 * 1000; // us
+
+  CHdrHistogram                 m_Histogram;
+  std::deque<uint64_t>          m_Window; // us
+  std::deque<TFrameStatsRecord> m_RecentFrames;
+  std::deque<THitchTrace>       m_Traces;
+  std::optional<THitchTrace>    m_PendingTrace;
+  float                         m_Threshold;
+  uint32_t                      m_FrameIndex;
+  uint32_t                      m_HitchesCount;
+  uint32_t                      m_LastLoadedAssetsCount;
+};
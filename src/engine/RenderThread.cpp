@@ -0,0 +1,136 @@
+#include "pch.h"
+
+#include "RenderThread.h"
+#include "Display.h"
+#include "interfaces/RenderPipeline.h"
+#include "utils/Memory.h"
+#include <cassert>
+
+CRenderThread::CRenderThread(CDisplay &_Display, IRenderPipeline &_RenderPipeline, IRenderer &_Renderer) :
+    m_Display(_Display),
+    m_RenderPipeline(_RenderPipeline),
+    m_Renderer(_Renderer),
+    m_QueuedPackets(0),
+    m_IsContextLent(false),
+    m_IsStopping(false)
+{
+}
+
+CRenderThread::~CRenderThread()
+{
+  Stop();
+}
+
+void CRenderThread::Start()
+{
+  assert(!m_Thread.joinable());
+
+  m_IsStopping = false;
+
+  m_Display.ReleaseContext();
+  m_Thread = std::thread(&CRenderThread::ThreadLoop, this);
+}
+
+void CRenderThread::Stop()
+{
+  if (!m_Thread.joinable())
+    return;
+
+  {
+    std::lock_guard Lock(m_Mutex);
+    m_IsStopping = true;
+  }
+  m_StateChanged.notify_all();
+
+  m_Thread.join();
+  m_Display.MakeContextCurrent();
+}
+
+void CRenderThread::Submit(TFramePacket _Packet)
+{
+  assert(m_Thread.joinable());
+
+  {
+    std::unique_lock Lock(m_Mutex);
+    m_StateChanged.wait(Lock, [this] { return m_QueuedPackets < MAX_QUEUED_PACKETS; });
+
+    m_Items.push_back(TItem{.Packet = std::move(_Packet)});
+    ++m_QueuedPackets;
+  }
+  m_StateChanged.notify_all();
+}
+
+void CRenderThread::RunWithContext(const std::function<void()> &_Task)
+{
+  assert(m_Thread.joinable());
+
+  {
+    std::unique_lock Lock(m_Mutex);
+    m_Items.emplace_back().IsContextRequest = true;
+    m_StateChanged.notify_all();
+
+    m_StateChanged.wait(Lock, [this] { return m_IsContextLent; });
+  }
+
+  m_Display.MakeContextCurrent();
+  _Task();
+  m_Display.ReleaseContext();
+
+  {
+    std::lock_guard Lock(m_Mutex);
+    m_IsContextLent = false;
+  }
+  m_StateChanged.notify_all();
+}
+
+void CRenderThread::ThreadLoop()
+{
+  MEMORY_TAG_SCOPE(EMemoryTag::Render);
+
+  m_Display.MakeContextCurrent();
+
+  std::unique_lock Lock(m_Mutex);
+  while (true)
+  {
+    m_StateChanged.wait(Lock, [this] { return m_IsStopping || !m_Items.empty(); });
+
+    // Stopping only once everything submitted is done
+    if (m_Items.empty())
+      break;
+
+    // Destroyed at the end of the iteration, before the next packet is taken and the main thread
+    // is let through to reuse the arena it was built in
+    TItem Item = std::move(m_Items.front());
+    m_Items.pop_front();
+
+    if (Item.IsContextRequest)
+    {
+      LendContext(Lock);
+      continue;
+    }
+
+    // The packet is out of the queue, the main thread may submit the next one while this renders
+    --m_QueuedPackets;
+    Lock.unlock();
+    m_StateChanged.notify_all();
+
+    m_RenderPipeline.Render(Item.Packet.FrameData, Item.Packet.Queue, m_Renderer);
+    if (Item.Packet.ShouldPresent)
+      m_Display.SwapBuffers();
+
+    Lock.lock();
+  }
+
+  m_Display.ReleaseContext();
+}
+
+void CRenderThread::LendContext(std::unique_lock<std::mutex> &_Lock)
+{
+  m_Display.ReleaseContext();
+
+  m_IsContextLent = true;
+  m_StateChanged.notify_all();
+  m_StateChanged.wait(_Lock, [this] { return !m_IsContextLent; });
+
+  m_Display.MakeContextCurrent();
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "render/FramePacket.h"
+#include <common/Core.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+class CDisplay;
+class IRenderPipeline;
+class IRenderer;
+
+// Owns the GL context and renders the submitted frame packets in order, so the main thread can
+// simulate the next frame meanwhile. One packet is rendered while at most MAX_QUEUED_PACKETS
+// wait, a submit beyond that blocks until the render thread catches up.
+//
+// The main thread never calls GL on its own while the thread runs: work that needs the context
+// (event handlers, asset unloading, the editor) goes through RunWithContext, which waits for the
+// render thread to go idle and lends the context for the call. The world isn't rendered from
+// directly, so nothing else has to be synchronized.
+class CRenderThread final
+{
+  DISABLE_CLASS_COPY(CRenderThread);
+
+public:
+  CRenderThread(CDisplay &_Display, IRenderPipeline &_RenderPipeline, IRenderer &_Renderer);
+  ~CRenderThread();
+
+  void Start(); // Takes the GL context from the calling thread
+  void Stop();  // Renders what's submitted, then gives the context back to the calling thread
+
+  void Submit(TFramePacket _Packet);
+
+  // Runs _Task on the calling thread with the GL context current, once the submitted packets are rendered
+  void RunWithContext(const std::function<void()> &_Task);
+
+private:
+  struct TItem
+  {
+    TFramePacket Packet;
+    bool         IsContextRequest = false; // No packet, the context is lent to the submitting thread instead
+  };
+
+  void ThreadLoop();
+  void LendContext(std::unique_lock<std::mutex> &_Lock);
+
+private:
+  static constexpr size_t MAX_QUEUED_PACKETS = 1;
+
+  CDisplay        &m_Display;
+  IRenderPipeline &m_RenderPipeline;
+  IRenderer       &m_Renderer;
+
+  std::thread             m_Thread;
+  std::mutex              m_Mutex;
+  std::condition_variable m_StateChanged;
+
+  // Guarded by m_Mutex
+  std::deque<TItem> m_Items;
+  size_t            m_QueuedPackets;
+  bool              m_IsContextLent;
+  bool              m_IsStopping;
+};
@@ -7,6 +7,8 @@
 #include "assets/Texture.h"
 #include "assets/TextureParams.h"
 #include "assets/TinyGLTFParseStrategy.h"
+#include "render/Sampler.h"
+#include "utils/Memory.h"
 #include <common/Logger.h>
 #include <common/Passkey.h>
 
@@ -22,6 +24,9 @@ static bool IsFormatSupported(const std::filesystem::path &_Path)
 
 CResourceManager::CResourceManager() :
     m_Assets(),
+    m_MaterialBuffer(),
+    m_GeometryPool(),
+    m_LoadedAssetsCount(0),
     m_IsPruneScheduled(false)
 {
 }
@@ -29,6 +34,9 @@ CResourceManager::CResourceManager() :
 void CResourceManager::Init()
 {
   event::Subscribe(TEventType::EntityRemoved, GetWeakPtr());
+
+  m_MaterialBuffer = CMaterialBuffer::Create();
+  m_GeometryPool   = CGeometryPool::Create();
 }
 
 void CResourceManager::Shutdown()
@@ -36,6 +44,9 @@ void CResourceManager::Shutdown()
   for (auto &[Path, Asset] : m_Assets)
     Asset->Shutdown();
   m_Assets.clear();
+  CSamplerCache::Clear();
+  m_MaterialBuffer.reset();
+  m_GeometryPool.reset();
 }
 
 void CResourceManager::Update(float _TimeDelta)
@@ -70,9 +81,11 @@ std::shared_ptr<CModel> CResourceManager::LoadModel(const std::filesystem::path
   auto Iter = m_Assets.find(PathStr);
   if (Iter == m_Assets.end())
   {
+    MEMORY_TAG_SCOPE(EMemoryTag::Assets);
+
     std::shared_ptr<IAsset> Model = std::make_shared<CModel>(std::make_unique<CTinyGLTFParseStrategy>());
     if (Model->Load(_Path, CPasskey(this)))
-      Iter = m_Assets.emplace(std::move(PathStr), std::move(Model)).first;
+      Iter = RegisterAsset(std::move(PathStr), std::move(Model));
     else
       return nullptr;
   }
@@ -88,9 +101,11 @@ std::shared_ptr<CShader> CResourceManager::LoadShader(const std::string &_Name)
   auto Iter = m_Assets.find(ShaderPathStr);
   if (Iter == m_Assets.end())
   {
+    MEMORY_TAG_SCOPE(EMemoryTag::Assets);
+
     std::shared_ptr<IAsset> Shader = std::make_shared<CShader>();
     if (Shader->Load(ShaderPath, CPasskey(this)))
-      Iter = m_Assets.emplace(std::move(ShaderPathStr), std::move(Shader)).first;
+      Iter = RegisterAsset(std::move(ShaderPathStr), std::move(Shader));
     else
       return nullptr;
   }
@@ -110,9 +125,11 @@ std::shared_ptr<CTexture> CResourceManager::LoadTexture(const std::filesystem::p
 
   if (Iter == m_Assets.end())
   {
+    MEMORY_TAG_SCOPE(EMemoryTag::Assets);
+
     std::shared_ptr<CTexture> Texture = std::make_shared<C2DTexture>();
     if (Texture->Load(_Path, CPasskey(this)))
-      Iter = m_Assets.emplace(std::move(PathStr), std::move(Texture)).first;
+      Iter = RegisterAsset(std::move(PathStr), std::move(Texture));
     else
       return nullptr;
   }
@@ -127,9 +144,11 @@ std::shared_ptr<CTexture> CResourceManager::LoadTexture(const std::filesystem::p
 
   if (Iter == m_Assets.end())
   {
+    MEMORY_TAG_SCOPE(EMemoryTag::Assets);
+
     std::shared_ptr<CTexture> Texture = std::make_shared<C2DTexture>();
     if (Texture->Load(_Path, _Params, CPasskey(this)))
-      Iter = m_Assets.emplace(std::move(PathStr), std::move(Texture)).first;
+      Iter = RegisterAsset(std::move(PathStr), std::move(Texture));
     else
       return nullptr;
   }
@@ -144,9 +163,11 @@ std::shared_ptr<CTexture> CResourceManager::LoadCubemap(const std::filesystem::p
 
   if (Iter == m_Assets.end())
   {
+    MEMORY_TAG_SCOPE(EMemoryTag::Assets);
+
     std::shared_ptr<CTexture> Texture = std::make_shared<CCubemap>();
     if (Texture->Load(_Path, CPasskey(this)))
-      Iter = m_Assets.emplace(std::move(PathStr), std::move(Texture)).first;
+      Iter = RegisterAsset(std::move(PathStr), std::move(Texture));
     else
       return nullptr;
   }
@@ -165,9 +186,11 @@ std::shared_ptr<CTexture> CResourceManager::CreateCubemap(const std::string &_Na
   auto Iter = m_Assets.find(_Name);
   if (Iter == m_Assets.end())
   {
+    MEMORY_TAG_SCOPE(EMemoryTag::Assets);
+
     std::shared_ptr<CTexture> Texture = std::make_shared<CCubemap>();
     if (Texture->Generate(_Params, CPasskey(this)))
-      Iter = m_Assets.emplace(_Name, std::move(Texture)).first;
+      Iter = RegisterAsset(_Name, std::move(Texture));
     else
       return nullptr;
   }
@@ -186,9 +209,11 @@ std::shared_ptr<CTexture> CResourceManager::CreateTexture(const std::string &_Na
   auto Iter = m_Assets.find(_Name);
   if (Iter == m_Assets.end())
   {
+    MEMORY_TAG_SCOPE(EMemoryTag::Assets);
+
     std::shared_ptr<CTexture> Texture = std::make_shared<C2DTexture>();
     if (Texture->Generate(_Params, CPasskey(this)))
-      Iter = m_Assets.emplace(_Name, std::move(Texture)).first;
+      Iter = RegisterAsset(_Name, std::move(Texture));
     else
       return nullptr;
   }
@@ -215,6 +240,39 @@ std::filesystem::path CResourceManager::GetDefaultTexturePath(ETextureType _Text
   }
 }
 
+uint32_t CResourceManager::GetLoadedAssetsCount() const
+{
+  return m_LoadedAssetsCount;
+}
+
+uint32_t CResourceManager::GetAssetsCount() const
+{
+  return static_cast<uint32_t>(m_Assets.size());
+}
+
+std::shared_ptr<CMaterialBuffer::CHandle> CResourceManager::CreateMaterial(const TShaderMaterial &_Material)
+{
+  assert(m_MaterialBuffer);
+  return m_MaterialBuffer->Add(_Material);
+}
+
+std::shared_ptr<CMaterialBuffer> CResourceManager::GetMaterialBuffer() const
+{
+  return m_MaterialBuffer;
+}
+
+std::shared_ptr<CGeometryPool::CAllocation> CResourceManager::AllocateGeometry(const TGeometryData &_Geometry)
+{
+  assert(m_GeometryPool);
+  return m_GeometryPool->Allocate(_Geometry);
+}
+
+CResourceManager::TAssetsMap::iterator CResourceManager::RegisterAsset(std::string _Name, std::shared_ptr<IAsset> _Asset)
+{
+  ++m_LoadedAssetsCount;
+  return m_Assets.emplace(std::move(_Name), std::move(_Asset)).first;
+}
+
 void CResourceManager::Retire(const std::string &_Name)
 {
   const auto It = m_Assets.find(_Name);
@@ -230,6 +288,11 @@ void CResourceManager::Prune()
   m_IsPruneScheduled = true;
 }
 
+bool CResourceManager::IsPruneScheduled() const
+{
+  return m_IsPruneScheduled;
+}
+
 void CResourceManager::UnloadUnusedAssets()
 {
   for (auto It = m_Assets.begin(); It != m_Assets.end();)
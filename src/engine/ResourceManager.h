@@ -1,6 +1,8 @@
 #pragma once
 
 #include "assets/TextureParams.h"
+#include "render/GeometryPool.h"
+#include "render/MaterialBuffer.h"
 #include <events/EventsListener.h>
 #include <common/interfaces/Shutdownable.h>
 #include <common/Sharable.h>
@@ -16,6 +18,8 @@ class CResourceManager final : public CSharable<CResourceManager>,
                                public IUpdateable,
                                public IShutdownable
 {
+  using TAssetsMap = std::map<std::string, std::shared_ptr<IAsset>>;
+
 public:
   CResourceManager();
 
@@ -36,16 +40,30 @@ public:
   std::shared_ptr<CTexture> CreateCubemap(const std::string &_Name, const TTextureParams &_Params);
   std::shared_ptr<CTexture> CreateTexture(const std::string &_Name, const TTextureParams &_Params);
 
+  std::shared_ptr<CMaterialBuffer::CHandle> CreateMaterial(const TShaderMaterial &_Material);
+  std::shared_ptr<CMaterialBuffer> GetMaterialBuffer() const;
+
+  std::shared_ptr<CGeometryPool::CAllocation> AllocateGeometry(const TGeometryData &_Geometry);
+
   void Retire(const std::string &_Name);
   void Prune();
+  bool IsPruneScheduled() const;
+
+  // Total number of assets loaded or generated since start
+  uint32_t GetLoadedAssetsCount() const;
+  uint32_t GetAssetsCount() const;
 
 private:
+  TAssetsMap::iterator RegisterAsset(std::string _Name, std::shared_ptr<IAsset> _Asset);
   void UnloadUnusedAssets();
 
 private:
   static std::filesystem::path GetDefaultTexturePath(ETextureType _TextureType);
 
 private:
-  std::map<std::string, std::shared_ptr<IAsset>> m_Assets;
-  bool                                           m_IsPruneScheduled;
+  TAssetsMap                       m_Assets;
+  std::shared_ptr<CMaterialBuffer> m_MaterialBuffer;
+  std::shared_ptr<CGeometryPool>   m_GeometryPool;
+  uint32_t                         m_LoadedAssetsCount;
+  bool                             m_IsPruneScheduled;
 };
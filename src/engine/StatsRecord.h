@@ -0,0 +1,55 @@
+#pragma once
+
+#include "render/RenderStats.h"
+#include <array>
+#include <cstdint>
+
+// Binary layout of a stats recording: one TStatsFileHeader followed by TFrameStatsRecord entries.
+// Every record has the same size, so a recording can be read (or truncated) at any frame boundary.
+// Bump STATS_FILE_VERSION whenever TFrameStatsRecord changes.
+
+inline constexpr uint32_t STATS_FILE_MAGIC   = 0x53544552; // "RETS"
+inline constexpr uint32_t STATS_FILE_VERSION = 3;
+
+struct TStatsFileHeader
+{
+  uint32_t Magic      = STATS_FILE_MAGIC;
+  uint32_t Version    = STATS_FILE_VERSION;
+  uint32_t RecordSize = 0;
+  uint32_t PassCount  = 0;
+};
+
+struct TFrameStatsRecord
+{
+  uint32_t FrameIndex = 0;
+  float    FrameTime  = 0.0f; // ms
+
+  std::array<float, RENDER_PASS_GROUPS_COUNT>    PassCPUTimes{};
+  std::array<float, RENDER_PASS_GROUPS_COUNT>    PassGPUTimes{};
+  std::array<uint32_t, RENDER_PASS_GROUPS_COUNT> PassDrawCalls{};
+  std::array<uint32_t, RENDER_PASS_GROUPS_COUNT> PassTriangles{};
+
+  std::array<TRenderStateChanges, RENDER_PASS_GROUPS_COUNT> PassStateChanges{};
+
+  uint32_t DrawCalls = 0;
+  uint32_t Vertices  = 0;
+  uint32_t Indices   = 0;
+  uint32_t Triangles = 0;
+  uint32_t Lines     = 0;
+  uint32_t Points    = 0;
+
+  TRenderStateChanges StateChanges;
+  TTextureUnitBinds   TextureUnitBinds{};
+
+  uint32_t AssetLoads  = 0; // Assets loaded during the frame
+  uint32_t AssetsCount = 0;
+
+  uint32_t HeapAllocations = 0; // During the frame, 0 without MEMORY_TRACKING
+  uint32_t FrameArenaUsage = 0; // bytes
+
+  uint64_t MemoryUsage     = 0; // bytes
+  uint64_t PeakMemoryUsage = 0; // bytes
+};
+
+static_assert(sizeof(TStatsFileHeader) == 16);
+static_assert(sizeof(TFrameStatsRecord) == 512, "Record layout changed, bump STATS_FILE_VERSION");
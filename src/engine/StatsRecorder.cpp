@@ -0,0 +1,130 @@
+#include "pch.h"
+
+#include "StatsRecorder.h"
+#include "Engine.h"
+#include "ResourceManager.h"
+#include "interfaces/RenderPipeline.h"
+#include "utils/Memory.h"
+#include <common/Logger.h>
+
+CStatsRecorder::CStatsRecorder() :
+    m_RecordsCount(0),
+    m_LastLoadedAssetsCount(0)
+{
+}
+
+CStatsRecorder::~CStatsRecorder()
+{
+  Stop();
+}
+
+bool CStatsRecorder::Start(const std::filesystem::path &_Path)
+{
+  Stop();
+
+  m_File.open(_Path, std::ios::binary | std::ios::trunc);
+  if (!m_File.is_open())
+  {
+    CLogger::Log(ELogType::Error, "[CStatsRecorder] Failed to open file: {}", _Path.string());
+    return false;
+  }
+
+  const TStatsFileHeader Header{
+      .RecordSize = sizeof(TFrameStatsRecord),
+      .PassCount  = RENDER_PASS_GROUPS_COUNT,
+  };
+  m_File.write(reinterpret_cast<const char *>(&Header), sizeof(Header));
+
+  m_Path                  = _Path;
+  m_RecordsCount          = 0;
+  m_LastLoadedAssetsCount = CEngine::Instance().GetResourceManager()->GetLoadedAssetsCount();
+  m_Pending.reserve(FLUSH_THRESHOLD);
+
+  CLogger::Log(ELogType::Info, "[CStatsRecorder] Recording started: {}", m_Path.string());
+  return true;
+}
+
+void CStatsRecorder::Stop()
+{
+  if (!IsRecording())
+    return;
+
+  Flush();
+  m_File.close();
+
+  CLogger::Log(ELogType::Info, "[CStatsRecorder] Recording stopped: {}. Frames: {}", m_Path.string(), m_RecordsCount);
+}
+
+bool CStatsRecorder::IsRecording() const
+{
+  return m_File.is_open();
+}
+
+uint32_t CStatsRecorder::GetRecordsCount() const
+{
+  return m_RecordsCount;
+}
+
+const std::filesystem::path &CStatsRecorder::GetPath() const
+{
+  return m_Path;
+}
+
+void CStatsRecorder::Record(const IRenderPipeline &_RenderPipeline, float _FrameTime)
+{
+  if (!IsRecording())
+    return;
+
+  const uint32_t LoadedAssetsCount = CEngine::Instance().GetResourceManager()->GetLoadedAssetsCount();
+
+  TFrameStatsRecord &Record = m_Pending.emplace_back(Capture(_RenderPipeline, _FrameTime));
+  Record.FrameIndex         = m_RecordsCount++;
+  Record.AssetLoads         = LoadedAssetsCount - m_LastLoadedAssetsCount;
+
+  m_LastLoadedAssetsCount = LoadedAssetsCount;
+
+  if (m_Pending.size() >= FLUSH_THRESHOLD)
+    Flush();
+}
+
+TFrameStatsRecord CStatsRecorder::Capture(const IRenderPipeline &_RenderPipeline, float _FrameTime)
+{
+  TFrameStatsRecord Record;
+  Record.FrameTime = _FrameTime;
+
+  for (size_t i = 0; i < RENDER_PASS_GROUPS_COUNT; ++i)
+  {
+    const TRenderPassStats Stats = _RenderPipeline.GetRenderPassStats(RENDER_PASS_GROUPS[i]);
+    Record.PassCPUTimes[i]       = Stats.CPUTime;
+    Record.PassGPUTimes[i]       = Stats.GPUTime;
+    Record.PassDrawCalls[i]      = Stats.DrawCalls;
+    Record.PassTriangles[i]      = Stats.Triangles;
+    Record.PassStateChanges[i]   = Stats.StateChanges;
+  }
+
+  Record.DrawCalls        = _RenderPipeline.GetDrawCallsCount();
+  Record.Vertices         = _RenderPipeline.GetVerticesCount();
+  Record.Indices          = _RenderPipeline.GetIndicesCount();
+  Record.Triangles        = _RenderPipeline.GetTrianglesCount();
+  Record.Lines            = _RenderPipeline.GetLinesCount();
+  Record.Points           = _RenderPipeline.GetPointsCount();
+  Record.StateChanges     = _RenderPipeline.GetStateChanges();
+  Record.TextureUnitBinds = _RenderPipeline.GetTextureUnitBinds();
+  Record.AssetsCount      = CEngine::Instance().GetResourceManager()->GetAssetsCount();
+  Record.MemoryUsage      = utils::GetMemoryUsage();
+  Record.PeakMemoryUsage  = utils::GetPeakMemoryUsage();
+  Record.HeapAllocations  = CEngine::Instance().GetFrameHeapAllocations();
+  Record.FrameArenaUsage  = static_cast<uint32_t>(CEngine::Instance().GetFrameArena().GetUsedSize());
+
+  return Record;
+}
+
+void CStatsRecorder::Flush()
+{
+  if (m_Pending.empty())
+    return;
+
+  m_File.write(reinterpret_cast<const char *>(m_Pending.data()), m_Pending.size() * sizeof(TFrameStatsRecord));
+  m_File.flush();
+  m_Pending.clear();
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "StatsRecord.h"
+#include <common/Core.h>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+class IRenderPipeline;
+
+// Appends a TFrameStatsRecord per frame to a binary file. Records are buffered and flushed in chunks
+class CStatsRecorder final
+{
+  DISABLE_CLASS_COPY(CStatsRecorder);
+
+public:
+  CStatsRecorder();
+  ~CStatsRecorder();
+
+  bool Start(const std::filesystem::path &_Path);
+  void Stop();
+
+  bool IsRecording() const;
+  uint32_t GetRecordsCount() const;
+  const std::filesystem::path &GetPath() const;
+
+  void Record(const IRenderPipeline &_RenderPipeline, float _FrameTime);
+
+  // Fills everything but FrameIndex and AssetLoads, which depend on the recording
+  static TFrameStatsRecord Capture(const IRenderPipeline &_RenderPipeline, float _FrameTime);
+
+private:
+  void Flush();
+
+private:
+  static constexpr size_t FLUSH_THRESHOLD = 256;
+
+  std::filesystem::path          m_Path;
+  std::ofstream                  m_File;
+  std::vector<TFrameStatsRecord> m_Pending;
+  uint32_t                       m_RecordsCount;
+  uint32_t                       m_LastLoadedAssetsCount;
+};
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <cstdint>
 #include <span>
 
 class IRenderer;
 struct TRenderCommand;
 struct TRenderContext;
 enum class ERenderPassType;
+enum ERenderFlags : uint32_t;
 
 class IRenderPass
 {
@@ -18,7 +20,7 @@ public:
   virtual void PreExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands)  = 0;
   virtual void Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands)     = 0;
   virtual void PostExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) = 0;
-  virtual bool Accepts(const TRenderCommand &_Command) const                                                    = 0;
+  virtual ERenderFlags GetAcceptedFlag() const                                                                  = 0; // Commands carrying it, ERenderFlags_Count for none
   virtual bool IsAvailable() const                                                                              = 0;
   virtual bool NeedsCommands() const                                                                            = 0;
 };
@@ -2,6 +2,7 @@
 
 #include <common/interfaces/Shutdownable.h>
 #include <common/MathTypes.h>
+#include "render/RenderStats.h"
 
 class IRenderer;
 class CRenderQueue;
@@ -16,14 +17,22 @@ public:
   virtual void Init(TVector2i _Viewport)                                                 = 0;
   virtual void Render(TFrameData &FrameData, CRenderQueue &_Queue, IRenderer &_Renderer) = 0;
 
-  virtual float GetRenderPassTime(ERenderPassType _Type) const = 0;
+  virtual float GetRenderPassTime(ERenderPassType _Type) const             = 0;
+  virtual float GetRenderPassGPUTime(ERenderPassType _Type) const          = 0;
+  virtual TRenderPassStats GetRenderPassStats(ERenderPassType _Type) const = 0;
 
-  virtual uint32_t GetDrawCallsCount() const     = 0;
-  virtual uint32_t GetVerticesCount() const      = 0;
-  virtual uint32_t GetIndicesCount() const       = 0;
-  virtual uint32_t GetTrianglesCount() const     = 0;
-  virtual uint32_t GetLinesCount() const         = 0;
-  virtual uint32_t GetPointsCount() const        = 0;
-  virtual uint32_t GetRenderTextureID() const    = 0;
-  virtual uint32_t GetShadowMapTextureID() const = 0;
+  virtual uint32_t GetDrawCallsCount() const           = 0;
+  virtual uint32_t GetVerticesCount() const            = 0;
+  virtual uint32_t GetIndicesCount() const             = 0;
+  virtual uint32_t GetTrianglesCount() const           = 0;
+  virtual uint32_t GetLinesCount() const               = 0;
+  virtual uint32_t GetPointsCount() const              = 0;
+  virtual uint32_t GetCulledObjectsCount() const       = 0;
+  virtual uint32_t GetCulledShadowCastersCount() const = 0;
+  virtual uint32_t GetOccludedObjectsCount() const     = 0;
+  virtual uint32_t GetRenderTextureID() const          = 0;
+  virtual uint32_t GetShadowMapTextureID() const       = 0;
+
+  virtual const TRenderStateChanges &GetStateChanges() const   = 0;
+  virtual const TTextureUnitBinds &GetTextureUnitBinds() const = 0;
 };
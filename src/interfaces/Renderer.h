@@ -1,13 +1,13 @@
 #pragma once
 
 #include <common/MathTypes.h>
+#include "render/RenderStats.h"
 #include "render/RenderTypes.h"
 #include "render/ShaderTypes.h"
 #include <memory>
 #include <string_view>
 
 class CShader;
-class CCamera;
 class CTexture;
 
 class IRenderer
@@ -21,9 +21,6 @@ public:
   virtual void Clear(EClearFlags _ClearFlags)   = 0;
   virtual void ClearColor(const TColor &_Color) = 0;
 
-  virtual void SetCamera(const std::shared_ptr<CCamera> &_Camera) = 0;
-  virtual const std::shared_ptr<CCamera> &GetCamera() const       = 0;
-
   virtual void SetShader(const std::shared_ptr<CShader> &_Shader)            = 0;
   virtual void SetUniform(std::string_view _Name, const UniformType &_Value) = 0;
   virtual const std::shared_ptr<CShader> &GetShader() const                  = 0;
@@ -34,6 +31,9 @@ public:
   virtual void DrawElements(EPrimitiveMode _Mode, int _Count, EIndexType _IndexType, const void *_Offset = nullptr) = 0;
   virtual void DrawArrays(EPrimitiveMode _Mode, int _Count)                                                         = 0;
 
+  // Draws commands from the bound GL_DRAW_INDIRECT_BUFFER, _IndicesCount is their sum and only feeds the stats
+  virtual void MultiDrawElementsIndirect(EPrimitiveMode _Mode, EIndexType _IndexType, const void *_Offset, int _DrawCount, int _IndicesCount) = 0;
+
   virtual void SetBlending(EAlphaMode _Mode) = 0;
   virtual void SetCullFace(ECullMode _Mode)  = 0;
   virtual void SetDepthTest(bool _Enable)    = 0;
@@ -46,4 +46,7 @@ public:
   virtual uint32_t GetTrianglesCount() const = 0;
   virtual uint32_t GetLinesCount() const     = 0;
   virtual uint32_t GetPointsCount() const    = 0;
+
+  virtual const TRenderStateChanges &GetStateChanges() const   = 0;
+  virtual const TTextureUnitBinds &GetTextureUnitBinds() const = 0;
 };
\ No newline at end of file
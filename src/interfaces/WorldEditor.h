@@ -1,6 +1,8 @@
 #pragma once
 
 #include <ecs/IEntitiesBroker.h>
+#include <glm/vec3.hpp>
+#include <optional>
 
 namespace ecs
 {
@@ -15,4 +17,7 @@ public:
 
   virtual ecs::TNameComponent *GetEntityName(ecs::TEntity _Entity) const     = 0;
   virtual ecs::TTransformComponent *GetTransform(ecs::TEntity _Entity) const = 0;
+
+  // Entity of the first collision box along the ray, one the origin is inside of comes first
+  virtual std::optional<ecs::TEntity> PickEntity(const glm::vec3 &_Origin, const glm::vec3 &_Direction, float _MaxDistance) const = 0;
 };
\ No newline at end of file
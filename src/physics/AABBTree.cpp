@@ -0,0 +1,347 @@
+#include "AABBTree.h"
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+namespace
+{
+
+constexpr float BOX_MARGIN = 0.1f; // Added on every side of the leaf boxes
+
+TAABB Union(const TAABB &_First, const TAABB &_Second)
+{
+  return TAABB{.Min = glm::min(_First.Min, _Second.Min), .Max = glm::max(_First.Max, _Second.Max)};
+}
+
+float SurfaceArea(const TAABB &_Box)
+{
+  const glm::vec3 Size = _Box.Size();
+  return 2.0f * (Size.x * Size.y + Size.y * Size.z + Size.z * Size.x);
+}
+
+bool Contains(const TAABB &_Outer, const TAABB &_Inner)
+{
+  return glm::all(glm::lessThanEqual(_Outer.Min, _Inner.Min)) && glm::all(glm::lessThanEqual(_Inner.Max, _Outer.Max));
+}
+
+TAABB Fatten(const TAABB &_Box)
+{
+  return TAABB{.Min = _Box.Min - glm::vec3(BOX_MARGIN), .Max = _Box.Max + glm::vec3(BOX_MARGIN)};
+}
+
+// Slab test, the distance to the entry point or zero when starting inside
+std::optional<float> IntersectRay(const TAABB &_Box, const glm::vec3 &_Origin, const glm::vec3 &_InverseDirection, float _MaxDistance)
+{
+  const glm::vec3 T0 = (_Box.Min - _Origin) * _InverseDirection;
+  const glm::vec3 T1 = (_Box.Max - _Origin) * _InverseDirection;
+
+  const glm::vec3 Near = glm::min(T0, T1);
+  const glm::vec3 Far  = glm::max(T0, T1);
+
+  const float Enter = std::max({Near.x, Near.y, Near.z, 0.0f});
+  const float Exit  = std::min({Far.x, Far.y, Far.z, _MaxDistance});
+
+  if (Enter > Exit)
+    return std::nullopt;
+
+  return Enter;
+}
+
+float DistanceSquared(const TAABB &_Box, const glm::vec3 &_Point)
+{
+  const glm::vec3 Delta = _Point - glm::clamp(_Point, _Box.Min, _Box.Max);
+  return glm::dot(Delta, Delta);
+}
+
+} // namespace
+
+CAABBTree::TProxy CAABBTree::Insert(const TAABB &_Box, uint32_t _UserData)
+{
+  assert(_Box.IsValid());
+
+  const TProxy Leaf = AllocateNode();
+
+  TNode &Node    = m_Nodes[Leaf];
+  Node.Box       = Fatten(_Box);
+  Node.ObjectBox = _Box;
+  Node.UserData  = _UserData;
+  Node.Height    = 0;
+
+  InsertLeaf(Leaf);
+  m_LeavesCount++;
+
+  return Leaf;
+}
+
+void CAABBTree::Remove(TProxy _Proxy)
+{
+  assert(_Proxy >= 0 && _Proxy < static_cast<TProxy>(m_Nodes.size()) && m_Nodes[_Proxy].IsLeaf());
+
+  RemoveLeaf(_Proxy);
+  FreeNode(_Proxy);
+  m_LeavesCount--;
+}
+
+bool CAABBTree::Move(TProxy _Proxy, const TAABB &_Box)
+{
+  assert(_Box.IsValid());
+
+  TNode &Node    = m_Nodes[_Proxy];
+  Node.ObjectBox = _Box;
+
+  if (Contains(Node.Box, _Box))
+    return false;
+
+  RemoveLeaf(_Proxy);
+  m_Nodes[_Proxy].Box = Fatten(_Box);
+  InsertLeaf(_Proxy);
+
+  return true;
+}
+
+void CAABBTree::Clear()
+{
+  m_Nodes.clear();
+  m_Root        = NULL_PROXY;
+  m_FreeList    = NULL_PROXY;
+  m_LeavesCount = 0;
+}
+
+uint32_t CAABBTree::GetUserData(TProxy _Proxy) const
+{
+  return m_Nodes[_Proxy].UserData;
+}
+
+size_t CAABBTree::GetLeavesCount() const
+{
+  return m_LeavesCount;
+}
+
+int32_t CAABBTree::GetHeight() const
+{
+  return m_Root != NULL_PROXY ? m_Nodes[m_Root].Height : 0;
+}
+
+std::optional<CAABBTree::TRayHit> CAABBTree::RayCast(const glm::vec3 &_Origin, const glm::vec3 &_Direction, float _MaxDistance) const
+{
+  const glm::vec3 Direction        = glm::normalize(_Direction);
+  const glm::vec3 InverseDirection = 1.0f / Direction; // Infinities for the axes the ray is parallel to
+
+  std::optional<TRayHit> Hit;
+  float                  Closest = _MaxDistance;
+
+  Traverse(
+      m_Root,
+      [&](const TAABB &_Box) { return IntersectRay(_Box, _Origin, InverseDirection, Closest).has_value(); },
+      [&](const TNode &_Leaf) {
+        const float Distance = IntersectRay(_Leaf.ObjectBox, _Origin, InverseDirection, Closest).value();
+        Closest              = Distance;
+        Hit                  = TRayHit{.UserData = _Leaf.UserData, .Distance = Distance};
+      });
+
+  return Hit;
+}
+
+std::optional<uint32_t> CAABBTree::QueryNearest(const glm::vec3 &_Point) const
+{
+  std::optional<uint32_t> Nearest;
+  float                   ClosestSquared = std::numeric_limits<float>::max();
+
+  // Subtrees farther than the best leaf so far are skipped
+  Traverse(
+      m_Root,
+      [&](const TAABB &_Box) { return DistanceSquared(_Box, _Point) < ClosestSquared; },
+      [&](const TNode &_Leaf) {
+        ClosestSquared = DistanceSquared(_Leaf.ObjectBox, _Point);
+        Nearest        = _Leaf.UserData;
+      });
+
+  return Nearest;
+}
+
+CAABBTree::TProxy CAABBTree::AllocateNode()
+{
+  if (m_FreeList == NULL_PROXY)
+  {
+    m_Nodes.emplace_back();
+    return static_cast<TProxy>(m_Nodes.size() - 1);
+  }
+
+  const TProxy Node = m_FreeList;
+  m_FreeList        = m_Nodes[Node].Parent;
+  m_Nodes[Node]     = TNode{};
+
+  return Node;
+}
+
+void CAABBTree::FreeNode(TProxy _Node)
+{
+  m_Nodes[_Node].Parent = m_FreeList;
+  m_Nodes[_Node].Height = -1;
+  m_FreeList            = _Node;
+}
+
+void CAABBTree::InsertLeaf(TProxy _Leaf)
+{
+  if (m_Root == NULL_PROXY)
+  {
+    m_Root                = _Leaf;
+    m_Nodes[_Leaf].Parent = NULL_PROXY;
+    return;
+  }
+
+  const TAABB LeafBox = m_Nodes[_Leaf].Box;
+
+  // Descends while pushing the leaf further down costs less than pairing it with the node
+  TProxy Sibling = m_Root;
+  while (!m_Nodes[Sibling].IsLeaf())
+  {
+    const TNode &Node = m_Nodes[Sibling];
+
+    const float Area         = SurfaceArea(Node.Box);
+    const float CombinedArea = SurfaceArea(Union(Node.Box, LeafBox));
+    const float Cost         = 2.0f * CombinedArea;
+    const float Inheritance  = 2.0f * (CombinedArea - Area); // Every ancestor grows by at least this much
+
+    const auto ChildCost = [&](TProxy _Child) {
+      const TNode &Child    = m_Nodes[_Child];
+      const float  Enlarged = SurfaceArea(Union(Child.Box, LeafBox));
+      return (Child.IsLeaf() ? Enlarged : Enlarged - SurfaceArea(Child.Box)) + Inheritance;
+    };
+
+    const float Cost1 = ChildCost(Node.Child1);
+    const float Cost2 = ChildCost(Node.Child2);
+
+    if (Cost < Cost1 && Cost < Cost2)
+      break;
+
+    Sibling = Cost1 < Cost2 ? Node.Child1 : Node.Child2;
+  }
+
+  const TProxy OldParent = m_Nodes[Sibling].Parent;
+  const TProxy NewParent = AllocateNode();
+
+  TNode &Parent = m_Nodes[NewParent];
+  Parent.Parent = OldParent;
+  Parent.Box    = Union(LeafBox, m_Nodes[Sibling].Box);
+  Parent.Height = m_Nodes[Sibling].Height + 1;
+  Parent.Child1 = Sibling;
+  Parent.Child2 = _Leaf;
+
+  if (OldParent == NULL_PROXY)
+    m_Root = NewParent;
+  else if (m_Nodes[OldParent].Child1 == Sibling)
+    m_Nodes[OldParent].Child1 = NewParent;
+  else
+    m_Nodes[OldParent].Child2 = NewParent;
+
+  m_Nodes[Sibling].Parent = NewParent;
+  m_Nodes[_Leaf].Parent   = NewParent;
+
+  RefitAncestors(NewParent);
+}
+
+void CAABBTree::RemoveLeaf(TProxy _Leaf)
+{
+  if (_Leaf == m_Root)
+  {
+    m_Root = NULL_PROXY;
+    return;
+  }
+
+  const TProxy Parent      = m_Nodes[_Leaf].Parent;
+  const TProxy GrandParent = m_Nodes[Parent].Parent;
+  const TProxy Sibling     = m_Nodes[Parent].Child1 == _Leaf ? m_Nodes[Parent].Child2 : m_Nodes[Parent].Child1;
+
+  // The sibling takes the place of the parent
+  m_Nodes[Sibling].Parent = GrandParent;
+  FreeNode(Parent);
+
+  if (GrandParent == NULL_PROXY)
+  {
+    m_Root = Sibling;
+    return;
+  }
+
+  if (m_Nodes[GrandParent].Child1 == Parent)
+    m_Nodes[GrandParent].Child1 = Sibling;
+  else
+    m_Nodes[GrandParent].Child2 = Sibling;
+
+  RefitAncestors(GrandParent);
+}
+
+void CAABBTree::RefitAncestors(TProxy _Node)
+{
+  for (TProxy Index = _Node; Index != NULL_PROXY; Index = m_Nodes[Index].Parent)
+  {
+    Index = Balance(Index);
+
+    TNode       &Node   = m_Nodes[Index];
+    const TNode &Child1 = m_Nodes[Node.Child1];
+    const TNode &Child2 = m_Nodes[Node.Child2];
+
+    Node.Height = 1 + std::max(Child1.Height, Child2.Height);
+    Node.Box    = Union(Child1.Box, Child2.Box);
+  }
+}
+
+// Rotates the higher child of _Node up if the heights of its children differ by more than one,
+// returns the node that ends up in its place
+CAABBTree::TProxy CAABBTree::Balance(TProxy _Node)
+{
+  TNode &A = m_Nodes[_Node];
+  if (A.IsLeaf() || A.Height < 2)
+    return _Node;
+
+  const TProxy IndexB = A.Child1;
+  const TProxy IndexC = A.Child2;
+  TNode       &B      = m_Nodes[IndexB];
+  TNode       &C      = m_Nodes[IndexC];
+
+  const int32_t Difference = C.Height - B.Height;
+  if (Difference >= -1 && Difference <= 1)
+    return _Node;
+
+  // The higher child becomes the parent of A, A keeps the lower grandchild
+  const bool   RotateC = Difference > 1;
+  const TProxy IndexUp = RotateC ? IndexC : IndexB;
+  TNode       &Up      = RotateC ? C : B;
+  TNode       &Other   = RotateC ? B : C;
+
+  const TProxy IndexF = Up.Child1;
+  const TProxy IndexG = Up.Child2;
+  TNode       &F      = m_Nodes[IndexF];
+  TNode       &G      = m_Nodes[IndexG];
+
+  Up.Child1 = _Node;
+  Up.Parent = A.Parent;
+  A.Parent  = IndexUp;
+
+  if (Up.Parent == NULL_PROXY)
+    m_Root = IndexUp;
+  else if (m_Nodes[Up.Parent].Child1 == _Node)
+    m_Nodes[Up.Parent].Child1 = IndexUp;
+  else
+    m_Nodes[Up.Parent].Child2 = IndexUp;
+
+  const bool   KeepF      = F.Height > G.Height;
+  const TProxy IndexKept  = KeepF ? IndexF : IndexG;
+  const TProxy IndexMoved = KeepF ? IndexG : IndexF;
+  TNode       &Kept       = KeepF ? F : G;
+  TNode       &Moved      = KeepF ? G : F;
+
+  Up.Child2 = IndexKept;
+  if (RotateC)
+    A.Child2 = IndexMoved;
+  else
+    A.Child1 = IndexMoved;
+  Moved.Parent = _Node;
+
+  A.Box     = Union(Other.Box, Moved.Box);
+  A.Height  = 1 + std::max(Other.Height, Moved.Height);
+  Up.Box    = Union(A.Box, Kept.Box);
+  Up.Height = 1 + std::max(A.Height, Kept.Height);
+
+  return IndexUp;
+}
@@ -0,0 +1,197 @@
+#pragma once
+
+#include "Collision.h"
+#include <common/FrustumCulling.h>
+#include <glm/vec3.hpp>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+// Dynamic bounding volume tree (as in Box2D and Bullet). Leaves hold fattened boxes, so objects
+// that move a little don't touch the tree; one that leaves its fattened box is reinserted next to
+// the sibling that grows the tree's surface area the least, and rotations keep the tree balanced.
+// Traversals walk the parent links instead of keeping a stack.
+class CAABBTree final
+{
+public:
+  using TProxy = int32_t;
+
+  static constexpr TProxy NULL_PROXY = -1;
+
+  struct TRayHit
+  {
+    uint32_t UserData;
+    float    Distance; // Along the normalized direction
+  };
+
+public:
+  TProxy Insert(const TAABB &_Box, uint32_t _UserData);
+  void Remove(TProxy _Proxy);
+  bool Move(TProxy _Proxy, const TAABB &_Box); // Returns true if the leaf was reinserted
+  void Clear();
+
+  uint32_t GetUserData(TProxy _Proxy) const;
+  size_t GetLeavesCount() const;
+  int32_t GetHeight() const;
+
+  // Leaves are tested with the boxes they were given, not the fattened ones.
+  // _OnLeaf(uint32_t _UserData) is called for every match, in no particular order.
+  template <typename TOnLeaf>
+  void QueryOverlap(const TAABB &_Box, TOnLeaf &&_OnLeaf) const;
+  template <typename TOnLeaf>
+  void QueryFrustum(const utils::TFrustum &_Frustum, TOnLeaf &&_OnLeaf) const;
+
+  std::optional<TRayHit> RayCast(const glm::vec3 &_Origin, const glm::vec3 &_Direction, float _MaxDistance) const; // Zero distance inside a box
+  std::optional<uint32_t> QueryNearest(const glm::vec3 &_Point) const; // Closest box, zero distance inside of it
+
+  // _Visit(const TAABB &_Box, bool _IsLeaf) for every node, meant for debug drawing
+  template <typename TVisit>
+  void ForEachNode(TVisit &&_Visit) const;
+
+private:
+  enum class EOverlap
+  {
+    None,
+    Partial,
+    Full // Every leaf below overlaps as well
+  };
+
+  struct TNode
+  {
+    TAABB    Box;                   // Fattened for leaves
+    TAABB    ObjectBox;             // Leaves only
+    TProxy   Parent   = NULL_PROXY; // Next free node while unused
+    TProxy   Child1   = NULL_PROXY;
+    TProxy   Child2   = NULL_PROXY;
+    int32_t  Height   = 0; // Zero for leaves, -1 for free nodes
+    uint32_t UserData = 0;
+
+    bool IsLeaf() const
+    {
+      return Child1 == NULL_PROXY;
+    }
+  };
+
+  TProxy AllocateNode();
+  void FreeNode(TProxy _Node);
+
+  void InsertLeaf(TProxy _Leaf);
+  void RemoveLeaf(TProxy _Leaf);
+  void RefitAncestors(TProxy _Node);
+  TProxy Balance(TProxy _Node);
+
+  // Depth first walk of the subtree at _Root over the nodes _Overlaps(const TAABB &) accepts,
+  // _OnLeaf(const TNode &) for the accepted leaves. Both may change state the next tests depend
+  // on. _Overlaps returns a bool, or an EOverlap to have the leaves under a Full node accepted
+  // without testing them.
+  template <typename TOverlaps, typename TOnLeaf>
+  void Traverse(TProxy _Root, TOverlaps &&_Overlaps, TOnLeaf &&_OnLeaf) const;
+
+private:
+  std::vector<TNode> m_Nodes;
+  TProxy             m_Root        = NULL_PROXY;
+  TProxy             m_FreeList    = NULL_PROXY;
+  size_t             m_LeavesCount = 0;
+};
+
+// ------------------------------------------------
+
+template <typename TOverlaps, typename TOnLeaf>
+void CAABBTree::Traverse(TProxy _Root, TOverlaps &&_Overlaps, TOnLeaf &&_OnLeaf) const
+{
+  constexpr bool IS_CLASSIFYING = std::is_same_v<std::invoke_result_t<TOverlaps, const TAABB &>, EOverlap>;
+
+  if (_Root == NULL_PROXY)
+    return;
+
+  const TProxy End = m_Nodes[_Root].Parent;
+
+  TProxy Node = _Root;
+  TProxy From = End;
+
+  // Coming from the parent means the node is entered, from the first child that the second one
+  // is next, from the second child that the subtree is done
+  while (Node != End)
+  {
+    const TNode &Current = m_Nodes[Node];
+
+    if (From == Current.Parent)
+    {
+      From = Node;
+
+      EOverlap Overlap;
+      if constexpr (IS_CLASSIFYING)
+        Overlap = _Overlaps(Current.IsLeaf() ? Current.ObjectBox : Current.Box);
+      else
+        Overlap = _Overlaps(Current.IsLeaf() ? Current.ObjectBox : Current.Box) ? EOverlap::Partial : EOverlap::None;
+
+      if (Overlap == EOverlap::None)
+      {
+        Node = Current.Parent;
+      }
+      else if (Current.IsLeaf())
+      {
+        _OnLeaf(Current);
+        Node = Current.Parent;
+      }
+      else if (Overlap == EOverlap::Full)
+      {
+        if constexpr (IS_CLASSIFYING)
+          Traverse(Node, [](const TAABB &) { return true; }, _OnLeaf);
+
+        Node = Current.Parent;
+      }
+      else
+      {
+        Node = Current.Child1;
+      }
+    }
+    else if (From == Current.Child1)
+    {
+      From = Node;
+      Node = Current.Child2;
+    }
+    else
+    {
+      From = Node;
+      Node = Current.Parent;
+    }
+  }
+}
+
+template <typename TOnLeaf>
+void CAABBTree::QueryOverlap(const TAABB &_Box, TOnLeaf &&_OnLeaf) const
+{
+  Traverse(
+      m_Root,
+      [&_Box](const TAABB &_NodeBox) {
+        return glm::all(glm::lessThanEqual(_NodeBox.Min, _Box.Max)) && glm::all(glm::lessThanEqual(_Box.Min, _NodeBox.Max));
+      },
+      [&_OnLeaf](const TNode &_Leaf) { _OnLeaf(_Leaf.UserData); });
+}
+
+template <typename TOnLeaf>
+void CAABBTree::QueryFrustum(const utils::TFrustum &_Frustum, TOnLeaf &&_OnLeaf) const
+{
+  Traverse(
+      m_Root,
+      [&_Frustum](const TAABB &_NodeBox) {
+        const glm::vec3 Center = _NodeBox.Center();
+        const glm::vec3 Extent = _NodeBox.Size() * 0.5f;
+
+        if (!utils::IsBoxVisible(_Frustum, Center, Extent))
+          return EOverlap::None;
+
+        return utils::IsBoxInside(_Frustum, Center, Extent) ? EOverlap::Full : EOverlap::Partial;
+      },
+      [&_OnLeaf](const TNode &_Leaf) { _OnLeaf(_Leaf.UserData); });
+}
+
+template <typename TVisit>
+void CAABBTree::ForEachNode(TVisit &&_Visit) const
+{
+  for (const TNode &Node : m_Nodes)
+    if (Node.Height >= 0)
+      _Visit(Node.Box, Node.IsLeaf());
+}
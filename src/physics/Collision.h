@@ -2,6 +2,7 @@
 
 #include <glm/vec3.hpp>
 #include <glm/ext.hpp>
+#include <array>
 #include <cfloat>
 
 struct TAABB
@@ -25,9 +26,28 @@ struct TAABB
     return Max - Min;
   }
 
-  std::vector<glm::vec3> GetCorners() const
+  // Default constructed boxes are empty until expanded
+  bool IsValid() const
   {
-    return {{Min.x, Min.y, Min.z}, {Max.x, Min.y, Min.z}, {Max.x, Max.y, Min.z}, {Min.x, Max.y, Min.z},
-            {Min.x, Min.y, Max.z}, {Max.x, Min.y, Max.z}, {Max.x, Max.y, Max.z}, {Min.x, Max.y, Max.z}};
+    return Min.x <= Max.x && Min.y <= Max.y && Min.z <= Max.z;
+  }
+
+  // Box around the transformed one (Arvo), cheaper than transforming the eight corners
+  TAABB Transform(const glm::mat4 &_Matrix) const
+  {
+    if (!IsValid())
+      return *this;
+
+    const glm::vec3 Center = glm::vec3(_Matrix * glm::vec4(this->Center(), 1.0f));
+    const glm::mat3 Abs(glm::vec3(glm::abs(_Matrix[0])), glm::vec3(glm::abs(_Matrix[1])), glm::vec3(glm::abs(_Matrix[2])));
+    const glm::vec3 Extent = Abs * (Size() * 0.5f);
+
+    return TAABB{.Min = Center - Extent, .Max = Center + Extent};
+  }
+
+  std::array<glm::vec3, 8> GetCorners() const
+  {
+    return {{{Min.x, Min.y, Min.z}, {Max.x, Min.y, Min.z}, {Max.x, Max.y, Min.z}, {Min.x, Max.y, Min.z},
+             {Min.x, Min.y, Max.z}, {Max.x, Min.y, Max.z}, {Max.x, Max.y, Max.z}, {Min.x, Max.y, Max.z}}};
   }
 };
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <glad/glad.h>
+#include "GLState.h"
+#include "utils/Memory.h"
 #include <common/Core.h>
 #include <vector>
 
@@ -88,9 +90,20 @@ class CVertexArray final : public CBuffer<CVertexArray> // VAO
   friend CBuffer;
 
 public:
-  void EnableAttrib(GLuint _Index, GLint _Size, GLenum _Type, GLboolean _Normalized, GLsizei _Stride, const void *_Offset = (GLvoid *)0)
+  // Every attribute reading the binding point shares the buffer and the stride
+  void AttachVertexBuffer(GLuint _BindingIndex, GLuint _BufferID, GLsizei _Stride, GLintptr _Offset = 0)
   {
-    glEnableVertexAttribArray(_Index);
+    glVertexArrayVertexBuffer(m_ID, _BindingIndex, _BufferID, _Offset, _Stride);
+  }
+
+  void AttachElementBuffer(GLuint _BufferID)
+  {
+    glVertexArrayElementBuffer(m_ID, _BufferID);
+  }
+
+  void EnableAttrib(GLuint _Index, GLint _Size, GLenum _Type, GLboolean _Normalized, GLuint _BindingIndex, GLuint _RelativeOffset = 0)
+  {
+    glEnableVertexArrayAttrib(m_ID, _Index);
 
     switch (_Type)
     {
@@ -100,42 +113,45 @@ public:
     case GL_UNSIGNED_SHORT:
     case GL_INT:
     case GL_UNSIGNED_INT:
-      glVertexAttribIPointer(_Index, _Size, _Type, _Stride, _Offset);
+      glVertexArrayAttribIFormat(m_ID, _Index, _Size, _Type, _RelativeOffset);
       break;
 
     case GL_DOUBLE:
-      glVertexAttribLPointer(_Index, _Size, _Type, _Stride, _Offset);
+      glVertexArrayAttribLFormat(m_ID, _Index, _Size, _Type, _RelativeOffset);
       break;
 
     default:
-      glVertexAttribPointer(_Index, _Size, _Type, _Normalized, _Stride, _Offset);
+      glVertexArrayAttribFormat(m_ID, _Index, _Size, _Type, _Normalized, _RelativeOffset);
       break;
     }
+
+    glVertexArrayAttribBinding(m_ID, _Index, _BindingIndex);
   }
 
   void DisableAttrib(GLuint _Index)
   {
-    glDisableVertexAttribArray(_Index);
+    glDisableVertexArrayAttrib(m_ID, _Index);
   }
 
 protected:
   void GenerateBuffer()
   {
-    glGenVertexArrays(1, &m_ID);
+    glCreateVertexArrays(1, &m_ID);
   }
 
   void BindBuffer()
   {
-    glBindVertexArray(m_ID);
+    CGLState::BindVertexArray(m_ID);
   }
 
   void UnbindBuffer()
   {
-    glBindVertexArray(INVALID_BUFFER);
+    CGLState::BindVertexArray(INVALID_BUFFER);
   }
 
   void DeleteBuffer()
   {
+    CGLState::OnVertexArrayDeleted(m_ID);
     glDeleteVertexArrays(1, &m_ID);
   }
 };
@@ -149,93 +165,93 @@ class CFrameBuffer final : public CBuffer<CFrameBuffer>
 public:
   void AttachTexture(GLenum _Attachment, GLuint _TextureID)
   {
-    glFramebufferTexture2D(GL_FRAMEBUFFER, _Attachment, GL_TEXTURE_2D, _TextureID, 0);
+    glNamedFramebufferTexture(m_ID, _Attachment, _TextureID, 0);
     assert(IsComplete());
   }
 
+  // Cubemap faces are attached as layers, any other target as a whole
   void AttachTexture(GLenum _Attachment, GLuint _TextureID, GLenum _TextureTarget)
   {
-    glFramebufferTexture2D(GL_FRAMEBUFFER, _Attachment, _TextureTarget, _TextureID, 0);
+    if (_TextureTarget >= GL_TEXTURE_CUBE_MAP_POSITIVE_X && _TextureTarget <= GL_TEXTURE_CUBE_MAP_NEGATIVE_Z)
+      glNamedFramebufferTextureLayer(m_ID, _Attachment, _TextureID, 0, _TextureTarget - GL_TEXTURE_CUBE_MAP_POSITIVE_X);
+    else
+      glNamedFramebufferTexture(m_ID, _Attachment, _TextureID, 0);
+
     assert(IsComplete());
   }
 
   void DetachTexture(GLenum _Attachment)
   {
-    glFramebufferTexture2D(GL_FRAMEBUFFER, _Attachment, GL_TEXTURE_2D, INVALID_BUFFER, 0);
+    glNamedFramebufferTexture(m_ID, _Attachment, INVALID_BUFFER, 0);
   }
 
   void AttachRenderBuffer(GLenum _Attachment, GLuint _RenderbufferID)
   {
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, _Attachment, GL_RENDERBUFFER, _RenderbufferID);
+    glNamedFramebufferRenderbuffer(m_ID, _Attachment, GL_RENDERBUFFER, _RenderbufferID);
     assert(IsComplete());
   }
 
   void DetachRenderBuffer(GLenum _Attachment)
   {
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, _Attachment, GL_RENDERBUFFER, INVALID_BUFFER);
+    glNamedFramebufferRenderbuffer(m_ID, _Attachment, GL_RENDERBUFFER, INVALID_BUFFER);
   }
 
   void DisableColorBuffer()
   {
-    glDrawBuffer(GL_NONE);
-    glReadBuffer(GL_NONE);
+    glNamedFramebufferDrawBuffer(m_ID, GL_NONE);
+    glNamedFramebufferReadBuffer(m_ID, GL_NONE);
   }
 
   void SetDrawBuffers(const GLenum *_Buffers, GLsizei _Count)
   {
-    glDrawBuffers(_Count, _Buffers);
+    glNamedFramebufferDrawBuffers(m_ID, _Count, _Buffers);
   }
 
+  // Leaves the bindings untouched
   static void Blit(GLuint _ReadBufferID, GLuint _DrawBufferID, GLsizei _Width, GLsizei _Height, GLbitfield _Mask, GLenum _Filter)
   {
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, _ReadBufferID);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, _DrawBufferID);
-    glBlitFramebuffer(0, 0, _Width, _Height, 0, 0, _Width, _Height, _Mask, _Filter);
-    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, INVALID_BUFFER);
-    glBindFramebuffer(GL_READ_FRAMEBUFFER, INVALID_BUFFER);
+    glBlitNamedFramebuffer(_ReadBufferID, _DrawBufferID, 0, 0, _Width, _Height, 0, 0, _Width, _Height, _Mask, _Filter);
   }
 
   static GLuint GetBound()
   {
-    GLint BufferID = 0;
-    glGetIntegerv(GL_FRAMEBUFFER_BINDING, &BufferID);
-    return static_cast<GLuint>(BufferID);
+    return CGLState::GetDrawFramebuffer();
   }
 
   static void BindDefault()
   {
-    glBindFramebuffer(GL_FRAMEBUFFER, INVALID_BUFFER);
+    CGLState::BindFramebuffer(GL_FRAMEBUFFER, INVALID_BUFFER);
   }
 
   static void BindBuffer(GLuint _BufferID)
   {
-    glBindFramebuffer(GL_FRAMEBUFFER, _BufferID);
+    CGLState::BindFramebuffer(GL_FRAMEBUFFER, _BufferID);
   }
 
   bool IsComplete() const
   {
-    return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    return glCheckNamedFramebufferStatus(m_ID, GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
   }
 
 protected:
   void GenerateBuffer()
   {
-    glGenFramebuffers(1, &m_ID);
-    assert(IsComplete());
+    glCreateFramebuffers(1, &m_ID);
   }
 
   void BindBuffer()
   {
-    glBindFramebuffer(GL_FRAMEBUFFER, m_ID);
+    CGLState::BindFramebuffer(GL_FRAMEBUFFER, m_ID);
   }
 
   void UnbindBuffer()
   {
-    glBindFramebuffer(GL_FRAMEBUFFER, INVALID_BUFFER);
+    CGLState::BindFramebuffer(GL_FRAMEBUFFER, INVALID_BUFFER);
   }
 
   void DeleteBuffer()
   {
+    CGLState::OnFramebufferDeleted(m_ID);
     glDeleteFramebuffers(1, &m_ID);
   }
 };
@@ -247,20 +263,70 @@ class CRenderBuffer final : public CBuffer<CRenderBuffer>
   friend CBuffer;
 
 public:
+  CRenderBuffer() = default;
+
+  CRenderBuffer(CRenderBuffer &&_Other) noexcept :
+      CBuffer<CRenderBuffer>(std::move(_Other)),
+      m_StorageSize(_Other.m_StorageSize)
+  {
+    _Other.m_StorageSize = 0;
+  }
+
+  CRenderBuffer &operator=(CRenderBuffer &&_Other)
+  {
+    if (m_ID != _Other.m_ID)
+      Shutdown();
+
+    m_ID                 = _Other.m_ID;
+    m_StorageSize        = _Other.m_StorageSize;
+    _Other.m_ID          = INVALID_BUFFER;
+    _Other.m_StorageSize = 0;
+
+    return *this;
+  }
+
+  ~CRenderBuffer()
+  {
+    Shutdown();
+  }
+
   void AllocateStorage(GLenum _InternalFormat, GLsizei _Width, GLsizei _Height)
   {
-    glRenderbufferStorage(GL_RENDERBUFFER, _InternalFormat, _Width, _Height);
+    glNamedRenderbufferStorage(m_ID, _InternalFormat, _Width, _Height);
+    SetStorageSize(static_cast<int64_t>(_Width) * _Height * GetTexelSize(_InternalFormat));
   }
 
   void AllocateStorageMultisample(GLenum _InternalFormat, GLsizei _Samples, GLsizei _Width, GLsizei _Height)
   {
-    glRenderbufferStorageMultisample(GL_RENDERBUFFER, _Samples, _InternalFormat, _Width, _Height);
+    glNamedRenderbufferStorageMultisample(m_ID, _Samples, _InternalFormat, _Width, _Height);
+    SetStorageSize(static_cast<int64_t>(_Width) * _Height * GetTexelSize(_InternalFormat) * std::max(_Samples, 1));
+  }
+
+private:
+  void SetStorageSize(int64_t _Size)
+  {
+    utils::TrackGPUMemory(EGPUMemoryTag::RenderBuffers, _Size - m_StorageSize);
+    m_StorageSize = _Size;
+  }
+
+  static int64_t GetTexelSize(GLenum _InternalFormat)
+  {
+    switch (_InternalFormat)
+    {
+    case GL_DEPTH_COMPONENT16:
+      return 2;
+    case GL_RGBA16F:
+    case GL_DEPTH32F_STENCIL8:
+      return 8;
+    default:
+      return 4;
+    }
   }
 
 protected:
   void GenerateBuffer()
   {
-    glGenRenderbuffers(1, &m_ID);
+    glCreateRenderbuffers(1, &m_ID);
   }
 
   void BindBuffer()
@@ -276,7 +342,10 @@ protected:
   void DeleteBuffer()
   {
     glDeleteRenderbuffers(1, &m_ID);
+    SetStorageSize(0);
   }
+
+  int64_t m_StorageSize = 0; // in bytes, estimated
 };
 
 // ------------------------------------------------
@@ -307,6 +376,11 @@ public:
     _Other.m_ActualSize = 0;
   }
 
+  ~CBufferObject()
+  {
+    Shutdown();
+  }
+
   CBufferObject &operator=(CBufferObject &&_Other)
   {
     if (m_ID != _Other.m_ID)
@@ -342,11 +416,11 @@ public:
     assert(_DataSizeInBytes > 0);
 
     if (m_Capacity == _DataSizeInBytes)
-      glBufferSubData(m_Target, 0, _DataSizeInBytes, _Data);
+      glNamedBufferSubData(m_ID, 0, _DataSizeInBytes, _Data);
     else
-      glBufferData(m_Target, _DataSizeInBytes, _Data, m_Usage);
+      glNamedBufferData(m_ID, _DataSizeInBytes, _Data, m_Usage);
 
-    m_Capacity   = _DataSizeInBytes;
+    SetCapacity(_DataSizeInBytes);
     m_ActualSize = _DataSizeInBytes;
   }
 
@@ -365,7 +439,7 @@ public:
     if (m_ActualSize + _DataSizeInBytes > m_Capacity)
       Reallocate(m_ActualSize + _DataSizeInBytes);
 
-    glBufferSubData(m_Target, m_ActualSize, _DataSizeInBytes, _Data);
+    glNamedBufferSubData(m_ID, m_ActualSize, _DataSizeInBytes, _Data);
     m_ActualSize += _DataSizeInBytes;
   }
 
@@ -375,19 +449,25 @@ public:
     Push(_Data.data(), _Data.size() * sizeof(T));
   }
 
+  // Overwrites a range that is already in use, the buffer never grows
+  template <typename T>
+  requires(std::is_trivially_copyable_v<T>)
+  void Write(GLintptr _Offset, T *_Data, GLsizeiptr _DataSizeInBytes)
+  {
+    assert(_DataSizeInBytes > 0 && _Offset + _DataSizeInBytes <= m_ActualSize);
+    glNamedBufferSubData(m_ID, _Offset, _DataSizeInBytes, _Data);
+  }
+
   void Erase(GLintptr _Offset, GLsizeiptr _SizeInBytes)
   {
-    GLuint NewBufferID = 0;
-    glGenBuffers(1, &NewBufferID);
-    glBindBuffer(m_Target, NewBufferID);
-    glBufferData(m_Target, m_Capacity - _SizeInBytes, nullptr, m_Usage);
+    const GLuint Scratch = CopyToScratch();
+    glNamedBufferData(m_ID, m_Capacity - _SizeInBytes, nullptr, m_Usage);
 
-    glCopyBufferSubData(m_Target, NewBufferID, 0, 0, _Offset);
-    glCopyBufferSubData(m_Target, NewBufferID, _Offset + _SizeInBytes, _Offset, m_ActualSize - _Offset - _SizeInBytes);
-    glDeleteBuffers(1, &m_ID);
-    m_ID = NewBufferID;
+    glCopyNamedBufferSubData(Scratch, m_ID, 0, 0, _Offset);
+    glCopyNamedBufferSubData(Scratch, m_ID, _Offset + _SizeInBytes, _Offset, m_ActualSize - _Offset - _SizeInBytes);
+    glDeleteBuffers(1, &Scratch);
 
-    m_Capacity   -= _SizeInBytes;
+    SetCapacity(m_Capacity - _SizeInBytes);
     m_ActualSize -= _SizeInBytes;
     assert(m_Capacity >= 0 && m_ActualSize >= 0);
   }
@@ -441,33 +521,39 @@ protected:
     ReallocateImpl(NewBufferCapacity, NeedCopyData);
   }
 
+  // The storage is respecified under the same name, so the VAOs it's attached to and the
+  // ranges bound from it stay valid. The data goes through a scratch buffer meanwhile.
   void ReallocateImpl(GLsizeiptr _NewCapacity, bool _NeedCopy)
   {
-    m_Capacity = _NewCapacity;
+    SetCapacity(_NewCapacity);
 
     if (!_NeedCopy)
     {
-      glBufferData(m_Target, _NewCapacity, nullptr, m_Usage);
+      glNamedBufferData(m_ID, _NewCapacity, nullptr, m_Usage);
       return;
     }
 
-    GLuint NewBufferID = 0;
-    glGenBuffers(1, &NewBufferID);
-    glBindBuffer(m_Target, NewBufferID);
-    glBufferData(m_Target, _NewCapacity, nullptr, m_Usage);
+    const GLuint Scratch = CopyToScratch();
+    glNamedBufferData(m_ID, _NewCapacity, nullptr, m_Usage);
 
-    glBindBuffer(GL_COPY_READ_BUFFER, m_ID);
-    glBindBuffer(GL_COPY_WRITE_BUFFER, NewBufferID);
-    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, m_ActualSize);
-    glBindBuffer(GL_COPY_READ_BUFFER, INVALID_BUFFER);
-    glBindBuffer(GL_COPY_WRITE_BUFFER, INVALID_BUFFER);
-    glDeleteBuffers(1, &m_ID);
-    m_ID = NewBufferID;
+    glCopyNamedBufferSubData(Scratch, m_ID, 0, 0, m_ActualSize);
+    glDeleteBuffers(1, &Scratch);
+  }
+
+  // The data in use, in a buffer of its own the caller deletes
+  GLuint CopyToScratch() const
+  {
+    GLuint Scratch = 0;
+    glCreateBuffers(1, &Scratch);
+    glNamedBufferData(Scratch, m_ActualSize, nullptr, GL_STREAM_COPY);
+
+    glCopyNamedBufferSubData(m_ID, Scratch, 0, 0, m_ActualSize);
+    return Scratch;
   }
 
   void GenerateBuffer()
   {
-    glGenBuffers(1, &m_ID);
+    glCreateBuffers(1, &m_ID);
   }
 
   void BindBuffer()
@@ -483,6 +569,13 @@ protected:
   void DeleteBuffer()
   {
     glDeleteBuffers(1, &m_ID);
+    SetCapacity(0);
+  }
+
+  void SetCapacity(GLsizeiptr _Capacity)
+  {
+    utils::TrackGPUMemory(EGPUMemoryTag::Buffers, _Capacity - m_Capacity);
+    m_Capacity = _Capacity;
   }
 
   GLenum     m_Target;
@@ -526,6 +619,17 @@ public:
 
 // ------------------------------------------------
 
+class CShaderStorageBuffer final : public CBufferObject // SSBO
+{
+public:
+  CShaderStorageBuffer(GLenum _Usage) :
+      CBufferObject(GL_SHADER_STORAGE_BUFFER, _Usage)
+  {
+  }
+};
+
+// ------------------------------------------------
+
 using TSharedVAO = std::shared_ptr<CVertexArray>;
 using TSharedVBO = std::shared_ptr<CVertexBuffer>;
 using TSharedEBO = std::shared_ptr<CElementBuffer>;
@@ -1,11 +1,18 @@
 #pragma once
 
 #include "RenderTypes.h"
-#include <glm/fwd.hpp>
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <memory_resource>
 #include <vector>
 
 struct TFrameData
 {
+  explicit TFrameData(std::pmr::memory_resource *_Resource = std::pmr::get_default_resource()) :
+      Lights(_Resource)
+  {
+  }
+
   struct TLight
   {
     ELightType Type;
@@ -23,6 +30,14 @@ struct TFrameData
     uint32_t IrradianceMap      = 0;
   };
 
-  std::vector<TLight> Lights;
-  TEnvironment        Environment;
+  struct TCamera
+  {
+    glm::vec3 Position   = glm::vec3(0.0f);
+    glm::mat4 View       = glm::mat4(1.0f);
+    glm::mat4 Projection = glm::mat4(1.0f);
+  };
+
+  std::pmr::vector<TLight> Lights;
+  TEnvironment             Environment;
+  TCamera                  Camera; // Copied, so the frame can be rendered while the camera moves on
 };
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "FrameData.h"
+#include "RenderQueue.h"
+#include <memory_resource>
+
+// Everything a frame is rendered from. Built by the main thread, which doesn't touch it once
+// submitted, so the render thread can consume it while the next frame is simulated.
+struct TFramePacket
+{
+  explicit TFramePacket(std::pmr::memory_resource *_Resource = std::pmr::get_default_resource()) :
+      FrameData(_Resource),
+      Queue(_Resource)
+  {
+  }
+
+  TFrameData   FrameData;
+  CRenderQueue Queue;
+  bool         ShouldPresent = true; // Otherwise whoever draws over the frame swaps the buffers
+};
@@ -1,6 +1,6 @@
 #include "GLRenderer.h"
+#include "GLState.h"
 #include "assets/Shader.h"
-#include "engine/Camera.h"
 #include "engine/Config.h"
 #include "assets/Texture.h"
 #include <common/Logger.h>
@@ -32,6 +32,22 @@ GLenum ConvertPrimitiveMode(EPrimitiveMode _Mode)
   }
 }
 
+GLenum ConvertIndexType(EIndexType _IndexType)
+{
+  switch (_IndexType)
+  {
+  case EIndexType::UnsignedByte:
+    return GL_UNSIGNED_BYTE;
+  case EIndexType::UnsignedShort:
+    return GL_UNSIGNED_SHORT;
+  case EIndexType::UnsignedInt:
+    return GL_UNSIGNED_INT;
+  default:
+    assert(false && "Invalid index type");
+    return GL_UNSIGNED_INT;
+  }
+}
+
 } // namespace
 
 void COpenGLRenderer::OnFrameBegin()
@@ -42,10 +58,16 @@ void COpenGLRenderer::OnFrameBegin()
   m_TrianglesCount = 0;
   m_LinesCount     = 0;
   m_PointsCount    = 0;
+
+  CRenderCounters::Reset();
 }
 
 void COpenGLRenderer::CheckErrors()
 {
+#if GL_STATE_VALIDATION
+  CGLState::Validate();
+#endif
+
   while (true)
   {
     GLenum Error = glGetError();
@@ -75,14 +97,13 @@ void COpenGLRenderer::ClearColor(const TColor &_Color)
 
 void COpenGLRenderer::SetViewport(TVector2i _Viewport)
 {
-  glViewport(0, 0, _Viewport.X, _Viewport.Y);
+  CGLState::SetViewport({.Width = _Viewport.X, .Height = _Viewport.Y});
 }
 
 TVector2i COpenGLRenderer::GetViewport() const
 {
-  GLint Viewport[4] = {0, 0, 0, 0};
-  glGetIntegerv(GL_VIEWPORT, Viewport);
-  return TVector2i(Viewport[2], Viewport[3]);
+  const CGLState::TViewport Viewport = CGLState::GetViewport();
+  return TVector2i(Viewport.Width, Viewport.Height);
 }
 
 void COpenGLRenderer::DrawArrays(EPrimitiveMode _Mode, int _Count)
@@ -93,57 +114,35 @@ void COpenGLRenderer::DrawArrays(EPrimitiveMode _Mode, int _Count)
   m_DrawCallsCount++;
   m_VerticesCount += _Count;
 
-  switch (glMode)
-  {
-  case GL_TRIANGLES:
-    m_TrianglesCount += _Count / 3;
-    break;
-  case GL_TRIANGLE_STRIP:
-    [[fallthrough]];
-  case GL_TRIANGLE_FAN:
-    m_TrianglesCount += (_Count > 2) ? (_Count - 2) : 0;
-    break;
-  case GL_LINES:
-    m_LinesCount += _Count / 2;
-    break;
-  case GL_LINE_STRIP:
-    m_LinesCount += (_Count > 1) ? (_Count - 1) : 0;
-    break;
-  case GL_LINE_LOOP:
-    m_LinesCount += _Count;
-    break;
-  case GL_POINTS:
-    m_PointsCount += _Count;
-    break;
-  }
+  CountPrimitives(glMode, _Count);
 }
 
 void COpenGLRenderer::DrawElements(EPrimitiveMode _Mode, int _Count, EIndexType _IndexType, const void *_Offset)
 {
   GLenum glMode = ConvertPrimitiveMode(_Mode);
 
-  GLenum glIndexType = GL_UNSIGNED_INT;
-  switch (_IndexType)
-  {
-  case EIndexType::UnsignedByte:
-    glIndexType = GL_UNSIGNED_BYTE;
-    break;
-  case EIndexType::UnsignedShort:
-    glIndexType = GL_UNSIGNED_SHORT;
-    break;
-  case EIndexType::UnsignedInt:
-    glIndexType = GL_UNSIGNED_INT;
-    break;
-  default:
-    assert(false && "Invalid index type");
-    break;
-  }
-
-  glDrawElements(glMode, static_cast<GLsizei>(_Count), static_cast<GLenum>(glIndexType), _Offset);
+  glDrawElements(glMode, static_cast<GLsizei>(_Count), ConvertIndexType(_IndexType), _Offset);
   m_DrawCallsCount++;
   m_IndicesCount += _Count;
 
-  switch (glMode)
+  CountPrimitives(glMode, _Count);
+}
+
+void COpenGLRenderer::MultiDrawElementsIndirect(EPrimitiveMode _Mode, EIndexType _IndexType, const void *_Offset, int _DrawCount, int _IndicesCount)
+{
+  GLenum glMode = ConvertPrimitiveMode(_Mode);
+
+  glMultiDrawElementsIndirect(glMode, ConvertIndexType(_IndexType), _Offset, static_cast<GLsizei>(_DrawCount), 0);
+  m_DrawCallsCount++;
+  m_IndicesCount += _IndicesCount;
+
+  // Exact for lists, strips and fans are counted as if the draws were one
+  CountPrimitives(glMode, _IndicesCount);
+}
+
+void COpenGLRenderer::CountPrimitives(GLenum _Mode, int _Count)
+{
+  switch (_Mode)
   {
   case GL_TRIANGLES:
     m_TrianglesCount += _Count / 3;
@@ -168,16 +167,6 @@ void COpenGLRenderer::DrawElements(EPrimitiveMode _Mode, int _Count, EIndexType
   }
 }
 
-void COpenGLRenderer::SetCamera(const std::shared_ptr<CCamera> &_Camera)
-{
-  m_Camera = _Camera;
-}
-
-const std::shared_ptr<CCamera> &COpenGLRenderer::GetCamera() const
-{
-  return m_Camera;
-}
-
 void COpenGLRenderer::SetShader(const std::shared_ptr<CShader> &_Shader)
 {
   if (m_CurrentShader == _Shader)
@@ -195,56 +184,43 @@ const std::shared_ptr<CShader> &COpenGLRenderer::GetShader() const
 
 void COpenGLRenderer::SetBlending(EAlphaMode _Mode)
 {
-  if (m_AlphaMode == _Mode)
-    return;
-
-  m_AlphaMode = _Mode;
-
   switch (_Mode)
   {
   case EAlphaMode::Opaque:
-    glDisable(GL_BLEND);
-    glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+    CGLState::SetEnabled(GL_BLEND, false);
+    CGLState::SetEnabled(GL_SAMPLE_ALPHA_TO_COVERAGE, false);
     break;
 
   case EAlphaMode::Mask:
-    glDisable(GL_BLEND);
-    glEnable(GL_SAMPLE_ALPHA_TO_COVERAGE); // optional
+    CGLState::SetEnabled(GL_BLEND, false);
+    CGLState::SetEnabled(GL_SAMPLE_ALPHA_TO_COVERAGE, true); // optional
     break;
 
   case EAlphaMode::Blend:
-    glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    CGLState::SetEnabled(GL_SAMPLE_ALPHA_TO_COVERAGE, false);
+    CGLState::SetEnabled(GL_BLEND, true);
+    CGLState::SetBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
     break;
   }
 }
 
 void COpenGLRenderer::SetDepthTest(bool _Enable)
 {
-  if (_Enable)
-    glEnable(GL_DEPTH_TEST);
-  else
-    glDisable(GL_DEPTH_TEST);
+  CGLState::SetEnabled(GL_DEPTH_TEST, _Enable);
 }
 
 void COpenGLRenderer::SetDepthFunc(int _Func)
 {
-  glDepthFunc(_Func);
+  CGLState::SetDepthFunc(static_cast<GLenum>(_Func));
 }
 
 void COpenGLRenderer::SetDepthMask(bool _Flag)
 {
-  glDepthMask(_Flag ? GL_TRUE : GL_FALSE);
+  CGLState::SetDepthMask(_Flag);
 }
 
 void COpenGLRenderer::SetCullFace(ECullMode _Mode)
 {
-  if (m_CullingMode == _Mode)
-    return;
-
-  m_CullingMode = _Mode;
-
   const GLenum glMode = _Mode == ECullMode::Front ? GL_FRONT : _Mode == ECullMode::Back ? GL_BACK : GL_FRONT_AND_BACK;
 
   switch (_Mode)
@@ -254,13 +230,13 @@ void COpenGLRenderer::SetCullFace(ECullMode _Mode)
   case ECullMode::Back:
     [[fallthrough]];
   case ECullMode::FrontAndBack:
-    glEnable(GL_CULL_FACE);
-    glFrontFace(GL_CCW);
-    glCullFace(glMode);
+    CGLState::SetEnabled(GL_CULL_FACE, true);
+    CGLState::SetFrontFace(GL_CCW);
+    CGLState::SetCullFace(glMode);
     break;
 
   case ECullMode::None:
-    glDisable(GL_CULL_FACE);
+    CGLState::SetEnabled(GL_CULL_FACE, false);
     break;
 
   default:
@@ -330,4 +306,14 @@ uint32_t COpenGLRenderer::GetLinesCount() const
 uint32_t COpenGLRenderer::GetPointsCount() const
 {
   return m_PointsCount;
+}
+
+const TRenderStateChanges &COpenGLRenderer::GetStateChanges() const
+{
+  return CRenderCounters::GetStateChanges();
+}
+
+const TTextureUnitBinds &COpenGLRenderer::GetTextureUnitBinds() const
+{
+  return CRenderCounters::GetTextureUnitBinds();
 }
\ No newline at end of file
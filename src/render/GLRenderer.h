@@ -2,6 +2,7 @@
 
 #include <glad/glad.h>
 #include "Buffer.h"
+#include "RenderStats.h"
 #include "RenderTypes.h"
 #include "ShaderTypes.h"
 #include "interfaces/Renderer.h"
@@ -20,9 +21,7 @@ public:
 
   void DrawElements(EPrimitiveMode _Mode, int _Count, EIndexType _IndexType, const void *_Offset = nullptr) override;
   void DrawArrays(EPrimitiveMode _Mode, int _Count) override;
-
-  void SetCamera(const std::shared_ptr<CCamera> &_Camera) override;
-  const std::shared_ptr<CCamera> &GetCamera() const override;
+  void MultiDrawElementsIndirect(EPrimitiveMode _Mode, EIndexType _IndexType, const void *_Offset, int _DrawCount, int _IndicesCount) override;
 
   void SetShader(const std::shared_ptr<CShader> &_Shader) override;
   void SetUniform(std::string_view _Name, const UniformType &_Value) override;
@@ -41,16 +40,17 @@ public:
   uint32_t GetLinesCount() const override;
   uint32_t GetPointsCount() const override;
 
+  const TRenderStateChanges &GetStateChanges() const override;
+  const TTextureUnitBinds &GetTextureUnitBinds() const override;
+
 private:
+  void CountPrimitives(GLenum _Mode, int _Count);
+
   static std::string GetGLErrorDescription(GLenum _Error);
 
 public:
-  std::shared_ptr<CCamera> m_Camera;
   std::shared_ptr<CShader> m_CurrentShader;
 
-  EAlphaMode m_AlphaMode   = static_cast<EAlphaMode>(-1);
-  ECullMode  m_CullingMode = static_cast<ECullMode>(-1);
-
   uint32_t m_DrawCallsCount = 0;
   uint32_t m_VerticesCount  = 0;
   uint32_t m_IndicesCount   = 0;
@@ -0,0 +1,384 @@
+#include "GLState.h"
+#include "RenderStats.h"
+#include <common/Logger.h>
+#include <algorithm>
+#include <array>
+#include <format>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+namespace
+{
+
+constexpr std::array<GLenum, 7> TRACKED_CAPABILITIES = {GL_DEPTH_TEST,               //
+                                                        GL_STENCIL_TEST,             //
+                                                        GL_BLEND,                    //
+                                                        GL_CULL_FACE,                //
+                                                        GL_SAMPLE_ALPHA_TO_COVERAGE, //
+                                                        GL_MULTISAMPLE,              //
+                                                        GL_TEXTURE_CUBE_MAP_SEAMLESS};
+
+constexpr std::array<GLenum, 3> TRACKED_TEXTURE_TARGETS = {GL_TEXTURE_2D, GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_CUBE_MAP};
+constexpr std::array<GLenum, 3> TEXTURE_TARGET_BINDINGS = {GL_TEXTURE_BINDING_2D, GL_TEXTURE_BINDING_2D_MULTISAMPLE, GL_TEXTURE_BINDING_CUBE_MAP};
+
+using TTextureUnit = std::array<std::optional<GLuint>, TRACKED_TEXTURE_TARGETS.size()>;
+
+struct TBlendFunc
+{
+  GLenum Source;
+  GLenum Destination;
+
+  bool operator==(const TBlendFunc &) const = default;
+};
+
+struct TState
+{
+  std::optional<GLuint>                                        Program;
+  std::optional<GLuint>                                        VAO;
+  std::optional<GLuint>                                        DrawFBO;
+  std::optional<GLuint>                                        ReadFBO;
+  std::optional<GLenum>                                        ActiveTexture;
+  std::array<TTextureUnit, MAX_TRACKED_TEXTURE_UNITS>          TextureUnits;
+  std::array<std::optional<GLuint>, MAX_TRACKED_TEXTURE_UNITS> Samplers;
+  std::array<std::optional<bool>, TRACKED_CAPABILITIES.size()> Capabilities;
+  std::optional<GLenum>                                        DepthFunc;
+  std::optional<bool>                                          DepthMask;
+  std::optional<GLuint>                                        StencilMask;
+  std::optional<TBlendFunc>                                    BlendFunc;
+  std::optional<GLenum>                                        CullFace;
+  std::optional<GLenum>                                        FrontFace;
+  std::optional<CGLState::TViewport>                           Viewport;
+};
+
+TState State;
+
+std::unordered_map<GLuint, GLuint> TextureSamplers;
+
+template <size_t N>
+std::optional<size_t> FindIndex(const std::array<GLenum, N> &_Values, GLenum _Value)
+{
+  for (size_t i = 0; i < N; ++i)
+    if (_Values[i] == _Value)
+      return i;
+
+  return std::nullopt;
+}
+
+// Units past the tracked ones and other targets are bound every time
+std::optional<GLuint> *FindTextureBinding(GLenum _TextureUnit, GLenum _Target)
+{
+  const size_t                Unit   = _TextureUnit - GL_TEXTURE0;
+  const std::optional<size_t> Target = FindIndex(TRACKED_TEXTURE_TARGETS, _Target);
+
+  if (Unit >= MAX_TRACKED_TEXTURE_UNITS || !Target)
+    return nullptr;
+
+  return &State.TextureUnits[Unit][*Target];
+}
+
+void SetActiveTexture(GLenum _TextureUnit)
+{
+  if (State.ActiveTexture == _TextureUnit)
+    return;
+
+  glActiveTexture(_TextureUnit);
+  State.ActiveTexture = _TextureUnit;
+}
+
+void CountCapabilityChange(GLenum _Capability)
+{
+  switch (_Capability)
+  {
+  case GL_DEPTH_TEST:
+    CRenderCounters::CountDepthChange();
+    break;
+  case GL_BLEND:
+    [[fallthrough]];
+  case GL_SAMPLE_ALPHA_TO_COVERAGE:
+    CRenderCounters::CountBlendChange();
+    break;
+  case GL_CULL_FACE:
+    CRenderCounters::CountCullChange();
+    break;
+  }
+}
+
+GLint GetInteger(GLenum _Name)
+{
+  GLint Value = 0;
+  glGetIntegerv(_Name, &Value);
+  return Value;
+}
+
+template <class T>
+bool Check(std::optional<T> &_Cached, const T &_Actual, std::string_view _Name)
+{
+  if (!_Cached || *_Cached == _Actual)
+    return true;
+
+  if constexpr (std::is_arithmetic_v<T>)
+    CLogger::Log(ELogType::Error, "[CGLState] {} is cached as {}, but GL has {}", _Name, *_Cached, _Actual);
+  else
+    CLogger::Log(ELogType::Error, "[CGLState] {} differs from the cached one", _Name);
+
+  _Cached = _Actual;
+  return false;
+}
+
+} // namespace
+
+void CGLState::UseProgram(GLuint _Program)
+{
+  if (State.Program == _Program)
+    return;
+
+  glUseProgram(_Program);
+  State.Program = _Program;
+  CRenderCounters::CountShaderSwitch();
+}
+
+void CGLState::BindVertexArray(GLuint _VAO)
+{
+  if (State.VAO == _VAO)
+    return;
+
+  glBindVertexArray(_VAO);
+  State.VAO = _VAO;
+  CRenderCounters::CountVAOBind();
+}
+
+void CGLState::BindFramebuffer(GLenum _Target, GLuint _FBO)
+{
+  const bool IsDraw = _Target == GL_FRAMEBUFFER || _Target == GL_DRAW_FRAMEBUFFER;
+  const bool IsRead = _Target == GL_FRAMEBUFFER || _Target == GL_READ_FRAMEBUFFER;
+
+  if ((!IsDraw || State.DrawFBO == _FBO) && (!IsRead || State.ReadFBO == _FBO))
+    return;
+
+  glBindFramebuffer(_Target, _FBO);
+  CRenderCounters::CountFBOBind();
+
+  if (IsDraw)
+    State.DrawFBO = _FBO;
+  if (IsRead)
+    State.ReadFBO = _FBO;
+}
+
+void CGLState::BindTexture(GLenum _Target, GLenum _TextureUnit, GLuint _Texture)
+{
+  // A unit holds one sampler for all its targets, so it's checked even if the texture is bound already
+  const auto It = TextureSamplers.find(_Texture);
+  BindSampler(_TextureUnit, It != TextureSamplers.end() ? It->second : 0);
+
+  std::optional<GLuint> *Binding = FindTextureBinding(_TextureUnit, _Target);
+  if (Binding && *Binding == _Texture)
+    return;
+
+  SetActiveTexture(_TextureUnit);
+  glBindTexture(_Target, _Texture);
+  CRenderCounters::CountTextureBind(_TextureUnit - GL_TEXTURE0);
+
+  if (Binding)
+    *Binding = _Texture;
+}
+
+void CGLState::BindSampler(GLenum _TextureUnit, GLuint _Sampler)
+{
+  const size_t Unit = _TextureUnit - GL_TEXTURE0;
+  if (Unit < MAX_TRACKED_TEXTURE_UNITS && State.Samplers[Unit] == _Sampler)
+    return;
+
+  glBindSampler(static_cast<GLuint>(Unit), _Sampler);
+
+  if (Unit < MAX_TRACKED_TEXTURE_UNITS)
+    State.Samplers[Unit] = _Sampler;
+}
+
+void CGLState::SetEnabled(GLenum _Capability, bool _Enable)
+{
+  const std::optional<size_t> Index = FindIndex(TRACKED_CAPABILITIES, _Capability);
+  if (Index && State.Capabilities[*Index] == _Enable)
+    return;
+
+  if (_Enable)
+    glEnable(_Capability);
+  else
+    glDisable(_Capability);
+
+  CountCapabilityChange(_Capability);
+
+  if (Index)
+    State.Capabilities[*Index] = _Enable;
+}
+
+void CGLState::SetDepthFunc(GLenum _Func)
+{
+  if (State.DepthFunc == _Func)
+    return;
+
+  glDepthFunc(_Func);
+  State.DepthFunc = _Func;
+  CRenderCounters::CountDepthChange();
+}
+
+void CGLState::SetDepthMask(bool _Flag)
+{
+  if (State.DepthMask == _Flag)
+    return;
+
+  glDepthMask(_Flag ? GL_TRUE : GL_FALSE);
+  State.DepthMask = _Flag;
+  CRenderCounters::CountDepthChange();
+}
+
+void CGLState::SetStencilMask(GLuint _Mask)
+{
+  if (State.StencilMask == _Mask)
+    return;
+
+  glStencilMask(_Mask);
+  State.StencilMask = _Mask;
+}
+
+void CGLState::SetBlendFunc(GLenum _Source, GLenum _Destination)
+{
+  const TBlendFunc BlendFunc{.Source = _Source, .Destination = _Destination};
+  if (State.BlendFunc == BlendFunc)
+    return;
+
+  glBlendFunc(_Source, _Destination);
+  State.BlendFunc = BlendFunc;
+  CRenderCounters::CountBlendChange();
+}
+
+void CGLState::SetCullFace(GLenum _Mode)
+{
+  if (State.CullFace == _Mode)
+    return;
+
+  glCullFace(_Mode);
+  State.CullFace = _Mode;
+  CRenderCounters::CountCullChange();
+}
+
+void CGLState::SetFrontFace(GLenum _Mode)
+{
+  if (State.FrontFace == _Mode)
+    return;
+
+  glFrontFace(_Mode);
+  State.FrontFace = _Mode;
+  CRenderCounters::CountCullChange();
+}
+
+void CGLState::SetViewport(const TViewport &_Viewport)
+{
+  if (State.Viewport == _Viewport)
+    return;
+
+  glViewport(_Viewport.X, _Viewport.Y, _Viewport.Width, _Viewport.Height);
+  State.Viewport = _Viewport;
+}
+
+void CGLState::SetTextureSampler(GLuint _Texture, GLuint _Sampler)
+{
+  TextureSamplers[_Texture] = _Sampler;
+}
+
+GLuint CGLState::GetDrawFramebuffer()
+{
+  if (!State.DrawFBO)
+    State.DrawFBO = static_cast<GLuint>(GetInteger(GL_DRAW_FRAMEBUFFER_BINDING));
+
+  return *State.DrawFBO;
+}
+
+CGLState::TViewport CGLState::GetViewport()
+{
+  if (!State.Viewport)
+  {
+    GLint Viewport[4] = {0, 0, 0, 0};
+    glGetIntegerv(GL_VIEWPORT, Viewport);
+    State.Viewport = TViewport{.X = Viewport[0], .Y = Viewport[1], .Width = Viewport[2], .Height = Viewport[3]};
+  }
+
+  return *State.Viewport;
+}
+
+void CGLState::OnTextureDeleted(GLuint _Texture)
+{
+  for (TTextureUnit &Unit : State.TextureUnits)
+    for (std::optional<GLuint> &Binding : Unit)
+      if (Binding == _Texture)
+        Binding = 0;
+
+  TextureSamplers.erase(_Texture);
+}
+
+void CGLState::OnVertexArrayDeleted(GLuint _VAO)
+{
+  if (State.VAO == _VAO)
+    State.VAO = 0;
+}
+
+void CGLState::OnFramebufferDeleted(GLuint _FBO)
+{
+  if (State.DrawFBO == _FBO)
+    State.DrawFBO = 0;
+  if (State.ReadFBO == _FBO)
+    State.ReadFBO = 0;
+}
+
+void CGLState::Invalidate()
+{
+  State = TState{};
+}
+
+bool CGLState::Validate()
+{
+  bool IsValid = true;
+
+  IsValid &= Check(State.Program, static_cast<GLuint>(GetInteger(GL_CURRENT_PROGRAM)), "Program");
+  IsValid &= Check(State.VAO, static_cast<GLuint>(GetInteger(GL_VERTEX_ARRAY_BINDING)), "VAO");
+  IsValid &= Check(State.DrawFBO, static_cast<GLuint>(GetInteger(GL_DRAW_FRAMEBUFFER_BINDING)), "Draw FBO");
+  IsValid &= Check(State.ReadFBO, static_cast<GLuint>(GetInteger(GL_READ_FRAMEBUFFER_BINDING)), "Read FBO");
+
+  const GLenum ActiveTexture = static_cast<GLenum>(GetInteger(GL_ACTIVE_TEXTURE));
+  IsValid &= Check(State.ActiveTexture, ActiveTexture, "Active texture unit");
+
+  for (size_t Unit = 0; Unit < State.TextureUnits.size(); ++Unit)
+  {
+    TTextureUnit &Bindings = State.TextureUnits[Unit];
+    if (!State.Samplers[Unit] && std::ranges::none_of(Bindings, [](const std::optional<GLuint> &_Binding) { return _Binding.has_value(); }))
+      continue;
+
+    glActiveTexture(static_cast<GLenum>(GL_TEXTURE0 + Unit));
+
+    IsValid &= Check(State.Samplers[Unit], static_cast<GLuint>(GetInteger(GL_SAMPLER_BINDING)), std::format("Texture unit {} sampler", Unit));
+
+    for (size_t Target = 0; Target < Bindings.size(); ++Target)
+      IsValid &= Check(Bindings[Target], static_cast<GLuint>(GetInteger(TEXTURE_TARGET_BINDINGS[Target])), std::format("Texture unit {} binding", Unit));
+  }
+
+  glActiveTexture(ActiveTexture);
+
+  for (size_t i = 0; i < TRACKED_CAPABILITIES.size(); ++i)
+    IsValid &= Check(State.Capabilities[i], glIsEnabled(TRACKED_CAPABILITIES[i]) == GL_TRUE, std::format("Capability {:#x}", TRACKED_CAPABILITIES[i]));
+
+  IsValid &= Check(State.DepthFunc, static_cast<GLenum>(GetInteger(GL_DEPTH_FUNC)), "Depth func");
+  IsValid &= Check(State.DepthMask, GetInteger(GL_DEPTH_WRITEMASK) == GL_TRUE, "Depth mask");
+  IsValid &= Check(State.StencilMask, static_cast<GLuint>(GetInteger(GL_STENCIL_WRITEMASK)), "Stencil mask");
+  IsValid &= Check(State.CullFace, static_cast<GLenum>(GetInteger(GL_CULL_FACE_MODE)), "Cull face");
+  IsValid &= Check(State.FrontFace, static_cast<GLenum>(GetInteger(GL_FRONT_FACE)), "Front face");
+
+  const TBlendFunc BlendFunc{.Source = static_cast<GLenum>(GetInteger(GL_BLEND_SRC_RGB)), .Destination = static_cast<GLenum>(GetInteger(GL_BLEND_DST_RGB))};
+  IsValid &= Check(State.BlendFunc, BlendFunc, "Blend func");
+
+  GLint Viewport[4] = {0, 0, 0, 0};
+  glGetIntegerv(GL_VIEWPORT, Viewport);
+  IsValid &= Check(State.Viewport, TViewport{.X = Viewport[0], .Y = Viewport[1], .Width = Viewport[2], .Height = Viewport[3]}, "Viewport");
+
+  return IsValid;
+}
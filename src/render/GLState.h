@@ -0,0 +1,55 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// Shadow copy of the GL state the engine changes. All state changes go through it, so calls that
+// wouldn't change anything never reach the driver and the render counters only see real changes.
+// State that wasn't set yet is unknown and always applied. Code that changes the state behind the
+// tracker has to restore it (the ImGui backend does) or call Invalidate().
+class CGLState final
+{
+public:
+  struct TViewport
+  {
+    GLint   X      = 0;
+    GLint   Y      = 0;
+    GLsizei Width  = 0;
+    GLsizei Height = 0;
+
+    bool operator==(const TViewport &) const = default;
+  };
+
+public:
+  static void UseProgram(GLuint _Program);
+  static void BindVertexArray(GLuint _VAO);
+  static void BindFramebuffer(GLenum _Target, GLuint _FBO); // GL_FRAMEBUFFER binds both the draw and the read buffer
+  static void BindTexture(GLenum _Target, GLenum _TextureUnit, GLuint _Texture); // Binds the sampler of the texture as well
+  static void BindSampler(GLenum _TextureUnit, GLuint _Sampler);
+
+  static void SetEnabled(GLenum _Capability, bool _Enable);
+  static void SetDepthFunc(GLenum _Func);
+  static void SetDepthMask(bool _Flag);
+  static void SetStencilMask(GLuint _Mask);
+  static void SetBlendFunc(GLenum _Source, GLenum _Destination);
+  static void SetCullFace(GLenum _Mode);
+  static void SetFrontFace(GLenum _Mode);
+  static void SetViewport(const TViewport &_Viewport);
+
+  // Not GL state and kept over Invalidate(). Textures without one are sampled with their own parameters.
+  static void SetTextureSampler(GLuint _Texture, GLuint _Sampler);
+
+  // Queried from GL only while unknown
+  static GLuint GetDrawFramebuffer();
+  static TViewport GetViewport();
+
+  // Deleting a bound object resets its bindings to zero, its name may be handed out again
+  static void OnTextureDeleted(GLuint _Texture);
+  static void OnVertexArrayDeleted(GLuint _VAO);
+  static void OnFramebufferDeleted(GLuint _FBO);
+
+  static void Invalidate();
+
+  // Compares the known state with glGet, logs every mismatch and adopts the actual value.
+  // Stalls the pipeline, meant for debugging only.
+  static bool Validate();
+};
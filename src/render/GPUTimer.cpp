@@ -0,0 +1,77 @@
+#include "GPUTimer.h"
+#include <cassert>
+
+CGPUTimer::CGPUTimer() :
+    m_Queries{},
+    m_IsPending{},
+    m_Index(0),
+    m_IsActive(false),
+    m_ElapsedTime(0.0f)
+{
+  glGenQueries(QUERIES_COUNT, m_Queries.data());
+}
+
+CGPUTimer::~CGPUTimer()
+{
+  glDeleteQueries(QUERIES_COUNT, m_Queries.data());
+}
+
+void CGPUTimer::Begin()
+{
+  assert(!m_IsActive);
+
+  CollectResults();
+
+  if (m_IsPending[m_Index]) // The oldest query is still in flight, wait for it instead of dropping the sample
+  {
+    GLuint64 Elapsed = 0;
+    glGetQueryObjectui64v(m_Queries[m_Index], GL_QUERY_RESULT, &Elapsed);
+    m_ElapsedTime        = static_cast<float>(Elapsed) / 1'000'000.0f;
+    m_IsPending[m_Index] = false;
+  }
+
+  glBeginQuery(GL_TIME_ELAPSED, m_Queries[m_Index]);
+  m_IsActive = true;
+}
+
+void CGPUTimer::End()
+{
+  assert(m_IsActive);
+
+  glEndQuery(GL_TIME_ELAPSED);
+
+  m_IsPending[m_Index] = true;
+  m_Index              = (m_Index + 1) % QUERIES_COUNT;
+  m_IsActive           = false;
+}
+
+void CGPUTimer::Clear()
+{
+  m_ElapsedTime = 0.0f;
+}
+
+float CGPUTimer::GetElapsedTimeMs() const
+{
+  return m_ElapsedTime;
+}
+
+void CGPUTimer::CollectResults()
+{
+  // Walk the ring from the oldest query to the newest one so the latest available result wins
+  for (int i = 0; i < QUERIES_COUNT; ++i)
+  {
+    const int Index = (m_Index + i) % QUERIES_COUNT;
+    if (!m_IsPending[Index])
+      continue;
+
+    GLint IsAvailable = GL_FALSE;
+    glGetQueryObjectiv(m_Queries[Index], GL_QUERY_RESULT_AVAILABLE, &IsAvailable);
+    if (IsAvailable == GL_FALSE)
+      break;
+
+    GLuint64 Elapsed = 0;
+    glGetQueryObjectui64v(m_Queries[Index], GL_QUERY_RESULT, &Elapsed);
+    m_ElapsedTime      = static_cast<float>(Elapsed) / 1'000'000.0f;
+    m_IsPending[Index] = false;
+  }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <common/Core.h>
+#include <array>
+
+// Measures GPU time of a command range with GL_TIME_ELAPSED queries.
+// Results are read back a few frames later to avoid stalling the pipeline.
+class CGPUTimer final
+{
+  DISABLE_CLASS_COPY(CGPUTimer);
+
+public:
+  CGPUTimer();
+  ~CGPUTimer();
+
+  void Begin();
+  void End();
+  void Clear();
+
+  float GetElapsedTimeMs() const;
+
+private:
+  void CollectResults();
+
+private:
+  static constexpr int QUERIES_COUNT = 4;
+
+  std::array<GLuint, QUERIES_COUNT> m_Queries;
+  std::array<bool, QUERIES_COUNT>   m_IsPending;
+  int                               m_Index;
+  bool                              m_IsActive;
+  float                             m_ElapsedTime;
+};
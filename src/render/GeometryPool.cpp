@@ -0,0 +1,202 @@
+#include "GeometryPool.h"
+#include <cassert>
+#include <iterator>
+
+struct CGeometryPool::TBucket
+{
+  TVertexFormat              Format;
+  TSharedVAO                 VAO;
+  std::vector<CVertexBuffer> VBOs; // One stream per attribute
+  CElementBuffer             EBO;
+  CRangeList                 FreeVertices;
+  CRangeList                 FreeIndices;
+  uint32_t                   VerticesCount = 0; // Used part of the buffers, including the free ranges
+  uint32_t                   IndicesCount  = 0;
+  bool                       IsLayoutDirty = true;
+
+  explicit TBucket(const TVertexFormat &_Format) :
+      Format(_Format),
+      VAO(std::make_shared<CVertexArray>()),
+      EBO(GL_STATIC_DRAW)
+  {
+    VBOs.reserve(Format.size());
+    for (size_t i = 0; i < Format.size(); ++i)
+      VBOs.emplace_back(GL_STATIC_DRAW);
+  }
+};
+
+// ------------------------------------------------
+
+std::optional<uint32_t> CGeometryPool::CRangeList::Take(uint32_t _Count)
+{
+  for (auto It = m_Ranges.begin(); It != m_Ranges.end(); ++It)
+  {
+    if (It->second < _Count)
+      continue;
+
+    const uint32_t Offset    = It->first;
+    const uint32_t Remaining = It->second - _Count;
+
+    m_Ranges.erase(It);
+    if (Remaining > 0)
+      m_Ranges.emplace(Offset + _Count, Remaining);
+
+    return Offset;
+  }
+
+  return std::nullopt;
+}
+
+void CGeometryPool::CRangeList::Release(uint32_t _Offset, uint32_t _Count)
+{
+  auto Next = m_Ranges.lower_bound(_Offset);
+  if (Next != m_Ranges.end() && _Offset + _Count == Next->first)
+  {
+    _Count += Next->second;
+    Next = m_Ranges.erase(Next);
+  }
+
+  if (Next != m_Ranges.begin())
+  {
+    auto Prev = std::prev(Next);
+    if (Prev->first + Prev->second == _Offset)
+    {
+      Prev->second += _Count;
+      return;
+    }
+  }
+
+  m_Ranges.emplace_hint(Next, _Offset, _Count);
+}
+
+// ------------------------------------------------
+
+CGeometryPool::CAllocation::CAllocation(std::shared_ptr<CGeometryPool> _Pool, TBucket &_Bucket, uint32_t _BaseVertex, uint32_t _VerticesCount,
+                                        uint32_t _FirstIndex, uint32_t _IndicesCount) :
+    m_Pool(std::move(_Pool)),
+    m_Bucket(_Bucket),
+    m_BaseVertex(_BaseVertex),
+    m_VerticesCount(_VerticesCount),
+    m_FirstIndex(_FirstIndex),
+    m_IndicesCount(_IndicesCount)
+{
+}
+
+CGeometryPool::CAllocation::~CAllocation()
+{
+  // The stale data stays in the buffers until the ranges are reused, nothing references it
+  m_Bucket.FreeVertices.Release(m_BaseVertex, m_VerticesCount);
+  m_Bucket.FreeIndices.Release(m_FirstIndex, m_IndicesCount);
+}
+
+const TSharedVAO &CGeometryPool::CAllocation::GetVAO() const
+{
+  return m_Bucket.VAO;
+}
+
+uint32_t CGeometryPool::CAllocation::GetBaseVertex() const
+{
+  return m_BaseVertex;
+}
+
+uint32_t CGeometryPool::CAllocation::GetVerticesCount() const
+{
+  return m_VerticesCount;
+}
+
+uint32_t CGeometryPool::CAllocation::GetFirstIndex() const
+{
+  return m_FirstIndex;
+}
+
+uint32_t CGeometryPool::CAllocation::GetIndicesCount() const
+{
+  return m_IndicesCount;
+}
+
+// ------------------------------------------------
+
+CGeometryPool::CGeometryPool() = default;
+
+CGeometryPool::~CGeometryPool() = default;
+
+std::shared_ptr<CGeometryPool::CAllocation> CGeometryPool::Allocate(const TGeometryData &_Geometry)
+{
+  assert(_Geometry.Streams.size() == _Geometry.Format.size());
+  assert(_Geometry.VerticesCount > 0 && !_Geometry.Indices.empty());
+
+  TBucket &Bucket = GetBucket(_Geometry.Format);
+
+  const uint32_t                IndicesCount = static_cast<uint32_t>(_Geometry.Indices.size());
+  const std::optional<uint32_t> FreeVertices = Bucket.FreeVertices.Take(_Geometry.VerticesCount);
+  const std::optional<uint32_t> FreeIndices  = Bucket.FreeIndices.Take(IndicesCount);
+  const uint32_t                BaseVertex   = FreeVertices.value_or(Bucket.VerticesCount);
+  const uint32_t                FirstIndex   = FreeIndices.value_or(Bucket.IndicesCount);
+
+  for (size_t i = 0; i < Bucket.VBOs.size(); ++i)
+  {
+    const std::span<const uint8_t> &Stream = _Geometry.Streams[i];
+    const GLsizei                   Stride = Bucket.Format[i].Stride;
+    CVertexBuffer                  &VBO    = Bucket.VBOs[i];
+
+    assert(Stream.size() == static_cast<size_t>(_Geometry.VerticesCount) * Stride);
+
+    if (FreeVertices)
+    {
+      VBO.Write(static_cast<GLintptr>(BaseVertex) * Stride, Stream.data(), Stream.size());
+    }
+    else
+    {
+      VBO.Push(Stream.data(), Stream.size());
+    }
+  }
+
+  const GLsizeiptr IndicesSize = static_cast<GLsizeiptr>(IndicesCount * sizeof(uint32_t));
+
+  if (FreeIndices)
+  {
+    Bucket.EBO.Write(static_cast<GLintptr>(FirstIndex * sizeof(uint32_t)), _Geometry.Indices.data(), IndicesSize);
+  }
+  else
+  {
+    Bucket.EBO.Push(_Geometry.Indices.data(), IndicesSize);
+  }
+
+  if (!FreeVertices)
+    Bucket.VerticesCount += _Geometry.VerticesCount;
+  if (!FreeIndices)
+    Bucket.IndicesCount += IndicesCount;
+
+  // Growing keeps the buffer names, the VAO is only set up once
+  if (Bucket.IsLayoutDirty)
+    SetupVertexArray(Bucket);
+
+  return std::make_shared<CAllocation>(GetSharedPtr(), Bucket, BaseVertex, _Geometry.VerticesCount, FirstIndex, IndicesCount);
+}
+
+CGeometryPool::TBucket &CGeometryPool::GetBucket(const TVertexFormat &_Format)
+{
+  auto It = m_BucketsByFormat.find(_Format);
+  if (It != m_BucketsByFormat.end())
+    return *It->second;
+
+  TBucket *Bucket = m_Buckets.emplace_back(std::make_unique<TBucket>(_Format)).get();
+  m_BucketsByFormat.emplace(_Format, Bucket);
+  return *Bucket;
+}
+
+// Every stream is sourced from its own binding point
+void CGeometryPool::SetupVertexArray(TBucket &_Bucket)
+{
+  for (size_t i = 0; i < _Bucket.VBOs.size(); ++i)
+  {
+    const TVertexAttribute &Attribute    = _Bucket.Format[i];
+    const GLuint            BindingIndex = static_cast<GLuint>(i);
+
+    _Bucket.VAO->AttachVertexBuffer(BindingIndex, _Bucket.VBOs[i].ID(), Attribute.Stride);
+    _Bucket.VAO->EnableAttrib(Attribute.Location, Attribute.Size, Attribute.ComponentType, Attribute.IsNormalized, BindingIndex);
+  }
+
+  _Bucket.VAO->AttachElementBuffer(_Bucket.EBO.ID());
+  _Bucket.IsLayoutDirty = false;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "Buffer.h"
+#include <common/Core.h>
+#include <common/Sharable.h>
+#include <compare>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+struct TVertexAttribute
+{
+  GLuint    Location;
+  GLint     Size;
+  GLenum    ComponentType;
+  GLboolean IsNormalized;
+  GLsizei   Stride; // Size of one vertex in the stream, the data is tightly packed
+
+  auto operator<=>(const TVertexAttribute &) const = default;
+};
+
+using TVertexFormat = std::vector<TVertexAttribute>;
+
+struct TGeometryData
+{
+  TVertexFormat                         Format;
+  std::vector<std::span<const uint8_t>> Streams; // One per attribute of the format
+  uint32_t                              VerticesCount = 0;
+  std::vector<uint32_t>                 Indices;
+};
+
+// Vertex and index data of all models, grouped by vertex format. Geometry of one format lives in
+// a shared set of buffers behind a single VAO, so draws of different meshes can be merged into one
+// multi-draw call and addressed with a first index and a base vertex.
+class CGeometryPool final : public CSharable<CGeometryPool>
+{
+  struct TBucket;
+
+  // Free ranges of a buffer, in elements, merged with their neighbours when released
+  class CRangeList final
+  {
+  public:
+    std::optional<uint32_t> Take(uint32_t _Count);
+    void Release(uint32_t _Offset, uint32_t _Count);
+
+  private:
+    std::map<uint32_t, uint32_t> m_Ranges; // Offset -> count
+  };
+
+public:
+  // Keeps the geometry in the pool, its ranges are reused once the allocation is gone
+  class CAllocation final
+  {
+    DISABLE_CLASS_COPY(CAllocation);
+
+  public:
+    CAllocation(std::shared_ptr<CGeometryPool> _Pool, TBucket &_Bucket, uint32_t _BaseVertex, uint32_t _VerticesCount, uint32_t _FirstIndex,
+                uint32_t _IndicesCount);
+    ~CAllocation();
+
+    const TSharedVAO &GetVAO() const;
+    uint32_t GetBaseVertex() const;
+    uint32_t GetVerticesCount() const;
+    uint32_t GetFirstIndex() const;
+    uint32_t GetIndicesCount() const;
+
+  private:
+    std::shared_ptr<CGeometryPool> m_Pool;
+    TBucket                       &m_Bucket;
+    uint32_t                       m_BaseVertex;
+    uint32_t                       m_VerticesCount;
+    uint32_t                       m_FirstIndex;
+    uint32_t                       m_IndicesCount;
+  };
+
+public:
+  CGeometryPool();
+  ~CGeometryPool();
+
+  // Indices are relative to the first vertex of the geometry
+  std::shared_ptr<CAllocation> Allocate(const TGeometryData &_Geometry);
+
+private:
+  TBucket &GetBucket(const TVertexFormat &_Format);
+
+  static void SetupVertexArray(TBucket &_Bucket);
+
+private:
+  std::vector<std::unique_ptr<TBucket>> m_Buckets;
+  std::map<TVertexFormat, TBucket *>    m_BucketsByFormat;
+};
@@ -0,0 +1,169 @@
+#include "HiZCulling.h"
+#include "IndirectDrawBuffer.h"
+#include "assets/Shader.h"
+#include "assets/Texture.h"
+#include "utils/Resource.h"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace
+{
+
+constexpr GLuint PYRAMID_GROUP_SIZE = 8;  // local_size of HiZInit.comp and HiZReduce.comp
+constexpr GLuint CULL_GROUP_SIZE    = 64; // local_size of OcclusionCull.comp
+
+GLuint GetGroupsCount(int _Size, GLuint _GroupSize)
+{
+  return (static_cast<GLuint>(_Size) + _GroupSize - 1) / _GroupSize;
+}
+
+} // namespace
+
+CHiZCulling::CHiZCulling() :
+    m_InitShader(resource::LoadShader("HiZInit")),
+    m_ReduceShader(resource::LoadShader("HiZReduce")),
+    m_CullShader(resource::LoadShader("OcclusionCull")),
+    m_Uniforms{},
+    m_DepthSamples(0),
+    m_PyramidLevels(0),
+    m_PyramidViewProjection(1.0f),
+    m_HasPyramid(false),
+    m_PendingDraws(GL_DYNAMIC_COPY)
+{
+  if (m_InitShader)
+  {
+    m_Uniforms.DepthMap   = m_InitShader->GetUniformHandle<int>("u_DepthMap");
+    m_Uniforms.DepthMapMS = m_InitShader->GetUniformHandle<int>("u_DepthMapMS");
+    m_Uniforms.Samples    = m_InitShader->GetUniformHandle<int>("u_Samples");
+  }
+
+  if (m_CullShader)
+  {
+    m_Uniforms.HiZ            = m_CullShader->GetUniformHandle<int>("u_HiZ");
+    m_Uniforms.ViewProjection = m_CullShader->GetUniformHandle<glm::mat4>("u_ViewProjection");
+    m_Uniforms.FirstCommand   = m_CullShader->GetUniformHandle<unsigned>("u_FirstCommand");
+    m_Uniforms.CommandsCount  = m_CullShader->GetUniformHandle<unsigned>("u_CommandsCount");
+    m_Uniforms.Phase          = m_CullShader->GetUniformHandle<int>("u_Phase");
+  }
+}
+
+bool CHiZCulling::IsAvailable() const
+{
+  return m_InitShader && m_ReduceShader && m_CullShader;
+}
+
+void CHiZCulling::SetDepthTexture(std::shared_ptr<CTexture> _DepthTexture)
+{
+  if (m_DepthTexture == _DepthTexture)
+    return;
+
+  m_DepthTexture = std::move(_DepthTexture);
+  m_HasPyramid   = false;
+
+  if (!m_DepthTexture)
+    return;
+
+  m_DepthSamples = 0;
+  if (m_DepthTexture->Target() == GL_TEXTURE_2D_MULTISAMPLE)
+    glGetTextureLevelParameteriv(m_DepthTexture->ID(), 0, GL_TEXTURE_SAMPLES, &m_DepthSamples);
+
+  if (!m_Pyramid || m_Pyramid->GetSize() != m_DepthTexture->GetSize())
+    CreatePyramid(m_DepthTexture->GetSize());
+}
+
+void CHiZCulling::CullFirstPhase(const TIndirectCommandsRange &_Commands)
+{
+  assert(_Commands.CommandsCount > 0);
+
+  m_PendingDraws.Reserve(static_cast<GLsizeiptr>(_Commands.CommandsCount * sizeof(uint32_t)));
+
+  if (m_HasPyramid)
+  {
+    Cull(_Commands, ECullPhase_First);
+    return;
+  }
+
+  // Everything is drawn now, nothing is left for the second phase
+  glClearNamedBufferSubData(m_PendingDraws.ID(), GL_R32UI, 0, static_cast<GLsizeiptr>(_Commands.CommandsCount * sizeof(uint32_t)), GL_RED_INTEGER,
+                            GL_UNSIGNED_INT, nullptr);
+}
+
+void CHiZCulling::BuildPyramid(const glm::mat4 &_ViewProjection)
+{
+  assert(m_DepthTexture && m_Pyramid);
+
+  const TVector2i Size = m_Pyramid->GetSize();
+
+  m_InitShader->Use();
+  m_InitShader->SetUniform(m_Uniforms.DepthMap, TEXTURE_DEPTH_MAP_INDEX);
+  m_InitShader->SetUniform(m_Uniforms.DepthMapMS, TEXTURE_DEPTH_MAP_MS_INDEX);
+  m_InitShader->SetUniform(m_Uniforms.Samples, m_DepthSamples);
+  m_DepthTexture->Bind(m_DepthSamples > 0 ? TEXTURE_DEPTH_MAP_MS_UNIT : TEXTURE_DEPTH_MAP_UNIT);
+
+  glBindImageTexture(0, m_Pyramid->ID(), 0, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+  glDispatchCompute(GetGroupsCount(Size.X, PYRAMID_GROUP_SIZE), GetGroupsCount(Size.Y, PYRAMID_GROUP_SIZE), 1);
+
+  m_ReduceShader->Use();
+
+  for (int Level = 1; Level < m_PyramidLevels; ++Level)
+  {
+    glMemoryBarrier(GL_SHADER_IMAGE_ACCESS_BARRIER_BIT);
+    glBindImageTexture(0, m_Pyramid->ID(), Level - 1, GL_FALSE, 0, GL_READ_ONLY, GL_R32F);
+    glBindImageTexture(1, m_Pyramid->ID(), Level, GL_FALSE, 0, GL_WRITE_ONLY, GL_R32F);
+
+    const int Width  = std::max(Size.X >> Level, 1);
+    const int Height = std::max(Size.Y >> Level, 1);
+    glDispatchCompute(GetGroupsCount(Width, PYRAMID_GROUP_SIZE), GetGroupsCount(Height, PYRAMID_GROUP_SIZE), 1);
+  }
+
+  glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+  m_PyramidViewProjection = _ViewProjection;
+  m_HasPyramid            = true;
+}
+
+void CHiZCulling::CullSecondPhase(const TIndirectCommandsRange &_Commands)
+{
+  assert(m_HasPyramid);
+  Cull(_Commands, ECullPhase_Second);
+}
+
+void CHiZCulling::Cull(const TIndirectCommandsRange &_Commands, ECullPhase _Phase)
+{
+  m_CullShader->Use();
+  m_CullShader->SetUniform(m_Uniforms.HiZ, TEXTURE_HIZ_INDEX);
+  m_CullShader->SetUniform(m_Uniforms.ViewProjection, m_PyramidViewProjection);
+  m_CullShader->SetUniform(m_Uniforms.FirstCommand, _Commands.FirstCommand);
+  m_CullShader->SetUniform(m_Uniforms.CommandsCount, _Commands.CommandsCount);
+  m_CullShader->SetUniform(m_Uniforms.Phase, static_cast<int>(_Phase));
+  m_Pyramid->Bind(TEXTURE_HIZ_UNIT);
+
+  // The draw data is still bound by the indirect draw buffer
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, BINDING_DRAW_COMMANDS_BUFFER, _Commands.Buffer);
+  m_PendingDraws.BindToBase(BINDING_PENDING_DRAWS_BUFFER);
+
+  glDispatchCompute(GetGroupsCount(static_cast<int>(_Commands.CommandsCount), CULL_GROUP_SIZE), 1, 1);
+
+  // The commands are read by the draws, the pending flags by the second phase
+  glMemoryBarrier(GL_COMMAND_BARRIER_BIT | GL_SHADER_STORAGE_BARRIER_BIT);
+}
+
+void CHiZCulling::CreatePyramid(TVector2i _Size)
+{
+  TTextureParams Params;
+  Params.Width           = _Size.X;
+  Params.Height          = _Size.Y;
+  Params.InternalFormat  = EInternalFormat::R32F;
+  Params.Format          = EFormat::Red;
+  Params.Type            = EType::Float;
+  Params.GenerateMipmaps = true;
+  Params.MinFilter       = ETextureFilter::NearestMipmapNearest;
+  Params.MagFilter       = ETextureFilter::Nearest;
+  Params.WrapS           = ETextureWrap::ClampToEdge;
+  Params.WrapT           = ETextureWrap::ClampToEdge;
+  Params.MemoryTag       = EGPUMemoryTag::RenderTargets;
+
+  m_Pyramid       = resource::RecreateTexture("HIZ_PYRAMID", Params);
+  m_PyramidLevels = static_cast<int>(std::bit_width(static_cast<unsigned>(std::max(_Size.X, _Size.Y))));
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Buffer.h"
+#include "ShaderTypes.h"
+#include <common/Core.h>
+#include <common/MathTypes.h>
+#include <glm/mat4x4.hpp>
+#include <cstdint>
+#include <memory>
+
+class CShader;
+class CTexture;
+struct TIndirectCommandsRange;
+
+// Occlusion culling on the GPU against a hierarchical depth buffer (Hi-Z). Every level of the
+// pyramid keeps the farthest depth of 2x2 texels of the level above, so a box is tested with four
+// fetches from the level where it covers at most 2x2 texels. Works on the indirect commands in
+// place: hidden draws keep their command with no instances, the CPU never reads anything back.
+//
+// Two phases per frame. The first tests against the pyramid of the last frame and keeps what it
+// hides. The pyramid is then rebuilt from the depth drawn so far, the second phase tests the kept
+// draws against it and draws the ones that were hidden wrongly. The pyramid stays for the next frame.
+class CHiZCulling final
+{
+  DISABLE_CLASS_COPY(CHiZCulling);
+
+public:
+  CHiZCulling();
+
+  bool IsAvailable() const;
+
+  // The pyramid is built from it, a different texture drops the pyramid of the last frame
+  void SetDepthTexture(std::shared_ptr<CTexture> _DepthTexture);
+
+  // Every command has to draw a single instance. Without a pyramid all draws stay.
+  void CullFirstPhase(const TIndirectCommandsRange &_Commands);
+  void BuildPyramid(const glm::mat4 &_ViewProjection);
+  // Same commands as the first phase, only the draws it hid wrongly are left
+  void CullSecondPhase(const TIndirectCommandsRange &_Commands);
+
+private:
+  enum ECullPhase : int
+  {
+    ECullPhase_First,
+    ECullPhase_Second
+  };
+
+  struct TUniforms
+  {
+    TUniformHandle<int>       DepthMap;
+    TUniformHandle<int>       DepthMapMS;
+    TUniformHandle<int>       Samples;
+    TUniformHandle<int>       HiZ;
+    TUniformHandle<glm::mat4> ViewProjection;
+    TUniformHandle<unsigned>  FirstCommand;
+    TUniformHandle<unsigned>  CommandsCount;
+    TUniformHandle<int>       Phase;
+  };
+
+  void Cull(const TIndirectCommandsRange &_Commands, ECullPhase _Phase);
+  void CreatePyramid(TVector2i _Size);
+
+private:
+  std::shared_ptr<CShader>  m_InitShader;
+  std::shared_ptr<CShader>  m_ReduceShader;
+  std::shared_ptr<CShader>  m_CullShader;
+  TUniforms                 m_Uniforms;
+  std::shared_ptr<CTexture> m_DepthTexture;
+  int                       m_DepthSamples; // Zero if not multisampled
+  std::shared_ptr<CTexture> m_Pyramid;
+  int                       m_PyramidLevels;
+  glm::mat4                 m_PyramidViewProjection;
+  bool                      m_HasPyramid;
+  CShaderStorageBuffer      m_PendingDraws; // One flag per command, written by the first phase
+};
@@ -0,0 +1,160 @@
+#include "IndirectDrawBuffer.h"
+#include "RenderCommand.h"
+#include "RenderTypes.h"
+#include "ShaderTypes.h"
+#include <cassert>
+
+namespace
+{
+
+constexpr GLsizeiptr INITIAL_DRAWS_COUNT = 4096;
+
+bool IsSameGeometryState(const TRenderCommand &_First, const TRenderCommand &_Command)
+{
+  return _First.VAO == _Command.VAO && _First.PrimitiveMode == _Command.PrimitiveMode && _First.IndexType == _Command.IndexType;
+}
+
+bool IsSameGeometry(const TRenderCommand &_First, const TRenderCommand &_Command)
+{
+  return _First.FirstIndex == _Command.FirstIndex && _First.BaseVertex == _Command.BaseVertex && _First.IndicesCount == _Command.IndicesCount;
+}
+
+} // namespace
+
+bool IsSameMaterialState(const TRenderCommand &_First, const TRenderCommand &_Command)
+{
+  const TMaterial &First    = _First.Material;
+  const TMaterial &Material = _Command.Material;
+
+  return First.BaseColorTexture == Material.BaseColorTexture && First.NormalTexture == Material.NormalTexture &&
+         First.MetallicRoughnessTexture == Material.MetallicRoughnessTexture && First.OcclusionTexture == Material.OcclusionTexture &&
+         First.EmissiveTexture == Material.EmissiveTexture && First.AlphaMode == Material.AlphaMode && First.IsDoubleSided == Material.IsDoubleSided;
+}
+
+CIndirectDrawBuffer::CIndirectDrawBuffer() :
+    m_DrawData(GL_SHADER_STORAGE_BUFFER, INITIAL_DRAWS_COUNT * sizeof(TShaderDrawData)),
+    m_IndirectCommands(GL_DRAW_INDIRECT_BUFFER, INITIAL_DRAWS_COUNT * sizeof(TDrawElementsIndirectCommand)),
+    m_CommandsRange{}
+{
+}
+
+void CIndirectDrawBuffer::BeginFrame()
+{
+  m_DrawData.BeginFrame();
+  m_IndirectCommands.BeginFrame();
+}
+
+void CIndirectDrawBuffer::EndFrame()
+{
+  m_DrawData.EndFrame();
+  m_IndirectCommands.EndFrame();
+}
+
+const std::vector<TDrawBatch> &CIndirectDrawBuffer::Build(const std::vector<const TRenderCommand *> &_Commands, TCanMergeFunc _CanMerge,
+                                                          bool _AllowInstancing)
+{
+  m_Batches.clear();
+  m_CommandsRange = TIndirectCommandsRange{};
+  if (_Commands.empty())
+    return m_Batches;
+
+  const GLsizeiptr DrawsCount = static_cast<GLsizeiptr>(_Commands.size());
+
+  // Both allocations are made before writing anything, growing a buffer drops what it held
+  const CRingBuffer::TAllocation DrawData = m_DrawData.Allocate(DrawsCount * sizeof(TShaderDrawData), sizeof(TShaderDrawData));
+  const CRingBuffer::TAllocation Commands =
+      m_IndirectCommands.Allocate(DrawsCount * sizeof(TDrawElementsIndirectCommand), sizeof(TDrawElementsIndirectCommand));
+
+  TShaderDrawData              *Draws     = static_cast<TShaderDrawData *>(DrawData.Data);
+  TDrawElementsIndirectCommand *Indirect  = static_cast<TDrawElementsIndirectCommand *>(Commands.Data);
+  const uint32_t                FirstDraw = static_cast<uint32_t>(DrawData.Offset / sizeof(TShaderDrawData));
+
+  uint32_t DrawIndex    = 0;
+  uint32_t CommandIndex = 0;
+
+  for (size_t BatchBegin = 0; BatchBegin < _Commands.size();)
+  {
+    const TRenderCommand *First = _Commands[BatchBegin];
+
+    size_t BatchEnd = BatchBegin + 1;
+    while (BatchEnd < _Commands.size() && IsSameGeometryState(*First, *_Commands[BatchEnd]) && _CanMerge(*First, *_Commands[BatchEnd]))
+      ++BatchEnd;
+
+    // All draws of a batch share the state, so their order only matters for blending. Within a VAO
+    // the first index tells the geometry apart, sorting by it puts the copies of a mesh together.
+    m_Entries.clear();
+    for (size_t i = BatchBegin; i < BatchEnd; ++i)
+      m_Entries.push_back(utils::TSortEntry{.Key = _AllowInstancing ? _Commands[i]->FirstIndex : 0, .Index = static_cast<uint32_t>(i)});
+
+    if (_AllowInstancing)
+      utils::RadixSort(m_Entries, m_Scratch);
+
+    TDrawBatch &Batch = m_Batches.emplace_back(TDrawBatch{
+        .Command        = First,
+        .CommandsOffset = Commands.Offset + static_cast<GLintptr>(CommandIndex * sizeof(TDrawElementsIndirectCommand)),
+        .DrawsCount     = 0,
+        .IndicesCount   = 0,
+    });
+
+    // Built here and stored once complete, the mapped memory is slow to read back
+    TDrawElementsIndirectCommand Current{};
+    const TRenderCommand        *Previous = nullptr;
+
+    for (const utils::TSortEntry &Entry : m_Entries)
+    {
+      const TRenderCommand *Command = _Commands[Entry.Index];
+      assert(Command->IndexType == EIndexType::UnsignedInt && "Indirect draws expect pooled geometry");
+
+      Draws[DrawIndex] = TShaderDrawData{
+          .Model         = Command->ModelMatrix,
+          .MaterialIndex = Command->Material.Index,
+          .BoundsMin     = glm::vec4(Command->Bounds.Min, 0.0f),
+          .BoundsMax     = glm::vec4(Command->Bounds.Max, 0.0f),
+      };
+
+      if (_AllowInstancing && Previous && IsSameGeometry(*Previous, *Command))
+      {
+        Current.InstanceCount++;
+      }
+      else
+      {
+        if (Previous)
+          Indirect[CommandIndex++] = Current;
+
+        Current = TDrawElementsIndirectCommand{
+            .Count         = Command->IndicesCount,
+            .InstanceCount = 1,
+            .FirstIndex    = Command->FirstIndex,
+            .BaseVertex    = Command->BaseVertex,
+            .BaseInstance  = FirstDraw + DrawIndex,
+        };
+        Batch.DrawsCount++;
+      }
+
+      Batch.IndicesCount += Command->IndicesCount;
+      Previous = Command;
+      DrawIndex++;
+    }
+
+    Indirect[CommandIndex++] = Current;
+
+    BatchBegin = BatchEnd;
+  }
+
+  // Allocations are aligned to the command size from the start of the buffer
+  m_CommandsRange = TIndirectCommandsRange{
+      .Buffer        = m_IndirectCommands.ID(),
+      .FirstCommand  = static_cast<uint32_t>(Commands.Offset / sizeof(TDrawElementsIndirectCommand)),
+      .CommandsCount = CommandIndex,
+  };
+
+  m_DrawData.BindToBase(BINDING_DRAW_DATA_BUFFER);
+  m_IndirectCommands.BindToTarget(GL_DRAW_INDIRECT_BUFFER);
+
+  return m_Batches;
+}
+
+const TIndirectCommandsRange &CIndirectDrawBuffer::GetCommandsRange() const
+{
+  return m_CommandsRange;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "RingBuffer.h"
+#include <common/RadixSort.h>
+#include <cstdint>
+#include <vector>
+
+struct TRenderCommand;
+
+// Draws that share a VAO, a primitive mode and the state checked by the pass, submitted with one
+// multi-draw call. Every instance finds its data in the shaders at gl_BaseInstance + gl_InstanceID.
+struct TDrawBatch
+{
+  const TRenderCommand *Command;        // First command of the batch, carries the shared state
+  GLintptr              CommandsOffset; // in bytes, into the indirect commands buffer
+  uint32_t              DrawsCount;     // Indirect commands
+  uint32_t              IndicesCount;   // Of all instances
+};
+
+// Indirect commands written by one build, consecutive in the buffer
+struct TIndirectCommandsRange
+{
+  GLuint   Buffer;
+  uint32_t FirstCommand; // Index, not bytes
+  uint32_t CommandsCount;
+};
+
+// Merge rule of the lit passes: without bindless textures every batch binds the textures of its
+// first material, culling and blending are set per batch as well
+bool IsSameMaterialState(const TRenderCommand &_First, const TRenderCommand &_Command);
+
+// Per-draw transforms and material indices along with the indirect commands of every pass.
+// Both live in persistently mapped buffers that are rewritten each frame.
+class CIndirectDrawBuffer final
+{
+public:
+  using TCanMergeFunc = bool (*)(const TRenderCommand &_First, const TRenderCommand &_Command);
+
+public:
+  CIndirectDrawBuffer();
+
+  void BeginFrame();
+  void EndFrame();
+
+  // Groups neighbouring commands into batches, writes their draws and binds the buffers. With
+  // _AllowInstancing the draws of a batch are reordered so that repeated geometry becomes a single
+  // instanced command, passes that rely on the submission order must not use it.
+  // The batches are valid until the next call.
+  const std::vector<TDrawBatch> &Build(const std::vector<const TRenderCommand *> &_Commands, TCanMergeFunc _CanMerge, bool _AllowInstancing);
+
+  // Commands of the last Build()
+  const TIndirectCommandsRange &GetCommandsRange() const;
+
+private:
+  CRingBuffer                    m_DrawData;
+  CRingBuffer                    m_IndirectCommands;
+  TIndirectCommandsRange         m_CommandsRange;
+  std::vector<TDrawBatch>        m_Batches;
+  std::vector<utils::TSortEntry> m_Entries;
+  std::vector<utils::TSortEntry> m_Scratch;
+};
@@ -0,0 +1,71 @@
+#include "MaterialBuffer.h"
+#include <cassert>
+
+CMaterialBuffer::CHandle::CHandle(std::shared_ptr<CMaterialBuffer> _Buffer, uint32_t _Index) :
+    m_Buffer(std::move(_Buffer)),
+    m_Index(_Index)
+{
+}
+
+CMaterialBuffer::CHandle::~CHandle()
+{
+  m_Buffer->Remove(m_Index);
+}
+
+uint32_t CMaterialBuffer::CHandle::GetIndex() const
+{
+  return m_Index;
+}
+
+CMaterialBuffer::CMaterialBuffer() :
+    m_Buffer(GL_STATIC_DRAW),
+    m_IsDirty(false)
+{
+}
+
+std::shared_ptr<CMaterialBuffer::CHandle> CMaterialBuffer::Add(const TShaderMaterial &_Material)
+{
+  uint32_t Index = static_cast<uint32_t>(m_Materials.size());
+  if (m_FreeIndices.empty())
+  {
+    m_Materials.push_back(_Material);
+  }
+  else
+  {
+    Index = m_FreeIndices.back();
+    m_FreeIndices.pop_back();
+    m_Materials[Index] = _Material;
+  }
+
+  m_IsDirty = true;
+  return std::make_shared<CHandle>(GetSharedPtr(), Index);
+}
+
+void CMaterialBuffer::Remove(uint32_t _Index)
+{
+  assert(_Index < m_Materials.size());
+
+  // The stale entry stays in the buffer until the slot is reused, nothing references it
+  m_FreeIndices.push_back(_Index);
+}
+
+void CMaterialBuffer::Upload()
+{
+  if (!m_IsDirty || m_Materials.empty())
+    return;
+
+  m_Buffer.Assign(m_Materials);
+
+  m_IsDirty = false;
+}
+
+void CMaterialBuffer::Bind(GLuint _Binding)
+{
+  if (m_Buffer.GetCapacity() > 0)
+    m_Buffer.BindToBase(_Binding);
+}
+
+uint32_t CMaterialBuffer::GetMaterialsCount() const
+{
+  return static_cast<uint32_t>(m_Materials.size() - m_FreeIndices.size());
+}
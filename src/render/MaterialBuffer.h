@@ -0,0 +1,50 @@
+#pragma once
+
+#include "Buffer.h"
+#include "ShaderTypes.h"
+#include <common/Core.h>
+#include <common/Sharable.h>
+#include <memory>
+#include <vector>
+
+// Parameters of all loaded materials, packed once into a single std430 storage buffer.
+// Draws select their material by index instead of uploading the parameters every time.
+class CMaterialBuffer final : public CSharable<CMaterialBuffer>
+{
+public:
+  // Keeps a material in the buffer, its slot is reused once the handle is gone
+  class CHandle final
+  {
+    DISABLE_CLASS_COPY(CHandle);
+
+  public:
+    CHandle(std::shared_ptr<CMaterialBuffer> _Buffer, uint32_t _Index);
+    ~CHandle();
+
+    uint32_t GetIndex() const;
+
+  private:
+    std::shared_ptr<CMaterialBuffer> m_Buffer;
+    uint32_t                         m_Index;
+  };
+
+public:
+  CMaterialBuffer();
+
+  std::shared_ptr<CHandle> Add(const TShaderMaterial &_Material);
+
+  // Uploads the materials if any were added since the last call
+  void Upload();
+  void Bind(GLuint _Binding);
+
+  uint32_t GetMaterialsCount() const;
+
+private:
+  void Remove(uint32_t _Index);
+
+private:
+  std::vector<TShaderMaterial> m_Materials;
+  std::vector<uint32_t>        m_FreeIndices;
+  CShaderStorageBuffer         m_Buffer;
+  bool                         m_IsDirty;
+};
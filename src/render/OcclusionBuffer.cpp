@@ -0,0 +1,313 @@
+#include "OcclusionBuffer.h"
+#include <common/JobSystem.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define OCCLUSION_BUFFER_SSE 1
+#else
+#define OCCLUSION_BUFFER_SSE 0
+#endif
+
+namespace
+{
+
+constexpr float CLEAR_DEPTH = 1.0f;
+constexpr float MIN_W       = 1e-3f; // Triangles and boxes reaching behind it aren't projected
+
+struct TScreenVertex
+{
+  float X, Y, Z;
+};
+
+} // namespace
+
+COcclusionBuffer::COcclusionBuffer() :
+    m_ViewProjection(1.0f),
+    m_Depth(WIDTH * HEIGHT, CLEAR_DEPTH),
+    m_TilesMaxDepth(TILES_X * TILES_Y, CLEAR_DEPTH)
+{
+}
+
+void COcclusionBuffer::Begin(const glm::mat4 &_ViewProjection)
+{
+  m_ViewProjection = _ViewProjection;
+  m_Occluders.clear();
+}
+
+void COcclusionBuffer::AddOccluder(const TOccluderMesh &_Mesh, const glm::mat4 &_ModelMatrix)
+{
+  m_Occluders.push_back(TOccluder{.Mesh = &_Mesh, .ModelViewProjection = m_ViewProjection * _ModelMatrix});
+}
+
+void COcclusionBuffer::Rasterize()
+{
+  std::fill(m_Depth.begin(), m_Depth.end(), CLEAR_DEPTH);
+
+  if (m_Occluders.empty())
+  {
+    std::fill(m_TilesMaxDepth.begin(), m_TilesMaxDepth.end(), CLEAR_DEPTH);
+    return;
+  }
+
+  if (m_Triangles.size() < m_Occluders.size())
+    m_Triangles.resize(m_Occluders.size());
+
+  utils::CJobSystem &Jobs = utils::CJobSystem::Instance();
+
+  Jobs.ParallelFor(m_Occluders.size(), [this](size_t _Index) { SetupTriangles(m_Occluders[_Index], m_Triangles[_Index]); });
+
+  // Bands don't share pixels, so they are written without synchronisation
+  Jobs.ParallelFor(TILES_Y, [this](size_t _TileRow) {
+    RasterizeBand(static_cast<int>(_TileRow));
+    UpdateTiles(static_cast<int>(_TileRow));
+  });
+}
+
+bool COcclusionBuffer::IsVisible(const TAABB &_Box) const
+{
+  float MinX = FLT_MAX, MinY = FLT_MAX, MinZ = FLT_MAX;
+  float MaxX = -FLT_MAX, MaxY = -FLT_MAX;
+
+  for (int Corner = 0; Corner < 8; ++Corner)
+  {
+    const glm::vec3 Position((Corner & 1) ? _Box.Max.x : _Box.Min.x, (Corner & 2) ? _Box.Max.y : _Box.Min.y, (Corner & 4) ? _Box.Max.z : _Box.Min.z);
+    const glm::vec4 Clip = m_ViewProjection * glm::vec4(Position, 1.0f);
+
+    // Boxes around the camera can't be placed on the screen
+    if (Clip.w < MIN_W)
+      return true;
+
+    const float InvW = 1.0f / Clip.w;
+    const float X    = (Clip.x * InvW * 0.5f + 0.5f) * WIDTH;
+    const float Y    = (Clip.y * InvW * 0.5f + 0.5f) * HEIGHT;
+
+    MinX = std::min(MinX, X);
+    MaxX = std::max(MaxX, X);
+    MinY = std::min(MinY, Y);
+    MaxY = std::max(MaxY, Y);
+    MinZ = std::min(MinZ, Clip.z * InvW);
+  }
+
+  if (MaxX < 0.0f || MaxY < 0.0f || MinX > WIDTH || MinY > HEIGHT)
+    return true;
+
+  // Every pixel the box touches, not only the covered centers
+  const int PixelMinX = std::max(static_cast<int>(std::floor(MinX)), 0);
+  const int PixelMaxX = std::min(static_cast<int>(std::floor(MaxX)), WIDTH - 1);
+  const int PixelMinY = std::max(static_cast<int>(std::floor(MinY)), 0);
+  const int PixelMaxY = std::min(static_cast<int>(std::floor(MaxY)), HEIGHT - 1);
+
+  for (int TileY = PixelMinY / TILE_SIZE; TileY <= PixelMaxY / TILE_SIZE; ++TileY)
+  {
+    for (int TileX = PixelMinX / TILE_SIZE; TileX <= PixelMaxX / TILE_SIZE; ++TileX)
+    {
+      if (m_TilesMaxDepth[TileY * TILES_X + TileX] < MinZ)
+        continue;
+
+      const int BeginX = std::max(PixelMinX, TileX * TILE_SIZE);
+      const int EndX   = std::min(PixelMaxX, TileX * TILE_SIZE + TILE_SIZE - 1);
+      const int BeginY = std::max(PixelMinY, TileY * TILE_SIZE);
+      const int EndY   = std::min(PixelMaxY, TileY * TILE_SIZE + TILE_SIZE - 1);
+
+      for (int Y = BeginY; Y <= EndY; ++Y)
+        for (int X = BeginX; X <= EndX; ++X)
+          if (m_Depth[Y * WIDTH + X] >= MinZ)
+            return true;
+    }
+  }
+
+  return false;
+}
+
+float COcclusionBuffer::GetDepth(int _X, int _Y) const
+{
+  assert(_X >= 0 && _X < WIDTH && _Y >= 0 && _Y < HEIGHT);
+  return m_Depth[_Y * WIDTH + _X];
+}
+
+size_t COcclusionBuffer::GetOccludersCount() const
+{
+  return m_Occluders.size();
+}
+
+void COcclusionBuffer::SetupTriangles(const TOccluder &_Occluder, std::vector<TTriangle> &_Triangles) const
+{
+  _Triangles.clear();
+
+  const TOccluderMesh &Mesh = *_Occluder.Mesh;
+
+  for (size_t i = 0; i + 2 < Mesh.Indices.size(); i += 3)
+  {
+    std::array<TScreenVertex, 3> Vertices;
+    bool                         IsProjectable = true;
+
+    for (size_t v = 0; v < 3; ++v)
+    {
+      const glm::vec4 Clip = _Occluder.ModelViewProjection * glm::vec4(Mesh.Positions[Mesh.Indices[i + v]], 1.0f);
+
+      // Dropping the triangle only loses occlusion, clipping it isn't worth it at this resolution
+      if (Clip.w < MIN_W)
+      {
+        IsProjectable = false;
+        break;
+      }
+
+      const float InvW = 1.0f / Clip.w;
+      Vertices[v]      = TScreenVertex{
+          .X = (Clip.x * InvW * 0.5f + 0.5f) * WIDTH,
+          .Y = (Clip.y * InvW * 0.5f + 0.5f) * HEIGHT,
+          .Z = Clip.z * InvW,
+      };
+    }
+
+    if (!IsProjectable)
+      continue;
+
+    TScreenVertex &V0 = Vertices[0];
+    TScreenVertex &V1 = Vertices[1];
+    TScreenVertex &V2 = Vertices[2];
+
+    // Both windings are drawn, counter-clockwise keeps the inside positive
+    float Area = (V1.X - V0.X) * (V2.Y - V0.Y) - (V2.X - V0.X) * (V1.Y - V0.Y);
+    if (std::abs(Area) < 1e-6f)
+      continue;
+
+    if (Area < 0.0f)
+    {
+      std::swap(V1, V2);
+      Area = -Area;
+    }
+
+    // Centers of the pixels in the bounds of the triangle
+    const int MinX = std::max(static_cast<int>(std::ceil(std::min({V0.X, V1.X, V2.X}) - 0.5f)), 0);
+    const int MaxX = std::min(static_cast<int>(std::floor(std::max({V0.X, V1.X, V2.X}) - 0.5f)), WIDTH - 1);
+    const int MinY = std::max(static_cast<int>(std::ceil(std::min({V0.Y, V1.Y, V2.Y}) - 0.5f)), 0);
+    const int MaxY = std::min(static_cast<int>(std::floor(std::max({V0.Y, V1.Y, V2.Y}) - 0.5f)), HEIGHT - 1);
+
+    if (MinX > MaxX || MinY > MaxY)
+      continue;
+
+    TTriangle &Triangle = _Triangles.emplace_back();
+
+    const std::array<const TScreenVertex *, 3> Edges = {&V0, &V1, &V2};
+    for (size_t e = 0; e < 3; ++e)
+    {
+      const TScreenVertex &A = *Edges[e];
+      const TScreenVertex &B = *Edges[(e + 1) % 3];
+
+      Triangle.EdgeA[e] = A.Y - B.Y;
+      Triangle.EdgeB[e] = B.X - A.X;
+      Triangle.EdgeC[e] = (B.Y - A.Y) * A.X - (B.X - A.X) * A.Y;
+    }
+
+    const float DepthDX = ((V1.Z - V0.Z) * (V2.Y - V0.Y) - (V2.Z - V0.Z) * (V1.Y - V0.Y)) / Area;
+    const float DepthDY = ((V2.Z - V0.Z) * (V1.X - V0.X) - (V1.Z - V0.Z) * (V2.X - V0.X)) / Area;
+
+    Triangle.DepthA = DepthDX;
+    Triangle.DepthB = DepthDY;
+    Triangle.DepthC = V0.Z - DepthDX * V0.X - DepthDY * V0.Y;
+    Triangle.MinX   = MinX;
+    Triangle.MaxX   = MaxX;
+    Triangle.MinY   = MinY;
+    Triangle.MaxY   = MaxY;
+  }
+}
+
+void COcclusionBuffer::RasterizeBand(int _TileRow)
+{
+  const int BandMinY = _TileRow * TILE_SIZE;
+  const int BandMaxY = BandMinY + TILE_SIZE - 1;
+
+  for (size_t Occluder = 0; Occluder < m_Occluders.size(); ++Occluder)
+  {
+    for (const TTriangle &Triangle : m_Triangles[Occluder])
+    {
+      if (Triangle.MaxY < BandMinY || Triangle.MinY > BandMaxY)
+        continue;
+
+      RasterizeTriangle(Triangle, std::max(Triangle.MinY, BandMinY), std::min(Triangle.MaxY, BandMaxY));
+    }
+  }
+}
+
+void COcclusionBuffer::RasterizeTriangle(const TTriangle &_Triangle, int _MinY, int _MaxY)
+{
+  // Rows start at a multiple of four, the lanes left of the triangle fail the edge tests
+  const int MinX = _Triangle.MinX & ~3;
+
+#if OCCLUSION_BUFFER_SSE
+  const __m128 Zero    = _mm_setzero_ps();
+  const __m128 LaneX   = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+  const __m128 EdgeA0  = _mm_set1_ps(_Triangle.EdgeA[0]);
+  const __m128 EdgeA1  = _mm_set1_ps(_Triangle.EdgeA[1]);
+  const __m128 EdgeA2  = _mm_set1_ps(_Triangle.EdgeA[2]);
+  const __m128 DepthA  = _mm_set1_ps(_Triangle.DepthA);
+  const __m128 EdgeA0x = _mm_mul_ps(EdgeA0, LaneX);
+  const __m128 EdgeA1x = _mm_mul_ps(EdgeA1, LaneX);
+  const __m128 EdgeA2x = _mm_mul_ps(EdgeA2, LaneX);
+  const __m128 DepthAx = _mm_mul_ps(DepthA, LaneX);
+
+  for (int Y = _MinY; Y <= _MaxY; ++Y)
+  {
+    const float CenterY = Y + 0.5f;
+    float      *Row     = &m_Depth[Y * WIDTH];
+
+    for (int X = MinX; X <= _Triangle.MaxX; X += 4)
+    {
+      const __m128 BaseX = _mm_set1_ps(static_cast<float>(X));
+
+      // Plane values at the four pixel centers of the group
+      const __m128 E0 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(EdgeA0, BaseX), EdgeA0x), _mm_set1_ps(_Triangle.EdgeB[0] * CenterY + _Triangle.EdgeC[0]));
+      const __m128 E1 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(EdgeA1, BaseX), EdgeA1x), _mm_set1_ps(_Triangle.EdgeB[1] * CenterY + _Triangle.EdgeC[1]));
+      const __m128 E2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(EdgeA2, BaseX), EdgeA2x), _mm_set1_ps(_Triangle.EdgeB[2] * CenterY + _Triangle.EdgeC[2]));
+      const __m128 Z  = _mm_add_ps(_mm_add_ps(_mm_mul_ps(DepthA, BaseX), DepthAx), _mm_set1_ps(_Triangle.DepthB * CenterY + _Triangle.DepthC));
+
+      const __m128 Inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(E0, Zero), _mm_cmpge_ps(E1, Zero)), _mm_cmpge_ps(E2, Zero));
+      if (_mm_movemask_ps(Inside) == 0)
+        continue;
+
+      const __m128 Old = _mm_loadu_ps(Row + X);
+      const __m128 New = _mm_min_ps(Old, Z);
+      _mm_storeu_ps(Row + X, _mm_or_ps(_mm_and_ps(Inside, New), _mm_andnot_ps(Inside, Old)));
+    }
+  }
+#else
+  for (int Y = _MinY; Y <= _MaxY; ++Y)
+  {
+    const float CenterY = Y + 0.5f;
+    float      *Row     = &m_Depth[Y * WIDTH];
+
+    for (int X = MinX; X <= _Triangle.MaxX; ++X)
+    {
+      const float CenterX = X + 0.5f;
+
+      bool IsInside = true;
+      for (int e = 0; e < 3; ++e)
+        IsInside &= _Triangle.EdgeA[e] * CenterX + _Triangle.EdgeB[e] * CenterY + _Triangle.EdgeC[e] >= 0.0f;
+
+      if (IsInside)
+        Row[X] = std::min(Row[X], _Triangle.DepthA * CenterX + _Triangle.DepthB * CenterY + _Triangle.DepthC);
+    }
+  }
+#endif
+}
+
+void COcclusionBuffer::UpdateTiles(int _TileRow)
+{
+  for (int TileX = 0; TileX < TILES_X; ++TileX)
+  {
+    float MaxDepth = -FLT_MAX;
+
+    for (int Y = _TileRow * TILE_SIZE; Y < (_TileRow + 1) * TILE_SIZE; ++Y)
+    {
+      const float *Row = &m_Depth[Y * WIDTH + TileX * TILE_SIZE];
+      MaxDepth         = std::max(MaxDepth, *std::max_element(Row, Row + TILE_SIZE));
+    }
+
+    m_TilesMaxDepth[_TileRow * TILES_X + TileX] = MaxDepth;
+  }
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "physics/Collision.h"
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+#include <cstdint>
+#include <vector>
+
+// Triangles drawn into the occlusion buffer in place of the full primitive, in the primitive space
+struct TOccluderMesh
+{
+  std::vector<glm::vec3> Positions;
+  std::vector<uint32_t>  Indices; // Triangle list
+};
+
+// Low resolution depth buffer rasterized on the CPU from the occluders of the frame, boxes behind
+// them can be dropped before they reach the GPU. The depth is the NDC z, occluders keep the nearest
+// value of every pixel and each 8x8 tile keeps the farthest value of its pixels, so most boxes are
+// decided on the tiles. The screen is split into bands of tiles rasterized in parallel, with SSE
+// covering four pixels at once. No GL involved, it works without a context.
+class COcclusionBuffer final
+{
+public:
+  static constexpr int WIDTH     = 256;
+  static constexpr int HEIGHT    = 144;
+  static constexpr int TILE_SIZE = 8;
+
+public:
+  COcclusionBuffer();
+
+  void Begin(const glm::mat4 &_ViewProjection);
+  void AddOccluder(const TOccluderMesh &_Mesh, const glm::mat4 &_ModelMatrix); // Kept by reference until Rasterize()
+  void Rasterize();
+
+  // Conservative: false only if the box is behind the occluders wherever it covers the screen
+  bool IsVisible(const TAABB &_Box) const;
+
+  float GetDepth(int _X, int _Y) const;
+  size_t GetOccludersCount() const;
+
+private:
+  static constexpr int TILES_X = WIDTH / TILE_SIZE;
+  static constexpr int TILES_Y = HEIGHT / TILE_SIZE;
+
+  static_assert(WIDTH % TILE_SIZE == 0 && HEIGHT % TILE_SIZE == 0 && TILE_SIZE % 4 == 0);
+
+  struct TOccluder
+  {
+    const TOccluderMesh *Mesh;
+    glm::mat4            ModelViewProjection;
+  };
+
+  // Edge functions and depth as planes over the screen, A * x + B * y + C
+  struct TTriangle
+  {
+    float EdgeA[3], EdgeB[3], EdgeC[3];
+    float DepthA, DepthB, DepthC;
+    int   MinX, MaxX, MinY, MaxY; // Pixels, inclusive
+  };
+
+  void SetupTriangles(const TOccluder &_Occluder, std::vector<TTriangle> &_Triangles) const;
+  void RasterizeBand(int _TileRow);
+  void RasterizeTriangle(const TTriangle &_Triangle, int _MinY, int _MaxY);
+  void UpdateTiles(int _TileRow);
+
+private:
+  glm::mat4                           m_ViewProjection;
+  std::vector<TOccluder>              m_Occluders;
+  std::vector<std::vector<TTriangle>> m_Triangles; // Per occluder, each filled by a single thread
+  std::vector<float>                  m_Depth;
+  std::vector<float>                  m_TilesMaxDepth;
+};
@@ -3,9 +3,12 @@
 #include "Buffer.h"
 #include "ShaderTypes.h"
 #include "RenderTypes.h"
+#include "physics/Collision.h"
 #include <glm/mat4x4.hpp>
 #include <bitset>
 
+struct TOccluderMesh;
+
 enum ERenderFlags : uint32_t
 {
   ERenderFlags_Transparent,
@@ -24,22 +27,12 @@ using TRenderFlags = std::bitset<ERenderFlags_Count>;
 
 struct TMaterial
 {
+  uint32_t   Index; // Parameters in the material buffer, see MaterialBuffer.h
   uint32_t   BaseColorTexture;
-  int32_t    BaseColorTextureTexCoordIndex;
   uint32_t   NormalTexture;
-  int32_t    NormalTextureTexCoordIndex;
   uint32_t   MetallicRoughnessTexture;
-  int32_t    MetallicRoughnessTextureTexCoordIndex;
   uint32_t   OcclusionTexture;
-  int32_t    OcclusionTextureTexCoordIndex;
   uint32_t   EmissiveTexture;
-  int32_t    EmissiveTextureTexCoordIndex;
-  glm::vec4  BaseColorFactor;
-  glm::vec3  EmissiveFactor;
-  float      MetallicFactor;
-  float      RoughnessFactor;
-  float      OcclusionStrength;
-  float      AlphaCutoff;
   EAlphaMode AlphaMode;
   bool       IsDoubleSided;
 };
@@ -53,12 +46,17 @@ struct TEnvironment
 
 struct TRenderCommand
 {
-  TMaterial      Material;
-  TEnvironment   Environment;
-  TSharedVAO     VAO;
-  glm::mat4      ModelMatrix;
-  uint32_t       IndicesCount;
-  EIndexType     IndexType;
-  EPrimitiveMode PrimitiveMode;
-  TRenderFlags   RenderFlags;
+  TMaterial            Material;
+  TEnvironment         Environment;
+  TSharedVAO           VAO;
+  glm::mat4            ModelMatrix;
+  TAABB                Bounds   = TAABB(); // World space, commands left without them are never culled
+  const TOccluderMesh *Occluder = nullptr; // Drawn into the occlusion buffer, owned by the model component
+  uint32_t             IndicesCount;
+  uint32_t             FirstIndex = 0; // Into the element buffer of the VAO
+  int32_t              BaseVertex = 0;
+  EIndexType           IndexType;
+  EPrimitiveMode       PrimitiveMode;
+  TRenderFlags         RenderFlags;
+  uint64_t             SortKey = 0; // See RenderCommandSorter.h, rebuilt every frame
 };
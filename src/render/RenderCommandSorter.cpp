@@ -0,0 +1,68 @@
+#include "RenderCommandSorter.h"
+#include "RenderCommand.h"
+#include <glm/gtx/norm.hpp>
+#include <bit>
+
+namespace
+{
+
+constexpr uint64_t LAYER_SHIFT    = 60;
+constexpr uint64_t STATE_SHIFT    = 56;
+constexpr uint64_t VAO_SHIFT      = 32;
+constexpr uint64_t MATERIAL_SHIFT = 8;
+constexpr uint64_t DEPTH_SHIFT    = 28;
+
+constexpr uint64_t STATE_MASK    = 0xF;
+constexpr uint64_t MATERIAL_MASK = 0xFFFFFF;
+constexpr uint64_t VAO_MASK      = 0xFFFFFF;
+
+ERenderLayer GetLayer(const TRenderFlags &_Flags)
+{
+  if (_Flags.test(ERenderFlags_Opaque))
+    return ERenderLayer::Opaque;
+  if (_Flags.test(ERenderFlags_Transparent))
+    return ERenderLayer::Transparent;
+  if (_Flags.test(ERenderFlags_Wireframe))
+    return ERenderLayer::Debug;
+  return ERenderLayer::Utility;
+}
+
+} // namespace
+
+uint64_t MakeSortKey(const TRenderCommand &_Command, const glm::vec3 &_CameraPosition)
+{
+  const ERenderLayer Layer = GetLayer(_Command.RenderFlags);
+  const uint64_t     Key   = static_cast<uint64_t>(Layer) << LAYER_SHIFT;
+
+  if (Layer == ERenderLayer::Transparent)
+  {
+    // Non-negative floats keep their order when compared as integers
+    const float    Distance = glm::length2(_CameraPosition - glm::vec3(_Command.ModelMatrix[3]));
+    const uint32_t Depth    = ~std::bit_cast<uint32_t>(Distance);
+    return Key | (static_cast<uint64_t>(Depth) << DEPTH_SHIFT);
+  }
+
+  const uint64_t State    = (static_cast<uint64_t>(_Command.Material.AlphaMode) << 1 | _Command.Material.IsDoubleSided) & STATE_MASK;
+  const uint64_t Material = _Command.Material.Index & MATERIAL_MASK;
+  const uint64_t VAO      = _Command.VAO ? _Command.VAO->ID() & VAO_MASK : 0;
+
+  return Key | (State << STATE_SHIFT) | (Material << MATERIAL_SHIFT) | (VAO << VAO_SHIFT);
+}
+
+const std::vector<const TRenderCommand *> &CRenderCommandSorter::Sort(std::span<TRenderCommand> _Commands, const glm::vec3 &_CameraPosition)
+{
+  m_Entries.resize(_Commands.size());
+  for (size_t i = 0; i < _Commands.size(); ++i)
+  {
+    _Commands[i].SortKey = MakeSortKey(_Commands[i], _CameraPosition);
+    m_Entries[i]         = utils::TSortEntry{.Key = _Commands[i].SortKey, .Index = static_cast<uint32_t>(i)};
+  }
+
+  utils::RadixSort(m_Entries, m_Scratch);
+
+  m_Sorted.resize(m_Entries.size());
+  for (size_t i = 0; i < m_Entries.size(); ++i)
+    m_Sorted[i] = &_Commands[m_Entries[i].Index];
+
+  return m_Sorted;
+}
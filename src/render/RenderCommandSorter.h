@@ -0,0 +1,43 @@
+#pragma once
+
+#include <common/RadixSort.h>
+#include <glm/vec3.hpp>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+struct TRenderCommand;
+
+// Render command sort keys, compared as plain 64-bit integers.
+//
+// Opaque:      | Layer 4 | State 4 | VAO 24 | Material 24 | 0 8 |
+// Transparent: | Layer 4 | ~Depth 32                  | 0 28     |
+//
+// State stands for the shader variant of a draw (alpha mode and culling) since all geometry of a
+// layer shares one program. VAO comes before the material: geometry of one vertex format shares a
+// VAO in the geometry pool, and a multi-draw batch can't span two of them. Material is the index in
+// the material buffer, so draws sharing textures end up next to each other within a VAO. Depth is
+// the squared camera distance, inverted so the farthest commands come first.
+
+enum class ERenderLayer : uint8_t
+{
+  Utility,
+  Opaque,
+  Transparent,
+  Debug
+};
+
+uint64_t MakeSortKey(const TRenderCommand &_Command, const glm::vec3 &_CameraPosition);
+
+// Orders commands by their keys without moving them: only the keys and indices are sorted.
+// The buffers are reused between frames.
+class CRenderCommandSorter final
+{
+public:
+  const std::vector<const TRenderCommand *> &Sort(std::span<TRenderCommand> _Commands, const glm::vec3 &_CameraPosition);
+
+private:
+  std::vector<utils::TSortEntry>      m_Entries;
+  std::vector<utils::TSortEntry>      m_Scratch;
+  std::vector<const TRenderCommand *> m_Sorted;
+};
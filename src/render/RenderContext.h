@@ -4,6 +4,8 @@
 
 struct TRenderTarget;
 class CVertexArray;
+class CIndirectDrawBuffer;
+class CHiZCulling;
 
 struct TAAData
 {
@@ -22,6 +24,9 @@ struct TRenderContext
   CVertexArray &QuadVAO;
   CVertexArray &CubeVAO;
 
+  CIndirectDrawBuffer &DrawBuffer;
+  CHiZCulling         *HiZCulling; // Null while GPU occlusion culling is off
+
   glm::vec3 CameraPosition;
   glm::mat4 ProjectionMatrix;
   glm::mat4 ViewMatrix;
@@ -6,6 +6,7 @@
 #include "FrameData.h"
 #include "RenderContext.h"
 #include "RenderTypes.h"
+#include "HiZCulling.h"
 #include "passes/OpaqueRenderPass.h"
 #include "passes/SkyboxRenderPass.h"
 #include "passes/TransparentRenderPass.h"
@@ -19,19 +20,23 @@
 #include "passes/IrradianceConvolutionPass.h"
 #include "passes/TAARenderPass.h"
 #include "assets/Texture.h"
-#include "engine/Camera.h"
 #include "engine/Config.h"
 #include "interfaces/Renderer.h"
 #include "utils/Resource.h"
 #include <common/Logger.h>
 #include <common/Stopwatch.h>
-#include <common/Clock.h>
-#include <glm/gtx/norm.hpp>
 #include <glm/gtx/string_cast.hpp>
 
+namespace
+{
+
+constexpr GLsizeiptr FRAME_UNIFORMS_REGION_SIZE = 4096;
+
+} // namespace
+
 CRenderPipeline::CRenderPipeline() :
     m_Lighting({}),
-    m_LightingUBO(GL_DYNAMIC_DRAW),
+    m_FrameUniforms(GL_UNIFORM_BUFFER, FRAME_UNIFORMS_REGION_SIZE),
     m_LastFrameDrawCalls(0),
     m_LastFrameVertices(0),
     m_LastFrameIndices(0),
@@ -39,6 +44,8 @@ CRenderPipeline::CRenderPipeline() :
     m_LastFrameLines(0),
     m_LastFramePoints(0),
     m_ShadowMapTextureID(0),
+    m_LastFrameTextureUnitBinds{},
+    m_IsGPUOcclusionCullingEnabled(false),
     m_PrevJitteredViewProjectionMatrix(glm::mat4(1.0f)),
     m_PreviousJitter(0.0f),
     m_JitterFrameIndex(0),
@@ -51,6 +58,7 @@ CRenderPipeline::~CRenderPipeline() = default;
 
 void CRenderPipeline::Shutdown()
 {
+  m_RenderPassGroups.clear();
   m_SceneTarget.reset();
   m_PostProcessTarget.reset();
   m_FinalTarget.reset();
@@ -67,6 +75,11 @@ void CRenderPipeline::Init(TVector2i _Viewport)
   m_MSAASamples = CConfig::Instance().GetMSAASampleCount();
   m_TAASamples  = CConfig::Instance().GetTAASampleCount();
 
+  m_Visibility.SetOcclusionCullingEnabled(CConfig::Instance().GetOcclusionCullingEnabled());
+
+  m_HiZCulling                   = std::make_unique<CHiZCulling>();
+  m_IsGPUOcclusionCullingEnabled = CConfig::Instance().GetGPUOcclusionCullingEnabled();
+
   m_ShadowPasses.emplace_back(CShadowRenderPass::Create(), ShadowsEnabled);
 
   m_UtilityPasses.emplace_back(CEquirectangularToCubemapPass::Create(), true);
@@ -85,11 +98,6 @@ void CRenderPipeline::Init(TVector2i _Viewport)
 
   m_OutputPasses.emplace_back(COutputRenderPass::Create(), true);
 
-  m_LightingUBO.Bind();
-  m_LightingUBO.Reserve(sizeof(TShaderLighting));
-  m_LightingUBO.BindToBase(BINDING_LIGHTING_BUFFER);
-  m_LightingUBO.Unbind();
-
   InitRenderTargets(_Viewport);
   InitCommonVAOs();
 
@@ -100,6 +108,8 @@ void CRenderPipeline::Init(TVector2i _Viewport)
   event::Subscribe(TEventType::Config_BloomEnabledChanged, GetWeakPtr());
   event::Subscribe(TEventType::Config_TAASamplesChanged, GetWeakPtr());
   event::Subscribe(TEventType::Config_MSAASamplesChanged, GetWeakPtr());
+  event::Subscribe(TEventType::Config_OcclusionCullingEnabledChanged, GetWeakPtr());
+  event::Subscribe(TEventType::Config_GPUOcclusionCullingEnabledChanged, GetWeakPtr());
 }
 
 void CRenderPipeline::OnEvent(const TEvent &_Event)
@@ -112,6 +122,14 @@ void CRenderPipeline::OnEvent(const TEvent &_Event)
     resource::Prune();
     break;
   }
+  case TEventType::Config_OcclusionCullingEnabledChanged: {
+    m_Visibility.SetOcclusionCullingEnabled(_Event.GetValue<bool>());
+    break;
+  }
+  case TEventType::Config_GPUOcclusionCullingEnabledChanged: {
+    m_IsGPUOcclusionCullingEnabled = _Event.GetValue<bool>();
+    break;
+  }
   case TEventType::Config_ShadowsEnabledChanged: {
     SetRenderPassEnabled(ERenderPassType::Shadow, _Event.GetValue<bool>(), m_ShadowPasses);
     break;
@@ -186,21 +204,24 @@ void CRenderPipeline::OnEvent(const TEvent &_Event)
 
 void CRenderPipeline::Render(TFrameData &FrameData, CRenderQueue &_Queue, IRenderer &_Renderer)
 {
-  std::vector<TRenderCommand> Commands      = _Queue.StealCommands();
-  TRenderContext              RenderContext = CreateRenderContext(FrameData, _Renderer);
+  std::pmr::vector<TRenderCommand> Commands      = _Queue.StealCommands();
+  TRenderContext                   RenderContext = CreateRenderContext(FrameData);
 
   BeginFrame(_Renderer, RenderContext);
-  SortCommands(Commands, RenderContext);
   SetLightingData(FrameData.Lights);
+  SetFrameData(RenderContext);
 
-  UtilityPass(_Renderer, RenderContext, Commands);
+  const std::vector<const TRenderCommand *> &SortedCommands = m_CommandSorter.Sort(Commands, RenderContext.CameraPosition);
+  m_Visibility.Build(SortedCommands, {RenderContext.ViewProjectionMatrix, RenderContext.LightSpaceMatrix});
 
-  ShadowPass(_Renderer, RenderContext, Commands);
-  GeometryPass(_Renderer, RenderContext, Commands);
-  PostProcessPass(_Renderer, RenderContext, Commands);
+  UtilityPass(_Renderer, RenderContext);
 
-  DebugPass(_Renderer, RenderContext, Commands);
-  OutputPass(_Renderer, RenderContext, Commands);
+  ShadowPass(_Renderer, RenderContext);
+  GeometryPass(_Renderer, RenderContext);
+  PostProcessPass(_Renderer, RenderContext);
+
+  DebugPass(_Renderer, RenderContext);
+  OutputPass(_Renderer, RenderContext);
 
   EndFrame(_Renderer, RenderContext);
 }
@@ -208,6 +229,13 @@ void CRenderPipeline::Render(TFrameData &FrameData, CRenderQueue &_Queue, IRende
 void CRenderPipeline::BeginFrame(IRenderer &_Renderer, const TRenderContext &_RenderContext)
 {
   _Renderer.OnFrameBegin();
+
+  std::shared_ptr<CMaterialBuffer> MaterialBuffer = resource::GetMaterialBuffer();
+  MaterialBuffer->Upload();
+  MaterialBuffer->Bind(BINDING_MATERIALS_BUFFER);
+
+  m_FrameUniforms.BeginFrame();
+  m_DrawBuffer.BeginFrame();
 }
 
 void CRenderPipeline::EndFrame(IRenderer &_Renderer, const TRenderContext &_RenderContext)
@@ -223,32 +251,38 @@ void CRenderPipeline::EndFrame(IRenderer &_Renderer, const TRenderContext &_Rend
   m_LastFrameLines     = _Renderer.GetLinesCount();
   m_LastFramePoints    = _Renderer.GetPointsCount();
 
+  m_LastFrameStateChanges     = _Renderer.GetStateChanges();
+  m_LastFrameTextureUnitBinds = _Renderer.GetTextureUnitBinds();
+
+  m_FrameUniforms.EndFrame();
+  m_DrawBuffer.EndFrame();
+
   _Renderer.CheckErrors();
 }
 
-void CRenderPipeline::UtilityPass(IRenderer &_Renderer, TRenderContext &_RenderContext, std::vector<TRenderCommand> &_Commands)
+void CRenderPipeline::UtilityPass(IRenderer &_Renderer, TRenderContext &_RenderContext)
 {
-  utils::CClock PassClock;
-  DoRenderPasses(m_UtilityPasses, _Renderer, _RenderContext, _Commands);
-  m_RenderPassTimes[ERenderPassType::Common_Utility] = PassClock.GetElapsedTimeMs();
+  BeginPassGroup(ERenderPassType::Common_Utility, _Renderer);
+  DoRenderPasses(m_UtilityPasses, _Renderer, _RenderContext, EVisibilityView::Camera);
+  EndPassGroup(ERenderPassType::Common_Utility, _Renderer);
 }
 
-void CRenderPipeline::ShadowPass(IRenderer &_Renderer, TRenderContext &_RenderContext, std::vector<TRenderCommand> &_Commands)
+void CRenderPipeline::ShadowPass(IRenderer &_Renderer, TRenderContext &_RenderContext)
 {
   if (!IsAnyPassEnabled(m_ShadowPasses))
   {
-    m_RenderPassTimes[ERenderPassType::Common_Shadow] = 0.0f;
+    SkipPassGroup(ERenderPassType::Common_Shadow);
     return;
   }
 
-  utils::CClock PassClock;
-  DoRenderPasses(m_ShadowPasses, _Renderer, _RenderContext, _Commands);
-  m_RenderPassTimes[ERenderPassType::Common_Shadow] = PassClock.GetElapsedTimeMs();
+  BeginPassGroup(ERenderPassType::Common_Shadow, _Renderer);
+  DoRenderPasses(m_ShadowPasses, _Renderer, _RenderContext, EVisibilityView::Light);
+  EndPassGroup(ERenderPassType::Common_Shadow, _Renderer);
 }
 
-void CRenderPipeline::GeometryPass(IRenderer &_Renderer, TRenderContext &_RenderContext, std::vector<TRenderCommand> &_Commands)
+void CRenderPipeline::GeometryPass(IRenderer &_Renderer, TRenderContext &_RenderContext)
 {
-  utils::CClock PassClock;
+  BeginPassGroup(ERenderPassType::Common_Geometry, _Renderer);
 
   m_SceneTarget->FrameBuffer.Bind();
   _Renderer.Clear(static_cast<EClearFlags>(EClearFlags::Color | EClearFlags::Depth));
@@ -265,7 +299,7 @@ void CRenderPipeline::GeometryPass(IRenderer &_Renderer, TRenderContext &_Render
     m_SceneTarget->FrameBuffer.SetDrawBuffers(Attachments, 1);
   }
 
-  DoRenderPasses(m_GeometryPasses, _Renderer, _RenderContext, _Commands);
+  DoRenderPasses(m_GeometryPasses, _Renderer, _RenderContext, EVisibilityView::Camera);
 
   m_SceneTarget->FrameBuffer.Unbind();
 
@@ -284,34 +318,34 @@ void CRenderPipeline::GeometryPass(IRenderer &_Renderer, TRenderContext &_Render
       _RenderContext.TAA->VelocityTexture = m_ResolvedSceneTarget->Velocity->ID();
   }
 
-  m_RenderPassTimes[ERenderPassType::Common_Geometry] = PassClock.GetElapsedTimeMs();
+  EndPassGroup(ERenderPassType::Common_Geometry, _Renderer);
 }
 
-void CRenderPipeline::PostProcessPass(IRenderer &_Renderer, TRenderContext &_RenderContext, std::vector<TRenderCommand> &_Commands)
+void CRenderPipeline::PostProcessPass(IRenderer &_Renderer, TRenderContext &_RenderContext)
 {
-  utils::CClock PassClock;
+  BeginPassGroup(ERenderPassType::Common_PostProcess, _Renderer);
 
   m_PostProcessTarget->FrameBuffer.Bind();
   _Renderer.SetViewport(m_PostProcessTarget->Size);
 
-  DoRenderPasses(m_PostProcessPasses, _Renderer, _RenderContext, _Commands);
+  DoRenderPasses(m_PostProcessPasses, _Renderer, _RenderContext, EVisibilityView::Camera);
 
   m_PostProcessTarget->FrameBuffer.Unbind();
 
   _RenderContext.ColorTexture = m_PostProcessTarget->Color->ID();
 
-  m_RenderPassTimes[ERenderPassType::Common_PostProcess] = PassClock.GetElapsedTimeMs();
+  EndPassGroup(ERenderPassType::Common_PostProcess, _Renderer);
 }
 
-void CRenderPipeline::DebugPass(IRenderer &_Renderer, TRenderContext &_RenderContext, std::vector<TRenderCommand> &_Commands)
+void CRenderPipeline::DebugPass(IRenderer &_Renderer, TRenderContext &_RenderContext)
 {
   if (!IsAnyPassEnabled(m_DebugPasses))
   {
-    m_RenderPassTimes[ERenderPassType::Common_Debug] = 0.0f;
+    SkipPassGroup(ERenderPassType::Common_Debug);
     return;
   }
 
-  utils::CClock PassClock;
+  BeginPassGroup(ERenderPassType::Common_Debug, _Renderer);
 
   CFrameBuffer::Blit(m_SceneTarget->FrameBuffer.ID(),       //
                      m_PostProcessTarget->FrameBuffer.ID(), //
@@ -323,16 +357,16 @@ void CRenderPipeline::DebugPass(IRenderer &_Renderer, TRenderContext &_RenderCon
   m_PostProcessTarget->FrameBuffer.Bind();
   _Renderer.SetViewport(m_PostProcessTarget->Size);
 
-  DoRenderPasses(m_DebugPasses, _Renderer, _RenderContext, _Commands);
+  DoRenderPasses(m_DebugPasses, _Renderer, _RenderContext, EVisibilityView::Camera);
 
   m_PostProcessTarget->FrameBuffer.Unbind();
 
-  m_RenderPassTimes[ERenderPassType::Common_Debug] = PassClock.GetElapsedTimeMs();
+  EndPassGroup(ERenderPassType::Common_Debug, _Renderer);
 }
 
-void CRenderPipeline::OutputPass(IRenderer &_Renderer, TRenderContext &_RenderContext, std::vector<TRenderCommand> &_Commands)
+void CRenderPipeline::OutputPass(IRenderer &_Renderer, TRenderContext &_RenderContext)
 {
-  utils::CClock PassClock;
+  BeginPassGroup(ERenderPassType::Common_Output, _Renderer);
 
   if (m_FinalTarget)
     m_FinalTarget->FrameBuffer.Bind();
@@ -342,23 +376,53 @@ void CRenderPipeline::OutputPass(IRenderer &_Renderer, TRenderContext &_RenderCo
   _Renderer.ClearColor({0.2f, 0.2f, 0.2f, 1.0f});
   _Renderer.SetViewport(m_SceneTarget->Size);
 
-  DoRenderPasses(m_OutputPasses, _Renderer, _RenderContext, _Commands);
+  DoRenderPasses(m_OutputPasses, _Renderer, _RenderContext, EVisibilityView::Camera);
 
   if (m_FinalTarget)
     m_FinalTarget->FrameBuffer.Unbind();
 
-  m_RenderPassTimes[ERenderPassType::Common_Output] = PassClock.GetElapsedTimeMs();
+  EndPassGroup(ERenderPassType::Common_Output, _Renderer);
+}
+
+void CRenderPipeline::BeginPassGroup(ERenderPassType _Type, IRenderer &_Renderer)
+{
+  TRenderPassGroup &Group = m_RenderPassGroups[_Type];
+  Group.Clock.Restart();
+  Group.GPUTimer.Begin();
+  Group.DrawCallsOnBegin    = _Renderer.GetDrawCallsCount();
+  Group.TrianglesOnBegin    = _Renderer.GetTrianglesCount();
+  Group.StateChangesOnBegin = _Renderer.GetStateChanges();
+}
+
+void CRenderPipeline::EndPassGroup(ERenderPassType _Type, IRenderer &_Renderer)
+{
+  TRenderPassGroup &Group = m_RenderPassGroups[_Type];
+  Group.GPUTimer.End();
+  Group.Stats.CPUTime      = Group.Clock.GetElapsedTimeMs();
+  Group.Stats.GPUTime      = Group.GPUTimer.GetElapsedTimeMs();
+  Group.Stats.DrawCalls    = _Renderer.GetDrawCallsCount() - Group.DrawCallsOnBegin;
+  Group.Stats.Triangles    = _Renderer.GetTrianglesCount() - Group.TrianglesOnBegin;
+  Group.Stats.StateChanges = _Renderer.GetStateChanges() - Group.StateChangesOnBegin;
+}
+
+void CRenderPipeline::SkipPassGroup(ERenderPassType _Type)
+{
+  TRenderPassGroup &Group = m_RenderPassGroups[_Type];
+  Group.GPUTimer.Clear();
+  Group.Stats = TRenderPassStats{};
 }
 
-void CRenderPipeline::DoRenderPasses(const TRenderPassesList           &_Passes,
-                                     IRenderer                         &_Renderer,
-                                     TRenderContext                    &_RenderContext,
-                                     const std::vector<TRenderCommand> &_Commands)
+void CRenderPipeline::DoRenderPasses(const TRenderPassesList &_Passes, IRenderer &_Renderer, TRenderContext &_RenderContext, EVisibilityView _View)
 {
+  static const std::vector<const TRenderCommand *> NoCommands;
+
   for (const TRenderPass &RenderPass : _Passes)
   {
-    if (RenderPass.IsEnabled)
-      DoRenderPass(RenderPass.Pass, _Renderer, _RenderContext, _Commands);
+    if (!RenderPass.IsEnabled)
+      continue;
+
+    const IRenderPass &Pass = *RenderPass.Pass;
+    DoRenderPass(RenderPass.Pass, _Renderer, _RenderContext, Pass.NeedsCommands() ? m_Visibility.Get(_View, Pass.GetAcceptedFlag()) : NoCommands);
   }
 }
 
@@ -372,57 +436,20 @@ bool CRenderPipeline::IsAnyPassEnabled(const TRenderPassesList &_Passes)
   return false;
 }
 
-void CRenderPipeline::DoRenderPass(const std::shared_ptr<IRenderPass> &_RenderPass,
-                                   IRenderer                          &_Renderer,
-                                   TRenderContext                     &_RenderContext,
-                                   const std::vector<TRenderCommand>  &_Commands)
+void CRenderPipeline::DoRenderPass(const std::shared_ptr<IRenderPass>        &_RenderPass,
+                                   IRenderer                                 &_Renderer,
+                                   TRenderContext                            &_RenderContext,
+                                   const std::vector<const TRenderCommand *> &_Commands)
 {
   if (!_RenderPass->IsAvailable())
     return;
 
-  std::vector<const TRenderCommand *> Commands;
-  if (_RenderPass->NeedsCommands())
-  {
-    Commands = FilterCommands(_RenderPass, _Commands);
-    if (Commands.empty())
-      return;
-  }
-
-  _RenderPass->PreExecute(_Renderer, _RenderContext, Commands);
-  _RenderPass->Execute(_Renderer, _RenderContext, Commands);
-  _RenderPass->PostExecute(_Renderer, _RenderContext, Commands);
-}
-
-void CRenderPipeline::SortCommands(std::vector<TRenderCommand> &_Commands, const TRenderContext &_RenderContext)
-{
-  auto It = std::stable_partition(_Commands.begin(), _Commands.end(), [](const TRenderCommand &Command) {
-    return Command.Material.AlphaMode != EAlphaMode::Blend;
-  });
-
-  const glm::vec3 CamPos = _RenderContext.CameraPosition;
-
-  std::stable_sort(It, _Commands.end(), [&CamPos](const TRenderCommand &A, const TRenderCommand &B) {
-    const glm::vec3 PosA = glm::vec3(A.ModelMatrix[3]);
-    const glm::vec3 PosB = glm::vec3(B.ModelMatrix[3]);
-
-    const float DistA = glm::length2(CamPos - PosA);
-    const float DistB = glm::length2(CamPos - PosB);
-
-    return DistA > DistB;
-  });
-}
-
-std::vector<const TRenderCommand *> CRenderPipeline::FilterCommands(const std::shared_ptr<IRenderPass> &_RenderPass, const std::vector<TRenderCommand> &_Commands)
-{
-  std::vector<const TRenderCommand *> FilteredCommands;
-
-  for (const TRenderCommand &Command : _Commands)
-  {
-    if (_RenderPass->Accepts(Command))
-      FilteredCommands.push_back(&Command);
-  }
+  if (_RenderPass->NeedsCommands() && _Commands.empty())
+    return;
 
-  return FilteredCommands;
+  _RenderPass->PreExecute(_Renderer, _RenderContext, _Commands);
+  _RenderPass->Execute(_Renderer, _RenderContext, _Commands);
+  _RenderPass->PostExecute(_Renderer, _RenderContext, _Commands);
 }
 
 bool CRenderPipeline::IsRenderPassEnabled(ERenderPassType _Type, const TRenderPassesList &_Passes)
@@ -446,7 +473,7 @@ void CRenderPipeline::SetRenderPassEnabled(ERenderPassType _Type, bool _Enabled,
     assert(false);
 }
 
-void CRenderPipeline::SetLightingData(const std::vector<TFrameData::TLight> &_Lighting)
+void CRenderPipeline::SetLightingData(std::span<const TFrameData::TLight> _Lighting)
 {
   TShaderLighting ShaderLighting;
   std::memset(&ShaderLighting, 0, sizeof(TShaderLighting));
@@ -466,30 +493,47 @@ void CRenderPipeline::SetLightingData(const std::vector<TFrameData::TLight> &_Li
   }
 
   m_Lighting = std::move(ShaderLighting);
-  m_LightingUBO.Bind();
-  m_LightingUBO.Assign(&m_Lighting, sizeof(TShaderLighting));
-  m_LightingUBO.Unbind();
 }
 
-glm::mat4 CRenderPipeline::CalculateLightSpaceMatrix() const
+void CRenderPipeline::SetFrameData(const TRenderContext &_RenderContext)
 {
-  const float NearPlane = CConfig::Instance().GetLightSpaceMatrixZNear();
-  const float FarPlane  = CConfig::Instance().GetLightSpaceMatrixZFar();
-  const float LeftBot   = CConfig::Instance().GetLightSpaceMatrixOrthLeftBot();
-  const float RightTop  = CConfig::Instance().GetLightSpaceMatrixOrthRightTop();
+  const TVector2i SceneSize = m_SceneTarget->Size;
 
-  const glm::vec3 LightDir        = m_Lighting.LightDirectional.Direction * -1.0f;
-  const glm::mat4 LightProjection = glm::ortho(LeftBot, RightTop, LeftBot, RightTop, NearPlane, FarPlane);
-  const glm::mat4 LightView       = glm::lookAt(LightDir, glm::vec3(0.0f), glm::vec3(0.0, 1.0, 0.0));
+  const TShaderFrame Frame{
+      .LightSpaceMatrix  = _RenderContext.LightSpaceMatrix,
+      .Jitter            = _RenderContext.TAA ? _RenderContext.TAA->Jitter : glm::vec2(0.0f),
+      .PrevJitter        = _RenderContext.TAA ? _RenderContext.TAA->PrevJitter : glm::vec2(0.0f),
+      .InverseScreenSize = glm::vec2(1.0f / SceneSize.X, 1.0f / SceneSize.Y),
+  };
+
+  const TShaderView View{
+      .ViewMatrix                       = _RenderContext.ViewMatrix,
+      .ProjectionMatrix                 = _RenderContext.ProjectionMatrix,
+      .ViewProjectionMatrix             = _RenderContext.ViewProjectionMatrix,
+      .JitteredViewProjectionMatrix     = _RenderContext.TAA ? _RenderContext.TAA->JitteredViewProjectionMatrix : _RenderContext.ViewProjectionMatrix,
+      .PrevJitteredViewProjectionMatrix = _RenderContext.TAA ? _RenderContext.TAA->PrevJitteredViewProjectionMatrix : _RenderContext.ViewProjectionMatrix,
+      .CameraPosition                   = _RenderContext.CameraPosition,
+  };
 
-  return LightProjection * LightView;
+  // Everything is pushed before binding, growing the buffer would drop the ranges bound earlier
+  const CRingBuffer::TAllocation LightingBlock = m_FrameUniforms.Push(m_Lighting);
+  const CRingBuffer::TAllocation FrameBlock    = m_FrameUniforms.Push(Frame);
+  const CRingBuffer::TAllocation ViewBlock     = m_FrameUniforms.Push(View);
+
+  m_FrameUniforms.BindRange(BINDING_LIGHTING_BUFFER, LightingBlock);
+  m_FrameUniforms.BindRange(BINDING_FRAME_BUFFER, FrameBlock);
+  m_FrameUniforms.BindRange(BINDING_VIEW_BUFFER, ViewBlock);
 }
 
-TRenderContext CRenderPipeline::CreateRenderContext(const TFrameData &FrameData, IRenderer &_Renderer)
+glm::mat4 CRenderPipeline::CalculateLightSpaceMatrix() const
 {
-  const auto     &Camera       = _Renderer.GetCamera();
-  const glm::mat4 Projection   = Camera->GetPerspectiveProjection();
-  const glm::mat4 View         = Camera->GetView();
+  return CreateLightSpaceMatrix(m_Lighting.LightDirectional.Direction);
+}
+
+TRenderContext CRenderPipeline::CreateRenderContext(const TFrameData &FrameData)
+{
+  const glm::mat4 Projection   = FrameData.Camera.Projection;
+  const glm::mat4 View         = FrameData.Camera.View;
   const bool      IsTaaEnabled = m_TAASamples > 0;
 
   std::optional<TAAData> TAA;
@@ -511,11 +555,25 @@ TRenderContext CRenderPipeline::CreateRenderContext(const TFrameData &FrameData,
     Data.HistoryMap                       = CTexture::INVALID_TEXTURE; // Set later
   }
 
+  // Dropping the depth texture while disabled keeps a stale pyramid from being used once enabled again
+  CHiZCulling *HiZCulling = nullptr;
+  if (m_IsGPUOcclusionCullingEnabled && m_HiZCulling->IsAvailable())
+  {
+    HiZCulling = m_HiZCulling.get();
+    HiZCulling->SetDepthTexture(std::get<TRenderTarget::TTexture>(m_SceneTarget->Depth));
+  }
+  else
+  {
+    m_HiZCulling->SetDepthTexture(nullptr);
+  }
+
   return TRenderContext{
       .TAA                  = std::move(TAA),
       .QuadVAO              = m_QuadBuffer.VAO,
       .CubeVAO              = m_CubeBuffer.VAO,
-      .CameraPosition       = Camera->GetPosition(),
+      .DrawBuffer           = m_DrawBuffer,
+      .HiZCulling           = HiZCulling,
+      .CameraPosition       = FrameData.Camera.Position,
       .ProjectionMatrix     = Projection,
       .ViewMatrix           = View,
       .ViewProjectionMatrix = Projection * View,
@@ -537,9 +595,7 @@ std::unique_ptr<TRenderTarget> CRenderPipeline::CreateRenderTarget(TVector2i _Si
 
   constexpr auto CreateDepthRBO = [](TVector2i _Size) {
     CRenderBuffer DepthRBO;
-    DepthRBO.Bind();
     DepthRBO.AllocateStorage(GL_DEPTH_COMPONENT, _Size.X, _Size.Y);
-    DepthRBO.Unbind();
     return DepthRBO;
   };
 
@@ -547,7 +603,6 @@ std::unique_ptr<TRenderTarget> CRenderPipeline::CreateRenderTarget(TVector2i _Si
   RenderTarget->Size                          = _Size;
   RenderTarget->MSAASamples                   = _MSAASamples;
   RenderTarget->Color                         = CreateRenderTexture(GetTextureName("RENDER_TARGET_COLOR"), _Size, _MSAASamples);
-  RenderTarget->FrameBuffer.Bind();
   RenderTarget->FrameBuffer.AttachTexture(GL_COLOR_ATTACHMENT0, RenderTarget->Color->ID(), RenderTarget->Color->Target());
 
   if (_CreateVelocityTexture)
@@ -569,8 +624,6 @@ std::unique_ptr<TRenderTarget> CRenderPipeline::CreateRenderTarget(TVector2i _Si
     RenderTarget->Depth = std::move(DepthRBO);
   }
 
-  RenderTarget->FrameBuffer.Unbind();
-
   return RenderTarget;
 }
 
@@ -584,6 +637,7 @@ std::shared_ptr<CTexture> CRenderPipeline::CreateRenderTexture(const std::string
   TextureParams.Type           = EType::Float;
   TextureParams.MinFilter      = ETextureFilter::Linear;
   TextureParams.MagFilter      = ETextureFilter::Linear;
+  TextureParams.MemoryTag      = EGPUMemoryTag::RenderTargets;
 
   if (_MSAASamples > 0)
     TextureParams.Samples = _MSAASamples;
@@ -603,6 +657,7 @@ std::shared_ptr<CTexture> CRenderPipeline::CreateDepthTexture(const std::string
   TextureParams.MagFilter      = ETextureFilter::Nearest;
   TextureParams.WrapS          = ETextureWrap::ClampToEdge;
   TextureParams.WrapT          = ETextureWrap::ClampToEdge;
+  TextureParams.MemoryTag      = EGPUMemoryTag::RenderTargets;
 
   if (_MSAASamples > 0)
     TextureParams.Samples = _MSAASamples;
@@ -620,6 +675,7 @@ std::shared_ptr<CTexture> CRenderPipeline::CreateVelocityTexture(const std::stri
   TextureParams.Type           = EType::Float;
   TextureParams.MinFilter      = ETextureFilter::Linear;
   TextureParams.MagFilter      = ETextureFilter::Linear;
+  TextureParams.MemoryTag      = EGPUMemoryTag::RenderTargets;
 
   if (_MSAASamples > 0)
     TextureParams.Samples = _MSAASamples;
@@ -644,18 +700,14 @@ void CRenderPipeline::InitRenderTargets(TVector2i _Viewport)
 
 void CRenderPipeline::InitCommonVAOs()
 {
-  m_QuadBuffer.VAO.Bind();
-  m_QuadBuffer.VBO.Bind();
   m_QuadBuffer.VBO.Assign(QUAD_VERTICES, sizeof(QUAD_VERTICES));
-  m_QuadBuffer.VAO.EnableAttrib(ATTRIB_LOC_POSITION, 3, GL_FLOAT, false, 5 * sizeof(float));
-  m_QuadBuffer.VAO.EnableAttrib(ATTRIB_LOC_TEXCOORDS_0, 2, GL_FLOAT, false, 5 * sizeof(float), (void *)(3 * sizeof(float)));
-  m_QuadBuffer.VAO.Unbind();
+  m_QuadBuffer.VAO.AttachVertexBuffer(0, m_QuadBuffer.VBO.ID(), 5 * sizeof(float));
+  m_QuadBuffer.VAO.EnableAttrib(ATTRIB_LOC_POSITION, 3, GL_FLOAT, false, 0);
+  m_QuadBuffer.VAO.EnableAttrib(ATTRIB_LOC_TEXCOORDS_0, 2, GL_FLOAT, false, 0, 3 * sizeof(float));
 
-  m_CubeBuffer.VAO.Bind();
-  m_CubeBuffer.VBO.Bind();
   m_CubeBuffer.VBO.Assign(CUBE_VERTICES, sizeof(CUBE_VERTICES));
-  m_CubeBuffer.VAO.EnableAttrib(ATTRIB_LOC_POSITION, 3, GL_FLOAT, false, 3 * sizeof(float));
-  m_CubeBuffer.VAO.Unbind();
+  m_CubeBuffer.VAO.AttachVertexBuffer(0, m_CubeBuffer.VBO.ID(), 3 * sizeof(float));
+  m_CubeBuffer.VAO.EnableAttrib(ATTRIB_LOC_POSITION, 3, GL_FLOAT, false, 0);
 }
 
 glm::vec2 CRenderPipeline::GenerateHaltonJitter(uint32_t _Index, int32_t _Samples)
@@ -686,6 +738,16 @@ uint32_t CRenderPipeline::GetShadowMapTextureID() const
   return m_ShadowMapTextureID;
 }
 
+const TRenderStateChanges &CRenderPipeline::GetStateChanges() const
+{
+  return m_LastFrameStateChanges;
+}
+
+const TTextureUnitBinds &CRenderPipeline::GetTextureUnitBinds() const
+{
+  return m_LastFrameTextureUnitBinds;
+}
+
 uint32_t CRenderPipeline::GetDrawCallsCount() const
 {
   return m_LastFrameDrawCalls;
@@ -716,11 +778,36 @@ uint32_t CRenderPipeline::GetPointsCount() const
   return m_LastFramePoints;
 }
 
+uint32_t CRenderPipeline::GetCulledObjectsCount() const
+{
+  return m_Visibility.GetCulledCount(EVisibilityView::Camera);
+}
+
+uint32_t CRenderPipeline::GetCulledShadowCastersCount() const
+{
+  return m_Visibility.GetCulledCount(EVisibilityView::Light);
+}
+
+uint32_t CRenderPipeline::GetOccludedObjectsCount() const
+{
+  return m_Visibility.GetOccludedCount();
+}
+
 float CRenderPipeline::GetRenderPassTime(ERenderPassType _Type) const
 {
-  auto It = m_RenderPassTimes.find(_Type);
-  if (It != m_RenderPassTimes.end())
-    return It->second;
+  return GetRenderPassStats(_Type).CPUTime;
+}
+
+float CRenderPipeline::GetRenderPassGPUTime(ERenderPassType _Type) const
+{
+  return GetRenderPassStats(_Type).GPUTime;
+}
+
+TRenderPassStats CRenderPipeline::GetRenderPassStats(ERenderPassType _Type) const
+{
+  auto It = m_RenderPassGroups.find(_Type);
+  if (It != m_RenderPassGroups.end())
+    return It->second.Stats;
 
-  return 0.0f;
+  return TRenderPassStats{};
 }
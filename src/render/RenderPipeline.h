@@ -5,10 +5,18 @@
 #include "render/FrameData.h"
 #include "passes/RenderPassTypes.h"
 #include "render/Buffer.h"
+#include "render/GPUTimer.h"
+#include "render/RenderStats.h"
+#include "render/RenderCommandSorter.h"
+#include "render/IndirectDrawBuffer.h"
+#include "render/Visibility.h"
+#include "render/RingBuffer.h"
 #include <events/EventsListener.h>
 #include <common/Sharable.h>
 #include <common/MathTypes.h>
+#include <common/Clock.h>
 #include <cstdint>
+#include <span>
 #include <vector>
 #include <memory>
 #include <map>
@@ -17,6 +25,7 @@ class IRenderer;
 class IRenderPass;
 class CRenderQueue;
 class CTexture;
+class CHiZCulling;
 class CVertexArray;
 class CVertexBuffer;
 struct TRenderContext;
@@ -47,6 +56,16 @@ class CRenderPipeline final : public CSharable<CRenderPipeline>,
 
   using TRenderPassesList = std::vector<TRenderPass>;
 
+  struct TRenderPassGroup
+  {
+    TRenderPassStats    Stats;
+    utils::CClock       Clock;
+    CGPUTimer           GPUTimer;
+    uint32_t            DrawCallsOnBegin = 0;
+    uint32_t            TrianglesOnBegin = 0;
+    TRenderStateChanges StateChangesOnBegin;
+  };
+
 public:
   CRenderPipeline();
   ~CRenderPipeline();
@@ -64,33 +83,43 @@ public:
   uint32_t GetTrianglesCount() const override;
   uint32_t GetLinesCount() const override;
   uint32_t GetPointsCount() const override;
+  uint32_t GetCulledObjectsCount() const override;
+  uint32_t GetCulledShadowCastersCount() const override;
+  uint32_t GetOccludedObjectsCount() const override;
   uint32_t GetRenderTextureID() const override;
   uint32_t GetShadowMapTextureID() const override;
 
+  const TRenderStateChanges &GetStateChanges() const override;
+  const TTextureUnitBinds &GetTextureUnitBinds() const override;
+
   float GetRenderPassTime(ERenderPassType _Type) const override;
+  float GetRenderPassGPUTime(ERenderPassType _Type) const override;
+  TRenderPassStats GetRenderPassStats(ERenderPassType _Type) const override;
 
 private:
   void BeginFrame(IRenderer &_Renderer, const TRenderContext &_RenderContext);
   void EndFrame(IRenderer &_Renderer, const TRenderContext &_RenderContext);
 
-  void UtilityPass(IRenderer &_Renderer, TRenderContext &_RenderContext, std::vector<TRenderCommand> &_Commands);
-  void ShadowPass(IRenderer &_Renderer, TRenderContext &_RenderContext, std::vector<TRenderCommand> &_Commands);
-  void GeometryPass(IRenderer &_Renderer, TRenderContext &_RenderContext, std::vector<TRenderCommand> &_Commands);
-  void DebugPass(IRenderer &_Renderer, TRenderContext &_RenderContext, std::vector<TRenderCommand> &_Commands);
-  void PostProcessPass(IRenderer &_Renderer, TRenderContext &_RenderContext, std::vector<TRenderCommand> &_Commands);
-  void OutputPass(IRenderer &_Renderer, TRenderContext &_RenderContext, std::vector<TRenderCommand> &_Commands);
+  void UtilityPass(IRenderer &_Renderer, TRenderContext &_RenderContext);
+  void ShadowPass(IRenderer &_Renderer, TRenderContext &_RenderContext);
+  void GeometryPass(IRenderer &_Renderer, TRenderContext &_RenderContext);
+  void DebugPass(IRenderer &_Renderer, TRenderContext &_RenderContext);
+  void PostProcessPass(IRenderer &_Renderer, TRenderContext &_RenderContext);
+  void OutputPass(IRenderer &_Renderer, TRenderContext &_RenderContext);
 
-  void SetLightingData(const std::vector<TFrameData::TLight> &_Lighting);
+  void SetLightingData(std::span<const TFrameData::TLight> _Lighting);
+  void SetFrameData(const TRenderContext &_RenderContext);
   glm::mat4 CalculateLightSpaceMatrix() const;
 
-  TRenderContext CreateRenderContext(const TFrameData &FrameData, IRenderer &_Renderer);
+  TRenderContext CreateRenderContext(const TFrameData &FrameData);
   void InitRenderTargets(TVector2i _Viewport);
   void InitCommonVAOs();
 
-  void DoRenderPasses(const TRenderPassesList           &_Passes,
-                      IRenderer                         &_Renderer,
-                      TRenderContext                    &_RenderContext,
-                      const std::vector<TRenderCommand> &_Commands);
+  void BeginPassGroup(ERenderPassType _Type, IRenderer &_Renderer);
+  void EndPassGroup(ERenderPassType _Type, IRenderer &_Renderer);
+  void SkipPassGroup(ERenderPassType _Type);
+
+  void DoRenderPasses(const TRenderPassesList &_Passes, IRenderer &_Renderer, TRenderContext &_RenderContext, EVisibilityView _View);
 
 private:
   static std::unique_ptr<TRenderTarget> CreateRenderTarget(TVector2i _Size,
@@ -101,18 +130,15 @@ private:
   static std::shared_ptr<CTexture> CreateRenderTexture(const std::string &_Name, TVector2i _Size, int _MSAASamples = 0);
   static std::shared_ptr<CTexture> CreateDepthTexture(const std::string &_Name, TVector2i _Size, int _MSAASamples = 0);
   static std::shared_ptr<CTexture> CreateVelocityTexture(const std::string &_Name, TVector2i _Size, int _MSAASamples = 0);
-  static std::vector<const TRenderCommand *> FilterCommands(const std::shared_ptr<IRenderPass> &_RenderPass,
-                                                            const std::vector<TRenderCommand>  &_Commands);
-  static void SortCommands(std::vector<TRenderCommand> &_Commands, const TRenderContext &_RenderContext);
   static bool IsRenderPassEnabled(ERenderPassType _Type, const TRenderPassesList &_Passes);
   static void SetRenderPassEnabled(ERenderPassType _Type, bool _Enabled, TRenderPassesList &_Passes);
   static glm::vec2 GenerateHaltonJitter(uint32_t _Index, int32_t _Samples);
 
   static bool IsAnyPassEnabled(const TRenderPassesList &_Passes);
-  static void DoRenderPass(const std::shared_ptr<IRenderPass> &_RenderPass,
-                           IRenderer                          &_Renderer,
-                           TRenderContext                     &_RenderContext,
-                           const std::vector<TRenderCommand>  &_Commands);
+  static void DoRenderPass(const std::shared_ptr<IRenderPass>        &_RenderPass,
+                           IRenderer                                 &_Renderer,
+                           TRenderContext                            &_RenderContext,
+                           const std::vector<const TRenderCommand *> &_Commands);
 
 private:
   TRenderPassesList m_UtilityPasses;
@@ -131,7 +157,7 @@ private:
   TBuffers m_CubeBuffer;
 
   TShaderLighting m_Lighting;
-  CUniformBuffer  m_LightingUBO;
+  CRingBuffer     m_FrameUniforms; // Lighting, frame and view blocks
 
   uint32_t m_LastFrameDrawCalls;
   uint32_t m_LastFrameVertices;
@@ -141,7 +167,17 @@ private:
   uint32_t m_LastFramePoints;
   uint32_t m_ShadowMapTextureID;
 
-  std::map<ERenderPassType, float> m_RenderPassTimes;
+  TRenderStateChanges m_LastFrameStateChanges;
+  TTextureUnitBinds   m_LastFrameTextureUnitBinds;
+
+  std::map<ERenderPassType, TRenderPassGroup> m_RenderPassGroups;
+
+  CRenderCommandSorter m_CommandSorter;
+  CIndirectDrawBuffer  m_DrawBuffer;
+  CVisibilityLists     m_Visibility;
+
+  std::unique_ptr<CHiZCulling> m_HiZCulling;
+  bool                         m_IsGPUOcclusionCullingEnabled;
 
   glm::mat4 m_PrevJitteredViewProjectionMatrix;
   glm::vec2 m_PreviousJitter;
@@ -1,31 +1,66 @@
 #pragma once
 
 #include "RenderCommand.h"
+#include <memory_resource>
+#include <span>
 #include <vector>
 
 class CRenderQueue
 {
 public:
+  explicit CRenderQueue(std::pmr::memory_resource *_Resource = std::pmr::get_default_resource()) :
+      m_Commands(_Resource)
+  {
+  }
+
+  void Reserve(size_t _CommandsCount)
+  {
+    m_Commands.reserve(_CommandsCount);
+  }
+
   void Push(TRenderCommand _Command)
   {
     m_Commands.push_back(std::move(_Command));
   }
 
+  // Makes room for _Count commands at the end, filled in place by the caller
+  std::span<TRenderCommand> Append(size_t _Count)
+  {
+    const size_t First = m_Commands.size();
+    m_Commands.resize(First + _Count);
+    return std::span<TRenderCommand>(m_Commands).subspan(First);
+  }
+
+  void Clear() // Keeps the capacity
+  {
+    m_Commands.clear();
+  }
+
   bool IsEmpty() const
   {
     return m_Commands.empty();
   }
 
-  const std::vector<TRenderCommand> &GetCommands() const
+  size_t GetSize() const
+  {
+    return m_Commands.size();
+  }
+
+  const std::pmr::vector<TRenderCommand> &GetCommands() const
+  {
+    return m_Commands;
+  }
+
+  std::pmr::vector<TRenderCommand> &GetCommands()
   {
     return m_Commands;
   }
 
-  std::vector<TRenderCommand> StealCommands()
+  std::pmr::vector<TRenderCommand> StealCommands()
   {
     return std::move(m_Commands);
   }
 
 private:
-  std::vector<TRenderCommand> m_Commands;
+  std::pmr::vector<TRenderCommand> m_Commands;
 };
\ No newline at end of file
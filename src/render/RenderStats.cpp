@@ -0,0 +1,62 @@
+#include "RenderStats.h"
+#include <algorithm>
+
+TRenderStateChanges CRenderCounters::StateChanges;
+TTextureUnitBinds   CRenderCounters::TextureUnitBinds = {};
+
+void CRenderCounters::CountShaderSwitch()
+{
+  StateChanges.ShaderSwitches++;
+}
+
+void CRenderCounters::CountTextureBind(unsigned _TextureUnit)
+{
+  StateChanges.TextureBinds++;
+  TextureUnitBinds[std::min<size_t>(_TextureUnit, MAX_TRACKED_TEXTURE_UNITS - 1)]++;
+}
+
+void CRenderCounters::CountVAOBind()
+{
+  StateChanges.VAOBinds++;
+}
+
+void CRenderCounters::CountUniformUpload()
+{
+  StateChanges.UniformUploads++;
+}
+
+void CRenderCounters::CountFBOBind()
+{
+  StateChanges.FBOBinds++;
+}
+
+void CRenderCounters::CountBlendChange()
+{
+  StateChanges.BlendChanges++;
+}
+
+void CRenderCounters::CountCullChange()
+{
+  StateChanges.CullChanges++;
+}
+
+void CRenderCounters::CountDepthChange()
+{
+  StateChanges.DepthChanges++;
+}
+
+void CRenderCounters::Reset()
+{
+  StateChanges = TRenderStateChanges{};
+  TextureUnitBinds.fill(0);
+}
+
+const TRenderStateChanges &CRenderCounters::GetStateChanges()
+{
+  return StateChanges;
+}
+
+const TTextureUnitBinds &CRenderCounters::GetTextureUnitBinds()
+{
+  return TextureUnitBinds;
+}
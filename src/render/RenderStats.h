@@ -0,0 +1,101 @@
+#pragma once
+
+#include "passes/RenderPassTypes.h"
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+// Number of GL calls that change pipeline state. Every field is a plain counter,
+// so snapshots can be subtracted to get the changes made in between.
+struct TRenderStateChanges
+{
+  uint32_t ShaderSwitches = 0;
+  uint32_t TextureBinds   = 0;
+  uint32_t VAOBinds       = 0;
+  uint32_t UniformUploads = 0;
+  uint32_t FBOBinds       = 0;
+  uint32_t BlendChanges   = 0;
+  uint32_t CullChanges    = 0;
+  uint32_t DepthChanges   = 0;
+
+  TRenderStateChanges operator-(const TRenderStateChanges &_Other) const
+  {
+    return TRenderStateChanges{
+        .ShaderSwitches = ShaderSwitches - _Other.ShaderSwitches,
+        .TextureBinds   = TextureBinds - _Other.TextureBinds,
+        .VAOBinds       = VAOBinds - _Other.VAOBinds,
+        .UniformUploads = UniformUploads - _Other.UniformUploads,
+        .FBOBinds       = FBOBinds - _Other.FBOBinds,
+        .BlendChanges   = BlendChanges - _Other.BlendChanges,
+        .CullChanges    = CullChanges - _Other.CullChanges,
+        .DepthChanges   = DepthChanges - _Other.DepthChanges,
+    };
+  }
+};
+
+inline constexpr size_t MAX_TRACKED_TEXTURE_UNITS = 32;
+
+using TTextureUnitBinds = std::array<uint32_t, MAX_TRACKED_TEXTURE_UNITS>;
+
+struct TRenderPassStats
+{
+  float               CPUTime   = 0.0f; // ms
+  float               GPUTime   = 0.0f; // ms
+  uint32_t            DrawCalls = 0;
+  uint32_t            Triangles = 0;
+  TRenderStateChanges StateChanges;
+};
+
+// State changes are issued directly by shaders, textures and buffers, not only through IRenderer,
+// so they are counted here and reset by the renderer at the start of every frame.
+class CRenderCounters final
+{
+public:
+  static void CountShaderSwitch();
+  static void CountTextureBind(unsigned _TextureUnit); // Zero-based unit index
+  static void CountVAOBind();
+  static void CountUniformUpload();
+  static void CountFBOBind();
+  static void CountBlendChange();
+  static void CountCullChange();
+  static void CountDepthChange();
+
+  static void Reset();
+
+  static const TRenderStateChanges &GetStateChanges();
+  static const TTextureUnitBinds &GetTextureUnitBinds();
+
+private:
+  static TRenderStateChanges StateChanges;
+  static TTextureUnitBinds   TextureUnitBinds;
+};
+
+inline constexpr std::array<ERenderPassType, 6> RENDER_PASS_GROUPS = {ERenderPassType::Common_Utility,     //
+                                                                      ERenderPassType::Common_Shadow,      //
+                                                                      ERenderPassType::Common_Geometry,    //
+                                                                      ERenderPassType::Common_PostProcess, //
+                                                                      ERenderPassType::Common_Debug,       //
+                                                                      ERenderPassType::Common_Output};
+
+inline constexpr size_t RENDER_PASS_GROUPS_COUNT = RENDER_PASS_GROUPS.size();
+
+constexpr std::string_view GetRenderPassGroupName(ERenderPassType _Type)
+{
+  switch (_Type)
+  {
+  case ERenderPassType::Common_Utility:
+    return "Utility";
+  case ERenderPassType::Common_Shadow:
+    return "Shadow";
+  case ERenderPassType::Common_Geometry:
+    return "Geometry";
+  case ERenderPassType::Common_PostProcess:
+    return "PostProcess";
+  case ERenderPassType::Common_Debug:
+    return "Debug";
+  case ERenderPassType::Common_Output:
+    return "Output";
+  default:
+    return "Unknown";
+  }
+}
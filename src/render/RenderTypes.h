@@ -59,6 +59,16 @@ enum class ECullMode : uint8_t
   Back
 };
 
+// Layout read by glMultiDrawElementsIndirect
+struct TDrawElementsIndirectCommand
+{
+  uint32_t Count;
+  uint32_t InstanceCount;
+  uint32_t FirstIndex;
+  int32_t  BaseVertex;
+  uint32_t BaseInstance;
+};
+
 enum class EAlphaMode : uint8_t
 {
   Opaque,
@@ -0,0 +1,178 @@
+#include "RingBuffer.h"
+#include "utils/Memory.h"
+#include <common/Logger.h>
+#include <algorithm>
+#include <cassert>
+
+CRingBuffer::CRingBuffer(GLenum _Target, GLsizeiptr _RegionSize) :
+    m_Target(_Target),
+    m_OffsetAlignment(QueryOffsetAlignment(_Target)),
+    m_ID(0),
+    m_Data(nullptr),
+    m_RegionSize(0),
+    m_RegionOffset(0),
+    m_Region(0),
+    m_Fences{}
+{
+  CreateStorage(_RegionSize);
+}
+
+CRingBuffer::~CRingBuffer()
+{
+  DeleteStorage();
+}
+
+void CRingBuffer::BeginFrame()
+{
+  m_Region       = (m_Region + 1) % REGIONS_COUNT;
+  m_RegionOffset = 0;
+  WaitForRegion(m_Region);
+}
+
+void CRingBuffer::EndFrame()
+{
+  assert(m_Fences[m_Region] == nullptr);
+  m_Fences[m_Region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+}
+
+CRingBuffer::TAllocation CRingBuffer::Allocate(GLsizeiptr _Size, GLsizeiptr _Alignment)
+{
+  assert(_Size > 0 && _Alignment > 0);
+
+  // Aligned from the start of the buffer, the regions themselves don't have to be
+  const auto AlignedOffset = [&]() {
+    const GLsizeiptr RegionStart = m_RegionSize * m_Region;
+    return (RegionStart + m_RegionOffset + _Alignment - 1) / _Alignment * _Alignment - RegionStart;
+  };
+
+  GLsizeiptr Offset = AlignedOffset();
+  if (Offset + _Size > m_RegionSize)
+  {
+    const GLsizeiptr NewRegionSize = std::max(m_RegionSize * 2, _Size + _Alignment);
+    CLogger::Log(ELogType::Info, "[CRingBuffer] Growing regions from {} to {} bytes", m_RegionSize, NewRegionSize);
+
+    for (uint32_t Region = 0; Region < REGIONS_COUNT; ++Region)
+      WaitForRegion(Region);
+
+    DeleteStorage();
+    CreateStorage(NewRegionSize);
+
+    m_RegionOffset = 0;
+    Offset         = AlignedOffset();
+  }
+
+  m_RegionOffset = Offset + _Size;
+
+  const GLintptr BufferOffset = m_RegionSize * m_Region + Offset;
+  return TAllocation{.Data = m_Data + BufferOffset, .Offset = BufferOffset, .Size = _Size};
+}
+
+void CRingBuffer::BindToTarget(GLenum _Target)
+{
+  glBindBuffer(_Target, m_ID);
+}
+
+void CRingBuffer::BindToBase(GLuint _Index)
+{
+  glBindBufferBase(m_Target, _Index, m_ID);
+}
+
+void CRingBuffer::BindRange(GLuint _Index, const TAllocation &_Allocation)
+{
+  assert(_Allocation.Offset % m_OffsetAlignment == 0);
+  glBindBufferRange(m_Target, _Index, m_ID, _Allocation.Offset, _Allocation.Size);
+}
+
+GLuint CRingBuffer::ID() const
+{
+  return m_ID;
+}
+
+GLsizeiptr CRingBuffer::GetRegionSize() const
+{
+  return m_RegionSize;
+}
+
+void CRingBuffer::CreateStorage(GLsizeiptr _RegionSize)
+{
+  assert(m_ID == 0 && _RegionSize > 0);
+
+  constexpr GLbitfield FLAGS = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+  const GLsizeiptr Size = _RegionSize * REGIONS_COUNT;
+
+  glCreateBuffers(1, &m_ID);
+  glNamedBufferStorage(m_ID, Size, nullptr, FLAGS);
+  m_Data = static_cast<uint8_t *>(glMapNamedBufferRange(m_ID, 0, Size, FLAGS));
+
+  assert(m_Data && "Failed to map the buffer");
+
+  m_RegionSize = _RegionSize;
+  utils::TrackGPUMemory(EGPUMemoryTag::Buffers, Size);
+}
+
+void CRingBuffer::DeleteStorage()
+{
+  if (m_ID == 0)
+    return;
+
+  for (GLsync &Fence : m_Fences)
+  {
+    if (Fence)
+      glDeleteSync(Fence);
+    Fence = nullptr;
+  }
+
+  glUnmapNamedBuffer(m_ID);
+  glDeleteBuffers(1, &m_ID);
+
+  utils::TrackGPUMemory(EGPUMemoryTag::Buffers, -m_RegionSize * REGIONS_COUNT);
+
+  m_ID         = 0;
+  m_Data       = nullptr;
+  m_RegionSize = 0;
+}
+
+void CRingBuffer::WaitForRegion(uint32_t _Region)
+{
+  GLsync &Fence = m_Fences[_Region];
+  if (!Fence)
+    return;
+
+  constexpr GLuint64 TIMEOUT = 1'000'000'000; // 1 second, in nanoseconds
+
+  while (true)
+  {
+    const GLenum Result = glClientWaitSync(Fence, GL_SYNC_FLUSH_COMMANDS_BIT, TIMEOUT);
+    if (Result == GL_ALREADY_SIGNALED || Result == GL_CONDITION_SATISFIED)
+      break;
+
+    if (Result == GL_WAIT_FAILED)
+    {
+      CLogger::Log(ELogType::Error, "[CRingBuffer] Failed to wait for a fence");
+      break;
+    }
+  }
+
+  glDeleteSync(Fence);
+  Fence = nullptr;
+}
+
+GLsizeiptr CRingBuffer::QueryOffsetAlignment(GLenum _Target)
+{
+  GLint Alignment = 1;
+
+  switch (_Target)
+  {
+  case GL_UNIFORM_BUFFER:
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &Alignment);
+    break;
+  case GL_SHADER_STORAGE_BUFFER:
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &Alignment);
+    break;
+  default:
+    break;
+  }
+
+  return std::max(Alignment, 1);
+}
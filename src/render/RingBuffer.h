@@ -0,0 +1,74 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <common/Core.h>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Buffer that stays mapped for its whole lifetime, split into one region per frame in flight.
+// The CPU fills the region of the current frame while the GPU may still read the previous ones,
+// a fence per region keeps them apart. Memory is coherent, so writes need no explicit flush.
+// The standard way to hand per-frame data to the GPU, nothing has to be orphaned or stalled on.
+class CRingBuffer final
+{
+  DISABLE_CLASS_COPY(CRingBuffer);
+
+public:
+  struct TAllocation
+  {
+    void      *Data;
+    GLintptr   Offset; // From the start of the buffer
+    GLsizeiptr Size;
+  };
+
+public:
+  CRingBuffer(GLenum _Target, GLsizeiptr _RegionSize);
+  ~CRingBuffer();
+
+  // Moves to the next region, waiting for the GPU if it still reads it
+  void BeginFrame();
+  void EndFrame();
+
+  // Space in the region of the current frame, valid until the region comes around again.
+  // Grows the buffer when the region is full, which invalidates the earlier allocations.
+  TAllocation Allocate(GLsizeiptr _Size, GLsizeiptr _Alignment);
+
+  // Copies the data into the current region, aligned so that it can be bound with BindRange()
+  template <typename T>
+  requires(std::is_trivially_copyable_v<T>)
+  TAllocation Push(const T &_Data)
+  {
+    const TAllocation Allocation = Allocate(sizeof(T), std::max<GLsizeiptr>(alignof(T), m_OffsetAlignment));
+    std::memcpy(Allocation.Data, &_Data, sizeof(T));
+    return Allocation;
+  }
+
+  void BindToTarget(GLenum _Target);
+  void BindToBase(GLuint _Index);
+  void BindRange(GLuint _Index, const TAllocation &_Allocation);
+
+  GLuint ID() const;
+  GLsizeiptr GetRegionSize() const;
+
+private:
+  void CreateStorage(GLsizeiptr _RegionSize);
+  void DeleteStorage();
+  void WaitForRegion(uint32_t _Region);
+
+  static GLsizeiptr QueryOffsetAlignment(GLenum _Target);
+
+private:
+  static constexpr inline uint32_t REGIONS_COUNT = 3;
+
+  GLenum                            m_Target;
+  GLsizeiptr                        m_OffsetAlignment; // Required by ranges bound to indexed targets
+  GLuint                            m_ID;
+  uint8_t                          *m_Data;
+  GLsizeiptr                        m_RegionSize;   // in bytes
+  GLsizeiptr                        m_RegionOffset; // in bytes, used part of the current region
+  uint32_t                          m_Region;
+  std::array<GLsync, REGIONS_COUNT> m_Fences;
+};
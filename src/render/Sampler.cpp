@@ -0,0 +1,45 @@
+#include "Sampler.h"
+#include <common/Logger.h>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+// Only a handful of states are in use, a linear search beats hashing them
+std::vector<std::pair<TSamplerState, GLuint>> Samplers;
+
+} // namespace
+
+GLuint CSamplerCache::Get(const TSamplerState &_State)
+{
+  for (const auto &[State, Sampler] : Samplers)
+    if (State == _State)
+      return Sampler;
+
+  GLuint Sampler = 0;
+  glCreateSamplers(1, &Sampler);
+
+  glSamplerParameteri(Sampler, GL_TEXTURE_WRAP_S, _State.WrapS);
+  glSamplerParameteri(Sampler, GL_TEXTURE_WRAP_T, _State.WrapT);
+  glSamplerParameteri(Sampler, GL_TEXTURE_WRAP_R, _State.WrapR);
+  glSamplerParameteri(Sampler, GL_TEXTURE_MIN_FILTER, _State.MinFilter);
+  glSamplerParameteri(Sampler, GL_TEXTURE_MAG_FILTER, _State.MagFilter);
+  glSamplerParameterfv(Sampler, GL_TEXTURE_BORDER_COLOR, _State.BorderColor.data());
+
+  if (GLAD_GL_ARB_texture_filter_anisotropic)
+    glSamplerParameterf(Sampler, GL_TEXTURE_MAX_ANISOTROPY, _State.Anisotropy);
+
+  Samplers.emplace_back(_State, Sampler);
+  LOG_INFO("[CSamplerCache] Sampler {} created, {} in use", Sampler, Samplers.size());
+
+  return Sampler;
+}
+
+void CSamplerCache::Clear()
+{
+  for (const auto &[State, Sampler] : Samplers)
+    glDeleteSamplers(1, &Sampler);
+
+  Samplers.clear();
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <array>
+
+// Sampling state of a texture, kept in sampler objects apart from the texture storage
+struct TSamplerState
+{
+  GLint                WrapS       = GL_REPEAT;
+  GLint                WrapT       = GL_REPEAT;
+  GLint                WrapR       = GL_REPEAT;
+  GLint                MinFilter   = GL_LINEAR_MIPMAP_LINEAR;
+  GLint                MagFilter   = GL_LINEAR;
+  float                Anisotropy  = 1.0f;
+  std::array<float, 4> BorderColor = {0.0f, 0.0f, 0.0f, 0.0f};
+
+  bool operator==(const TSamplerState &) const = default;
+};
+
+// One sampler object per distinct state, textures sampled the same way share it
+class CSamplerCache final
+{
+public:
+  // Created on the first request, lives until Clear()
+  static GLuint Get(const TSamplerState &_State);
+  static void Clear();
+};
@@ -36,3 +36,9 @@ const int      TEXTURE_VELOCITY_INDEX = 24;
 
 const unsigned TEXTURE_TAA_HISTORY_UNIT  = GL_TEXTURE25;
 const int      TEXTURE_TAA_HISTORY_INDEX = 25;
+
+const unsigned TEXTURE_DEPTH_MAP_MS_UNIT  = GL_TEXTURE26;
+const int      TEXTURE_DEPTH_MAP_MS_INDEX = 26;
+
+const unsigned TEXTURE_HIZ_UNIT  = GL_TEXTURE27;
+const int      TEXTURE_HIZ_INDEX = 27;
@@ -1,12 +1,50 @@
 #pragma once
 
 #include <glm/glm.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 #include <variant>
 
 class CVertexArray;
 
 using UniformType = std::variant<int, unsigned, float, glm::mat3, glm::mat4, glm::vec2, glm::vec3, glm::vec4>;
 
+template <class T, class Variant>
+struct TVariantIndex;
+
+template <class T, class... Types>
+struct TVariantIndex<T, std::variant<Types...>>
+{
+  static constexpr size_t Value = []() {
+    constexpr bool IsSame[] = {std::is_same_v<T, Types>...};
+    for (size_t i = 0; i < sizeof...(Types); ++i)
+      if (IsSame[i])
+        return i;
+    return sizeof...(Types);
+  }();
+};
+
+template <class T>
+inline constexpr size_t UNIFORM_TYPE_INDEX = TVariantIndex<T, UniformType>::Value;
+
+// Uniform of a shader resolved once by name, see CShader::GetUniformHandle(). The value type is
+// part of the handle, so writes through it need neither a name lookup nor a variant dispatch.
+template <class T>
+struct TUniformHandle
+{
+  static_assert(UNIFORM_TYPE_INDEX<T> < std::variant_size_v<UniformType>, "Unsupported uniform type");
+
+  static constexpr inline uint32_t INVALID_SLOT = UINT32_MAX;
+
+  uint32_t Slot = INVALID_SLOT;
+
+  bool IsValid() const
+  {
+    return Slot != INVALID_SLOT;
+  }
+};
+
 constexpr inline unsigned ATTRIB_LOC_POSITION    = 0;
 constexpr inline unsigned ATTRIB_LOC_NORMAL      = 1;
 constexpr inline unsigned ATTRIB_LOC_TANGENT     = 2;
@@ -15,7 +53,13 @@ constexpr inline unsigned ATTRIB_LOC_TEXCOORDS_1 = 4;
 constexpr inline unsigned ATTRIB_LOC_TEXCOORDS_2 = 5;
 constexpr inline unsigned ATTRIB_LOC_TEXCOORDS_3 = 6;
 
-constexpr inline unsigned BINDING_LIGHTING_BUFFER = 1;
+constexpr inline unsigned BINDING_LIGHTING_BUFFER      = 1;
+constexpr inline unsigned BINDING_MATERIALS_BUFFER     = 2;
+constexpr inline unsigned BINDING_DRAW_DATA_BUFFER     = 3;
+constexpr inline unsigned BINDING_FRAME_BUFFER         = 4;
+constexpr inline unsigned BINDING_VIEW_BUFFER          = 5;
+constexpr inline unsigned BINDING_DRAW_COMMANDS_BUFFER = 6; // Indirect commands culled by OcclusionCull.comp
+constexpr inline unsigned BINDING_PENDING_DRAWS_BUFFER = 7;
 
 extern const unsigned TEXTURE_BASIC_COLOR_UNIT;
 extern const int      TEXTURE_BASIC_COLOR_INDEX;
@@ -41,6 +85,10 @@ extern const unsigned TEXTURE_VELOCITY_UNIT;
 extern const int      TEXTURE_VELOCITY_INDEX;
 extern const unsigned TEXTURE_TAA_HISTORY_UNIT;
 extern const int      TEXTURE_TAA_HISTORY_INDEX;
+extern const unsigned TEXTURE_DEPTH_MAP_MS_UNIT;
+extern const int      TEXTURE_DEPTH_MAP_MS_INDEX;
+extern const unsigned TEXTURE_HIZ_UNIT;
+extern const int      TEXTURE_HIZ_INDEX;
 
 constexpr inline int MAX_POINT_LIGHTS = 5;
 
@@ -57,6 +105,63 @@ struct TShaderLighting
   TLightDirectional LightDirectional;
 };
 
+// std430, matches TMaterial in PBR.frag and Depth.frag
+struct alignas(16) TShaderMaterial
+{
+  alignas(16) glm::vec4 BaseColorFactor;
+  alignas(16) glm::vec3 EmissiveFactor;
+
+  float    MetallicFactor;
+  float    RoughnessFactor;
+  float    OcclusionStrength;
+  float    AlphaCutoff;
+  int32_t  AlphaMode;
+  uint32_t IsDoubleSided;
+  int32_t  BaseColorTextureTexCoordIndex;
+  int32_t  MetallicRoughnessTextureTexCoordIndex;
+  int32_t  NormalTextureTexCoordIndex;
+  int32_t  OcclusionTextureTexCoordIndex;
+  int32_t  EmissiveTextureTexCoordIndex;
+};
+
+static_assert(sizeof(TShaderMaterial) == 80, "TShaderMaterial must match the std430 array stride");
+
+// std430, matches TDrawData in PBR.vert, Depth.vert and OcclusionCull.comp
+struct alignas(16) TShaderDrawData
+{
+  glm::mat4 Model;
+  uint32_t  MaterialIndex;
+
+  alignas(16) glm::vec4 BoundsMin; // World space, empty boxes are never culled
+  alignas(16) glm::vec4 BoundsMax;
+};
+
+static_assert(sizeof(TShaderDrawData) == 112, "TShaderDrawData must match the std430 array stride");
+
+// std140, matches u_Frame in the shaders. Written once per frame, shared by all passes.
+struct alignas(16) TShaderFrame
+{
+  glm::mat4 LightSpaceMatrix;
+  glm::vec2 Jitter;     // Zero without TAA
+  glm::vec2 PrevJitter;
+  glm::vec2 InverseScreenSize;
+};
+
+static_assert(sizeof(TShaderFrame) == 96, "TShaderFrame must match the std140 block size");
+
+// std140, matches u_View in the shaders
+struct alignas(16) TShaderView
+{
+  glm::mat4 ViewMatrix;
+  glm::mat4 ProjectionMatrix;
+  glm::mat4 ViewProjectionMatrix;
+  glm::mat4 JitteredViewProjectionMatrix; // Same as ViewProjectionMatrix without TAA
+  glm::mat4 PrevJitteredViewProjectionMatrix;
+  glm::vec3 CameraPosition;
+};
+
+static_assert(sizeof(TShaderView) == 336, "TShaderView must match the std140 block size");
+
 //
 
 constexpr float CUBE_VERTICES[] = {-1.0f, 1.0f,  -1.0f, //
@@ -0,0 +1,174 @@
+#include "Visibility.h"
+#include "engine/Config.h"
+#include <common/JobSystem.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+
+constexpr size_t OCCLUSION_TESTS_PER_JOB = 256;
+
+} // namespace
+
+glm::mat4 CreateLightSpaceMatrix(const glm::vec3 &_LightDirection)
+{
+  const float NearPlane = CConfig::Instance().GetLightSpaceMatrixZNear();
+  const float FarPlane  = CConfig::Instance().GetLightSpaceMatrixZFar();
+  const float LeftBot   = CConfig::Instance().GetLightSpaceMatrixOrthLeftBot();
+  const float RightTop  = CConfig::Instance().GetLightSpaceMatrixOrthRightTop();
+
+  const glm::mat4 LightProjection = glm::ortho(LeftBot, RightTop, LeftBot, RightTop, NearPlane, FarPlane);
+  const glm::mat4 LightView       = glm::lookAt(_LightDirection * -1.0f, glm::vec3(0.0f), glm::vec3(0.0, 1.0, 0.0));
+
+  return LightProjection * LightView;
+}
+
+void CVisibilityLists::Build(const CommandsList &_Commands, const std::array<glm::mat4, VISIBILITY_VIEWS_COUNT> &_ViewProjections)
+{
+  m_Bounds.Clear();
+  m_BoundedCommands.clear();
+  for (const TRenderCommand *Command : _Commands)
+  {
+    if (Command->Bounds.IsValid())
+    {
+      m_Bounds.Push(Command->Bounds.Center(), Command->Bounds.Size() * 0.5f);
+      m_BoundedCommands.push_back(Command);
+    }
+  }
+
+  std::array<TRenderFlags, VISIBILITY_VIEWS_COUNT> ViewFlags;
+
+  for (size_t View = 0; View < VISIBILITY_VIEWS_COUNT; ++View)
+  {
+    const EVisibilityView ViewType = static_cast<EVisibilityView>(View);
+
+    utils::CullBounds(CreateFrustum(ViewType, _ViewProjections[View]), m_Bounds, m_Results[View]);
+    ViewFlags[View]      = GetViewFlags(ViewType);
+    m_CulledCounts[View] = 0;
+
+    for (CommandsList &Bucket : m_Buckets[View])
+      Bucket.clear();
+  }
+
+  m_OccludedCount = 0;
+  if (m_IsOcclusionCullingEnabled)
+    CullOccluded(_ViewProjections[static_cast<size_t>(EVisibilityView::Camera)]);
+
+  // Every command is visited once and dropped into the buckets of all its flags
+  size_t BoundsIndex = 0;
+  for (const TRenderCommand *Command : _Commands)
+  {
+    const bool   HasBounds = Command->Bounds.IsValid();
+    const size_t Index     = HasBounds ? BoundsIndex++ : 0;
+
+    for (size_t View = 0; View < VISIBILITY_VIEWS_COUNT; ++View)
+    {
+      const TRenderFlags Flags = Command->RenderFlags & ViewFlags[View];
+      if (Flags.none())
+        continue;
+
+      if (HasBounds && !m_Results[View][Index])
+      {
+        m_CulledCounts[View]++;
+        continue;
+      }
+
+      for (size_t Flag = 0; Flag < ERenderFlags_Count; ++Flag)
+        if (Flags.test(Flag))
+          m_Buckets[View][Flag].push_back(Command);
+    }
+  }
+}
+
+const CVisibilityLists::CommandsList &CVisibilityLists::Get(EVisibilityView _View, ERenderFlags _Flag) const
+{
+  if (_Flag >= ERenderFlags_Count)
+    return m_Empty;
+
+  return m_Buckets[static_cast<size_t>(_View)][_Flag];
+}
+
+uint32_t CVisibilityLists::GetCulledCount(EVisibilityView _View) const
+{
+  return m_CulledCounts[static_cast<size_t>(_View)];
+}
+
+uint32_t CVisibilityLists::GetOccludedCount() const
+{
+  return m_OccludedCount;
+}
+
+void CVisibilityLists::SetOcclusionCullingEnabled(bool _Enabled)
+{
+  m_IsOcclusionCullingEnabled = _Enabled;
+}
+
+// Runs on the frustum culling results of the camera, only the boxes that passed are tested
+void CVisibilityLists::CullOccluded(const glm::mat4 &_ViewProjection)
+{
+  std::vector<uint8_t> &Visible = m_Results[static_cast<size_t>(EVisibilityView::Camera)];
+
+  m_OcclusionBuffer.Begin(_ViewProjection);
+  for (size_t i = 0; i < m_BoundedCommands.size(); ++i)
+  {
+    const TRenderCommand *Command = m_BoundedCommands[i];
+    if (Visible[i] && Command->Occluder && Command->RenderFlags.test(ERenderFlags_Opaque))
+      m_OcclusionBuffer.AddOccluder(*Command->Occluder, Command->ModelMatrix);
+  }
+
+  if (m_OcclusionBuffer.GetOccludersCount() == 0)
+    return;
+
+  m_OcclusionBuffer.Rasterize();
+
+  m_Occluded.assign(m_BoundedCommands.size(), 0);
+
+  const size_t JobsCount = (m_BoundedCommands.size() + OCCLUSION_TESTS_PER_JOB - 1) / OCCLUSION_TESTS_PER_JOB;
+  utils::CJobSystem::Instance().ParallelFor(JobsCount, [&](size_t _Job) {
+    const size_t Begin = _Job * OCCLUSION_TESTS_PER_JOB;
+    const size_t End   = std::min(Begin + OCCLUSION_TESTS_PER_JOB, m_BoundedCommands.size());
+
+    for (size_t i = Begin; i < End; ++i)
+      m_Occluded[i] = Visible[i] && !m_OcclusionBuffer.IsVisible(m_BoundedCommands[i]->Bounds);
+  });
+
+  for (size_t i = 0; i < m_Occluded.size(); ++i)
+  {
+    if (m_Occluded[i])
+    {
+      Visible[i] = 0;
+      m_OccludedCount++;
+    }
+  }
+}
+
+utils::TFrustum CVisibilityLists::CreateFrustum(EVisibilityView _View, const glm::mat4 &_ViewProjection)
+{
+  utils::TFrustum Frustum = utils::ExtractFrustum(_ViewProjection);
+
+  // Casters between the light and the near plane still shade the volume, so it's extruded towards
+  // the light without an end: a zero normal with a positive distance lets every box pass
+  if (_View == EVisibilityView::Light)
+    Frustum.Planes[utils::EFrustumPlane_Near] = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+
+  return Frustum;
+}
+
+TRenderFlags CVisibilityLists::GetViewFlags(EVisibilityView _View)
+{
+  TRenderFlags ShadowFlags;
+  ShadowFlags.set(ERenderFlags_CastShadow);
+
+  switch (_View)
+  {
+  case EVisibilityView::Camera:
+    return ~ShadowFlags;
+  case EVisibilityView::Light:
+    return ShadowFlags;
+  default:
+    assert(false && "Unknown visibility view");
+    return TRenderFlags();
+  }
+}
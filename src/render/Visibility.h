@@ -0,0 +1,63 @@
+#pragma once
+
+#include "RenderCommand.h"
+#include "OcclusionBuffer.h"
+#include <common/FrustumCulling.h>
+#include <glm/mat4x4.hpp>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// Points of view the commands are culled for, shadow cascades would get a view each
+enum class EVisibilityView : uint8_t
+{
+  Camera,
+  Light,
+
+  Count
+};
+
+inline constexpr size_t VISIBILITY_VIEWS_COUNT = static_cast<size_t>(EVisibilityView::Count);
+
+// View projection of the light view: the directional light's shadow map, sized by the config
+glm::mat4 CreateLightSpaceMatrix(const glm::vec3 &_LightDirection);
+
+// Culled and bucketed commands of every view, rebuilt once per frame. A view gathers the commands
+// of its flags only: the light view holds the shadow casters, the camera view everything else.
+// Commands without bounds are visible in every view. Buckets keep the order of the input.
+// The camera view also drops the commands hidden behind the opaque occluders in its frustum.
+class CVisibilityLists final
+{
+public:
+  using CommandsList = std::vector<const TRenderCommand *>;
+
+public:
+  // _ViewProjections is indexed by EVisibilityView
+  void Build(const CommandsList &_Commands, const std::array<glm::mat4, VISIBILITY_VIEWS_COUNT> &_ViewProjections);
+
+  const CommandsList &Get(EVisibilityView _View, ERenderFlags _Flag) const;
+  uint32_t GetCulledCount(EVisibilityView _View) const; // Occluded commands included
+  uint32_t GetOccludedCount() const;
+
+  void SetOcclusionCullingEnabled(bool _Enabled);
+
+  // What a view keeps, also used to cull the entities before their commands are built
+  static utils::TFrustum CreateFrustum(EVisibilityView _View, const glm::mat4 &_ViewProjection);
+
+private:
+  void CullOccluded(const glm::mat4 &_ViewProjection);
+
+  static TRenderFlags GetViewFlags(EVisibilityView _View);
+
+private:
+  utils::TBoundsList                                                               m_Bounds;
+  CommandsList                                                                     m_BoundedCommands; // Owners of m_Bounds
+  std::array<std::vector<uint8_t>, VISIBILITY_VIEWS_COUNT>                         m_Results;
+  std::array<std::array<CommandsList, ERenderFlags_Count>, VISIBILITY_VIEWS_COUNT> m_Buckets;
+  std::array<uint32_t, VISIBILITY_VIEWS_COUNT>                                     m_CulledCounts = {};
+  CommandsList                                                                     m_Empty;
+  COcclusionBuffer                                                                 m_OcclusionBuffer;
+  std::vector<uint8_t>                                                             m_Occluded;
+  uint32_t                                                                         m_OccludedCount             = 0;
+  bool                                                                             m_IsOcclusionCullingEnabled = true;
+};
@@ -1,4 +1,5 @@
 #include "BloomRenderPass.h"
+#include "assets/Shader.h"
 #include "render/RenderCommand.h"
 #include "render/RenderContext.h"
 #include "render/RenderTarget.h"
@@ -16,6 +17,18 @@ CBloomRenderPass::CBloomRenderPass(TVector2i _Viewport) :
     m_BlurPasses(CConfig::Instance().GetBloomBlurPasses()),
     m_PrevFBO(0)
 {
+  if (m_DownsampleShader)
+  {
+    m_DownsampleUniforms.ColorTexture = m_DownsampleShader->GetUniformHandle<int>("ColorTexture");
+    m_DownsampleUniforms.Threshold    = m_DownsampleShader->GetUniformHandle<float>("Threshold");
+  }
+
+  if (m_BlurShader)
+  {
+    m_BlurUniforms.Image      = m_BlurShader->GetUniformHandle<int>("Image");
+    m_BlurUniforms.Horizontal = m_BlurShader->GetUniformHandle<int>("Horizontal");
+  }
+
   m_BloomFBO       = std::make_unique<CFrameBuffer>();
   m_PingPongFBO[0] = std::make_unique<CFrameBuffer>();
   m_PingPongFBO[1] = std::make_unique<CFrameBuffer>();
@@ -41,9 +54,9 @@ void CBloomRenderPass::Execute(IRenderer &_Renderer, TRenderContext &_RenderCont
   _Renderer.SetShader(m_DownsampleShader);
 
   C2DTexture::Bind(TEXTURE_BASIC_COLOR_UNIT, _RenderContext.ColorTexture);
-  _Renderer.SetUniform("ColorTexture", TEXTURE_BASIC_COLOR_INDEX);
+  m_DownsampleShader->SetUniform(m_DownsampleUniforms.ColorTexture, TEXTURE_BASIC_COLOR_INDEX);
 
-  _Renderer.SetUniform("Threshold", m_Threshold);
+  m_DownsampleShader->SetUniform(m_DownsampleUniforms.Threshold, m_Threshold);
   _Renderer.DrawArrays(EPrimitiveMode::Triangles, 6);
 
   m_BloomFBO->Unbind();
@@ -55,8 +68,8 @@ void CBloomRenderPass::Execute(IRenderer &_Renderer, TRenderContext &_RenderCont
     m_PingPongFBO[Horizontal]->Bind();
 
     C2DTexture::Bind(TEXTURE_BASIC_COLOR_UNIT, i == 0 ? m_BloomColor->ID() : m_PingPongColor[!Horizontal]->ID());
-    _Renderer.SetUniform("Image", TEXTURE_BASIC_COLOR_INDEX);
-    _Renderer.SetUniform("Horizontal", Horizontal);
+    m_BlurShader->SetUniform(m_BlurUniforms.Image, TEXTURE_BASIC_COLOR_INDEX);
+    m_BlurShader->SetUniform(m_BlurUniforms.Horizontal, Horizontal);
 
     _Renderer.DrawArrays(EPrimitiveMode::Triangles, 6);
 
@@ -72,9 +85,9 @@ void CBloomRenderPass::PostExecute(IRenderer &_Renderer, TRenderContext &_Render
   _Renderer.SetViewport(m_PrevViewport);
 }
 
-bool CBloomRenderPass::Accepts(const TRenderCommand &_Command) const
+ERenderFlags CBloomRenderPass::GetAcceptedFlag() const
 {
-  return false;
+  return ERenderFlags_Count;
 }
 
 bool CBloomRenderPass::IsAvailable() const
@@ -127,15 +140,14 @@ void CBloomRenderPass::InitTextures(TVector2i _Viewport)
   Params.MagFilter      = ETextureFilter::Linear;
   Params.WrapS          = ETextureWrap::ClampToEdge;
   Params.WrapT          = ETextureWrap::ClampToEdge;
+  Params.MemoryTag      = EGPUMemoryTag::RenderTargets;
 
   for (int i = 0; i < 2; ++i)
   {
-    m_PingPongFBO[i]->Bind();
     m_PingPongColor[i] = resource::RecreateTexture("BLOOM_COLOR_" + std::to_string(i + 1), Params);
     m_PingPongFBO[i]->AttachTexture(GL_COLOR_ATTACHMENT0, m_PingPongColor[i]->ID());
   }
 
-  m_BloomFBO->Bind();
   m_BloomColor = resource::RecreateTexture("BLOOM_COLOR", Params);
   m_BloomFBO->AttachTexture(GL_COLOR_ATTACHMENT0, m_BloomColor->ID());
 }
@@ -2,6 +2,7 @@
 
 #include "RenderPassTypes.h"
 #include "interfaces/RenderPass.h"
+#include "render/ShaderTypes.h"
 #include <common/MathTypes.h>
 #include <common/Sharable.h>
 #include <events/EventsListener.h>
@@ -34,7 +35,7 @@ public:
   void PreExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
   void Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
   void PostExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
-  bool Accepts(const TRenderCommand &_Command) const override;
+  ERenderFlags GetAcceptedFlag() const override;
   bool IsAvailable() const override;
   bool NeedsCommands() const override;
 
@@ -45,8 +46,22 @@ private:
   void InitTextures(TVector2i _Viewport);
 
 private:
+  struct TDownsampleUniforms
+  {
+    TUniformHandle<int>   ColorTexture;
+    TUniformHandle<float> Threshold;
+  };
+
+  struct TBlurUniforms
+  {
+    TUniformHandle<int> Image;
+    TUniformHandle<int> Horizontal;
+  };
+
   std::shared_ptr<CShader> m_DownsampleShader;
   std::shared_ptr<CShader> m_BlurShader;
+  TDownsampleUniforms      m_DownsampleUniforms;
+  TBlurUniforms            m_BlurUniforms;
 
   std::unique_ptr<CFrameBuffer> m_BloomFBO;
   std::shared_ptr<CTexture>     m_BloomColor;
@@ -46,13 +46,16 @@ CCollisionRenderPass::CCollisionRenderPass() :
     m_VAO(),
     m_VBO(GL_STATIC_DRAW)
 {
-  m_VAO.Bind();
-  m_VBO.Bind();
-  m_VBO.Assign(WIREFRAME_VERTICES, sizeof(WIREFRAME_VERTICES));
+  if (m_Shader)
+  {
+    m_Uniforms.Model = m_Shader->GetUniformHandle<glm::mat4>("u_Model");
+    m_Uniforms.Color = m_Shader->GetUniformHandle<glm::vec4>("u_Color");
+  }
 
-  m_VAO.EnableAttrib(ATTRIB_LOC_POSITION, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float));
+  m_VBO.Assign(WIREFRAME_VERTICES, sizeof(WIREFRAME_VERTICES));
 
-  m_VAO.Unbind();
+  m_VAO.AttachVertexBuffer(0, m_VBO.ID(), 3 * sizeof(float));
+  m_VAO.EnableAttrib(ATTRIB_LOC_POSITION, 3, GL_FLOAT, GL_FALSE, 0);
 }
 
 void CCollisionRenderPass::PreExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const IRenderPass::CommandsList &_Commands)
@@ -68,8 +71,8 @@ void CCollisionRenderPass::Execute(IRenderer &_Renderer, TRenderContext &_Render
 
   for (const TRenderCommand *Command : _Commands)
   {
-    _Renderer.SetUniform("u_MVP", _RenderContext.ViewProjectionMatrix * Command->ModelMatrix);
-    _Renderer.SetUniform("u_Color", m_WireframeColor);
+    m_Shader->SetUniform(m_Uniforms.Model, Command->ModelMatrix);
+    m_Shader->SetUniform(m_Uniforms.Color, m_WireframeColor);
 
     _Renderer.DrawArrays(EPrimitiveMode::Lines, ARRAY_SIZE(WIREFRAME_VERTICES));
   }
@@ -81,9 +84,9 @@ void CCollisionRenderPass::PostExecute(IRenderer &_Renderer, TRenderContext &_Re
 {
 }
 
-bool CCollisionRenderPass::Accepts(const TRenderCommand &_Command) const
+ERenderFlags CCollisionRenderPass::GetAcceptedFlag() const
 {
-  return _Command.RenderFlags.test(ERenderFlags_Wireframe);
+  return ERenderFlags_Wireframe;
 }
 
 bool CCollisionRenderPass::IsAvailable() const
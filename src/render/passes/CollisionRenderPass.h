@@ -2,6 +2,7 @@
 
 #include "RenderPassTypes.h"
 #include "interfaces/RenderPass.h"
+#include "render/ShaderTypes.h"
 #include "render/Buffer.h"
 #include <events/EventsListener.h>
 #include <common/Sharable.h>
@@ -34,7 +35,7 @@ public:
   void Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
   void PostExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
 
-  bool Accepts(const TRenderCommand &_Command) const override;
+  ERenderFlags GetAcceptedFlag() const override;
   bool IsAvailable() const override;
   bool NeedsCommands() const override;
 
@@ -44,7 +45,14 @@ private:
   void SubscribeToEvents();
 
 private:
+  struct TUniforms
+  {
+    TUniformHandle<glm::mat4> Model;
+    TUniformHandle<glm::vec4> Color;
+  };
+
   std::shared_ptr<CShader> m_Shader;
+  TUniforms                m_Uniforms;
   glm::vec4                m_WireframeColor;
   CVertexArray             m_VAO;
   CVertexBuffer            m_VBO;
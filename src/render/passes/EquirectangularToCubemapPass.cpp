@@ -1,4 +1,5 @@
 #include "EquirectangularToCubemapPass.h"
+#include "assets/Shader.h"
 #include "interfaces/Renderer.h"
 #include "render/RenderContext.h"
 #include "render/RenderCommand.h"
@@ -12,8 +13,13 @@
 CEquirectangularToCubemapPass::CEquirectangularToCubemapPass() :
     m_Shader(resource::LoadShader("EquirectangularToCubemap"))
 {
-  m_FBO.Bind();
-  m_RBO.Bind();
+  if (m_Shader)
+  {
+    m_Uniforms.Projection         = m_Shader->GetUniformHandle<glm::mat4>("u_Projection");
+    m_Uniforms.EquirectangularMap = m_Shader->GetUniformHandle<int>("u_EquirectangularMap");
+    m_Uniforms.View               = m_Shader->GetUniformHandle<glm::mat4>("u_View");
+  }
+
   m_RBO.AllocateStorage(GL_DEPTH_COMPONENT24, 512, 512);
   m_FBO.AttachRenderBuffer(GL_DEPTH_ATTACHMENT, m_RBO.ID());
 
@@ -38,18 +44,18 @@ void CEquirectangularToCubemapPass::PreExecute(IRenderer &_Renderer, TRenderCont
 
 void CEquirectangularToCubemapPass::Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const IRenderPass::CommandsList &_Commands)
 {
-  _Renderer.SetUniform("u_Projection", m_Projection);
+  m_Shader->SetUniform(m_Uniforms.Projection, m_Projection);
 
   for (const TRenderCommand *Command : _Commands)
   {
     C2DTexture::Bind(TEXTURE_BASIC_COLOR_UNIT, Command->Environment.EquirectangularMap);
-    _Renderer.SetUniform("u_EquirectangularMap", TEXTURE_BASIC_COLOR_INDEX);
+    m_Shader->SetUniform(m_Uniforms.EquirectangularMap, TEXTURE_BASIC_COLOR_INDEX);
 
     m_FBO.Bind();
     for (int i = 0; i < CUBEMAP_FACES; ++i)
     {
       m_FBO.AttachTexture(GL_COLOR_ATTACHMENT0, Command->Environment.SkyboxTexture, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i);
-      _Renderer.SetUniform("u_View", m_Views[i]);
+      m_Shader->SetUniform(m_Uniforms.View, m_Views[i]);
       _Renderer.Clear(static_cast<EClearFlags>(EClearFlags::Color | EClearFlags::Depth));
       _Renderer.DrawArrays(EPrimitiveMode::Triangles, ARRAY_SIZE(CUBE_VERTICES) / 3);
     }
@@ -63,9 +69,9 @@ void CEquirectangularToCubemapPass::PostExecute(IRenderer &_Renderer, TRenderCon
   _Renderer.SetDepthFunc(GL_LESS);
 }
 
-bool CEquirectangularToCubemapPass::Accepts(const TRenderCommand &_Command) const
+ERenderFlags CEquirectangularToCubemapPass::GetAcceptedFlag() const
 {
-  return _Command.RenderFlags.test(ERenderFlags_EquirectangularToCubemap);
+  return ERenderFlags_EquirectangularToCubemap;
 }
 
 bool CEquirectangularToCubemapPass::IsAvailable() const
@@ -47,15 +47,18 @@ CGridRenderPass::CGridRenderPass() :
     m_VBO(GL_STATIC_DRAW),
     m_VertexCount(0)
 {
+  if (m_Shader)
+  {
+    m_Uniforms.Model = m_Shader->GetUniformHandle<glm::mat4>("u_Model");
+  }
+
   const std::vector<float> Grid = GenerateGridVertices(50.0f, 1.0f);
 
   m_VertexCount = static_cast<uint32_t>(Grid.size() / 3);
 
-  m_VAO.Bind();
-  m_VBO.Bind();
   m_VBO.Assign(Grid);
-  m_VAO.EnableAttrib(ATTRIB_LOC_POSITION, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float));
-  m_VAO.Unbind();
+  m_VAO.AttachVertexBuffer(0, m_VBO.ID(), 3 * sizeof(float));
+  m_VAO.EnableAttrib(ATTRIB_LOC_POSITION, 3, GL_FLOAT, GL_FALSE, 0);
 }
 
 void CGridRenderPass::PreExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const IRenderPass::CommandsList &_Commands)
@@ -75,8 +78,7 @@ void CGridRenderPass::Execute(IRenderer &_Renderer, TRenderContext &_RenderConte
   glm::mat4 Model = glm::scale(glm::mat4(1.0f), glm::vec3(1.0f));
   Model           = glm::translate(Model, glm::vec3(0.0f, -0.01f, 0.0f)); // To prevent z-fighting
 
-  _Renderer.SetUniform("u_MVP", _RenderContext.ViewProjectionMatrix * Model);
-  _Renderer.SetUniform("u_Model", Model);
+  m_Shader->SetUniform(m_Uniforms.Model, Model);
 
   _Renderer.DrawArrays(EPrimitiveMode::Lines, m_VertexCount);
 
@@ -88,9 +90,9 @@ void CGridRenderPass::PostExecute(IRenderer &_Renderer, TRenderContext &_RenderC
   _Renderer.SetDepthMask(true);
 }
 
-bool CGridRenderPass::Accepts(const TRenderCommand &_Command) const
+ERenderFlags CGridRenderPass::GetAcceptedFlag() const
 {
-  return false;
+  return ERenderFlags_Count;
 }
 
 bool CGridRenderPass::IsAvailable() const
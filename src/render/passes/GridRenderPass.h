@@ -2,6 +2,7 @@
 
 #include "RenderPassTypes.h"
 #include "interfaces/RenderPass.h"
+#include "render/ShaderTypes.h"
 #include "render/Buffer.h"
 #include <common/Sharable.h>
 
@@ -22,12 +23,18 @@ public:
   void Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
   void PostExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
 
-  bool Accepts(const TRenderCommand &_Command) const override;
+  ERenderFlags GetAcceptedFlag() const override;
   bool IsAvailable() const override;
   bool NeedsCommands() const override;
 
 private:
+  struct TUniforms
+  {
+    TUniformHandle<glm::mat4> Model;
+  };
+
   std::shared_ptr<CShader> m_Shader;
+  TUniforms                m_Uniforms;
   CVertexArray             m_VAO;
   CVertexBuffer            m_VBO;
   uint32_t                 m_VertexCount;
@@ -1,4 +1,5 @@
 #include "IrradianceConvolutionPass.h"
+#include "assets/Shader.h"
 #include "interfaces/Renderer.h"
 #include "render/RenderContext.h"
 #include "render/RenderCommand.h"
@@ -12,8 +13,13 @@
 CIrradianceConvolutionPass::CIrradianceConvolutionPass() :
     m_Shader(resource::LoadShader("IrradianceConvolution"))
 {
-  m_FBO.Bind();
-  m_RBO.Bind();
+  if (m_Shader)
+  {
+    m_Uniforms.Projection     = m_Shader->GetUniformHandle<glm::mat4>("u_Projection");
+    m_Uniforms.EnvironmentMap = m_Shader->GetUniformHandle<int>("u_EnvironmentMap");
+    m_Uniforms.View           = m_Shader->GetUniformHandle<glm::mat4>("u_View");
+  }
+
   m_RBO.AllocateStorage(GL_DEPTH_COMPONENT24, IRRADIANCE_MAP_SIZE, IRRADIANCE_MAP_SIZE);
   m_FBO.AttachRenderBuffer(GL_DEPTH_ATTACHMENT, m_RBO.ID());
 
@@ -38,18 +44,18 @@ void CIrradianceConvolutionPass::PreExecute(IRenderer &_Renderer, TRenderContext
 
 void CIrradianceConvolutionPass::Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const IRenderPass::CommandsList &_Commands)
 {
-  _Renderer.SetUniform("u_Projection", m_Projection);
+  m_Shader->SetUniform(m_Uniforms.Projection, m_Projection);
 
   for (const TRenderCommand *Command : _Commands)
   {
     CCubemap::Bind(TEXTURE_SKYBOX_UNIT, Command->Environment.SkyboxTexture);
-    _Renderer.SetUniform("u_EnvironmentMap", TEXTURE_SKYBOX_INDEX);
+    m_Shader->SetUniform(m_Uniforms.EnvironmentMap, TEXTURE_SKYBOX_INDEX);
 
     m_FBO.Bind();
     for (int i = 0; i < CUBEMAP_FACES; ++i)
     {
       m_FBO.AttachTexture(GL_COLOR_ATTACHMENT0, Command->Environment.IrradianceMap, GL_TEXTURE_CUBE_MAP_POSITIVE_X + i);
-      _Renderer.SetUniform("u_View", m_Views[i]);
+      m_Shader->SetUniform(m_Uniforms.View, m_Views[i]);
       _Renderer.Clear(static_cast<EClearFlags>(EClearFlags::Color | EClearFlags::Depth));
       _Renderer.DrawArrays(EPrimitiveMode::Triangles, ARRAY_SIZE(CUBE_VERTICES) / 3);
     }
@@ -63,9 +69,9 @@ void CIrradianceConvolutionPass::PostExecute(IRenderer &_Renderer, TRenderContex
   _Renderer.SetDepthFunc(GL_LESS);
 }
 
-bool CIrradianceConvolutionPass::Accepts(const TRenderCommand &_Command) const
+ERenderFlags CIrradianceConvolutionPass::GetAcceptedFlag() const
 {
-  return _Command.RenderFlags.test(ERenderFlags_IrradianceConvolution);
+  return ERenderFlags_IrradianceConvolution;
 }
 
 bool CIrradianceConvolutionPass::IsAvailable() const
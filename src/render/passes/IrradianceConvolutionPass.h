@@ -2,6 +2,7 @@
 
 #include "RenderPassTypes.h"
 #include "interfaces/RenderPass.h"
+#include "render/ShaderTypes.h"
 #include "render/RenderContext.h"
 #include "render/Buffer.h"
 #include <common/Sharable.h>
@@ -23,15 +24,23 @@ public:
   void PreExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
   void Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
   void PostExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
-  bool Accepts(const TRenderCommand &_Command) const override;
+  ERenderFlags GetAcceptedFlag() const override;
   bool IsAvailable() const override;
   bool NeedsCommands() const override;
 
 private:
+  struct TUniforms
+  {
+    TUniformHandle<glm::mat4> Projection;
+    TUniformHandle<int>       EnvironmentMap;
+    TUniformHandle<glm::mat4> View;
+  };
+
   static constexpr inline int CUBEMAP_FACES       = 6;
   static constexpr inline int IRRADIANCE_MAP_SIZE = 32;
 
   std::shared_ptr<CShader> m_Shader;
+  TUniforms                m_Uniforms;
 
   CFrameBuffer  m_FBO;
   CRenderBuffer m_RBO;
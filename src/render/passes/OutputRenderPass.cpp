@@ -13,6 +13,10 @@
 COutputRenderPass::COutputRenderPass() :
     m_Shader(resource::LoadShader("Output"))
 {
+  if (m_Shader)
+  {
+    m_Uniforms.Texture = m_Shader->GetUniformHandle<int>("Texture");
+  }
 }
 
 void COutputRenderPass::PreExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const IRenderPass::CommandsList &_Commands)
@@ -28,7 +32,7 @@ void COutputRenderPass::PreExecute(IRenderer &_Renderer, TRenderContext &_Render
 void COutputRenderPass::Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const IRenderPass::CommandsList &_Commands)
 {
   C2DTexture::Bind(TEXTURE_BASIC_COLOR_UNIT, _RenderContext.ColorTexture);
-  _Renderer.SetUniform("Texture", TEXTURE_BASIC_COLOR_INDEX);
+  m_Shader->SetUniform(m_Uniforms.Texture, TEXTURE_BASIC_COLOR_INDEX);
   _Renderer.DrawArrays(EPrimitiveMode::Triangles, 6);
 }
 
@@ -37,9 +41,9 @@ void COutputRenderPass::PostExecute(IRenderer &_Renderer, TRenderContext &_Rende
   _RenderContext.QuadVAO.Unbind();
 }
 
-bool COutputRenderPass::Accepts(const TRenderCommand &_Command) const
+ERenderFlags COutputRenderPass::GetAcceptedFlag() const
 {
-  return false;
+  return ERenderFlags_Count;
 }
 
 bool COutputRenderPass::IsAvailable() const
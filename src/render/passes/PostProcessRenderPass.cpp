@@ -1,4 +1,5 @@
 #include "PostProcessRenderPass.h"
+#include "assets/Shader.h"
 #include "render/RenderCommand.h"
 #include "render/RenderContext.h"
 #include "interfaces/Renderer.h"
@@ -17,6 +18,21 @@ CPostProcessRenderPass::CPostProcessRenderPass() :
     m_BloomIntensity(CConfig::Instance().GetBloomIntensity()),
     m_Gamma(CConfig::Instance().GetGamma())
 {
+  if (m_Shader)
+  {
+    m_Uniforms.ColorTexture             = m_Shader->GetUniformHandle<int>("ColorTexture");
+    m_Uniforms.DepthTexture             = m_Shader->GetUniformHandle<int>("DepthTexture");
+    m_Uniforms.BloomTexture             = m_Shader->GetUniformHandle<int>("BloomTexture");
+    m_Uniforms.TAATexture               = m_Shader->GetUniformHandle<int>("TAATexture");
+    m_Uniforms.IsFXAAEnabled            = m_Shader->GetUniformHandle<int>("IsFXAAEnabled");
+    m_Uniforms.IsTAAEnabled             = m_Shader->GetUniformHandle<int>("IsTAAEnabled");
+    m_Uniforms.IsHDR                    = m_Shader->GetUniformHandle<int>("IsHDR");
+    m_Uniforms.IsBloomEnabled           = m_Shader->GetUniformHandle<int>("IsBloomEnabled");
+    m_Uniforms.BloomIntensity           = m_Shader->GetUniformHandle<float>("BloomIntensity");
+    m_Uniforms.IsGammaCorrectionEnabled = m_Shader->GetUniformHandle<int>("IsGammaCorrectionEnabled");
+    m_Uniforms.Exposure                 = m_Shader->GetUniformHandle<float>("Exposure");
+    m_Uniforms.Gamma                    = m_Shader->GetUniformHandle<float>("Gamma");
+  }
 }
 
 void CPostProcessRenderPass::PreExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const IRenderPass::CommandsList &_Commands)
@@ -28,28 +44,25 @@ void CPostProcessRenderPass::PreExecute(IRenderer &_Renderer, TRenderContext &_R
 
 void CPostProcessRenderPass::Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const IRenderPass::CommandsList &_Commands)
 {
-  const auto      Viewport     = _Renderer.GetViewport();
-  const glm::vec2 InverseSize  = glm::vec2(1.0f / Viewport.X, 1.0f / Viewport.Y);
-  const bool      IsTAAEnabled = _RenderContext.TAA.has_value();
+  const bool IsTAAEnabled = _RenderContext.TAA.has_value();
 
   C2DTexture::Bind(TEXTURE_DEPTH_MAP_UNIT, _RenderContext.DepthTexture);
   C2DTexture::Bind(TEXTURE_BASIC_COLOR_UNIT, _RenderContext.ColorTexture);
   C2DTexture::Bind(TEXTURE_BLOOM_UNIT, _RenderContext.BloomMap);
   C2DTexture::Bind(TEXTURE_TAA_HISTORY_UNIT, _RenderContext.TAA ? _RenderContext.TAA->HistoryMap : CTexture::INVALID_TEXTURE);
 
-  _Renderer.SetUniform("ColorTexture", TEXTURE_BASIC_COLOR_INDEX);
-  _Renderer.SetUniform("DepthTexture", TEXTURE_DEPTH_MAP_INDEX);
-  _Renderer.SetUniform("BloomTexture", TEXTURE_BLOOM_INDEX);
-  _Renderer.SetUniform("TAATexture", TEXTURE_TAA_HISTORY_INDEX);
-  _Renderer.SetUniform("InverseScreenSize", InverseSize);
-  _Renderer.SetUniform("IsFXAAEnabled", m_IsFXAAEnabled);
-  _Renderer.SetUniform("IsTAAEnabled", IsTAAEnabled);
-  _Renderer.SetUniform("IsHDR", m_IsHDREnabled);
-  _Renderer.SetUniform("IsBloomEnabled", m_IsBloomEnabled);
-  _Renderer.SetUniform("BloomIntensity", m_BloomIntensity);
-  _Renderer.SetUniform("IsGammaCorrectionEnabled", m_IsGammaCorrectionEnabled);
-  _Renderer.SetUniform("Exposure", m_HDRExposure);
-  _Renderer.SetUniform("Gamma", m_Gamma);
+  m_Shader->SetUniform(m_Uniforms.ColorTexture, TEXTURE_BASIC_COLOR_INDEX);
+  m_Shader->SetUniform(m_Uniforms.DepthTexture, TEXTURE_DEPTH_MAP_INDEX);
+  m_Shader->SetUniform(m_Uniforms.BloomTexture, TEXTURE_BLOOM_INDEX);
+  m_Shader->SetUniform(m_Uniforms.TAATexture, TEXTURE_TAA_HISTORY_INDEX);
+  m_Shader->SetUniform(m_Uniforms.IsFXAAEnabled, m_IsFXAAEnabled);
+  m_Shader->SetUniform(m_Uniforms.IsTAAEnabled, IsTAAEnabled);
+  m_Shader->SetUniform(m_Uniforms.IsHDR, m_IsHDREnabled);
+  m_Shader->SetUniform(m_Uniforms.IsBloomEnabled, m_IsBloomEnabled);
+  m_Shader->SetUniform(m_Uniforms.BloomIntensity, m_BloomIntensity);
+  m_Shader->SetUniform(m_Uniforms.IsGammaCorrectionEnabled, m_IsGammaCorrectionEnabled);
+  m_Shader->SetUniform(m_Uniforms.Exposure, m_HDRExposure);
+  m_Shader->SetUniform(m_Uniforms.Gamma, m_Gamma);
   _Renderer.DrawArrays(EPrimitiveMode::Triangles, 6);
 }
 
@@ -58,9 +71,9 @@ void CPostProcessRenderPass::PostExecute(IRenderer &_Renderer, TRenderContext &_
   _RenderContext.QuadVAO.Unbind();
 }
 
-bool CPostProcessRenderPass::Accepts(const TRenderCommand &_Command) const
+ERenderFlags CPostProcessRenderPass::GetAcceptedFlag() const
 {
-  return false;
+  return ERenderFlags_Count;
 }
 
 bool CPostProcessRenderPass::IsAvailable() const
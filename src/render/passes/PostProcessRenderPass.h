@@ -2,6 +2,7 @@
 
 #include "RenderPassTypes.h"
 #include "interfaces/RenderPass.h"
+#include "render/ShaderTypes.h"
 #include <events/EventsListener.h>
 #include <common/Sharable.h>
 
@@ -31,7 +32,7 @@ public:
   void PreExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
   void Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
   void PostExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
-  bool Accepts(const TRenderCommand &_Command) const override;
+  ERenderFlags GetAcceptedFlag() const override;
   bool IsAvailable() const override;
   bool NeedsCommands() const override;
 
@@ -41,7 +42,24 @@ private:
   void SubscribeToEvents();
 
 private:
+  struct TUniforms
+  {
+    TUniformHandle<int>   ColorTexture;
+    TUniformHandle<int>   DepthTexture;
+    TUniformHandle<int>   BloomTexture;
+    TUniformHandle<int>   TAATexture;
+    TUniformHandle<int>   IsFXAAEnabled;
+    TUniformHandle<int>   IsTAAEnabled;
+    TUniformHandle<int>   IsHDR;
+    TUniformHandle<int>   IsBloomEnabled;
+    TUniformHandle<float> BloomIntensity;
+    TUniformHandle<int>   IsGammaCorrectionEnabled;
+    TUniformHandle<float> Exposure;
+    TUniformHandle<float> Gamma;
+  };
+
   std::shared_ptr<CShader> m_Shader;
+  TUniforms                m_Uniforms;
 
   bool  m_IsFXAAEnabled;
   bool  m_IsHDREnabled;
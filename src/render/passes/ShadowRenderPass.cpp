@@ -1,12 +1,28 @@
 #include "ShadowRenderPass.h"
+#include "assets/Shader.h"
 #include "interfaces/Renderer.h"
 #include "render/RenderContext.h"
 #include "render/RenderCommand.h"
+#include "render/IndirectDrawBuffer.h"
 #include "interfaces/Renderer.h"
 #include "assets/Texture.h"
 #include "engine/Config.h"
 #include "utils/Resource.h"
 
+namespace
+{
+
+// Only alpha tested draws read the base color in the depth shader, the rest merge regardless of it
+bool IsSameShadowState(const TRenderCommand &_First, const TRenderCommand &_Command)
+{
+  if (_First.Material.AlphaMode == EAlphaMode::Opaque && _Command.Material.AlphaMode == EAlphaMode::Opaque)
+    return true;
+
+  return _First.Material.BaseColorTexture == _Command.Material.BaseColorTexture;
+}
+
+} // namespace
+
 const std::string CShadowRenderPass::SHADOW_MAP_NAME = "SHADOW_PASS_DEPTH_MAP";
 
 CShadowRenderPass::CShadowRenderPass() :
@@ -15,11 +31,14 @@ CShadowRenderPass::CShadowRenderPass() :
     m_DepthMap(CreateDepthMap(TVector2i(m_ShadowMapSize, m_ShadowMapSize))),
     m_DepthMapFBO()
 {
+  if (m_Shader)
+  {
+    m_Uniforms.BaseColorTexture = m_Shader->GetUniformHandle<int>("u_BaseColorTexture");
+  }
+
   assert(m_DepthMap);
-  m_DepthMapFBO.Bind();
   m_DepthMapFBO.AttachTexture(GL_DEPTH_ATTACHMENT, m_DepthMap->ID());
   m_DepthMapFBO.DisableColorBuffer();
-  m_DepthMapFBO.Unbind();
 }
 
 void CShadowRenderPass::PreExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const IRenderPass::CommandsList &_Commands)
@@ -37,27 +56,22 @@ void CShadowRenderPass::PreExecute(IRenderer &_Renderer, TRenderContext &_Render
   _Renderer.SetViewport(NewViewport);
   _Renderer.Clear(EClearFlags::Depth);
   _Renderer.SetShader(m_Shader);
-  _Renderer.SetUniform("u_LightSpaceMatrix", _RenderContext.LightSpaceMatrix);
+  m_Shader->SetUniform(m_Uniforms.BaseColorTexture, TEXTURE_BASIC_COLOR_INDEX);
 }
 
 void CShadowRenderPass::Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const IRenderPass::CommandsList &_Commands)
 {
-  for (const TRenderCommand *Command : _Commands)
+  const std::vector<TDrawBatch> &Batches = _RenderContext.DrawBuffer.Build(_Commands, IsSameShadowState, true);
+
+  for (const TDrawBatch &Batch : Batches)
   {
-    _Renderer.SetUniform("u_Model", Command->ModelMatrix);
+    const TRenderCommand *Command = Batch.Command;
 
     C2DTexture::Bind(TEXTURE_BASIC_COLOR_UNIT, Command->Material.BaseColorTexture);
-    _Renderer.SetUniform("u_Material.BaseColorTexture", TEXTURE_BASIC_COLOR_INDEX);
-    _Renderer.SetUniform("u_Material.AlphaCutoff", Command->Material.AlphaCutoff);
-    _Renderer.SetUniform("u_Material.AlphaMode", static_cast<int>(Command->Material.AlphaMode));
 
     Command->VAO->Bind();
-
-    if (Command->IndexType != EIndexType::Absent)
-      _Renderer.DrawElements(Command->PrimitiveMode, Command->IndicesCount, Command->IndexType);
-    else
-      _Renderer.DrawArrays(Command->PrimitiveMode, Command->IndicesCount);
-
+    _Renderer.MultiDrawElementsIndirect(Command->PrimitiveMode, Command->IndexType, reinterpret_cast<const void *>(Batch.CommandsOffset),
+                                        static_cast<int>(Batch.DrawsCount), static_cast<int>(Batch.IndicesCount));
     Command->VAO->Unbind();
   }
 }
@@ -68,9 +82,9 @@ void CShadowRenderPass::PostExecute(IRenderer &_Renderer, TRenderContext &_Rende
   m_DepthMapFBO.Unbind();
 }
 
-bool CShadowRenderPass::Accepts(const TRenderCommand &_Command) const
+ERenderFlags CShadowRenderPass::GetAcceptedFlag() const
 {
-  return _Command.RenderFlags.test(ERenderFlags_CastShadow);
+  return ERenderFlags_CastShadow;
 }
 
 bool CShadowRenderPass::IsAvailable() const
@@ -96,6 +110,7 @@ std::shared_ptr<CTexture> CShadowRenderPass::CreateDepthMap(TVector2i _Size)
   DepthMapParams.WrapT          = ETextureWrap::ClampToBorder;
   DepthMapParams.MinFilter      = ETextureFilter::Nearest;
   DepthMapParams.MagFilter      = ETextureFilter::Nearest;
+  DepthMapParams.MemoryTag      = EGPUMemoryTag::ShadowMaps;
   return resource::RecreateTexture(SHADOW_MAP_NAME, DepthMapParams);
 }
 
@@ -115,9 +130,7 @@ void CShadowRenderPass::OnEvent(const TEvent &_Event)
       m_ShadowMapSize = NewSize;
 
       m_DepthMap = CreateDepthMap(TVector2i(m_ShadowMapSize, m_ShadowMapSize));
-      m_DepthMapFBO.Bind();
       m_DepthMapFBO.AttachTexture(GL_DEPTH_ATTACHMENT, m_DepthMap->ID());
-      m_DepthMapFBO.Unbind();
     }
     break;
   }
@@ -140,12 +153,10 @@ void CShadowRenderPass::RenderDebugQuad(IRenderer &_Renderer)
 
     CVertexArray  VAO;
     CVertexBuffer VBO(GL_STATIC_DRAW);
-    VAO.Bind();
-    VBO.Bind();
     VBO.Assign(QuadVertices, sizeof(QuadVertices));
-    VAO.EnableAttrib(ATTRIB_LOC_POSITION, 3, GL_FLOAT, false, 5 * sizeof(float), (void *)0);
-    VAO.EnableAttrib(ATTRIB_LOC_TEXCOORDS_0, 2, GL_FLOAT, false, 5 * sizeof(float), (void *)(3 * sizeof(float)));
-    VAO.Unbind();
+    VAO.AttachVertexBuffer(0, VBO.ID(), 5 * sizeof(float));
+    VAO.EnableAttrib(ATTRIB_LOC_POSITION, 3, GL_FLOAT, false, 0);
+    VAO.EnableAttrib(ATTRIB_LOC_TEXCOORDS_0, 2, GL_FLOAT, false, 0, 3 * sizeof(float));
 
     return VAO;
   }();
@@ -4,6 +4,7 @@
 #include "render/RenderCommand.h"
 #include "interfaces/Renderer.h"
 #include "interfaces/RenderPass.h"
+#include "render/ShaderTypes.h"
 #include <events/EventsListener.h>
 #include <common/Sharable.h>
 #include <vector>
@@ -32,7 +33,7 @@ public:
     return ERenderPassType::Shadow;
   }
 
-  bool Accepts(const TRenderCommand &_Command) const override;
+  ERenderFlags GetAcceptedFlag() const override;
   void PreExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
   void Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
   void PostExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
@@ -48,11 +49,17 @@ private:
   void DestroyDepthMap();
 
 private:
+  struct TUniforms
+  {
+    TUniformHandle<int> BaseColorTexture;
+  };
+
   static const std::string SHADOW_MAP_NAME;
 
-  int                           m_ShadowMapSize;
-  std::shared_ptr<CShader>      m_Shader;
+  int                       m_ShadowMapSize;
+  std::shared_ptr<CShader>  m_Shader;
+  TUniforms                 m_Uniforms;
   std::shared_ptr<CTexture> m_DepthMap;
-  CFrameBuffer                  m_DepthMapFBO;
-  TVector2i                     m_OldViewport;
+  CFrameBuffer              m_DepthMapFBO;
+  TVector2i                 m_OldViewport;
 };
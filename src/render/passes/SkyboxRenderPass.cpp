@@ -1,4 +1,5 @@
 #include "SkyboxRenderPass.h"
+#include "assets/Shader.h"
 #include "interfaces/Renderer.h"
 #include "render/RenderContext.h"
 #include "render/RenderCommand.h"
@@ -11,6 +12,10 @@
 CSkyboxRenderPass::CSkyboxRenderPass() :
     m_Shader(resource::LoadShader("Skybox"))
 {
+  if (m_Shader)
+  {
+    m_Uniforms.Cubemap = m_Shader->GetUniformHandle<int>("u_Cubemap");
+  }
 }
 
 void CSkyboxRenderPass::PreExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const IRenderPass::CommandsList &_Commands)
@@ -20,8 +25,6 @@ void CSkyboxRenderPass::PreExecute(IRenderer &_Renderer, TRenderContext &_Render
   _Renderer.SetDepthMask(false);
   _Renderer.SetCullFace(ECullMode::None);
   _Renderer.SetShader(m_Shader);
-  _Renderer.SetUniform("u_View", glm::mat4(glm::mat3(_RenderContext.ViewMatrix)));
-  _Renderer.SetUniform("u_Projection", _RenderContext.ProjectionMatrix);
   _RenderContext.CubeVAO.Bind();
 }
 
@@ -30,7 +33,7 @@ void CSkyboxRenderPass::Execute(IRenderer &_Renderer, TRenderContext &_RenderCon
   for (const TRenderCommand *Command : _Commands)
   {
     CCubemap::Bind(TEXTURE_SKYBOX_UNIT, Command->Environment.SkyboxTexture);
-    _Renderer.SetUniform("u_Cubemap", TEXTURE_SKYBOX_INDEX);
+    m_Shader->SetUniform(m_Uniforms.Cubemap, TEXTURE_SKYBOX_INDEX);
 
     _Renderer.DrawArrays(EPrimitiveMode::Triangles, ARRAY_SIZE(CUBE_VERTICES) / 3);
   }
@@ -43,9 +46,9 @@ void CSkyboxRenderPass::PostExecute(IRenderer &_Renderer, TRenderContext &_Rende
   _Renderer.SetDepthFunc(GL_LESS);
 }
 
-bool CSkyboxRenderPass::Accepts(const TRenderCommand &_Command) const
+ERenderFlags CSkyboxRenderPass::GetAcceptedFlag() const
 {
-  return _Command.RenderFlags.test(ERenderFlags_Skybox);
+  return ERenderFlags_Skybox;
 }
 
 bool CSkyboxRenderPass::IsAvailable() const
@@ -1,4 +1,5 @@
 #include "TAARenderPass.h"
+#include "assets/Shader.h"
 #include "render/RenderCommand.h"
 #include "render/RenderContext.h"
 #include "render/RenderTarget.h"
@@ -14,6 +15,14 @@ CTAARenderPass::CTAARenderPass(TVector2i _Viewport) :
     m_HistoryIndex(0),
     m_PrevFBO(0)
 {
+  if (m_Shader)
+  {
+    m_Uniforms.CurrentFrame    = m_Shader->GetUniformHandle<int>("CurrentFrame");
+    m_Uniforms.HistoryFrame    = m_Shader->GetUniformHandle<int>("HistoryFrame");
+    m_Uniforms.VelocityTexture = m_Shader->GetUniformHandle<int>("VelocityTexture");
+    m_Uniforms.DepthTexture    = m_Shader->GetUniformHandle<int>("DepthTexture");
+  }
+
   InitHistoryTargets(_Viewport);
 }
 
@@ -35,21 +44,14 @@ void CTAARenderPass::Execute(IRenderer &_Renderer, TRenderContext &_RenderContex
 {
   TRenderTarget &PrevOutput = *m_HistoryTargets[!m_HistoryIndex];
 
-  const glm::vec2 InverseSize = glm::vec2(1.0f / PrevOutput.Size.X, 1.0f / PrevOutput.Size.Y);
-
   C2DTexture::Bind(TEXTURE_TAA_HISTORY_UNIT, PrevOutput.Color->ID());
   C2DTexture::Bind(TEXTURE_BASIC_COLOR_UNIT, _RenderContext.ColorTexture);
   C2DTexture::Bind(TEXTURE_DEPTH_MAP_UNIT, _RenderContext.DepthTexture);
   C2DTexture::Bind(TEXTURE_VELOCITY_UNIT, _RenderContext.TAA->VelocityTexture);
-  _Renderer.SetUniform("CurrentFrame", TEXTURE_BASIC_COLOR_INDEX);
-  _Renderer.SetUniform("HistoryFrame", TEXTURE_TAA_HISTORY_INDEX);
-  _Renderer.SetUniform("VelocityTexture", TEXTURE_VELOCITY_INDEX);
-  _Renderer.SetUniform("DepthTexture", TEXTURE_DEPTH_MAP_INDEX);
-  _Renderer.SetUniform("CurrentViewProjection", _RenderContext.TAA->JitteredViewProjectionMatrix);
-  _Renderer.SetUniform("PreviousViewProjection", _RenderContext.TAA->PrevJitteredViewProjectionMatrix);
-  _Renderer.SetUniform("Jitter", _RenderContext.TAA->Jitter);
-  _Renderer.SetUniform("PrevJitter", _RenderContext.TAA->PrevJitter);
-  _Renderer.SetUniform("InverseScreenSize", InverseSize);
+  m_Shader->SetUniform(m_Uniforms.CurrentFrame, TEXTURE_BASIC_COLOR_INDEX);
+  m_Shader->SetUniform(m_Uniforms.HistoryFrame, TEXTURE_TAA_HISTORY_INDEX);
+  m_Shader->SetUniform(m_Uniforms.VelocityTexture, TEXTURE_VELOCITY_INDEX);
+  m_Shader->SetUniform(m_Uniforms.DepthTexture, TEXTURE_DEPTH_MAP_INDEX);
 
   _Renderer.DrawArrays(EPrimitiveMode::Triangles, 6);
 }
@@ -64,9 +66,9 @@ void CTAARenderPass::PostExecute(IRenderer &_Renderer, TRenderContext &_RenderCo
   CFrameBuffer::BindBuffer(m_PrevFBO);
 }
 
-bool CTAARenderPass::Accepts(const TRenderCommand &_Command) const
+ERenderFlags CTAARenderPass::GetAcceptedFlag() const
 {
-  return false;
+  return ERenderFlags_Count;
 }
 
 bool CTAARenderPass::IsAvailable() const
@@ -83,9 +85,7 @@ void CTAARenderPass::InitHistoryTargets(const TVector2i &_Viewport)
 {
   const auto CreateDepthRBO = [](TVector2i _Size) {
     CRenderBuffer DepthRBO;
-    DepthRBO.Bind();
     DepthRBO.AllocateStorage(GL_DEPTH_COMPONENT, _Size.X, _Size.Y);
-    DepthRBO.Unbind();
     return DepthRBO;
   };
 
@@ -97,7 +97,7 @@ void CTAARenderPass::InitHistoryTargets(const TVector2i &_Viewport)
       .Type           = EType::Float,
       .MinFilter      = ETextureFilter::Linear,
       .MagFilter      = ETextureFilter::Linear,
-
+      .MemoryTag      = EGPUMemoryTag::RenderTargets,
   };
 
   for (int i = 0; i < HISTORY_TARGETS_COUNT; ++i)
@@ -106,10 +106,8 @@ void CTAARenderPass::InitHistoryTargets(const TVector2i &_Viewport)
     m_HistoryTargets[i]->Size  = _Viewport;
     m_HistoryTargets[i]->Depth = CreateDepthRBO(_Viewport);
     m_HistoryTargets[i]->Color = resource::RecreateTexture("TAA_HISTORY" + std::to_string(i), TextureParams);
-    m_HistoryTargets[i]->FrameBuffer.Bind();
     m_HistoryTargets[i]->FrameBuffer.AttachTexture(GL_COLOR_ATTACHMENT0, m_HistoryTargets[i]->Color->ID());
     m_HistoryTargets[i]->FrameBuffer.AttachRenderBuffer(GL_DEPTH_ATTACHMENT, std::get<CRenderBuffer>(m_HistoryTargets[i]->Depth).ID());
-    m_HistoryTargets[i]->FrameBuffer.Unbind();
   }
 }
 
@@ -2,6 +2,7 @@
 
 #include "RenderPassTypes.h"
 #include "interfaces/RenderPass.h"
+#include "render/ShaderTypes.h"
 #include <events/EventsListener.h>
 #include <common/Sharable.h>
 #include <common/MathTypes.h>
@@ -33,7 +34,7 @@ public:
   void PreExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
   void Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
   void PostExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
-  bool Accepts(const TRenderCommand &_Command) const override;
+  ERenderFlags GetAcceptedFlag() const override;
   bool IsAvailable() const override;
   bool NeedsCommands() const override;
 
@@ -44,9 +45,18 @@ private:
   void InitHistoryTargets(const TVector2i &_Viewport);
 
 private:
+  struct TUniforms
+  {
+    TUniformHandle<int> CurrentFrame;
+    TUniformHandle<int> HistoryFrame;
+    TUniformHandle<int> VelocityTexture;
+    TUniformHandle<int> DepthTexture;
+  };
+
   static constexpr inline int HISTORY_TARGETS_COUNT = 2;
 
   std::shared_ptr<CShader>       m_Shader;
+  TUniforms                      m_Uniforms;
   std::shared_ptr<TRenderTarget> m_HistoryTargets[HISTORY_TARGETS_COUNT];
   int32_t                        m_HistoryIndex;
 
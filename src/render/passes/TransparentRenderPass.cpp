@@ -1,8 +1,10 @@
 #include "TransparentRenderPass.h"
+#include "assets/Shader.h"
 #include "interfaces/Renderer.h"
 #include "render/RenderContext.h"
 #include "render/RenderCommand.h"
 #include "render/RenderTarget.h"
+#include "render/IndirectDrawBuffer.h"
 #include "assets/Texture.h"
 #include "engine/Camera.h"
 #include "utils/Resource.h"
@@ -10,6 +12,17 @@
 CTransparentRenderPass::CTransparentRenderPass() :
     m_Shader(resource::LoadShader("PBR"))
 {
+  if (m_Shader)
+  {
+    m_Uniforms.IsShadowMapEnabled       = m_Shader->GetUniformHandle<int>("u_IsShadowMapEnabled");
+    m_Uniforms.ShadowMap                = m_Shader->GetUniformHandle<int>("u_ShadowMap");
+    m_Uniforms.IrradianceMap            = m_Shader->GetUniformHandle<int>("u_IrradianceMap");
+    m_Uniforms.BaseColorTexture         = m_Shader->GetUniformHandle<int>("u_BaseColorTexture");
+    m_Uniforms.NormalTexture            = m_Shader->GetUniformHandle<int>("u_NormalTexture");
+    m_Uniforms.EmissiveTexture          = m_Shader->GetUniformHandle<int>("u_EmissiveTexture");
+    m_Uniforms.MetallicRoughnessTexture = m_Shader->GetUniformHandle<int>("u_MetallicRoughnessTexture");
+    m_Uniforms.OcclusionTexture         = m_Shader->GetUniformHandle<int>("u_OcclusionTexture");
+  }
 }
 
 void CTransparentRenderPass::PreExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const IRenderPass::CommandsList &_Commands)
@@ -20,23 +33,25 @@ void CTransparentRenderPass::PreExecute(IRenderer &_Renderer, TRenderContext &_R
   _Renderer.SetCullFace(ECullMode::Back);
   _Renderer.SetBlending(EAlphaMode::Blend);
   _Renderer.SetShader(m_Shader);
-  _Renderer.SetUniform("u_ViewPos", _RenderContext.CameraPosition);
-  _Renderer.SetUniform("u_LightSpaceMatrix", _RenderContext.LightSpaceMatrix);
-  _Renderer.SetUniform("u_CurrViewProjection", _RenderContext.TAA ? _RenderContext.TAA->JitteredViewProjectionMatrix : _RenderContext.ViewProjectionMatrix);
-  _Renderer.SetUniform("u_PrevViewProjection", _RenderContext.TAA ? _RenderContext.TAA->PrevJitteredViewProjectionMatrix : _RenderContext.ViewProjectionMatrix);
-  _Renderer.SetUniform("u_IsShadowMapEnabled", _RenderContext.ShadowMap != CTexture::INVALID_TEXTURE);
-  _Renderer.SetUniform("u_ShadowMap", TEXTURE_SHADOW_MAP_INDEX);
-  _Renderer.SetUniform("u_IrradianceMap", TEXTURE_IRRADIANCE_MAP_INDEX);
+  m_Shader->SetUniform(m_Uniforms.IsShadowMapEnabled, _RenderContext.ShadowMap != CTexture::INVALID_TEXTURE);
+  m_Shader->SetUniform(m_Uniforms.ShadowMap, TEXTURE_SHADOW_MAP_INDEX);
+  m_Shader->SetUniform(m_Uniforms.IrradianceMap, TEXTURE_IRRADIANCE_MAP_INDEX);
+  m_Shader->SetUniform(m_Uniforms.BaseColorTexture, TEXTURE_BASIC_COLOR_INDEX);
+  m_Shader->SetUniform(m_Uniforms.NormalTexture, TEXTURE_NORMAL_INDEX);
+  m_Shader->SetUniform(m_Uniforms.EmissiveTexture, TEXTURE_EMISSIVE_INDEX);
+  m_Shader->SetUniform(m_Uniforms.MetallicRoughnessTexture, TEXTURE_METALLIC_ROUGHNESS_INDEX);
+  m_Shader->SetUniform(m_Uniforms.OcclusionTexture, TEXTURE_OCCLUSION_INDEX);
   C2DTexture::Bind(TEXTURE_SHADOW_MAP_UNIT, _RenderContext.ShadowMap);
   CCubemap::Bind(TEXTURE_IRRADIANCE_MAP_UNIT, _RenderContext.IrradianceMap);
 }
 
 void CTransparentRenderPass::Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const IRenderPass::CommandsList &_Commands)
 {
-  for (const TRenderCommand *Command : _Commands)
+  const std::vector<TDrawBatch> &Batches = _RenderContext.DrawBuffer.Build(_Commands, IsSameMaterialState, false);
+
+  for (const TDrawBatch &Batch : Batches)
   {
-    _Renderer.SetUniform("u_Model", Command->ModelMatrix);
-    _Renderer.SetUniform("u_MVP", _RenderContext.ViewProjectionMatrix * Command->ModelMatrix);
+    const TRenderCommand *Command = Batch.Command;
 
     C2DTexture::Bind(TEXTURE_BASIC_COLOR_UNIT, Command->Material.BaseColorTexture);
     C2DTexture::Bind(TEXTURE_NORMAL_UNIT, Command->Material.NormalTexture);
@@ -44,33 +59,11 @@ void CTransparentRenderPass::Execute(IRenderer &_Renderer, TRenderContext &_Rend
     C2DTexture::Bind(TEXTURE_METALLIC_ROUGHNESS_UNIT, Command->Material.MetallicRoughnessTexture);
     C2DTexture::Bind(TEXTURE_OCCLUSION_UNIT, Command->Material.OcclusionTexture);
 
-    _Renderer.SetUniform("u_Material.BaseColorTexture", TEXTURE_BASIC_COLOR_INDEX);
-    _Renderer.SetUniform("u_Material.NormalTexture", TEXTURE_NORMAL_INDEX);
-    _Renderer.SetUniform("u_Material.EmissiveTexture", TEXTURE_EMISSIVE_INDEX);
-    _Renderer.SetUniform("u_Material.MetallicRoughnessTexture", TEXTURE_METALLIC_ROUGHNESS_INDEX);
-    _Renderer.SetUniform("u_Material.OcclusionTexture", TEXTURE_OCCLUSION_INDEX);
-    _Renderer.SetUniform("u_Material.BaseColorTextureTexCoordIndex", Command->Material.BaseColorTextureTexCoordIndex);
-    _Renderer.SetUniform("u_Material.NormalTextureTexCoordIndex", Command->Material.NormalTextureTexCoordIndex);
-    _Renderer.SetUniform("u_Material.EmissiveTextureTexCoordIndex", Command->Material.EmissiveTextureTexCoordIndex);
-    _Renderer.SetUniform("u_Material.MetallicRoughnessTextureTexCoordIndex", Command->Material.MetallicRoughnessTextureTexCoordIndex);
-    _Renderer.SetUniform("u_Material.OcclusionTextureTexCoordIndex", Command->Material.OcclusionTextureTexCoordIndex);
-    _Renderer.SetUniform("u_Material.BaseColorFactor", Command->Material.BaseColorFactor);
-    _Renderer.SetUniform("u_Material.EmissiveFactor", Command->Material.EmissiveFactor);
-    _Renderer.SetUniform("u_Material.MetallicFactor", Command->Material.MetallicFactor);
-    _Renderer.SetUniform("u_Material.RoughnessFactor", Command->Material.RoughnessFactor);
-    _Renderer.SetUniform("u_Material.OcclusionStrength", Command->Material.OcclusionStrength);
-    _Renderer.SetUniform("u_Material.IsDoubleSided", Command->Material.IsDoubleSided);
-    _Renderer.SetUniform("u_Material.AlphaMode", static_cast<int>(Command->Material.AlphaMode));
-    _Renderer.SetUniform("u_Material.AlphaCutoff", Command->Material.AlphaCutoff);
     _Renderer.SetCullFace(Command->Material.IsDoubleSided ? ECullMode::None : ECullMode::Back);
 
     Command->VAO->Bind();
-
-    if (Command->IndexType != EIndexType::Absent)
-      _Renderer.DrawElements(Command->PrimitiveMode, Command->IndicesCount, Command->IndexType);
-    else
-      _Renderer.DrawArrays(Command->PrimitiveMode, Command->IndicesCount);
-
+    _Renderer.MultiDrawElementsIndirect(Command->PrimitiveMode, Command->IndexType, reinterpret_cast<const void *>(Batch.CommandsOffset),
+                                        static_cast<int>(Batch.DrawsCount), static_cast<int>(Batch.IndicesCount));
     Command->VAO->Unbind();
   }
 }
@@ -80,9 +73,9 @@ void CTransparentRenderPass::PostExecute(IRenderer &_Renderer, TRenderContext &_
   _Renderer.SetDepthMask(true); // Required for clearing the depth buffer
 }
 
-bool CTransparentRenderPass::Accepts(const TRenderCommand &_Command) const
+ERenderFlags CTransparentRenderPass::GetAcceptedFlag() const
 {
-  return _Command.RenderFlags.test(ERenderFlags_Transparent);
+  return ERenderFlags_Transparent;
 }
 
 bool CTransparentRenderPass::IsAvailable() const
@@ -2,6 +2,7 @@
 
 #include "RenderPassTypes.h"
 #include "interfaces/RenderPass.h"
+#include "render/ShaderTypes.h"
 #include <common/Sharable.h>
 
 class CShader;
@@ -20,10 +21,23 @@ public:
   void PreExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
   void Execute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
   void PostExecute(IRenderer &_Renderer, TRenderContext &_RenderContext, const CommandsList &_Commands) override;
-  bool Accepts(const TRenderCommand &_Command) const override;
+  ERenderFlags GetAcceptedFlag() const override;
   bool IsAvailable() const override;
   bool NeedsCommands() const override;
 
 private:
+  struct TUniforms
+  {
+    TUniformHandle<int> IsShadowMapEnabled;
+    TUniformHandle<int> ShadowMap;
+    TUniformHandle<int> IrradianceMap;
+    TUniformHandle<int> BaseColorTexture;
+    TUniformHandle<int> NormalTexture;
+    TUniformHandle<int> EmissiveTexture;
+    TUniformHandle<int> MetallicRoughnessTexture;
+    TUniformHandle<int> OcclusionTexture;
+  };
+
   std::shared_ptr<CShader> m_Shader;
+  TUniforms                m_Uniforms;
 };
\ No newline at end of file
@@ -7,12 +7,26 @@
 #include "ecs/systems/EnvironmentRenderSystem.h"
 #include "ecs/systems/ModelRenderSystem.h"
 #include "ecs/systems/CollisionRenderSystem.h"
+#include "ecs/systems/SpatialSystem.h"
+#include "engine/Camera.h"
+#include "engine/Config.h"
 #include "engine/Engine.h"
 #include "assets/Shader.h"
 #include "render/RenderQueue.h"
+#include "render/Visibility.h"
 #include "utils/Event.h"
+#include "utils/Memory.h"
 #include <ecs/EntitySpawner.h>
 #include <ecs/Coordinator.h>
+#include <common/JobSystem.h>
+#include <algorithm>
+
+namespace
+{
+
+constexpr size_t PROXIES_PER_JOB = 2048;
+
+} // namespace
 
 CWorld::CWorld() :
     m_EntitiesCoordinator(std::make_unique<ecs::CCoordinator>())
@@ -58,9 +72,94 @@ void CWorld::Collect(TFrameData &_FrameData)
 
 void CWorld::Collect(CRenderQueue &_Queue)
 {
-  m_EntitiesCoordinator->GetSystem<ecs::CModelRenderSystem>()->Collect(_Queue);
+  if (CConfig::Instance().GetParallelCollectEnabled())
+  {
+    Collect(_Queue, utils::CJobSystem::Instance());
+    return;
+  }
+
+  ecs::CModelRenderSystem *ModelRenderSystem = m_EntitiesCoordinator->GetSystem<ecs::CModelRenderSystem>().get();
+  ModelRenderSystem->BeginCollect(CullEntities());
+  ModelRenderSystem->Collect(_Queue, 0, ModelRenderSystem->GetProxiesCount());
+
   m_EntitiesCoordinator->GetSystem<ecs::CEnvironmentRenderSystem>()->Collect(_Queue);
   m_EntitiesCoordinator->GetSystem<ecs::CCollisionRenderSystem>()->Collect(_Queue);
+  m_EntitiesCoordinator->GetSystem<ecs::CSpatialSystem>()->Collect(_Queue);
+}
+
+void CWorld::Collect(CRenderQueue &_Queue, utils::CJobSystem &_JobSystem)
+{
+  ecs::CModelRenderSystem *ModelRenderSystem = m_EntitiesCoordinator->GetSystem<ecs::CModelRenderSystem>().get();
+
+  IRenderCollector *const Collectors[] = {
+      m_EntitiesCoordinator->GetSystem<ecs::CEnvironmentRenderSystem>().get(),
+      m_EntitiesCoordinator->GetSystem<ecs::CCollisionRenderSystem>().get(),
+      m_EntitiesCoordinator->GetSystem<ecs::CSpatialSystem>().get(),
+  };
+
+  // Every job fills a buffer of its own: the models in ranges of proxies, the rest one collector each
+  ModelRenderSystem->BeginCollect(CullEntities());
+
+  const size_t ProxiesCount   = ModelRenderSystem->GetProxiesCount();
+  const size_t ModelJobsCount = (ProxiesCount + PROXIES_PER_JOB - 1) / PROXIES_PER_JOB;
+  const size_t JobsCount      = ModelJobsCount + std::size(Collectors);
+
+  if (m_CommandBuffers.size() < JobsCount)
+    m_CommandBuffers.resize(JobsCount);
+
+  _JobSystem.ParallelFor(JobsCount, [&](size_t _Job) {
+    MEMORY_TAG_SCOPE(EMemoryTag::Render);
+
+    CRenderQueue &Buffer = m_CommandBuffers[_Job];
+    Buffer.Clear();
+
+    if (_Job < ModelJobsCount)
+    {
+      const size_t FirstProxy = _Job * PROXIES_PER_JOB;
+      ModelRenderSystem->Collect(Buffer, FirstProxy, std::min(PROXIES_PER_JOB, ProxiesCount - FirstProxy));
+    }
+    else
+    {
+      Collectors[_Job - ModelJobsCount]->Collect(Buffer);
+    }
+  });
+
+  // The buffers are merged in the job order, so the queue doesn't depend on the scheduling
+  m_CommandOffsets.resize(JobsCount + 1);
+  m_CommandOffsets[0] = 0;
+  for (size_t Job = 0; Job < JobsCount; ++Job)
+    m_CommandOffsets[Job + 1] = m_CommandOffsets[Job] + m_CommandBuffers[Job].GetSize();
+
+  const std::span<TRenderCommand> Commands = _Queue.Append(m_CommandOffsets[JobsCount]);
+
+  _JobSystem.ParallelFor(JobsCount, [&](size_t _Job) {
+    std::ranges::move(m_CommandBuffers[_Job].GetCommands(), Commands.begin() + m_CommandOffsets[_Job]);
+  });
+}
+
+std::optional<std::span<const ecs::TEntity>> CWorld::CullEntities()
+{
+  const std::shared_ptr<CCamera> Camera = CEngine::Instance().GetCamera();
+  if (!CConfig::Instance().GetSpatialCullingEnabled() || !Camera)
+    return std::nullopt;
+
+  const CAABBTree &Tree       = m_EntitiesCoordinator->GetSystem<ecs::CSpatialSystem>()->GetTree();
+  const auto       AddVisible = [this](uint32_t _Entity) { m_VisibleEntities.push_back(static_cast<ecs::TEntity>(_Entity)); };
+
+  m_VisibleEntities.clear();
+
+  const glm::mat4 ViewProjection = Camera->GetPerspectiveProjection() * Camera->GetView();
+  Tree.QueryFrustum(CVisibilityLists::CreateFrustum(EVisibilityView::Camera, ViewProjection), AddVisible);
+
+  // Shadow casters out of the camera view still darken what's in it
+  if (const std::optional<glm::vec3> LightDirection = m_EntitiesCoordinator->GetSystem<ecs::CLightingSystem>()->GetDirectionalLightDirection())
+    Tree.QueryFrustum(CVisibilityLists::CreateFrustum(EVisibilityView::Light, CreateLightSpaceMatrix(LightDirection.value())), AddVisible);
+
+  // Entities in both views are reported twice
+  std::ranges::sort(m_VisibleEntities);
+  m_VisibleEntities.erase(std::ranges::unique(m_VisibleEntities).begin(), m_VisibleEntities.end());
+
+  return m_VisibleEntities;
 }
 
 ecs::TNameComponent *CWorld::GetEntityName(ecs::TEntity _Entity) const
@@ -79,6 +178,15 @@ ecs::TTransformComponent *CWorld::GetTransform(ecs::TEntity _Entity) const
   return nullptr;
 }
 
+std::optional<ecs::TEntity> CWorld::PickEntity(const glm::vec3 &_Origin, const glm::vec3 &_Direction, float _MaxDistance) const
+{
+  const std::optional<CAABBTree::TRayHit> Hit = m_EntitiesCoordinator->GetSystem<ecs::CSpatialSystem>()->GetTree().RayCast(_Origin, _Direction, _MaxDistance);
+  if (!Hit.has_value())
+    return std::nullopt;
+
+  return static_cast<ecs::TEntity>(Hit->UserData);
+}
+
 ecs::TEntity CWorld::CloneEntity(ecs::TEntity _Entity)
 {
   return m_EntitiesCoordinator->CloneEntity(_Entity);
@@ -104,6 +212,11 @@ CUnorderedVector<ecs::TComponentView> CWorld::GetEntityComponents(ecs::TEntity _
   return m_EntitiesCoordinator->GetEntityComponents(_Entity);
 }
 
+void CWorld::NotifyComponentChanged(ecs::TEntity _Entity, ecs::TTypeID _TypeID)
+{
+  m_EntitiesCoordinator->NotifyComponentChanged(_Entity, _TypeID);
+}
+
 void CWorld::InitECS()
 {
   m_EntitiesCoordinator->Init();
@@ -120,6 +233,7 @@ void CWorld::InitECS()
   m_EntitiesCoordinator->RegisterSystem<ecs::CEnvironmentRenderSystem>();
   m_EntitiesCoordinator->RegisterSystem<ecs::CPhysicsSystem>();
   m_EntitiesCoordinator->RegisterSystem<ecs::CCollisionRenderSystem>();
+  m_EntitiesCoordinator->RegisterSystem<ecs::CSpatialSystem>();
 
   {
     ecs::TSignature LightingSystemSignature;
@@ -157,6 +271,13 @@ void CWorld::InitECS()
     CollisionRenderSystemSignature.set(m_EntitiesCoordinator->GetComponentType<ecs::TCollisionComponent>());
     m_EntitiesCoordinator->SetSystemSignature<ecs::CCollisionRenderSystem>(CollisionRenderSystemSignature);
   }
+
+  {
+    ecs::TSignature SpatialSystemSignature;
+    SpatialSystemSignature.set(m_EntitiesCoordinator->GetComponentType<ecs::TTransformComponent>());
+    SpatialSystemSignature.set(m_EntitiesCoordinator->GetComponentType<ecs::TCollisionComponent>());
+    m_EntitiesCoordinator->SetSystemSignature<ecs::CSpatialSystem>(SpatialSystemSignature);
+  }
 }
 
 void CWorld::SubscribeToEvents()
@@ -7,8 +7,17 @@
 #include <common/interfaces/Updateable.h>
 #include <common/Sharable.h>
 #include <events/EventsListener.h>
+#include <optional>
+#include <span>
+#include <vector>
 
 class CEngine;
+class CRenderQueue;
+
+namespace utils
+{
+class CJobSystem;
+} // namespace utils
 
 namespace ecs
 {
@@ -39,19 +48,31 @@ public:
 
   void Collect(TFrameData &_FrameData) override;
   void Collect(CRenderQueue &_Queue) override;
+  void Collect(CRenderQueue &_Queue, utils::CJobSystem &_JobSystem); // On the jobs whatever the config says
 
   ecs::TNameComponent *GetEntityName(ecs::TEntity _Entity) const override;
   ecs::TTransformComponent *GetTransform(ecs::TEntity _Entity) const override;
+  std::optional<ecs::TEntity> PickEntity(const glm::vec3 &_Origin, const glm::vec3 &_Direction, float _MaxDistance) const override;
   ecs::TEntity CloneEntity(ecs::TEntity _Entity) override;
   void DestroyEntity(ecs::TEntity _Entity) override;
   ecs::CEntitySpawner CreateEntitySpawner() override;
   CUnorderedVector<ecs::TEntity> GetEntities() const override;
   CUnorderedVector<ecs::TComponentView> GetEntityComponents(ecs::TEntity _Entity) const override;
+  void NotifyComponentChanged(ecs::TEntity _Entity, ecs::TTypeID _TypeID) override;
 
 protected:
   void InitECS();
   void SubscribeToEvents();
 
+  // The entities in the camera view or in the light view, found in the spatial tree, sorted.
+  // std::nullopt with the culling disabled.
+  std::optional<std::span<const ecs::TEntity>> CullEntities();
+
 public:
   std::unique_ptr<ecs::CCoordinator> m_EntitiesCoordinator;
+
+private:
+  std::vector<CRenderQueue> m_CommandBuffers; // One per collection job, reused between frames
+  std::vector<size_t>       m_CommandOffsets; // Of the job buffers in the merged queue
+  std::vector<ecs::TEntity> m_VisibleEntities;
 };
\ No newline at end of file
@@ -0,0 +1,278 @@
+#include "Memory.h"
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <unistd.h>
+#include <cstdio>
+#elif defined(__APPLE__)
+#include <sys/resource.h>
+#include <mach/mach.h>
+#elif defined(_WIN32)
+#include <malloc.h>
+#endif
+
+#ifndef MEMORY_TRACKING
+#define MEMORY_TRACKING 0
+#endif
+
+namespace
+{
+
+struct TAtomicMemoryCounter
+{
+  std::atomic<uint64_t> Live{0};
+  std::atomic<uint64_t> Peak{0};
+};
+
+std::array<TAtomicMemoryCounter, static_cast<size_t>(EMemoryTag::Count)>    CPUCounters;
+std::array<TAtomicMemoryCounter, static_cast<size_t>(EGPUMemoryTag::Count)> GPUCounters;
+std::atomic<uint64_t>                                                       CPUAllocationsCount{0};
+
+thread_local EMemoryTag CurrentTag = EMemoryTag::General;
+
+void AddLive(TAtomicMemoryCounter &_Counter, int64_t _Delta)
+{
+  const uint64_t Live = _Counter.Live.fetch_add(static_cast<uint64_t>(_Delta), std::memory_order_relaxed) + static_cast<uint64_t>(_Delta);
+
+  uint64_t Peak = _Counter.Peak.load(std::memory_order_relaxed);
+  while (Live > Peak && !_Counter.Peak.compare_exchange_weak(Peak, Live, std::memory_order_relaxed))
+  {
+  }
+}
+
+TMemoryCounter Load(const TAtomicMemoryCounter &_Counter)
+{
+  return TMemoryCounter{
+      .Live = _Counter.Live.load(std::memory_order_relaxed),
+      .Peak = _Counter.Peak.load(std::memory_order_relaxed),
+  };
+}
+
+#if MEMORY_TRACKING
+
+// Stored right before the pointer returned to the caller
+struct alignas(__STDCPP_DEFAULT_NEW_ALIGNMENT__) TAllocationHeader
+{
+  uint64_t   Size;
+  uint32_t   Offset; // From the start of the block to the returned pointer
+  EMemoryTag Tag;
+  bool       IsOverAligned;
+};
+
+void *Allocate(std::size_t _Size, std::size_t _Alignment) noexcept
+{
+  const bool        IsOverAligned = _Alignment > __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+  const std::size_t Offset        = std::max(_Alignment, sizeof(TAllocationHeader));
+
+  void *Block = nullptr;
+  if (IsOverAligned)
+  {
+#if defined(_WIN32)
+    Block = _aligned_malloc(Offset + _Size, _Alignment);
+#else
+    Block = std::aligned_alloc(_Alignment, (Offset + _Size + _Alignment - 1) & ~(_Alignment - 1));
+#endif
+  }
+  else
+  {
+    Block = std::malloc(Offset + _Size);
+  }
+
+  if (!Block)
+    return nullptr;
+
+  std::byte         *Pointer = static_cast<std::byte *>(Block) + Offset;
+  TAllocationHeader *Header  = reinterpret_cast<TAllocationHeader *>(Pointer) - 1;
+
+  Header->Size          = _Size;
+  Header->Offset        = static_cast<uint32_t>(Offset);
+  Header->Tag           = CurrentTag;
+  Header->IsOverAligned = IsOverAligned;
+
+  AddLive(CPUCounters[static_cast<size_t>(Header->Tag)], static_cast<int64_t>(_Size));
+  CPUAllocationsCount.fetch_add(1, std::memory_order_relaxed);
+  return Pointer;
+}
+
+void *AllocateOrThrow(std::size_t _Size, std::size_t _Alignment)
+{
+  void *Pointer = Allocate(_Size, _Alignment);
+  if (!Pointer)
+    throw std::bad_alloc();
+
+  return Pointer;
+}
+
+void Deallocate(void *_Pointer) noexcept
+{
+  if (!_Pointer)
+    return;
+
+  const TAllocationHeader *Header = static_cast<TAllocationHeader *>(_Pointer) - 1;
+  AddLive(CPUCounters[static_cast<size_t>(Header->Tag)], -static_cast<int64_t>(Header->Size));
+
+  void *Block = static_cast<std::byte *>(_Pointer) - Header->Offset;
+#if defined(_WIN32)
+  if (Header->IsOverAligned)
+  {
+    _aligned_free(Block);
+    return;
+  }
+#endif
+  std::free(Block);
+}
+
+#endif
+
+} // namespace
+
+#if MEMORY_TRACKING
+
+// clang-format off
+void *operator new(std::size_t _Size)                                                             { return AllocateOrThrow(_Size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void *operator new[](std::size_t _Size)                                                           { return AllocateOrThrow(_Size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void *operator new(std::size_t _Size, const std::nothrow_t &) noexcept                            { return Allocate(_Size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void *operator new[](std::size_t _Size, const std::nothrow_t &) noexcept                          { return Allocate(_Size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+void *operator new(std::size_t _Size, std::align_val_t _Align)                                    { return AllocateOrThrow(_Size, static_cast<std::size_t>(_Align)); }
+void *operator new[](std::size_t _Size, std::align_val_t _Align)                                  { return AllocateOrThrow(_Size, static_cast<std::size_t>(_Align)); }
+void *operator new(std::size_t _Size, std::align_val_t _Align, const std::nothrow_t &) noexcept   { return Allocate(_Size, static_cast<std::size_t>(_Align)); }
+void *operator new[](std::size_t _Size, std::align_val_t _Align, const std::nothrow_t &) noexcept { return Allocate(_Size, static_cast<std::size_t>(_Align)); }
+
+void operator delete(void *_Pointer) noexcept                                                     { Deallocate(_Pointer); }
+void operator delete[](void *_Pointer) noexcept                                                   { Deallocate(_Pointer); }
+void operator delete(void *_Pointer, std::size_t) noexcept                                        { Deallocate(_Pointer); }
+void operator delete[](void *_Pointer, std::size_t) noexcept                                      { Deallocate(_Pointer); }
+void operator delete(void *_Pointer, const std::nothrow_t &) noexcept                             { Deallocate(_Pointer); }
+void operator delete[](void *_Pointer, const std::nothrow_t &) noexcept                           { Deallocate(_Pointer); }
+void operator delete(void *_Pointer, std::align_val_t) noexcept                                   { Deallocate(_Pointer); }
+void operator delete[](void *_Pointer, std::align_val_t) noexcept                                 { Deallocate(_Pointer); }
+void operator delete(void *_Pointer, std::size_t, std::align_val_t) noexcept                      { Deallocate(_Pointer); }
+void operator delete[](void *_Pointer, std::size_t, std::align_val_t) noexcept                    { Deallocate(_Pointer); }
+void operator delete(void *_Pointer, std::align_val_t, const std::nothrow_t &) noexcept           { Deallocate(_Pointer); }
+void operator delete[](void *_Pointer, std::align_val_t, const std::nothrow_t &) noexcept         { Deallocate(_Pointer); }
+// clang-format on
+
+#endif
+
+namespace utils
+{
+uint64_t GetMemoryUsage()
+{
+#if defined(__linux__)
+  FILE *File = std::fopen("/proc/self/statm", "r");
+  if (!File)
+    return 0;
+
+  unsigned long long Size     = 0;
+  unsigned long long Resident = 0;
+  const int          Read     = std::fscanf(File, "%llu %llu", &Size, &Resident);
+  std::fclose(File);
+
+  return Read == 2 ? Resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE)) : 0;
+#elif defined(__APPLE__)
+  mach_task_basic_info_data_t Info{};
+  mach_msg_type_number_t      Count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&Info), &Count) != KERN_SUCCESS)
+    return 0;
+
+  return Info.resident_size;
+#else
+  return 0;
+#endif
+}
+
+uint64_t GetPeakMemoryUsage()
+{
+#if defined(__linux__)
+  rusage Usage{};
+  getrusage(RUSAGE_SELF, &Usage);
+  return static_cast<uint64_t>(Usage.ru_maxrss) * 1024; // KB on Linux
+#elif defined(__APPLE__)
+  rusage Usage{};
+  getrusage(RUSAGE_SELF, &Usage);
+  return static_cast<uint64_t>(Usage.ru_maxrss);
+#else
+  return 0;
+#endif
+}
+
+CMemoryTagScope::CMemoryTagScope(EMemoryTag _Tag) :
+    m_PreviousTag(CurrentTag)
+{
+  CurrentTag = _Tag;
+}
+
+CMemoryTagScope::~CMemoryTagScope()
+{
+  CurrentTag = m_PreviousTag;
+}
+
+bool IsMemoryTrackingEnabled()
+{
+  return MEMORY_TRACKING;
+}
+
+TMemoryCounter GetCPUMemory(EMemoryTag _Tag)
+{
+  return Load(CPUCounters[static_cast<size_t>(_Tag)]);
+}
+
+uint64_t GetCPUAllocationsCount()
+{
+  return CPUAllocationsCount.load(std::memory_order_relaxed);
+}
+
+void TrackGPUMemory(EGPUMemoryTag _Tag, int64_t _Delta)
+{
+  AddLive(GPUCounters[static_cast<size_t>(_Tag)], _Delta);
+}
+
+TMemoryCounter GetGPUMemory(EGPUMemoryTag _Tag)
+{
+  return Load(GPUCounters[static_cast<size_t>(_Tag)]);
+}
+
+std::string_view GetMemoryTagName(EMemoryTag _Tag)
+{
+  switch (_Tag)
+  {
+  case EMemoryTag::General:
+    return "General";
+  case EMemoryTag::Assets:
+    return "Assets";
+  case EMemoryTag::ECS:
+    return "ECS";
+  case EMemoryTag::Render:
+    return "Render";
+  case EMemoryTag::Editor:
+    return "Editor";
+  default:
+    return "Unknown";
+  }
+}
+
+std::string_view GetMemoryTagName(EGPUMemoryTag _Tag)
+{
+  switch (_Tag)
+  {
+  case EGPUMemoryTag::Textures:
+    return "Textures";
+  case EGPUMemoryTag::Environment:
+    return "Environment";
+  case EGPUMemoryTag::RenderTargets:
+    return "RenderTargets";
+  case EGPUMemoryTag::ShadowMaps:
+    return "ShadowMaps";
+  case EGPUMemoryTag::Buffers:
+    return "Buffers";
+  case EGPUMemoryTag::RenderBuffers:
+    return "RenderBuffers";
+  default:
+    return "Unknown";
+  }
+}
+} // namespace utils
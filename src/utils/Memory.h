@@ -0,0 +1,66 @@
+#pragma once
+
+#include <common/Core.h>
+#include <cstdint>
+#include <string_view>
+
+enum class EMemoryTag : std::uint8_t
+{
+  General,
+  Assets,
+  ECS,
+  Render,
+  Editor,
+  Count
+};
+
+enum class EGPUMemoryTag : std::uint8_t
+{
+  Textures,
+  Environment,
+  RenderTargets,
+  ShadowMaps,
+  Buffers,
+  RenderBuffers,
+  Count
+};
+
+struct TMemoryCounter
+{
+  uint64_t Live = 0; // bytes
+  uint64_t Peak = 0; // bytes
+};
+
+namespace utils
+{
+// Resident memory of the process in bytes. Returns 0 if the platform isn't supported
+uint64_t GetMemoryUsage();
+uint64_t GetPeakMemoryUsage();
+
+// Heap allocations made through operator new are attributed to the tag of the innermost scope
+// on the allocating thread and released from the same tag. Counted only with MEMORY_TRACKING
+class CMemoryTagScope final
+{
+  DISABLE_CLASS_COPY(CMemoryTagScope);
+
+public:
+  explicit CMemoryTagScope(EMemoryTag _Tag);
+  ~CMemoryTagScope();
+
+private:
+  EMemoryTag m_PreviousTag;
+};
+
+bool IsMemoryTrackingEnabled();
+TMemoryCounter GetCPUMemory(EMemoryTag _Tag);
+uint64_t GetCPUAllocationsCount(); // Made since the start, of any tag
+
+// GPU memory can't be queried portably, so owners of GL resources report their estimated size
+void TrackGPUMemory(EGPUMemoryTag _Tag, int64_t _Delta);
+TMemoryCounter GetGPUMemory(EGPUMemoryTag _Tag);
+
+std::string_view GetMemoryTagName(EMemoryTag _Tag);
+std::string_view GetMemoryTagName(EGPUMemoryTag _Tag);
+} // namespace utils
+
+#define MEMORY_TAG_SCOPE(Tag) utils::CMemoryTagScope MemoryTagScope(Tag)
@@ -58,6 +58,21 @@ std::shared_ptr<CTexture> GetDefaultTexture(ETextureType _TextureType)
   return Get()->GetDefaultTexture(_TextureType);
 }
 
+std::shared_ptr<CMaterialBuffer::CHandle> CreateMaterial(const TShaderMaterial &_Material)
+{
+  return Get()->CreateMaterial(_Material);
+}
+
+std::shared_ptr<CMaterialBuffer> GetMaterialBuffer()
+{
+  return Get()->GetMaterialBuffer();
+}
+
+std::shared_ptr<CGeometryPool::CAllocation> AllocateGeometry(const TGeometryData &_Geometry)
+{
+  return Get()->AllocateGeometry(_Geometry);
+}
+
 void Retire(const std::string &_Name)
 {
   Get()->Retire(_Name);
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "assets/TextureParams.h"
+#include "render/GeometryPool.h"
+#include "render/MaterialBuffer.h"
 
 class CModel;
 class CShader;
@@ -18,6 +20,9 @@ std::shared_ptr<CTexture> CreateCubemap(const std::string &_Name, const TTexture
 std::shared_ptr<CTexture> CreateTexture(const std::string &_Name, const TTextureParams &_Params);
 std::shared_ptr<CTexture> RecreateTexture(const std::string &_Name, const TTextureParams &_Params);
 std::shared_ptr<CTexture> GetDefaultTexture(ETextureType _TextureType);
+std::shared_ptr<CMaterialBuffer::CHandle> CreateMaterial(const TShaderMaterial &_Material);
+std::shared_ptr<CMaterialBuffer> GetMaterialBuffer();
+std::shared_ptr<CGeometryPool::CAllocation> AllocateGeometry(const TGeometryData &_Geometry);
 void Retire(const std::string &_Name);
 void Prune();
 
@@ -0,0 +1,113 @@
+// Times the SSE frustum culling kernel (see modules/common/FrustumCulling.h) against the scalar test
+// of one box at a time, on 10k to 1M synthetic boxes. Medians of a few repeats, both have to agree
+// on every box.
+// Usage: CullingBench
+// Returns 1 if the kernel and the scalar test disagree.
+
+#include <common/Clock.h>
+#include <common/FrustumCulling.h>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <print>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t BOXES_COUNTS[] = {10'000, 100'000, 1'000'000};
+constexpr size_t REPEATS        = 7;
+
+// Boxes scattered in a cube growing with their count, so the density around the camera stays the same
+utils::TBoundsList GenerateBounds(size_t _Count)
+{
+  const float HalfSide = 2.0f * std::cbrt(static_cast<float>(_Count));
+
+  std::mt19937                          Random(42);
+  std::uniform_real_distribution<float> Position(-HalfSide, HalfSide);
+  std::uniform_real_distribution<float> Extent(0.25f, 1.0f);
+
+  utils::TBoundsList Bounds;
+  for (size_t i = 0; i < _Count; ++i)
+  {
+    const glm::vec3 Center(Position(Random), Position(Random), Position(Random));
+    const glm::vec3 HalfSize(Extent(Random), Extent(Random), Extent(Random));
+
+    Bounds.Push(Center, HalfSize);
+  }
+
+  return Bounds;
+}
+
+float Median(std::vector<float> _Times)
+{
+  std::sort(_Times.begin(), _Times.end());
+  return _Times[(_Times.size() - 1) / 2];
+}
+
+// Returns false if the kernel and the scalar test disagree
+bool RunBenchmark(size_t _BoxesCount, const utils::TFrustum &_Frustum)
+{
+  const utils::TBoundsList Bounds = GenerateBounds(_BoxesCount);
+
+  std::vector<float>   KernelTimes;
+  std::vector<float>   ScalarTimes;
+  std::vector<uint8_t> KernelVisible;
+  std::vector<uint8_t> ScalarVisible(_BoxesCount);
+
+  for (size_t Repeat = 0; Repeat < REPEATS; ++Repeat)
+  {
+    utils::CClock Clock;
+    utils::CullBounds(_Frustum, Bounds, KernelVisible);
+    KernelTimes.push_back(Clock.GetElapsedTimeMs());
+
+    Clock = utils::CClock();
+    for (size_t i = 0; i < _BoxesCount; ++i)
+    {
+      const glm::vec3 Center(Bounds.CenterX[i], Bounds.CenterY[i], Bounds.CenterZ[i]);
+      const glm::vec3 Extent(Bounds.ExtentX[i], Bounds.ExtentY[i], Bounds.ExtentZ[i]);
+      ScalarVisible[i] = utils::IsBoxVisible(_Frustum, Center, Extent);
+    }
+    ScalarTimes.push_back(Clock.GetElapsedTimeMs());
+  }
+
+  const size_t VisibleCount = std::count(KernelVisible.begin(), KernelVisible.end(), 1);
+
+  size_t MismatchCount = 0;
+  for (size_t i = 0; i < _BoxesCount; ++i)
+    MismatchCount += KernelVisible[i] != ScalarVisible[i];
+
+  std::println("{:>9} {:>9} {:>10.3f} {:>10.3f}", _BoxesCount, VisibleCount, Median(KernelTimes), Median(ScalarTimes));
+
+  if (MismatchCount != 0)
+  {
+    std::println(stderr, "The SSE and scalar culling disagree on {} of {} boxes", MismatchCount, _BoxesCount);
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace
+
+int main()
+{
+  if (!FRUSTUM_CULLING_SSE)
+    std::println(stderr, "Built without SSE, the culling kernel runs the scalar loop as well");
+
+  const glm::mat4       ViewProjection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f) * glm::lookAt(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+  const utils::TFrustum Frustum        = utils::ExtractFrustum(ViewProjection);
+
+  std::println("Medians of {} runs, times in ms", REPEATS);
+  std::println("{:>9} {:>9} {:>10} {:>10}", "Boxes", "Visible", "SSE", "Scalar");
+
+  bool IsMatching = true;
+  for (size_t BoxesCount : BOXES_COUNTS)
+    IsMatching = RunBenchmark(BoxesCount, Frustum) && IsMatching;
+
+  return IsMatching ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,150 @@
+// Rasterizes known occluders into the CPU occlusion buffer (see src/render/OcclusionBuffer.h) and
+// checks which boxes it reports as hidden.
+// Usage: OcclusionTest
+// Returns 1 if at least one case got the wrong answer.
+
+#include "render/OcclusionBuffer.h"
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <cstdlib>
+#include <print>
+#include <string_view>
+
+namespace
+{
+
+constexpr float WIDTH  = static_cast<float>(COcclusionBuffer::WIDTH);
+constexpr float HEIGHT = static_cast<float>(COcclusionBuffer::HEIGHT);
+
+struct TCase
+{
+  std::string_view Name;
+  TAABB            Box;
+  bool             IsVisible;
+};
+
+// Quad facing the camera, two triangles
+TOccluderMesh CreateQuad(float _MinX, float _MinY, float _MaxX, float _MaxY, float _Z)
+{
+  TOccluderMesh Mesh;
+  Mesh.Positions = {{_MinX, _MinY, _Z}, {_MaxX, _MinY, _Z}, {_MaxX, _MaxY, _Z}, {_MinX, _MaxY, _Z}};
+  Mesh.Indices   = {0, 1, 2, 0, 2, 3};
+  return Mesh;
+}
+
+// The camera looks down -z and a world unit is a buffer pixel, so boxes can be placed on exact pixels and tiles
+glm::mat4 CreatePixelViewProjection()
+{
+  return glm::ortho(0.0f, WIDTH, 0.0f, HEIGHT, 1.0f, 100.0f);
+}
+
+glm::mat4 CreatePerspectiveViewProjection()
+{
+  return glm::perspective(glm::radians(90.0f), WIDTH / HEIGHT, 0.1f, 100.0f);
+}
+
+int RunCases(std::string_view _Group, const COcclusionBuffer &_Buffer, std::initializer_list<TCase> _Cases)
+{
+  int Failures = 0;
+  for (const TCase &Case : _Cases)
+  {
+    const bool IsVisible = _Buffer.IsVisible(Case.Box);
+    const bool IsPassed  = IsVisible == Case.IsVisible;
+
+    std::println("{} {}: {} ({})", IsPassed ? "[ OK ]" : "[FAIL]", _Group, Case.Name, IsVisible ? "visible" : "hidden");
+    Failures += IsPassed ? 0 : 1;
+  }
+
+  return Failures;
+}
+
+// One occluder covering the tiles 0..7 in both directions, pixels 0..63, at z = -10
+int TestPixelAligned()
+{
+  const TOccluderMesh Quad = CreateQuad(0.0f, 0.0f, 64.0f, 64.0f, -10.0f);
+
+  COcclusionBuffer Buffer;
+  Buffer.Begin(CreatePixelViewProjection());
+  Buffer.AddOccluder(Quad, glm::mat4(1.0f));
+  Buffer.Rasterize();
+
+  return RunCases("Pixel aligned", Buffer, {
+    {"fully hidden",             {{8.0f, 8.0f, -30.0f}, {40.0f, 40.0f, -20.0f}},  false},
+    {"in front of the occluder", {{8.0f, 8.0f, -8.0f}, {40.0f, 40.0f, -5.0f}},    true},
+    {"crossing the occluder",    {{8.0f, 8.0f, -20.0f}, {40.0f, 40.0f, -5.0f}},   true},
+    {"partly hidden",            {{48.0f, 8.0f, -30.0f}, {80.0f, 40.0f, -20.0f}}, true},
+    {"off the occluder",         {{96.0f, 8.0f, -30.0f}, {120.0f, 40.0f, -20.0f}}, true},
+    {"off screen",               {{-40.0f, 8.0f, -30.0f}, {-8.0f, 40.0f, -20.0f}}, true},
+  });
+}
+
+// Boxes placed against the tile borders of the occluder
+int TestTileEdges()
+{
+  const TOccluderMesh Full = CreateQuad(0.0f, 0.0f, 64.0f, 64.0f, -10.0f);
+  // Ends in the middle of the tile column 7, after the pixel 59, so that tile is decided per pixel
+  const TOccluderMesh Partial = CreateQuad(0.0f, 72.0f, 60.0f, 136.0f, -10.0f);
+
+  COcclusionBuffer Buffer;
+  Buffer.Begin(CreatePixelViewProjection());
+  Buffer.AddOccluder(Full, glm::mat4(1.0f));
+  Buffer.AddOccluder(Partial, glm::mat4(1.0f));
+  Buffer.Rasterize();
+
+  return RunCases("Tile edges", Buffer, {
+    {"inside the last covered tile",       {{56.0f, 56.0f, -30.0f}, {63.5f, 63.5f, -20.0f}}, false},
+    {"spanning two covered tiles",         {{4.0f, 4.0f, -30.0f}, {12.0f, 12.0f, -20.0f}},   false},
+    {"touching the uncovered tile column", {{56.0f, 8.0f, -30.0f}, {64.0f, 16.0f, -20.0f}},  true},
+    {"touching the uncovered tile row",    {{8.0f, 56.0f, -30.0f}, {16.0f, 64.0f, -20.0f}},  true},
+    {"covered part of a partial tile",     {{50.0f, 80.0f, -30.0f}, {59.5f, 88.0f, -20.0f}}, false},
+    {"uncovered part of a partial tile",   {{50.0f, 80.0f, -30.0f}, {60.5f, 88.0f, -20.0f}}, true},
+  });
+}
+
+// Perspective camera at the origin with the near plane at 0.1 and an occluder filling the view
+int TestNearPlane()
+{
+  const TOccluderMesh Wall = CreateQuad(-100.0f, -100.0f, 100.0f, 100.0f, -10.0f);
+
+  COcclusionBuffer Buffer;
+  Buffer.Begin(CreatePerspectiveViewProjection());
+  Buffer.AddOccluder(Wall, glm::mat4(1.0f));
+  Buffer.Rasterize();
+
+  int Failures = RunCases("Near plane", Buffer, {
+    {"behind the wall",           {{-1.0f, -1.0f, -30.0f}, {1.0f, 1.0f, -20.0f}}, false},
+    {"straddling the camera",     {{-0.5f, -0.5f, -1.0f}, {0.5f, 0.5f, 1.0f}},    true},
+    {"straddling the near plane", {{-0.5f, -0.5f, -0.2f}, {0.5f, 0.5f, -0.05f}},  true},
+    {"behind the camera",         {{-0.5f, -0.5f, 1.0f}, {0.5f, 0.5f, 2.0f}},     true},
+  });
+
+  // The same wall turned to reach behind the camera, its triangles aren't projected and hide nothing
+  const TOccluderMesh Crossing = CreateQuad(-100.0f, -100.0f, 100.0f, 100.0f, 0.0f);
+  const glm::mat4     Model    = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(0.0f, 0.0f, -10.0f)), glm::radians(60.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+  Buffer.Begin(CreatePerspectiveViewProjection());
+  Buffer.AddOccluder(Crossing, Model);
+  Buffer.Rasterize();
+
+  Failures += RunCases("Near plane", Buffer, {
+    {"behind a wall crossing the near plane", {{-1.0f, -1.0f, -40.0f}, {1.0f, 1.0f, -30.0f}}, true},
+  });
+
+  return Failures;
+}
+
+} // namespace
+
+int main()
+{
+  const int Failures = TestPixelAligned() + TestTileEdges() + TestNearPlane();
+
+  if (Failures != 0)
+  {
+    std::println(stderr, "{} case(s) failed", Failures);
+    return EXIT_FAILURE;
+  }
+
+  std::println("All cases passed");
+  return EXIT_SUCCESS;
+}
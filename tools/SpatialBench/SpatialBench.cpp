@@ -0,0 +1,219 @@
+// Times the spatial tree queries (see src/physics/AABBTree.h) against a sweep of every box, on 1k to
+// 1M synthetic objects: a camera frustum as the visibility build runs it, rays as the editor picks
+// with them and nearest box queries. Medians of a few repeats, the results of both sides are compared.
+// Usage: SpatialBench
+// Returns 1 if the tree and the sweep disagree.
+
+#include "physics/AABBTree.h"
+#include <common/Clock.h>
+#include <common/FrustumCulling.h>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <print>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+constexpr size_t OBJECTS_COUNTS[] = {1'000, 10'000, 100'000, 1'000'000};
+constexpr size_t REPEATS          = 7;
+constexpr size_t RAYS_COUNT       = 64;
+constexpr float  RAY_LENGTH       = 300.0f;
+constexpr size_t POINTS_COUNT     = 64; // Nearest box queries
+
+// Boxes scattered in a cube growing with their count, so the density around the camera stays the same
+std::vector<TAABB> GenerateBoxes(size_t _Count)
+{
+  const float HalfSide = 2.0f * std::cbrt(static_cast<float>(_Count));
+
+  std::mt19937                          Random(42);
+  std::uniform_real_distribution<float> Position(-HalfSide, HalfSide);
+  std::uniform_real_distribution<float> Extent(0.25f, 1.0f);
+
+  std::vector<TAABB> Boxes(_Count);
+  for (TAABB &Box : Boxes)
+  {
+    const glm::vec3 Center(Position(Random), Position(Random), Position(Random));
+    const glm::vec3 HalfSize(Extent(Random), Extent(Random), Extent(Random));
+
+    Box = TAABB{.Min = Center - HalfSize, .Max = Center + HalfSize};
+  }
+
+  return Boxes;
+}
+
+// Slab test, as the tree does it, the distance to the entry point or zero when starting inside
+std::optional<float> IntersectRay(const TAABB &_Box, const glm::vec3 &_Origin, const glm::vec3 &_InverseDirection, float _MaxDistance)
+{
+  const glm::vec3 T0 = (_Box.Min - _Origin) * _InverseDirection;
+  const glm::vec3 T1 = (_Box.Max - _Origin) * _InverseDirection;
+
+  const glm::vec3 Near = glm::min(T0, T1);
+  const glm::vec3 Far  = glm::max(T0, T1);
+
+  const float Enter = std::max({Near.x, Near.y, Near.z, 0.0f});
+  const float Exit  = std::min({Far.x, Far.y, Far.z, _MaxDistance});
+
+  if (Enter > Exit)
+    return std::nullopt;
+
+  return Enter;
+}
+
+float DistanceSquared(const TAABB &_Box, const glm::vec3 &_Point)
+{
+  const glm::vec3 Delta = _Point - glm::clamp(_Point, _Box.Min, _Box.Max);
+  return glm::dot(Delta, Delta);
+}
+
+float Median(std::vector<float> _Times)
+{
+  std::sort(_Times.begin(), _Times.end());
+  return _Times[(_Times.size() - 1) / 2];
+}
+
+// Returns false if the tree and the sweep disagree
+bool RunBenchmark(size_t _ObjectsCount, const utils::TFrustum &_Frustum, const std::vector<glm::vec3> &_RayDirections, const std::vector<glm::vec3> &_Points)
+{
+  const std::vector<TAABB> Boxes = GenerateBoxes(_ObjectsCount);
+
+  utils::TBoundsList Bounds;
+  for (const TAABB &Box : Boxes)
+    Bounds.Push(Box.Center(), Box.Size() * 0.5f);
+
+  utils::CClock Clock;
+
+  CAABBTree Tree;
+  for (size_t i = 0; i < Boxes.size(); ++i)
+    Tree.Insert(Boxes[i], static_cast<uint32_t>(i));
+
+  const float BuildTime = Clock.GetElapsedTimeMs();
+
+  std::vector<float>   SweepFrustumTimes;
+  std::vector<float>   TreeFrustumTimes;
+  std::vector<float>   SweepRayTimes;
+  std::vector<float>   TreeRayTimes;
+  std::vector<float>   SweepNearestTimes;
+  std::vector<float>   TreeNearestTimes;
+  std::vector<uint8_t> Visible;
+  size_t               SweepVisibleCount = 0;
+  size_t               TreeVisibleCount  = 0;
+  size_t               RayMismatches     = 0;
+  size_t               NearestMismatches = 0;
+
+  for (size_t Repeat = 0; Repeat < REPEATS; ++Repeat)
+  {
+    Clock = utils::CClock();
+    utils::CullBounds(_Frustum, Bounds, Visible);
+    SweepVisibleCount = std::count(Visible.begin(), Visible.end(), 1);
+    SweepFrustumTimes.push_back(Clock.GetElapsedTimeMs());
+
+    Clock            = utils::CClock();
+    TreeVisibleCount = 0;
+    Tree.QueryFrustum(_Frustum, [&TreeVisibleCount](uint32_t) { ++TreeVisibleCount; });
+    TreeFrustumTimes.push_back(Clock.GetElapsedTimeMs());
+
+    std::vector<float> SweepDistances(RAYS_COUNT, -1.0f);
+
+    Clock = utils::CClock();
+    for (size_t Ray = 0; Ray < RAYS_COUNT; ++Ray)
+    {
+      const glm::vec3 InverseDirection = 1.0f / _RayDirections[Ray];
+
+      float Closest = RAY_LENGTH;
+      for (const TAABB &Box : Boxes)
+      {
+        if (const std::optional<float> Distance = IntersectRay(Box, glm::vec3(0.0f), InverseDirection, Closest))
+        {
+          Closest             = Distance.value();
+          SweepDistances[Ray] = Closest;
+        }
+      }
+    }
+    SweepRayTimes.push_back(Clock.GetElapsedTimeMs());
+
+    std::vector<float> TreeDistances(RAYS_COUNT, -1.0f);
+
+    Clock = utils::CClock();
+    for (size_t Ray = 0; Ray < RAYS_COUNT; ++Ray)
+      if (const std::optional<CAABBTree::TRayHit> Hit = Tree.RayCast(glm::vec3(0.0f), _RayDirections[Ray], RAY_LENGTH))
+        TreeDistances[Ray] = Hit->Distance;
+    TreeRayTimes.push_back(Clock.GetElapsedTimeMs());
+
+    // Distances, the boxes hit may differ on ties
+    RayMismatches = 0;
+    for (size_t Ray = 0; Ray < RAYS_COUNT; ++Ray)
+      if (std::abs(SweepDistances[Ray] - TreeDistances[Ray]) > 1e-4f)
+        ++RayMismatches;
+
+    std::vector<float> SweepNearestDistances(POINTS_COUNT, std::numeric_limits<float>::max());
+
+    Clock = utils::CClock();
+    for (size_t Point = 0; Point < POINTS_COUNT; ++Point)
+      for (const TAABB &Box : Boxes)
+        SweepNearestDistances[Point] = std::min(SweepNearestDistances[Point], DistanceSquared(Box, _Points[Point]));
+    SweepNearestTimes.push_back(Clock.GetElapsedTimeMs());
+
+    std::vector<std::optional<uint32_t>> TreeNearest(POINTS_COUNT);
+
+    Clock = utils::CClock();
+    for (size_t Point = 0; Point < POINTS_COUNT; ++Point)
+      TreeNearest[Point] = Tree.QueryNearest(_Points[Point]);
+    TreeNearestTimes.push_back(Clock.GetElapsedTimeMs());
+
+    // Distances as well, several boxes may contain the point
+    NearestMismatches = 0;
+    for (size_t Point = 0; Point < POINTS_COUNT; ++Point)
+      if (!TreeNearest[Point] || DistanceSquared(Boxes[TreeNearest[Point].value()], _Points[Point]) != SweepNearestDistances[Point])
+        ++NearestMismatches;
+  }
+
+  std::println("{:>9} {:>10.3f} {:>9} {:>14.3f} {:>14.3f} {:>14.3f} {:>14.3f} {:>14.3f} {:>14.3f}", _ObjectsCount, BuildTime, TreeVisibleCount,
+               Median(SweepFrustumTimes), Median(TreeFrustumTimes), Median(SweepRayTimes), Median(TreeRayTimes), Median(SweepNearestTimes),
+               Median(TreeNearestTimes));
+
+  if (SweepVisibleCount != TreeVisibleCount || RayMismatches != 0 || NearestMismatches != 0)
+  {
+    std::println(stderr, "Queries over {} objects disagree: {} visible by the sweep, {} by the tree, {} rays and {} nearest boxes differ", _ObjectsCount,
+                 SweepVisibleCount, TreeVisibleCount, RayMismatches, NearestMismatches);
+    return false;
+  }
+
+  return true;
+}
+
+} // namespace
+
+int main()
+{
+  const glm::mat4       ViewProjection = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 300.0f) * glm::lookAt(glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+  const utils::TFrustum Frustum        = utils::ExtractFrustum(ViewProjection);
+
+  std::mt19937                          Random(7);
+  std::uniform_real_distribution<float> Axis(-1.0f, 1.0f);
+
+  std::vector<glm::vec3> RayDirections(RAYS_COUNT);
+  for (glm::vec3 &Direction : RayDirections)
+    Direction = glm::normalize(glm::vec3(1.0f, Axis(Random) * 0.5f, Axis(Random) * 0.5f));
+
+  // Around the camera, inside the boxes of the smallest set as well
+  std::vector<glm::vec3> Points(POINTS_COUNT);
+  for (glm::vec3 &Point : Points)
+    Point = glm::vec3(Axis(Random), Axis(Random), Axis(Random)) * 20.0f;
+
+  std::println("Medians of {} runs, {} rays, {} nearest queries, times in ms", REPEATS, RAYS_COUNT, POINTS_COUNT);
+  std::println("{:>9} {:>10} {:>9} {:>14} {:>14} {:>14} {:>14} {:>14} {:>14}", "Objects", "Build", "Visible", "Frustum sweep", "Frustum tree", "Rays sweep",
+               "Rays tree", "Nearest sweep", "Nearest tree");
+
+  bool IsMatching = true;
+  for (size_t ObjectsCount : OBJECTS_COUNTS)
+    IsMatching = RunBenchmark(ObjectsCount, Frustum, RayDirections, Points) && IsMatching;
+
+  return IsMatching ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,291 @@
+// Compares two stats recordings (see src/engine/StatsRecord.h) and flags statistically significant regressions.
+// Usage: StatsDiff <baseline> <candidate> [--threshold <percent>] [--alpha <p-value>]
+// Returns 1 if at least one metric regressed, 2 on invalid input.
+
+#include "engine/StatsRecord.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <optional>
+#include <print>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+
+struct TMetric
+{
+  std::string                                      Name;
+  std::function<double(const TFrameStatsRecord &)> Extract;
+};
+
+struct TSummary
+{
+  double Mean = 0.0;
+  double P50  = 0.0;
+  double P95  = 0.0;
+  double P99  = 0.0;
+};
+
+std::optional<std::vector<TFrameStatsRecord>> ReadRecording(const std::filesystem::path &_Path)
+{
+  std::ifstream File(_Path, std::ios::binary);
+  if (!File.is_open())
+  {
+    std::println(stderr, "Failed to open '{}'", _Path.string());
+    return std::nullopt;
+  }
+
+  TStatsFileHeader Header;
+  File.read(reinterpret_cast<char *>(&Header), sizeof(Header));
+
+  if (!File || Header.Magic != STATS_FILE_MAGIC)
+  {
+    std::println(stderr, "'{}' isn't a stats recording", _Path.string());
+    return std::nullopt;
+  }
+
+  if (Header.Version != STATS_FILE_VERSION || Header.RecordSize != sizeof(TFrameStatsRecord) || Header.PassCount != RENDER_PASS_GROUPS_COUNT)
+  {
+    std::println(stderr, "'{}' has an incompatible format. Version: {}, expected: {}", _Path.string(), Header.Version, STATS_FILE_VERSION);
+    return std::nullopt;
+  }
+
+  std::vector<TFrameStatsRecord> Records;
+
+  TFrameStatsRecord Record;
+  while (File.read(reinterpret_cast<char *>(&Record), sizeof(Record)))
+    Records.push_back(Record);
+
+  return Records;
+}
+
+std::vector<double> Extract(const std::vector<TFrameStatsRecord> &_Records, const TMetric &_Metric)
+{
+  std::vector<double> Values;
+  Values.reserve(_Records.size());
+  for (const TFrameStatsRecord &Record : _Records)
+    Values.push_back(_Metric.Extract(Record));
+  return Values;
+}
+
+// Nearest-rank percentile, expects sorted input
+double Percentile(const std::vector<double> &_Sorted, double _Percent)
+{
+  if (_Sorted.empty())
+    return 0.0;
+
+  const size_t Rank = static_cast<size_t>(std::ceil(_Percent / 100.0 * _Sorted.size()));
+  return _Sorted[std::clamp<size_t>(Rank, 1, _Sorted.size()) - 1];
+}
+
+TSummary Summarize(std::vector<double> _Values)
+{
+  if (_Values.empty())
+    return TSummary{};
+
+  std::sort(_Values.begin(), _Values.end());
+
+  return TSummary{
+      .Mean = std::accumulate(_Values.begin(), _Values.end(), 0.0) / _Values.size(),
+      .P50  = Percentile(_Values, 50.0),
+      .P95  = Percentile(_Values, 95.0),
+      .P99  = Percentile(_Values, 99.0),
+  };
+}
+
+// One-sided Mann-Whitney U test (normal approximation with tie correction).
+// Returns the p-value of the hypothesis "candidate values tend to be greater than baseline values"
+double MannWhitneyGreater(const std::vector<double> &_Baseline, const std::vector<double> &_Candidate)
+{
+  const size_t N1 = _Baseline.size();
+  const size_t N2 = _Candidate.size();
+  if (N1 == 0 || N2 == 0)
+    return 1.0;
+
+  std::vector<std::pair<double, bool>> Combined; // value, is candidate
+  Combined.reserve(N1 + N2);
+  for (double Value : _Baseline)
+    Combined.emplace_back(Value, false);
+  for (double Value : _Candidate)
+    Combined.emplace_back(Value, true);
+
+  std::sort(Combined.begin(), Combined.end());
+
+  const double N = static_cast<double>(N1 + N2);
+
+  double CandidateRanks = 0.0;
+  double TiesTerm       = 0.0;
+
+  for (size_t i = 0; i < Combined.size();)
+  {
+    size_t j = i;
+    while (j < Combined.size() && Combined[j].first == Combined[i].first)
+      ++j;
+
+    const double Ties     = static_cast<double>(j - i);
+    const double MidRank  = (i + 1 + j) / 2.0;
+    TiesTerm             += Ties * Ties * Ties - Ties;
+
+    for (size_t k = i; k < j; ++k)
+      if (Combined[k].second)
+        CandidateRanks += MidRank;
+
+    i = j;
+  }
+
+  const double U        = CandidateRanks - N2 * (N2 + 1) / 2.0;
+  const double Mean     = N1 * N2 / 2.0;
+  const double Variance = N1 * N2 / 12.0 * ((N + 1.0) - TiesTerm / (N * (N - 1.0)));
+
+  if (Variance <= 0.0)
+    return 1.0;
+
+  const double Z = (U - Mean) / std::sqrt(Variance);
+  return 0.5 * std::erfc(Z / std::sqrt(2.0));
+}
+
+std::vector<TMetric> GetMetrics()
+{
+  std::vector<TMetric> Metrics = {
+      {"FrameTime (ms)", [](const TFrameStatsRecord &_Record) { return double(_Record.FrameTime); }},
+      {"DrawCalls", [](const TFrameStatsRecord &_Record) { return double(_Record.DrawCalls); }},
+      {"Triangles", [](const TFrameStatsRecord &_Record) { return double(_Record.Triangles); }},
+      {"Vertices", [](const TFrameStatsRecord &_Record) { return double(_Record.Vertices); }},
+      {"AssetLoads", [](const TFrameStatsRecord &_Record) { return double(_Record.AssetLoads); }},
+      {"Memory (MB)", [](const TFrameStatsRecord &_Record) { return double(_Record.MemoryUsage) / (1024.0 * 1024.0); }},
+      {"HeapAllocations", [](const TFrameStatsRecord &_Record) { return double(_Record.HeapAllocations); }},
+      {"FrameArena (KB)", [](const TFrameStatsRecord &_Record) { return double(_Record.FrameArenaUsage) / 1024.0; }},
+      {"ShaderSwitches", [](const TFrameStatsRecord &_Record) { return double(_Record.StateChanges.ShaderSwitches); }},
+      {"TextureBinds", [](const TFrameStatsRecord &_Record) { return double(_Record.StateChanges.TextureBinds); }},
+      {"VAOBinds", [](const TFrameStatsRecord &_Record) { return double(_Record.StateChanges.VAOBinds); }},
+      {"UniformUploads", [](const TFrameStatsRecord &_Record) { return double(_Record.StateChanges.UniformUploads); }},
+      {"FBOBinds", [](const TFrameStatsRecord &_Record) { return double(_Record.StateChanges.FBOBinds); }},
+      {"BlendChanges", [](const TFrameStatsRecord &_Record) { return double(_Record.StateChanges.BlendChanges); }},
+      {"CullChanges", [](const TFrameStatsRecord &_Record) { return double(_Record.StateChanges.CullChanges); }},
+      {"DepthChanges", [](const TFrameStatsRecord &_Record) { return double(_Record.StateChanges.DepthChanges); }},
+  };
+
+  for (size_t i = 0; i < RENDER_PASS_GROUPS_COUNT; ++i)
+  {
+    const std::string Name(GetRenderPassGroupName(RENDER_PASS_GROUPS[i]));
+
+    Metrics.push_back({Name + " CPU (ms)", [i](const TFrameStatsRecord &_Record) { return double(_Record.PassCPUTimes[i]); }});
+    Metrics.push_back({Name + " GPU (ms)", [i](const TFrameStatsRecord &_Record) { return double(_Record.PassGPUTimes[i]); }});
+    Metrics.push_back({Name + " DrawCalls", [i](const TFrameStatsRecord &_Record) { return double(_Record.PassDrawCalls[i]); }});
+    Metrics.push_back({Name + " Shaders", [i](const TFrameStatsRecord &_Record) { return double(_Record.PassStateChanges[i].ShaderSwitches); }});
+    Metrics.push_back({Name + " Textures", [i](const TFrameStatsRecord &_Record) { return double(_Record.PassStateChanges[i].TextureBinds); }});
+  }
+
+  return Metrics;
+}
+
+template <typename T>
+bool ParseNumber(std::string_view _Text, T &_Value)
+{
+  const auto [Ptr, Error] = std::from_chars(_Text.data(), _Text.data() + _Text.size(), _Value);
+  return Error == std::errc() && Ptr == _Text.data() + _Text.size();
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+  std::vector<std::filesystem::path> Paths;
+  double                             Threshold = 5.0; // %
+  double                             Alpha     = 0.01;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string_view Argument = argv[i];
+
+    bool IsValid = true;
+    if (Argument == "--threshold" && i + 1 < argc)
+      IsValid = ParseNumber(std::string_view(argv[++i]), Threshold);
+    else if (Argument == "--alpha" && i + 1 < argc)
+      IsValid = ParseNumber(std::string_view(argv[++i]), Alpha);
+    else
+      Paths.emplace_back(Argument);
+
+    if (!IsValid)
+    {
+      std::println(stderr, "Invalid value for '{}'", Argument);
+      return 2;
+    }
+  }
+
+  if (Paths.size() != 2)
+  {
+    std::println(stderr, "Usage: {} <baseline> <candidate> [--threshold <percent>] [--alpha <p-value>]", argv[0]);
+    return 2;
+  }
+
+  const auto Baseline  = ReadRecording(Paths[0]);
+  const auto Candidate = ReadRecording(Paths[1]);
+  if (!Baseline || !Candidate)
+    return 2;
+
+  std::println("Baseline: {} frames, candidate: {} frames. Threshold: {}%, alpha: {}", Baseline->size(), Candidate->size(), Threshold, Alpha);
+  std::println("{:<24} {:>12} {:>12} {:>9} {:>12} {:>12} {:>9} {:>10}  {}", "Metric", "Base mean", "Cand mean", "Mean %", "Base p95", "Cand p95",
+               "p95 %", "p-value", "Verdict");
+
+  int RegressionsCount = 0;
+
+  for (const TMetric &Metric : GetMetrics())
+  {
+    const std::vector<double> BaseValues = Extract(*Baseline, Metric);
+    const std::vector<double> CandValues = Extract(*Candidate, Metric);
+
+    const TSummary Base = Summarize(BaseValues);
+    const TSummary Cand = Summarize(CandValues);
+
+    const auto RelativeChange = [](double _Base, double _Cand) {
+      if (_Base == 0.0)
+        return _Cand == 0.0 ? 0.0 : 100.0;
+      return (_Cand - _Base) / _Base * 100.0;
+    };
+
+    const double MeanChange = RelativeChange(Base.Mean, Cand.Mean);
+    const double P95Change  = RelativeChange(Base.P95, Cand.P95);
+
+    const double PGreater = MannWhitneyGreater(BaseValues, CandValues);
+    const double PLess    = MannWhitneyGreater(CandValues, BaseValues);
+
+    const bool IsWorse  = std::max(MeanChange, P95Change) > Threshold;
+    const bool IsBetter = std::min(MeanChange, P95Change) < -Threshold;
+
+    std::string_view Verdict = "";
+    double           PValue  = std::min(PGreater, PLess);
+
+    if (IsWorse && PGreater < Alpha)
+    {
+      Verdict = "REGRESSION";
+      PValue  = PGreater;
+      ++RegressionsCount;
+    }
+    else if (IsBetter && PLess < Alpha)
+    {
+      Verdict = "improvement";
+      PValue  = PLess;
+    }
+
+    std::println("{:<24} {:>12.3f} {:>12.3f} {:>+8.1f}% {:>12.3f} {:>12.3f} {:>+8.1f}% {:>10.2e}  {}", Metric.Name, Base.Mean, Cand.Mean, MeanChange,
+                 Base.P95, Cand.P95, P95Change, PValue, Verdict);
+  }
+
+  if (RegressionsCount > 0)
+  {
+    std::println("{} regression(s) found", RegressionsCount);
+    return 1;
+  }
+
+  std::println("No significant regressions");
+  return 0;
+}